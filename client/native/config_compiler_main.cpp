@@ -0,0 +1,48 @@
+/*
+ * Copyright (C) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include "util/dump_config_compiler.h"
+using OHOS::HiviewDFX::DumpConfigCompiler;
+
+// compiles a JSON config into the blob the service maps at start, see dump_config_compiler.h.
+int main(int argc, char *argv[])
+{
+    if (argc != 3) {
+        fprintf(stderr, "usage: %s <config.json> <config blob>\n", argv[0]);
+        return 1;
+    }
+    std::ifstream in(argv[1], std::ios::binary);
+    if (!in) {
+        fprintf(stderr, "can not open %s\n", argv[1]);
+        return 1;
+    }
+    std::stringstream text;
+    text << in.rdbuf();
+    std::string blob;
+    std::string error;
+    if (!DumpConfigCompiler::Compile(text.str(), blob, error)) {
+        fprintf(stderr, "%s: %s\n", argv[1], error.c_str());
+        return 1;
+    }
+    std::ofstream out(argv[2], std::ios::binary | std::ios::trunc);
+    if (!out.write(blob.data(), blob.size()) || !out.flush()) {
+        fprintf(stderr, "can not write %s\n", argv[2]);
+        return 1;
+    }
+    return 0;
+}
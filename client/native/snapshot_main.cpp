@@ -0,0 +1,76 @@
+/*
+ * Copyright (C) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <cstdio>
+#include <string>
+#include "dump_snapshot_reader.h"
+using OHOS::HiviewDFX::DumpSnapshotReader;
+using OHOS::HiviewDFX::SnapshotCell;
+
+namespace {
+static const char CELL_SEPARATOR = '\t';
+
+void PrintRow(DumpSnapshotReader &reader)
+{
+    std::string line;
+    SnapshotCell cell;
+    bool first = true;
+    while (reader.NextCell(cell)) {
+        if (!first) {
+            line.push_back(CELL_SEPARATOR);
+        }
+        line.append(cell.ToString());
+        first = false;
+    }
+    printf("%s\n", line.c_str());
+}
+} // namespace
+
+// prints snapshots written by hidumper --format snapshot, cells split by tabs.
+int main(int argc, char *argv[])
+{
+    if (argc != 2) {
+        fprintf(stderr, "usage: %s <snapshot file>\n", argv[0]);
+        return 1;
+    }
+    DumpSnapshotReader reader;
+    if (!reader.Open(argv[1])) {
+        fprintf(stderr, "can not open %s\n", argv[1]);
+        return 1;
+    }
+    while (reader.Next()) {
+        switch (reader.GetType()) {
+            case DumpSnapshotReader::RECORD_BEGIN:
+                printf("# snapshot version %u, time %llu ms\n", reader.GetVersion(),
+                    static_cast<unsigned long long>(reader.GetTime()));
+                break;
+            case OHOS::HiviewDFX::SNAPSHOT_RECORD_SECTION:
+                printf("[%s]\n", reader.GetSection().ToString().c_str());
+                break;
+            case OHOS::HiviewDFX::SNAPSHOT_RECORD_ROW:
+                PrintRow(reader);
+                break;
+            case OHOS::HiviewDFX::SNAPSHOT_RECORD_TEXT:
+                printf("%s\n", reader.GetText().ToString().c_str());
+                break;
+            default:
+                break;
+        }
+    }
+    if (reader.IsCorrupted()) {
+        fprintf(stderr, "%s is corrupted or truncated\n", argv[1]);
+        return 1;
+    }
+    return 0;
+}
@@ -18,7 +18,6 @@
 #include "common/option_args.h"
 namespace OHOS {
 namespace HiviewDFX {
-class HidumperExecutor;
 struct DumpCfg {
     std::string name_;
     std::string desc_;
@@ -31,9 +30,7 @@ struct DumpCfg {
     std::shared_ptr<OptionArgs> args_;
     int type_ {DumperConstant::NONE}; // DumperConstant::NONE, GROUPTYPE_PID, GROUPTYPE_CPUID
     bool expand_ {false}; // true: expand; false: non-expand
-    std::shared_ptr<DumpCfg> parent_;
-    std::vector<std::shared_ptr<DumpCfg>> childs_; // GROUP, must clear
-    std::shared_ptr<HidumperExecutor> executor_; // GROUP, must clear
+    int parent_ {-1}; // index of the group in the config list, -1: no group
 public:
     DumpCfg();
     ~DumpCfg();
@@ -37,6 +37,8 @@ enum DumperConstant {
     SA_DUMPER,
     MEMORY_DUMPER,
     STACK_DUMPER,
+    SCHED_DUMPER,
+    CGROUP_DUMPER,
     DUMPER_END,   // dumper end
     FILTER_BEGIN, // filter begin
     COLUMN_ROWS_FILTER,
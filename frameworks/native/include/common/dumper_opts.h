@@ -22,11 +22,14 @@ struct DumperOpts {
     bool isDumpCpuFreq_;
     bool isDumpCpuUsage_;
     int cpuUsagePid_;
+    bool isDumpSchedStat_;
+    int schedStatPid_;
     bool isDumpLog_;
     std::vector<std::string> logArgs_;
     bool isDumpMem_;
     int memPid_;
     bool isDumpStorage_;
+    bool isDumpCgroup_;
     bool isDumpNet_;
     bool isDumpList_;
     bool isDumpService_;
@@ -41,6 +44,10 @@ struct DumperOpts {
     int timeout_;
     int limitSize_;
     std::string path_; // for zip
+    std::string zipCodec_; // for zip, <codec>[:level]
+    std::string format_; // output format, text, json or snapshot
+    bool isTee_; // zip and print to the client too
+    bool isStats_; // cost of each executor after the dump
     bool isAppendix_;
     bool isTest_;
 public:
@@ -50,6 +57,8 @@ public:
     void AddSelectAll();
     bool IsSelectAny() const;
     bool IsDumpZip() const;
+    bool IsDumpJson() const;
+    bool IsDumpSnapshot() const;
     bool CheckOptions(std::string& errStr) const;
     void Dump() const;
 };
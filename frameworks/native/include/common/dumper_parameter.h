@@ -21,6 +21,8 @@
 #include "common/dumper_constant.h"
 #include "common/dump_cfg.h"
 #include "common/dumper_opts.h"
+#include "util/dump_fd_writer.h"
+#include "util/dump_line_buffer.h"
 namespace OHOS {
 namespace HiviewDFX {
 class DumperParameter {
@@ -42,6 +44,16 @@ public:
     void setClientCallback(const std::shared_ptr<RawParam>& reqCtl);
     // get client callback
     std::shared_ptr<RawParam> getClientCallback();
+    // get buffered writer of client output fd, shared by all sections of the request
+    std::shared_ptr<DumpFdWriter> GetOutputWriter();
+    // flush client output at the end of request
+    bool FlushOutputWriter();
+    // lines waiting for the output executor, shared by all executors of the request
+    std::shared_ptr<DumpLineBuffer> GetLineBuffer();
+    // replace the line buffer, e.g. to output lines collected by a section running on a worker
+    void SetLineBuffer(const std::shared_ptr<DumpLineBuffer> &lineBuffer);
+    // parameter of a section running on a worker, same request but its own line buffer and no output writer
+    std::shared_ptr<DumperParameter> CreateSectionParameter() const;
     // set IPC flag
     // check IPC flag
     void SetUid(int uid)
@@ -60,13 +72,35 @@ public:
     {
         return pid_;
     };
+    // bytes a dumper may leave in the line buffer before it yields to the output, 0 for no limit
+    void SetChunkBudget(size_t budget)
+    {
+        chunkBudget_ = budget;
+    }
+    size_t GetChunkBudget() const
+    {
+        return chunkBudget_;
+    }
+    // set section of the dumpers being output, empty if they have none
+    void SetCurrentSection(const std::string &section)
+    {
+        currentSection_ = section;
+    }
+    const std::string &GetCurrentSection() const
+    {
+        return currentSection_;
+    }
     void Dump() const;
 private:
     int uid_ {-1};
     int pid_ {-1};
+    size_t chunkBudget_ {0};
     DumperOpts opts_;
     std::vector<std::shared_ptr<DumpCfg>> list_; // list
     std::shared_ptr<RawParam> mPtrReqCtl;
+    std::shared_ptr<DumpFdWriter> ptrOutputWriter_;
+    std::shared_ptr<DumpLineBuffer> ptrLineBuffer_;
+    std::string currentSection_;
 };
 } // namespace HiviewDFX
 } // namespace OHOS
@@ -0,0 +1,49 @@
+/*
+ * Copyright (C) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef CGROUP_DUMPER_H
+#define CGROUP_DUMPER_H
+#include "util/dump_cgroup_util.h"
+#include "hidumper_executor.h"
+
+namespace OHOS {
+namespace HiviewDFX {
+class CgroupDumper : public HidumperExecutor {
+public:
+    CgroupDumper();
+    ~CgroupDumper();
+    DumpStatus PreExecute(const std::shared_ptr<DumperParameter>& parameter,
+        StringMatrix dumpDatas) override;
+    DumpStatus Execute() override;
+    DumpStatus AfterExecute() override;
+
+private:
+    DumpStatus DumpCgroupInfo();
+    void DumpCgroupLine(const std::shared_ptr<CgroupInfo>& curInfo, const std::shared_ptr<CgroupInfo>& oldInfo);
+    void AddStrLineToDumpInfo(const std::string& strLine);
+    static uint64_t GetDeltaValue(uint64_t curValue, uint64_t oldValue);
+
+private:
+    static const int CGROUP_INFO_LENGTH;
+    static const uint64_t US_PER_MS;
+    static const uint64_t BYTES_PER_KB;
+    static const int CGROUP_SAMPLE_INTERVAL;
+
+    StringMatrix dumpCgroupDatas_;
+    std::vector<std::shared_ptr<CgroupInfo>> curCgroups_;
+    std::vector<std::shared_ptr<CgroupInfo>> oldCgroups_;
+};
+} // namespace HiviewDFX
+} // namespace OHOS
+#endif // CGROUP_DUMPER_H
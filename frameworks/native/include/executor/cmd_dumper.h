@@ -16,6 +16,8 @@
 #define CMD_DUMPER_H
 
 #include "hidumper_executor.h"
+#include "util/dump_command.h"
+#include "util/dump_line_reader.h"
 
 namespace OHOS {
 namespace HiviewDFX {
@@ -38,12 +40,15 @@ private:
 private:
     std::string cmd_ = "";
     StringMatrix dumpDatas_;
-    FILE *fp_;
+    std::shared_ptr<DumpLineBuffer> lineBuffer_;
+    DumpCommand command_;
+    DumpLineReader reader_;
     std::vector<std::string> lineData_;
 
     // MoreData Flag
     bool moreData_ = false;
     bool needLoop_ = false;
+    bool timedOut_ = false;
 };
 } // namespace HiviewDFX
 } // namespace OHOS
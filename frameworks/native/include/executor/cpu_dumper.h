@@ -36,26 +36,31 @@ private:
     void CreateDumpTimeString(const std::string& startTime, const std::string& endTime,
         std::string& timeStr);
     void AddStrLineToDumpInfo(const std::string& strLine);
+    void AddPsiInfo(const std::string& resource);
     void CreateCPUStatString(std::string& str);
     std::shared_ptr<ProcInfo> GetOldProc(const std::string& pid);
     void DumpProcInfo();
-    static bool SortProcInfo(std::shared_ptr<ProcInfo> &left, std::shared_ptr<ProcInfo> &right);
+    void AddProcInfoToTable(const ProcInfo &info, DumpTable &table);
 
 private:
     static const std::string LOAD_AVG_FILE_PATH;
     static const size_t LOAD_AVG_INFO_COUNT;
     static const int TM_START_YEAR;
     static const int DEC_SYSTEM_VALUE;
-    static const int PROC_CPU_LENGTH;
+    static const int PID_WIDTH;
+    static const int USAGE_WIDTH;
+    static const int FAULT_WIDTH;
+    static const int COMM_WIDTH;
     static const long unsigned HUNDRED_PERCENT_VALUE;
 
-    StringMatrix dumpCPUDatas_;
+    std::shared_ptr<DumpLineBuffer> lineBuffer_;
     bool isDumpCpuUsage_ = false;
     int cpuUsagePid_ = -1;
     std::shared_ptr<CPUInfo> curCPUInfo_;
     std::shared_ptr<CPUInfo> oldCPUInfo_;
     std::vector<std::shared_ptr<ProcInfo>> curProcs_;
     std::vector<std::shared_ptr<ProcInfo>> oldProcs_;
+    DumpCpuInfoUtil::ProcInfoMap oldProcMap_;
     std::shared_ptr<ProcInfo> curSpecProc_;
     std::shared_ptr<ProcInfo> oldSpecProc_;
     std::string startTime_;
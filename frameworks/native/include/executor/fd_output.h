@@ -16,6 +16,7 @@
 #define FD_OUTPUT_H
 
 #include "hidumper_executor.h"
+#include "util/dump_fd_writer.h"
 
 #define HIDUMPER_DEBUG
 #ifdef HIDUMPER_DEBUG
@@ -40,13 +41,21 @@ public:
     void OutMethod();
     void NewLineMethod(std::string &str);
 
+private:
+    void WriteCell(const std::shared_ptr<DumpFdWriter> &writer, const DumpLineBuffer::Cell &cell, bool isLineEnd);
+    void WriteTable(const DumpTable &table);
+    void WriteTextLine(const std::string &text);
+
 private:
     int fd_;
     std::string path_;
     StringMatrix dumpDatas_;
+    std::shared_ptr<DumpLineBuffer> lineBuffer_;
     std::string dataStr_;
     std::vector<std::string> lineData_;
     std::shared_ptr<RawParam> ptrReqCtl_;
+    std::shared_ptr<DumpFdWriter> ptrOutputWriter_;
+    std::shared_ptr<DumpFdWriter> ptrFileWriter_;
     static const mode_t OPEN_ARGV;
 };
 } // namespace HiviewDFX
@@ -29,10 +29,12 @@ public:
     DumpStatus AfterExecute() override;
 
 private:
-    static void FilterControlChar(std::string &str);
+    // filters in place, returns the new size.
+    static size_t FilterControlChar(char *data, size_t size);
 
 private:
     StringMatrix dumpDatas_;
+    std::shared_ptr<DumpLineBuffer> lineBuffer_;
 };
 } // namespace HiviewDFX
 } // namespace OHOS
@@ -16,6 +16,7 @@
 #define FILE_STREAM_DUMPER_H
 
 #include "hidumper_executor.h"
+#include "util/dump_line_reader.h"
 
 namespace OHOS {
 namespace HiviewDFX {
@@ -40,14 +41,16 @@ private:
 
 private:
     std::vector<std::string> filenames_;
-    FILE* fp_;
     int fd_;
+    DumpLineReader reader_;
     unsigned int next_file_index_;
     StringMatrix result_;
+    std::shared_ptr<DumpLineBuffer> lineBuffer_;
 
     // MoreData Flag
     bool more_data_;
     bool need_loop_;
+    bool timed_out_;
 };
 } // namespace HiviewDFX
 } // namespace OHOS
@@ -38,11 +38,16 @@ public:
     DumpStatus DoAfterExecute();
 
     void SetDumpConfig(const std::shared_ptr<DumpCfg>& config);
+    // the executor of the group of the config, it lives as long as this one.
+    void SetParent(const HidumperExecutor *parent);
     const std::shared_ptr<DumpCfg>& GetDumpConfig() const;
 
     uint64_t GetTimeRemain() const;
     bool IsTimeout() const;
     bool IsCanceled() const;
+    // true once the lines waiting for the output reach the chunk budget,
+    // a dumper then returns DUMP_MORE_DATA and goes on after the output.
+    bool IsChunkFull() const;
     std::string GetTimeoutStr(std::string head = "") const;
 protected:
     std::shared_ptr<DumpCfg> ptrDumpCfg_;
@@ -51,7 +56,9 @@ private:
     uint64_t GetHitTickCount(int nest = 0) const;
 private:
     std::shared_ptr<RawParam> rawParam_;
-    std::shared_ptr<HidumperExecutor> ptrParent_;
+    const HidumperExecutor *ptrParent_ {nullptr};
+    std::shared_ptr<DumpLineBuffer> chunkLines_;
+    size_t chunkBudget_ {0};
     bool hasOnce_ {false};
     bool hasOnceTimeout_ {false};
     uint64_t hitTickCount_ {0};
@@ -0,0 +1,92 @@
+/*
+ * Copyright (C) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef JSON_OUTPUT_H
+#define JSON_OUTPUT_H
+
+#include "hidumper_executor.h"
+#include "util/dump_fd_writer.h"
+
+namespace OHOS {
+namespace HiviewDFX {
+/**
+ * Writes the request to the client as one JSON document, row by row:
+ *   {"sections":[{"name":"memory","blocks":[
+ *   {"type":"text","lines":["..."]},
+ *   {"type":"table","header":[["","Pss"]],"rows":[["init",1024]]}]}]}
+ * Lines of one cell are text, lines of several cells are table rows. Table
+ * rows before the first one holding a number are its header. Cells are
+ * trimmed, and numbers, also "12%", are written as JSON numbers. A typed
+ * table is written from its values, its header is the names of the columns.
+ * Given a path, the document goes to that file instead of the client, e.g.
+ * as a sink of --tee.
+ */
+class JsonOutput : public HidumperExecutor {
+public:
+    JsonOutput();
+    explicit JsonOutput(const std::string &path);
+    ~JsonOutput();
+    DumpStatus PreExecute(const std::shared_ptr<DumperParameter>& parameter,
+        StringMatrix dumpDatas) override;
+    DumpStatus Execute() override;
+    DumpStatus AfterExecute() override;
+    void Reset() override;
+
+    // append str as a JSON string, a byte of no valid UTF-8 sequence as U+FFFD.
+    static void AppendString(const std::string &str, std::string &out);
+    // the document of a request no section has started in.
+    static void AppendEmptyDocument(DumpFdWriter &writer);
+    // append a trimmed cell, as a number if it is one.
+    static void AppendCell(const std::string &cell, std::string &out);
+
+private:
+    enum BlockType {
+        BLOCK_NONE = 0,
+        BLOCK_TEXT,
+        BLOCK_TABLE,
+    };
+
+    void BeginSection(const std::string &name);
+    void EndSection();
+    void BeginBlock(BlockType type);
+    void EndBlock();
+    void BeginItem();
+    void WriteText(const std::string &text);
+    void WriteTableRow(const std::vector<std::string> &line);
+    void WriteTable(const DumpTable &table);
+    void Write();
+    bool OpenFile();
+    void CloseFile();
+
+private:
+    StringMatrix dumpDatas_;
+    std::shared_ptr<DumpLineBuffer> lineBuffer_;
+    std::shared_ptr<RawParam> ptrReqCtl_;
+    std::shared_ptr<DumpFdWriter> ptrOutputWriter_;
+    std::string filePath_;
+    int fileFd_;
+    std::shared_ptr<DumpFdWriter> fileWriter_;
+    std::string buffer_;
+    bool started_;
+    bool firstSection_;
+    bool sectionOpened_;
+    std::string section_;
+    bool firstBlock_;
+    BlockType block_;
+    bool inHeader_;
+    bool firstItem_;
+};
+} // namespace HiviewDFX
+} // namespace OHOS
+#endif // JSON_OUTPUT_H
@@ -18,6 +18,7 @@
 #include <string>
 #include <vector>
 #include "executor/memory/parse/meminfo_data.h"
+#include "util/dump_line_buffer.h"
 #include "common.h"
 #include "time.h"
 namespace OHOS {
@@ -27,12 +28,11 @@ public:
     MemoryInfo();
     ~MemoryInfo();
 
-    using StringMatrix = std::shared_ptr<std::vector<std::vector<std::string>>>;
     using PairMatrix = std::vector<std::pair<std::string, uint64_t>>;
     using PairMatrixGroup = std::vector<std::pair<std::string, PairMatrix>>;
 
-    bool GetMemoryInfoByPid(const int &pid, StringMatrix result);
-    DumpStatus GetMemoryInfoNoPid(StringMatrix result);
+    bool GetMemoryInfoByPid(const int &pid, const std::shared_ptr<DumpLineBuffer> &lines);
+    DumpStatus GetMemoryInfoNoPid(const std::shared_ptr<DumpLineBuffer> &lines);
 
 private:
     enum Status {
@@ -64,12 +64,14 @@ private:
     bool pidSuccess_ = false;
     bool memProcessDone_ = false;
     bool addMemProcessTitle_ = false;
+    bool memUsageHeaderShown_ = false;
+    std::shared_ptr<DumpLineBuffer> lineBuffer_;
     std::vector<int> pids_;
     std::vector<MemInfoData::MemUsage> memUsages_;
 
     PairMatrixGroup smapsResult_;
-    void insertMemoryTitle(StringMatrix result);
-    void BuildResult(const PairMatrixGroup &infos, StringMatrix result);
+    void insertMemoryTitle();
+    void BuildResult(const PairMatrixGroup &infos);
 
     std::string AddKbUnit(const uint64_t &value);
     bool static GetMemByProcessPid(const int &pid, MemInfoData::MemUsage &usage);
@@ -78,26 +80,30 @@ private:
                             std::vector<MemInfoData::MemUsage> &memInfos);
     bool static GetSmapsInfoNoPid(const int &pid, PairMatrixGroup &result);
     bool GetMeminfo(PairMatrix &result);
-    bool GetHardWareUsage(StringMatrix result);
-    bool GetCMAUsage(StringMatrix result);
-    bool GetKernelUsage(const PairMatrix &infos, StringMatrix result);
-    void GetProcesses(const PairMatrixGroup &infos, StringMatrix result);
+    bool GetHardWareUsage();
+    bool GetCMAUsage();
+    bool GetKernelUsage(const PairMatrix &infos);
+    void GetProcesses(const PairMatrixGroup &infos);
     bool GetPids();
     void GetGroupOfPids(const int &index, const int &size, const std::vector<int> &pids, std::vector<int> &groupPids);
-    void GetPssTotal(const PairMatrixGroup &infos, StringMatrix result);
-    void GetRamUsage(const PairMatrixGroup &smapsinfos, const PairMatrix &meminfo, StringMatrix result);
-    void GetRamCategory(const PairMatrixGroup &smapsinfos, const PairMatrix &meminfos, StringMatrix result);
-    void AddBlankLine(StringMatrix result);
-    void MemUsageToMatrix(const std::vector<MemInfoData::MemUsage> &memInfos, StringMatrix result);
+    void GetPssTotal(const PairMatrixGroup &infos);
+    void GetRamUsage(const PairMatrixGroup &smapsinfos, const PairMatrix &meminfo);
+    void GetRamCategory(const PairMatrixGroup &smapsinfos, const PairMatrix &meminfos);
+    void AddBlankLine();
+    DumpTable::Column MemUsageColumn(const std::string &name, DumpTable::ColumnType type, const std::string &title,
+        int width, const std::string &unit);
+    std::shared_ptr<DumpTable> CreateMemUsageTable(const std::vector<MemInfoData::MemUsage> &memInfos);
+    void AddMemUsageTable(const std::shared_ptr<DumpTable> &table);
     void DeletePid(std::vector<int> &pids, const int &pid);
-    void AddMemByProcessTitle(StringMatrix result);
+    void AddMemPressure();
+    void AddMemByProcessTitle();
     bool static GetVss(const int &pid, uint64_t &value);
     bool static GetProcName(const int &pid, std::string &name);
     void static InitMemInfo(MemInfoData::MemInfo &memInfo);
     void static InitMemUsage(MemInfoData::MemUsage &usage);
-    void CalcGroup(const PairMatrixGroup &infos, StringMatrix result);
+    void CalcGroup(const PairMatrixGroup &infos);
     void SetValue(const std::string &value, std::vector<std::string> &lines, std::vector<std::string> &values);
-    void GetSortedMemoryInfoNoPid(StringMatrix result);
+    void GetSortedMemoryInfoNoPid();
 };
 } // namespace HiviewDFX
 } // namespace OHOS
@@ -36,7 +36,7 @@ public:
 private:
     int pid_ = 0;
     DumpStatus status_ = DUMP_FAIL;
-    StringMatrix dumpDatas_;
+    std::shared_ptr<DumpLineBuffer> lineBuffer_;
     std::unique_ptr<MemoryInfo> memoryInfo_;
 };
 } // namespace HiviewDFX
@@ -16,6 +16,7 @@
 #define SADUMPER_H
 #include <iservice_registry.h>
 #include "../include/executor/hidumper_executor.h"
+#include "util/dump_line_reader.h"
 
 namespace OHOS {
 namespace HiviewDFX {
@@ -32,11 +33,21 @@ public:
     using U16StringVector = std::vector<std::u16string>;
 
 private:
-    StringMatrix result_;
+    std::shared_ptr<DumpLineBuffer> lineBuffer_;
     StringVector names_;
     U16StringVector args_;
+    size_t nextName_ = 0;
+    std::string readName_;
+    int readFd_ = -1;
+    DumpLineReader reader_;
+    bool started_ = false;
+    bool moreData_ = false;
+    bool timedOut_ = false;
 
     DumpStatus GetData(const std::string &name, const sptr<ISystemAbilityManager> &sam);
+    bool OpenNextDump();
+    void ReadDumpLine();
+    void ClosePipe();
 };
 } // namespace HiviewDFX
 } // namespace OHOS
@@ -0,0 +1,59 @@
+/*
+ * Copyright (C) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef SCHED_DUMPER_H
+#define SCHED_DUMPER_H
+#include "util/dump_cpu_info_util.h"
+#include "hidumper_executor.h"
+
+namespace OHOS {
+namespace HiviewDFX {
+class SchedDumper : public HidumperExecutor {
+public:
+    SchedDumper();
+    ~SchedDumper();
+    DumpStatus PreExecute(const std::shared_ptr<DumperParameter>& parameter,
+        StringMatrix dumpDatas) override;
+    DumpStatus Execute() override;
+    DumpStatus AfterExecute() override;
+
+private:
+    struct SchedDelta {
+        std::string pid;
+        std::string comm;
+        uint64_t runTime;
+        uint64_t waitTime;
+        uint64_t timeslices;
+    };
+    DumpStatus DumpProcSchedStat();
+    DumpStatus DumpTaskSchedStat();
+    void CreateSchedDeltas(const std::vector<std::shared_ptr<ProcInfo>>& curInfos,
+        const std::vector<std::shared_ptr<ProcInfo>>& oldInfos);
+    void DumpSchedDeltas(const std::string& idTitle);
+    void AddStrLineToDumpInfo(const std::string& strLine);
+    static uint64_t GetDeltaValue(uint64_t curValue, uint64_t oldValue);
+    static bool SortSchedDelta(const SchedDelta& left, const SchedDelta& right);
+
+private:
+    static const int SCHED_STAT_LENGTH;
+    static const uint64_t NS_PER_US;
+    static const int TASK_SAMPLE_INTERVAL;
+
+    StringMatrix dumpSchedDatas_;
+    int schedStatPid_ = -1;
+    std::vector<SchedDelta> deltas_;
+};
+} // namespace HiviewDFX
+} // namespace OHOS
+#endif // SCHED_DUMPER_H
@@ -0,0 +1,63 @@
+/*
+ * Copyright (C) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef SNAPSHOT_OUTPUT_H
+#define SNAPSHOT_OUTPUT_H
+
+#include "hidumper_executor.h"
+#include "util/dump_fd_writer.h"
+#include "util/dump_snapshot_writer.h"
+
+namespace OHOS {
+namespace HiviewDFX {
+/**
+ * Writes the request to the client as a binary snapshot, for tools that
+ * compare captures; hidumper_snapshot prints it back. Lines are split into
+ * tables and text the way --format json does, a table is started once its
+ * header rows are known. A typed table is written from its values.
+ */
+class SnapshotOutput : public HidumperExecutor {
+public:
+    SnapshotOutput();
+    ~SnapshotOutput();
+    DumpStatus PreExecute(const std::shared_ptr<DumperParameter>& parameter,
+        StringMatrix dumpDatas) override;
+    DumpStatus Execute() override;
+    DumpStatus AfterExecute() override;
+    void Reset() override;
+
+private:
+    void WriteTableRow(const std::vector<std::string> &line);
+    void WriteHeader();
+    void WriteTable(const DumpTable &table);
+    void EndTable();
+    void WriteText(const std::string &text);
+    void Write();
+
+private:
+    StringMatrix dumpDatas_;
+    std::shared_ptr<DumpLineBuffer> lineBuffer_;
+    std::shared_ptr<RawParam> ptrReqCtl_;
+    std::shared_ptr<DumpFdWriter> ptrOutputWriter_;
+    DumpSnapshotWriter snapshot_;
+    bool sectionWritten_;
+    std::string section_;
+    bool inTable_;
+    bool inText_;
+    bool headerWritten_;
+    std::vector<std::vector<std::string>> header_;
+};
+} // namespace HiviewDFX
+} // namespace OHOS
+#endif // SNAPSHOT_OUTPUT_H
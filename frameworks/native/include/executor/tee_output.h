@@ -0,0 +1,43 @@
+/*
+ * Copyright (C) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef TEE_OUTPUT_H
+#define TEE_OUTPUT_H
+
+#include "hidumper_executor.h"
+
+namespace OHOS {
+namespace HiviewDFX {
+/**
+ * Hands every chunk of dump lines to several outputs, e.g. the client and
+ * the zip archive, so the data is collected once. Each output encodes the
+ * chunk itself; the chunk is cleared once all of them have written it.
+ */
+class TeeOutput : public HidumperExecutor {
+public:
+    explicit TeeOutput(const std::vector<std::shared_ptr<HidumperExecutor>> &sinks);
+    ~TeeOutput();
+    DumpStatus PreExecute(const std::shared_ptr<DumperParameter>& parameter,
+        StringMatrix dumpDatas) override;
+    DumpStatus Execute() override;
+    DumpStatus AfterExecute() override;
+    void Reset() override;
+
+private:
+    std::vector<std::shared_ptr<HidumperExecutor>> sinks_;
+    std::vector<bool> ready_; // PreExecute of the sink succeeded for this chunk
+};
+} // namespace HiviewDFX
+} // namespace OHOS
+#endif // TEE_OUTPUT_H
@@ -29,20 +29,21 @@ public:
         StringMatrix dumpDatas) override;
     DumpStatus Execute() override;
     DumpStatus AfterExecute() override;
+    void Reset() override;
 
 private:
-    DumpStatus CompressAndWriteToFd();
-    DumpStatus CompressBigLine(const char* content, uint16_t size);
-    void ClearBuffer();
+    DumpStatus FinishStream();
+    DumpStatus AppendTable(const DumpTable &table);
 
 private:
     std::string mFilePath_;
     StringMatrix mDumpDatas_;
+    std::shared_ptr<DumpLineBuffer> lineBuffer_;
     int fd_;
+    std::string text_;
 
+    // one gzip stream for the whole request, shared by every section.
     DumpCompressor compressor_;
-    std::shared_ptr<CompressBuffer> srcBuffer_;
-    std::shared_ptr<CompressBuffer> destBuffer_;
 };
 } // namespace HiviewDFX
 } // namespace OHOS
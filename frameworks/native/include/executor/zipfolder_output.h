@@ -14,9 +14,17 @@
  */
 #ifndef ZIP_FOLDER_OUTPUT_H
 #define ZIP_FOLDER_OUTPUT_H
+#include <memory>
+#include <set>
 #include "hidumper_executor.h"
+#include "util/zip/zip_writer.h"
 namespace OHOS {
 namespace HiviewDFX {
+/**
+ * Streams the dump into the zip, one entry per section, compressing lines as
+ * they are produced. Files copied to the request folder, e.g. smaps, are
+ * added when the request ends.
+ */
 class ZipFolderOutput : public HidumperExecutor {
 public:
     ZipFolderOutput();
@@ -27,11 +35,20 @@ public:
     DumpStatus Execute() override;
     DumpStatus AfterExecute() override;
     void Reset() override;
+private:
+    bool OpenSectionEntry(const std::string &section);
+    bool WriteBuffer();
+    bool AppendTable(const DumpTable &table);
+    bool EndBufferLine(size_t start);
 private:
     StringMatrix dumpDatas_;
+    std::shared_ptr<DumpLineBuffer> lineBuffer_;
     std::shared_ptr<DumperParameter> param_;
-    std::string logDefaultPath_;
-    int fd_;
+    std::unique_ptr<ZipWriter> zipWriter_;
+    bool entryOpened_;
+    std::string entrySection_;
+    std::set<std::string> entryNames_;
+    std::string buffer_;
 };
 } // namespace HiviewDFX
 } // namespace OHOS
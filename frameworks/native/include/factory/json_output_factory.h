@@ -0,0 +1,35 @@
+/*
+ * Copyright (C) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef JSON_OUTPUT_FACTORY_H
+#define JSON_OUTPUT_FACTORY_H
+
+#include <string>
+#include "executor_factory.h"
+
+namespace OHOS {
+namespace HiviewDFX {
+class JsonOutputFactory : public ExecutorFactory {
+public:
+    JsonOutputFactory() = default;
+    // the outputs write to the file at path instead of the client.
+    explicit JsonOutputFactory(const std::string &path);
+    std::shared_ptr<HidumperExecutor> CreateExecutor() override;
+
+private:
+    std::string path_;
+};
+} // namespace HiviewDFX
+} // namespace OHOS
+#endif // JSON_OUTPUT_FACTORY_H
@@ -0,0 +1,33 @@
+/*
+ * Copyright (C) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef TEE_OUTPUT_FACTORY_H
+#define TEE_OUTPUT_FACTORY_H
+
+#include <vector>
+#include "executor_factory.h"
+
+namespace OHOS {
+namespace HiviewDFX {
+class TeeOutputFactory : public ExecutorFactory {
+public:
+    explicit TeeOutputFactory(const std::vector<std::shared_ptr<ExecutorFactory>> &sinkFactories);
+    std::shared_ptr<HidumperExecutor> CreateExecutor() override;
+
+private:
+    std::vector<std::shared_ptr<ExecutorFactory>> sinkFactories_;
+};
+} // namespace HiviewDFX
+} // namespace OHOS
+#endif // TEE_OUTPUT_FACTORY_H
@@ -14,6 +14,8 @@
  */
 #ifndef DUMP_IMPLEMENT_H
 #define DUMP_IMPLEMENT_H
+#include <condition_variable>
+#include <deque>
 #include <map>
 #include <memory>
 #include <getopt.h>
@@ -27,6 +29,7 @@
 #include "common/dumper_constant.h"
 #include "executor/hidumper_executor.h"
 #include "factory/executor_factory.h"
+#include "util/dump_executor_stats.h"
 
 namespace OHOS {
 namespace HiviewDFX {
@@ -49,17 +52,94 @@ private:
      */
     bool IsHidumperClientProcess(int pid);
     DumpStatus CmdParseWithParameter(int argc, char* argv[], DumperOpts& opts_);
-    DumpStatus CmdParseWithParameter(std::shared_ptr<DumperParameter>& dumpParameter,
-        int argc, char* argv[], DumperOpts& opts_);
     DumpStatus SetCmdParameter(int argc, char* argv[], DumperOpts& opts_);
     DumpStatus SetCmdIntegerParameter(const std::string& str, int& value);
     void CmdHelp();
+    std::shared_ptr<ExecutorFactory> CreateOutputFactory(const DumperOpts& opts);
     void setExecutorList(std::vector<std::shared_ptr<HidumperExecutor>>& executors,
-        const std::vector<std::shared_ptr<DumpCfg>>& configs, bool isZip);
+        const std::vector<std::shared_ptr<DumpCfg>>& configs, const DumperOpts& opts);
     DumpStatus DumpDatas(const std::vector<std::shared_ptr<HidumperExecutor>>& executors,
         const std::shared_ptr<DumperParameter>& dumpParameter,
         HidumperExecutor::StringMatrix dumpDatas);
     void AddGroupTitle(const std::string& groupName, HidumperExecutor::StringMatrix dumpDatas);
+#ifdef DUMP_TEST_MODE // for mock test
+public:
+#else // for mock test
+private:
+#endif // for mock test
+    DumpStatus CmdParseWithParameter(std::shared_ptr<DumperParameter>& dumpParameter,
+        int argc, char* argv[], DumperOpts& opts_);
+    // the json file --tee writes next to the archive.
+    static std::string GetTeeJsonPath(const std::string& zipPath);
+    // lines of one output point of a section, collected by a worker.
+    struct SectionBatch {
+        size_t index; // of the output executor
+        std::string section;
+        std::shared_ptr<DumpLineBuffer> lines;
+        size_t bytes;
+    };
+    // a range of executors with one top-level section, run by one worker.
+    struct SectionJob {
+        size_t begin;
+        size_t end;
+        std::deque<SectionBatch> batches;
+        std::vector<std::shared_ptr<DumpLineBuffer>> freeLines; // drained by the output, filled again
+        bool done;
+    };
+    struct SectionSchedule {
+        std::mutex mutex;
+        std::condition_variable cond;
+        std::condition_variable roomCond;
+        std::vector<SectionJob> jobs;
+        size_t nextJob = 0;
+        size_t outputJob = 0; // the job the main thread outputs, it never waits for room
+        size_t pendingBytes = 0; // of the batches not output yet
+        size_t maxPendingBytes = 0; // 0 for no limit
+        bool stopping = false;
+        DumpExecutorStats* stats = nullptr;
+    };
+    static uint32_t GetSectionWorkers();
+    // bytes of lines a dumper collects before the output runs, 0 for no limit.
+    static size_t GetChunkBudget();
+    static long long GetNumberParameter(const char* key, long long defaultValue);
+    /**
+     * Split the executor list at the outputs where the section changes, so each job owns the group
+     * executors of its section and the loops of its dumpers.
+     */
+    void SplitSections(const std::vector<std::shared_ptr<HidumperExecutor>>& executors,
+        std::vector<SectionJob>& jobs);
+    /**
+     * Run executors [begin, end). Without a schedule the outputs run inline; with one, the lines at
+     * each output are kept as a batch of the job, to be output later in config order.
+     * A dumper returning DUMP_MORE_DATA, e.g. at the chunk budget, runs again after the output, and
+     * the dumpers behind it wait until it is done.
+     */
+    void DumpRange(const std::vector<std::shared_ptr<HidumperExecutor>>& executors, size_t begin, size_t end,
+        const std::shared_ptr<DumperParameter>& dumpParameter, HidumperExecutor::StringMatrix dumpDatas,
+        SectionSchedule* schedule, size_t job, DumpExecutorStats* stats);
+    // false if the executor stopped before AfterExecute.
+    bool ExecuteOne(const std::shared_ptr<HidumperExecutor>& executor, size_t index,
+        const std::shared_ptr<DumperParameter>& dumpParameter, HidumperExecutor::StringMatrix dumpDatas,
+        DumpExecutorStats* stats, DumpStatus& ret);
+    bool RunExecutor(const std::shared_ptr<HidumperExecutor>& executor,
+        const std::shared_ptr<DumperParameter>& dumpParameter, HidumperExecutor::StringMatrix dumpDatas,
+        DumpStatus& ret);
+    std::shared_ptr<DumpExecutorStats> CreateExecutorStats(
+        const std::vector<std::shared_ptr<HidumperExecutor>>& executors);
+    // the stats table goes through the output as the last section.
+    void DumpExecutorStatsTable(const std::vector<std::shared_ptr<HidumperExecutor>>& executors,
+        const std::shared_ptr<DumperParameter>& dumpParameter, const DumpExecutorStats& stats);
+    void AddSectionBatch(SectionSchedule& schedule, size_t job, size_t index,
+        const std::shared_ptr<DumperParameter>& sectionParameter, HidumperExecutor::StringMatrix dumpDatas);
+    // give the lines of an output batch back to its job, so the arena is reused for the next batches.
+    void RecycleSectionLines(SectionSchedule& schedule, size_t job, const std::shared_ptr<DumpLineBuffer>& lines);
+    void RunSectionJobs(const std::vector<std::shared_ptr<HidumperExecutor>>& executors,
+        const std::shared_ptr<DumperParameter>& dumpParameter, SectionSchedule& schedule);
+    bool WaitSectionBatch(SectionSchedule& schedule, size_t job, const std::shared_ptr<RawParam>& callback,
+        SectionBatch& batch);
+    void DumpSections(const std::vector<std::shared_ptr<HidumperExecutor>>& executors,
+        const std::shared_ptr<DumperParameter>& dumpParameter, SectionSchedule& schedule, uint32_t workers);
+private:
     void AddExecutorFactoryToMap();
     /**
      * Check group name changed.
@@ -96,7 +176,6 @@ private:
     std::shared_ptr<RawParam> ptrReqCtl_;
     sptr<ISystemAbilityManager> sam_;
     std::string GetTime();
-    std::string path_;
 };
 } // namespace HiviewDFX
 } // namespace OHOS
@@ -14,7 +14,9 @@
  */
 #ifndef HIDUMPER_SERVICES_CONFIG_DATA_H
 #define HIDUMPER_SERVICES_CONFIG_DATA_H
+#include <cstdint>
 #include <string>
+#include <string_view>
 namespace OHOS {
 namespace HiviewDFX {
 class ConfigData {
@@ -33,6 +35,7 @@ public:
     static const std::string CONFIG_NAME_ABILITY;
     static const std::string CONFIG_GROUP_CPU_FREQ;
     static const std::string CONFIG_GROUP_CPU_USAGE;
+    static const std::string CONFIG_GROUP_SCHED_STAT;
     static const std::string CONFIG_GROUP_LOG;
     static const std::string CONFIG_GROUP_LOG_;
     static const std::string CONFIG_GROUP_LOG_KERNEL;
@@ -40,6 +43,7 @@ public:
     static const std::string CONFIG_GROUP_LOG_INIT;
     static const std::string CONFIG_GROUP_MEMORY;
     static const std::string CONFIG_GROUP_STORAGE;
+    static const std::string CONFIG_GROUP_CGROUP;
     static const std::string CONFIG_GROUP_NET;
     static const std::string CONFIG_GROUP_SERVICE;
     static const std::string CONFIG_GROUP_ABILITY;
@@ -63,31 +67,46 @@ public:
     static const std::string STR_BASE;
     static const std::string STR_SERVICE;
     static const std::string STR_SYSTEM;
-protected:
+    // the tables are constant data, names are found through a perfect hash built at compile time.
     struct ItemCfg {
-        const std::string &name_;
-        const std::string &desc_;
-        const std::string &target_;
-        const std::string &section_;
-        const int &class_;
-        const int &level_;
-        const int &loop_;
-        const std::string &filterCfg_;
+        std::string_view name_;
+        std::string_view desc_;
+        std::string_view target_;
+        std::string_view section_;
+        int class_;
+        int level_;
+        int loop_;
+        std::string_view filterCfg_;
     };
     struct DumperCfg {
-        const std::string &name_;
-        const std::string &desc_;
-        const ItemCfg * const &list_;
-        const int &size_;
+        std::string_view name_;
+        std::string_view desc_;
+        const ItemCfg *list_;
+        int size_;
     };
     struct GroupCfg {
-        const std::string &name_;
-        const std::string &desc_;
-        const std::string * const &list_;
-        const int &size_;
-        const int type_; // DumperConstant::NONE, GROUPTYPE_PID, GROUPTYPE_CPUID
-        const bool expand_; // true: expand; false: non-expand
+        std::string_view name_;
+        std::string_view desc_;
+        const std::string_view *list_;
+        int size_;
+        int type_; // DumperConstant::NONE, GROUPTYPE_PID, GROUPTYPE_CPUID
+        bool expand_; // true: expand; false: non-expand
     };
+    // FNV-1a of the name, the tables and the config blobs are indexed by it.
+    static constexpr uint32_t HashName(std::string_view name, uint32_t seed)
+    {
+        uint32_t hash = HASH_OFFSET ^ seed;
+        for (char c : name) {
+            hash = (hash ^ static_cast<unsigned char>(c)) * HASH_PRIME;
+        }
+        return hash;
+    }
+    // index in dumpers_/groups_, -1 if there is no such name.
+    static int FindDumper(std::string_view name);
+    static int FindGroup(std::string_view name);
+protected:
+    static constexpr uint32_t HASH_OFFSET = 2166136261u;
+    static constexpr uint32_t HASH_PRIME = 16777619u;
     static const GroupCfg groups_[];
     static const int groupSum_;
     static const DumperCfg dumpers_[];
@@ -102,6 +121,8 @@ private:
     static const ItemCfg kernelCpufreqDumper_[];
     static const ItemCfg uptimeDumper_[];
     static const ItemCfg cpuUsageDumper_[];
+    static const ItemCfg schedStatDumper_[];
+    static const ItemCfg cgroupDumper_[];
     static const ItemCfg cpuFreqDumper_[];
     static const ItemCfg memDumper_[];
     static const ItemCfg envDumper_[];
@@ -140,32 +161,32 @@ private:
     static const ItemCfg listSystemAbilityDumper_[];
     static const ItemCfg listSystemDumper_[];
     static const ItemCfg testDumper_[];
-    static const std::string cpuFreqGroup_[];
-    static const std::string cpuUsageGroup_[];
-    static const std::string logKernelGroup_[];
-    static const std::string logHilogGroup_[];
-    static const std::string logInitGroup_[];
-    static const std::string memoryGroup_[];
-    static const std::string storageGroup_[];
-    static const std::string netGroup_[];
-    static const std::string serviceGroup_[];
-    static const std::string systemAbilityGroup_[];
-    static const std::string systemBaseGroup_[];
-    static const std::string systemSystemGroup_[];
-    static const std::string processesGroup_[];
-    static const std::string processesGroup_eng_[];
-    static const std::string processesPidGroup_[];
-    static const std::string processesPidGroup_eng_[];
-    static const std::string faultLogGroup_[];
-    static const std::string stackGroup_[];
-    static const std::string testGroup_[];
-    static const std::string processesGroupMini_[];
-    static const std::string processesGroupMini_eng_[];
-    static const std::string processesPidGroupMini_[];
-    static const std::string processesPidGroupMini_eng_[];
-    static const std::string systemBaseCpuIdGroupMini_[];
-    static const std::string systemSystemCpuIdGroupMini_[];
-    static const std::string systemSystemPidGroupMini_[];
+    static const std::string_view cpuFreqGroup_[];
+    static const std::string_view cpuUsageGroup_[];
+    static const std::string_view schedStatGroup_[];
+    static const std::string_view logKernelGroup_[];
+    static const std::string_view logHilogGroup_[];
+    static const std::string_view memoryGroup_[];
+    static const std::string_view storageGroup_[];
+    static const std::string_view cgroupGroup_[];
+    static const std::string_view netGroup_[];
+    static const std::string_view systemAbilityGroup_[];
+    static const std::string_view systemBaseGroup_[];
+    static const std::string_view systemSystemGroup_[];
+    static const std::string_view processesGroup_[];
+    static const std::string_view processesGroup_eng_[];
+    static const std::string_view processesPidGroup_[];
+    static const std::string_view processesPidGroup_eng_[];
+    static const std::string_view faultLogGroup_[];
+    static const std::string_view stackGroup_[];
+    static const std::string_view testGroup_[];
+    static const std::string_view processesGroupMini_[];
+    static const std::string_view processesGroupMini_eng_[];
+    static const std::string_view processesPidGroupMini_[];
+    static const std::string_view processesPidGroupMini_eng_[];
+    static const std::string_view systemBaseCpuIdGroupMini_[];
+    static const std::string_view systemSystemCpuIdGroupMini_[];
+    static const std::string_view systemSystemPidGroupMini_[];
 };
 } // namespace HiviewDFX
 } // namespace OHOS
@@ -14,12 +14,14 @@
  */
 #ifndef HIDUMPER_SERVICES_CONFIG_UTILS_H
 #define HIDUMPER_SERVICES_CONFIG_UTILS_H
+#include <memory>
 #include <string>
 #include <vector>
 #include "dump_common_utils.h"
 #include "common/dump_cfg.h"
 #include "common/dumper_parameter.h"
 #include "util/config_data.h"
+#include "util/dump_config_blob.h"
 namespace OHOS {
 namespace HiviewDFX {
 class ConfigUtils : public ConfigData {
@@ -33,13 +35,26 @@ public:
     static DumpStatus GetSectionNames(const std::string &name, std::vector<std::string> &nameList);
     // Used for get dump level
     static int GetDumpLevelByPid(int uid, const DumpCommonUtils::PidInfo &pidInfo);
+    // Used for add the dumpers and groups of config blobs, a name is taken from the tables first.
+    static void LoadConfigBlobs();
+    static void SetConfigBlobs(const std::vector<std::shared_ptr<const DumpConfigBlob>> &blobs);
 #ifdef DUMP_TEST_MODE // for mock test
 public:
 #else // for mock test
 private:
 #endif // for mock test
     DumpStatus GetDumperConfigs();
+    // the configs of an earlier request with the same options, if the processes and cpus are the same.
+    static bool GetPlanDumperConfigs(const std::shared_ptr<DumperParameter> &param, const std::string &key);
+    static std::string GetPlanKey(const DumperOpts &opts, int uid);
+    static void GetPlanInputValues(const DumperOpts &opts, uint32_t inputs,
+        const std::vector<DumpCommonUtils::PidInfo> &pidInfos, const std::vector<DumpCommonUtils::CpuInfo> &cpuInfos,
+        std::vector<int> &values);
     bool MergePidInfos(std::vector<DumpCommonUtils::PidInfo> &outInfos, int pid);
+    void ClearCurrentPidInfos();
+    // processes of the current option, listed on first use when the option takes them all.
+    const std::vector<DumpCommonUtils::PidInfo> &GetCurrentPidInfos();
+    const std::vector<DumpCommonUtils::CpuInfo> &GetCpuInfos();
     bool HandleDumpLog(std::vector<std::shared_ptr<DumpCfg>> &dumpCfgs);
     bool HandleDumpList(std::vector<std::shared_ptr<DumpCfg>> &dumpCfgs);
     bool HandleDumpService(std::vector<std::shared_ptr<DumpCfg>> &dumpCfgs);
@@ -47,8 +62,10 @@ private:
     bool HandleDumpSystem(std::vector<std::shared_ptr<DumpCfg>> &dumpCfgs);
     bool HandleDumpCpuFreq(std::vector<std::shared_ptr<DumpCfg>> &dumpCfgs);
     bool HandleDumpCpuUsage(std::vector<std::shared_ptr<DumpCfg>> &dumpCfgs);
+    bool HandleDumpSchedStat(std::vector<std::shared_ptr<DumpCfg>> &dumpCfgs);
     bool HandleDumpMem(std::vector<std::shared_ptr<DumpCfg>> &dumpCfgs);
     bool HandleDumpStorage(std::vector<std::shared_ptr<DumpCfg>> &dumpCfgs);
+    bool HandleDumpCgroup(std::vector<std::shared_ptr<DumpCfg>> &dumpCfgs);
     bool HandleDumpNet(std::vector<std::shared_ptr<DumpCfg>> &dumpCfgs);
     bool HandleDumpProcesses(std::vector<std::shared_ptr<DumpCfg>> &dumpCfgs);
     bool HandleDumpFaultLog(std::vector<std::shared_ptr<DumpCfg>> &dumpCfgs);
@@ -67,19 +84,37 @@ private:
         std::shared_ptr<OptionArgs> args, int level = DumperConstant::NONE, int nest = 0);
     // Used for get section name from group name
     static std::string GetSectionName(const std::string &name);
+    // the indexes of the config blobs follow the ones of the tables.
+    int FindDumperIndex(const std::string &name) const;
+    int FindGroupIndex(const std::string &name) const;
 private:
-    DumpStatus GetGroupSimple(const GroupCfg& groupCfg, std::vector<std::shared_ptr<DumpCfg>> &result,
-        std::shared_ptr<OptionArgs> args, int level = DumperConstant::NONE, int nest = 0);
+    // the blob a config is read from and its index there, no blob for the tables.
+    struct BlobRef {
+        const DumpConfigBlob *blob;
+        int index;
+    };
+    using ConfigBlobs = std::vector<std::shared_ptr<const DumpConfigBlob>>;
+    static std::shared_ptr<const ConfigBlobs> GetConfigBlobs();
+    bool GetDumperCfg(int index, DumperCfg &dumperCfg, BlobRef &ref) const;
+    bool GetGroupCfg(int index, GroupCfg &groupCfg, BlobRef &ref) const;
+    DumpStatus GetGroupSimple(const GroupCfg& groupCfg, const BlobRef &ref,
+        std::vector<std::shared_ptr<DumpCfg>> &result, std::shared_ptr<OptionArgs> args,
+        int level = DumperConstant::NONE, int nest = 0);
     static DumpStatus GetGroupNames(const std::string &name, std::vector<std::string> &nameList);
-    static void ConvertTreeToList(std::vector<std::shared_ptr<DumpCfg>> &tree,
-        std::vector<std::shared_ptr<DumpCfg>> &list, int nest = 0);
-    static void SetSection(std::vector<std::shared_ptr<DumpCfg>> &dumpCfgs, const std::string &section, int nest = 0);
+    // a group is in the list before its configs, they point back to it by index.
+    static void SetParent(std::vector<std::shared_ptr<DumpCfg>> &list, size_t begin, int parent);
+    static void SetSection(std::vector<std::shared_ptr<DumpCfg>> &dumpCfgs, size_t begin, const std::string &section);
 private:
     const std::shared_ptr<DumperParameter> dumperParam_;
+    const std::shared_ptr<const ConfigBlobs> blobs_;
     std::vector<DumpCommonUtils::PidInfo> pidInfos_;
     std::vector<DumpCommonUtils::CpuInfo> cpuInfos_;
     std::vector<DumpCommonUtils::PidInfo> currentPidInfos_;
     DumpCommonUtils::PidInfo currentPidInfo_;
+    uint32_t planInputs_ {0};
+    bool allPids_ {false};
+    bool pidInfosDone_ {false};
+    bool cpuInfosDone_ {false};
 };
 } // namespace HiviewDFX
 } // namespace OHOS
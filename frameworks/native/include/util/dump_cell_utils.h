@@ -0,0 +1,40 @@
+/*
+ * Copyright (C) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef HIDUMPER_DUMP_CELL_UTILS_H
+#define HIDUMPER_DUMP_CELL_UTILS_H
+#include <cstdint>
+#include <string>
+#include <vector>
+namespace OHOS {
+namespace HiviewDFX {
+/**
+ * Helpers for outputs that type the cells of dump lines instead of joining
+ * them, e.g. --format json.
+ */
+class DumpCellUtils {
+public:
+    // str without leading and trailing blanks.
+    static std::string Trim(const std::string &str);
+    // -?(0|[1-9][0-9]*)(\.[0-9]+)?%? on a trimmed cell.
+    static bool IsNumber(const std::string &str);
+    // true for a trimmed number, mantissa * 10^-scale is its value.
+    static bool ParseNumber(const std::string &str, int64_t &mantissa, uint8_t &scale, bool &percent);
+    // a row of dashes and blanks only, drawn under a table header.
+    static bool IsSeparatorRow(const std::vector<std::string> &line);
+    static bool HasNumber(const std::vector<std::string> &line);
+};
+} // namespace HiviewDFX
+} // namespace OHOS
+#endif // HIDUMPER_DUMP_CELL_UTILS_H
@@ -0,0 +1,76 @@
+/*
+ * Copyright (C) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef HIDUMPER_UTILS_DUMP_CGROUP_H
+#define HIDUMPER_UTILS_DUMP_CGROUP_H
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "singleton.h"
+#include "util/dump_psi_util.h"
+namespace OHOS {
+namespace HiviewDFX {
+struct CgroupInfo {
+    std::string path; // relative to the cgroup v2 root
+    bool hasCpuStat;
+    uint64_t usageUsec; // from cpu.stat
+    uint64_t userUsec;
+    uint64_t systemUsec;
+    bool hasMemory;
+    uint64_t memCurrent; // from memory.current, in bytes
+    uint64_t anon; // from memory.stat, in bytes
+    uint64_t file;
+    uint64_t kernel;
+    uint64_t sock;
+    bool hasMemPressure;
+    PsiInfo memPressure; // from memory.pressure
+};
+
+class DumpCgroupUtil : public Singleton<DumpCgroupUtil> {
+public:
+    // key is path of cgroup, used to join the current and old samples.
+    using CgroupInfoMap = std::unordered_map<std::string, std::shared_ptr<CgroupInfo>>;
+    DumpCgroupUtil();
+    ~DumpCgroupUtil();
+    bool GetCgroupRoot(std::string &root);
+    // walk the cgroup v2 hierarchy once, one read per controller file of each cgroup.
+    bool GetCurCgroupInfo(std::vector<std::shared_ptr<CgroupInfo>> &cgroupInfos);
+    bool GetOldCgroupInfo(std::vector<std::shared_ptr<CgroupInfo>> &cgroupInfos, uint64_t &tick);
+    void SetOldCgroupInfo(const std::vector<std::shared_ptr<CgroupInfo>> &cgroupInfos, uint64_t tick);
+    static void BuildCgroupInfoMap(const std::vector<std::shared_ptr<CgroupInfo>> &cgroupInfos,
+        CgroupInfoMap &cgroupMap);
+
+private:
+    void ReadCgroupInfo(const std::string &root, const std::string &path, std::shared_ptr<CgroupInfo> &cgroupInfo);
+    bool ReadCpuStat(const std::string &dir, std::shared_ptr<CgroupInfo> &cgroupInfo);
+    bool ReadMemoryStat(const std::string &dir, std::shared_ptr<CgroupInfo> &cgroupInfo);
+    static bool ReadKeyValues(const std::string &filePath, std::unordered_map<std::string, uint64_t> &values);
+
+private:
+    static const std::string DEFAULT_CGROUP_ROOT;
+    static const std::string MOUNTS_FILE_PATH;
+    static const size_t MOUNT_INFO_TYPE_INDEX = 2;
+    static const size_t MAX_CGROUP_DEPTH = 16;
+
+    std::string cgroupRoot_;
+    std::vector<std::shared_ptr<CgroupInfo>> oldCgroups_;
+    uint64_t oldCgroupsTick_ {0};
+    std::mutex mutex_;
+};
+} // namespace HiviewDFX
+} // namespace OHOS
+#endif // HIDUMPER_UTILS_DUMP_CGROUP_H
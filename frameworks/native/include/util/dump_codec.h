@@ -0,0 +1,58 @@
+/*
+ * Copyright (C) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef HIDUMPER_DUMP_CODEC_H
+#define HIDUMPER_DUMP_CODEC_H
+#include <string>
+namespace OHOS {
+namespace HiviewDFX {
+/**
+ * Codec of dump archives, selected with --zip=<codec>[:level].
+ *   deflate[:0-9]  zlib deflate, level 6 by default; 1 is the fast one.
+ *   store          no compression, for captures recompressed off device.
+ * Both are zip methods 8 and 0, so any unzip reads the archive.
+ */
+class DumpCodec {
+public:
+    enum Type {
+        CODEC_DEFLATE = 0,
+        CODEC_STORE,
+    };
+
+    DumpCodec();
+    DumpCodec(Type type, int level);
+    ~DumpCodec() = default;
+
+    // text: <codec>[:level], empty means the default codec.
+    static bool Parse(const std::string &text, DumpCodec &codec);
+
+    Type GetType() const;
+    int GetLevel() const;
+    std::string GetName() const;
+    int GetZipMethod() const;
+    int GetZlibLevel() const;
+
+public:
+    static const int DEFAULT_LEVEL;
+    static const int MIN_LEVEL;
+    static const int MAX_LEVEL;
+    static const int ZIP_METHOD_STORE;
+
+private:
+    Type type_;
+    int level_;
+};
+} // namespace HiviewDFX
+} // namespace OHOS
+#endif // HIDUMPER_DUMP_CODEC_H
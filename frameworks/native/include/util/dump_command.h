@@ -0,0 +1,54 @@
+/*
+ * Copyright (C) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef HIDUMPER_UTILS_DUMP_COMMAND_H
+#define HIDUMPER_UTILS_DUMP_COMMAND_H
+#include <cstdint>
+#include <string>
+#include <sys/types.h>
+namespace OHOS {
+namespace HiviewDFX {
+/**
+ * A shell command whose stdout is read by the dumper, as with popen, but
+ * run in its own process group so a command that outlives its deadline is
+ * killed together with the commands it started.
+ */
+class DumpCommand {
+public:
+    DumpCommand();
+    ~DumpCommand();
+    DumpCommand(const DumpCommand &) = delete;
+    DumpCommand &operator=(const DumpCommand &) = delete;
+
+    bool Start(const std::string &cmd);
+    bool IsRunning() const;
+    // read end of the stdout of the command.
+    int GetOutputFd() const;
+    // wait up to waitMs for the command to exit, kill it after.
+    void Stop(uint64_t waitMs);
+    void Kill();
+
+private:
+    void CloseOutput();
+    bool Reap(bool block);
+
+private:
+    static const int WAIT_SLICE_MILLSEC = 10;
+
+    pid_t pid_;
+    int fd_;
+};
+} // namespace HiviewDFX
+} // namespace OHOS
+#endif // HIDUMPER_UTILS_DUMP_COMMAND_H
@@ -15,48 +15,177 @@
 #ifndef HIDUMPER_DUMP_COMPRESSOR_H
 #define HIDUMPER_DUMP_COMPRESSOR_H
 
+#include <condition_variable>
+#include <deque>
+#include <functional>
 #include <iostream>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
 #include <zlib.h>
 #include "common.h"
+#include "util/dump_codec.h"
 
 
 const uint32_t MAX_COMPRESS_BUFFER_SIZE = 32 * 1024;
 
 namespace OHOS {
 namespace HiviewDFX {
-typedef struct {
-    uint32_t offset = 0;
-    char content[MAX_COMPRESS_BUFFER_SIZE] = { 0 };
-} CompressBuffer;
-
 const uint16_t CHUNK = 16384;
 const uint16_t WINDOWS_BITS = 16;
 const uint16_t MEM_LEVEL = 8;
 
+/**
+ * One gzip stream that lives as long as the request. Input is staged in a
+ * reusable buffer and deflated with Z_NO_FLUSH, so the dictionary survives
+ * across lines and sections; only Finish() closes the gzip member.
+ *
+ * With more than one worker the input is cut into fixed-size blocks which
+ * are deflated in parallel, pigz style: every block is primed with the tail
+ * of the previous one as dictionary and ends on a sync flush, so the blocks
+ * are written in order as one deflate stream.
+ */
 class DumpCompressor {
 public:
+    enum Format {
+        FORMAT_GZIP = 0,
+        FORMAT_RAW, // bare deflate data, for callers that frame it themselves
+    };
+    // takes the compressed data in stream order, false stops the stream.
+    using Sink = std::function<bool(const unsigned char *data, size_t len)>;
+
     DumpCompressor();
-    ~DumpCompressor() = default;
+    ~DumpCompressor();
 
     /**
-     * Compress content in source buffer to dest buffer using zlib.
+     * Start a compressed stream written to fd. The fd is borrowed, not closed.
      *
-     * @param srcBuffer, source buffer.
-     * @param destBuffer, dest buffer.
+     * @param fd, file to write the compressed data to.
+     * @param codec, deflate level.
+     * @param workers, deflate threads, 1 compresses on the calling thread.
+     * @param format, gzip member or raw deflate.
      * @return DUMP_OK on sucess or DUMP_FAIL on any errors.
      */
-    DumpStatus Compress(CompressBuffer*& srcBuffer, CompressBuffer*& destBuffer);
+    DumpStatus Init(int fd, const DumpCodec &codec = DumpCodec(), uint32_t workers = 1,
+        Format format = FORMAT_GZIP);
+
+    /**
+     * Start a compressed stream handed to sink instead of a file.
+     *
+     * @param sink, receives the compressed data.
+     * @param codec, deflate level.
+     * @param workers, deflate threads, 1 compresses on the calling thread.
+     * @param format, gzip member or raw deflate.
+     * @return DUMP_OK on sucess or DUMP_FAIL on any errors.
+     */
+    DumpStatus Init(const Sink &sink, const DumpCodec &codec = DumpCodec(), uint32_t workers = 1,
+        Format format = FORMAT_GZIP);
+
+    /**
+     * Feed data into the stream, compressing whenever the input buffer is full.
+     *
+     * @param data, content to compress.
+     * @param len, size of data.
+     * @return DUMP_OK on sucess or DUMP_FAIL on any errors.
+     */
+    DumpStatus Append(const char* data, size_t len);
+
+    /**
+     * Drain the input buffer, write the gzip trailer and release the stream.
+     *
+     * @return DUMP_OK on sucess or DUMP_FAIL on any errors.
+     */
+    DumpStatus Finish();
+
+    // Drop the stream without writing the trailer. The deflate state and the
+    // workers of a finished stream are kept and reused by the next Init().
+    void Reset();
+
+    bool IsActive() const
+    {
+        return active_;
+    }
+
+    // crc32 of the input of the last stream, kept after Finish().
+    uLong GetCrc() const
+    {
+        return crc_;
+    }
+
+    // input size of the last stream, kept after Finish().
+    uint64_t GetTotalIn() const
+    {
+        return totalIn_;
+    }
+
+    // Worker count from persist.hidumper.zip.workers, capped by the cpu count.
+    static uint32_t GetDefaultWorkers();
+
+public:
+    static const size_t PARALLEL_BLOCK_SIZE;
+    static const size_t DICTIONARY_SIZE;
+    static const uint32_t MAX_WORKERS;
 
 private:
-    DumpStatus FillBuffer(int& flush, CompressBuffer*& srcBuffer, char*& buffIn,
-        size_t const toRead, size_t& src_pos, size_t srcBufferOffset);
-    DumpStatus DeflateBuffer(int flush, char*& buffOut, size_t& dst_pos);
-    void DeleteZData();
+    struct Block {
+        uint64_t seq = 0;
+        bool last = false;
+        bool ok = false;
+        uLong crc = 0;
+        std::vector<unsigned char> in;
+        std::vector<unsigned char> dict;
+        std::vector<unsigned char> out;
+    };
+
+    DumpStatus Deflate(const unsigned char* data, size_t len, int flush);
+    DumpStatus FlushInput();
+    DumpStatus WriteOutput();
+    DumpStatus Start(const DumpCodec &codec, uint32_t workers, Format format);
+    DumpStatus WriteFd(const unsigned char* data, size_t len);
+    void UpdateCrc(const unsigned char* data, size_t len);
+
+    void Release();
+    DumpStatus StartWorkers(uint32_t workers);
+    void StopWorkers();
+    void WorkerLoop();
+    bool CompressBlock(z_stream &stream, Block &block);
+    DumpStatus AppendParallel(const unsigned char* data, size_t len);
+    DumpStatus SubmitBlock(bool last);
+    DumpStatus WriteBlocks(bool all);
+    DumpStatus FinishParallel();
 
 private:
     z_stream zStream_ = {0};
-    unsigned char* zData_ = nullptr;
-    uint32_t zDataSize_ = 0;
+    bool streamReady_ = false;
+    int streamBits_ = 0;
+    int streamLevel_ = Z_DEFAULT_COMPRESSION;
+    bool active_ = false;
+    int fd_ = -1;
+    Sink sink_;
+    int level_ = Z_DEFAULT_COMPRESSION;
+    Format format_ = FORMAT_GZIP;
+    std::vector<unsigned char> inBuffer_;
+    size_t inOffset_ = 0;
+    std::vector<unsigned char> outBuffer_;
+    size_t outOffset_ = 0;
+
+    // parallel mode
+    std::vector<std::thread> workers_;
+    std::mutex mutex_;
+    std::condition_variable jobCond_;
+    std::condition_variable doneCond_;
+    std::deque<std::shared_ptr<Block>> jobs_;
+    std::map<uint64_t, std::shared_ptr<Block>> done_;
+    bool stopping_ = false;
+    int workerLevel_ = Z_DEFAULT_COMPRESSION;
+    std::shared_ptr<Block> curBlock_;
+    std::vector<unsigned char> prevTail_;
+    uint64_t nextSeq_ = 0;
+    uint64_t nextWrite_ = 0;
+    uLong crc_ = 0;
+    uint64_t totalIn_ = 0;
 };
 } // namespace HiviewDFX
 } // namespace OHOS
@@ -0,0 +1,136 @@
+/*
+ * Copyright (C) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef HIDUMPER_UTIL_DUMP_CONFIG_BLOB_H
+#define HIDUMPER_UTIL_DUMP_CONFIG_BLOB_H
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include "util/config_data.h"
+namespace OHOS {
+namespace HiviewDFX {
+/**
+ * Dumpers and groups compiled from a config file by hidumper_config_compiler,
+ * they come after the ones of ConfigData. Little endian, counts and offsets
+ * are u32 and offsets are from the start of the file.
+ *
+ *   header  "HDCF" u16 version, u16 header size, u32 file size,
+ *           u32 DumperConstant::LOOP, the constants it was compiled with   16 bytes
+ *   parts   u32 offset, u32 count of each ConfigBlobPart                   56 bytes
+ *   seeds   u32 seed of the dumper index, u32 seed of the group index       8 bytes
+ *   BYTES   the text of the strings, a string is u32 offset, u32 size
+ *   ITEM    name, desc, target, section, filter strings,
+ *           i32 class, level, loop                                         52 bytes
+ *   DUMPER  name, desc strings, u32 first item, u32 item count             24 bytes
+ *   GROUP   name, desc strings, u32 first entry, u32 entry count,
+ *           i32 type, u32 expand                                           32 bytes
+ *   ENTRY   string, the name of a dumper or a mini group of a group         8 bytes
+ *   INDEX   i32 dumper or group, -1 for none. A name is in the slot
+ *           ConfigData::HashName(name, seed) & (count - 1), count is a
+ *           power of 2 and the compiler picks a seed without collisions.
+ *
+ * Readers take versions up to their own, later versions may add to the header.
+ */
+constexpr char CONFIG_BLOB_MAGIC[] = "HDCF";
+constexpr size_t CONFIG_BLOB_MAGIC_SIZE = sizeof(CONFIG_BLOB_MAGIC) - 1;
+constexpr uint16_t CONFIG_BLOB_VERSION = 1;
+constexpr size_t CONFIG_BLOB_HEADER_SIZE = 80;
+constexpr size_t CONFIG_BLOB_STRING_SIZE = 8;
+constexpr size_t CONFIG_BLOB_ITEM_SIZE = 52;
+constexpr size_t CONFIG_BLOB_DUMPER_SIZE = 24;
+constexpr size_t CONFIG_BLOB_GROUP_SIZE = 32;
+constexpr size_t CONFIG_BLOB_ENTRY_SIZE = CONFIG_BLOB_STRING_SIZE;
+constexpr size_t CONFIG_BLOB_SLOT_SIZE = 4;
+
+enum ConfigBlobPart : uint32_t {
+    CONFIG_BLOB_BYTES = 0,
+    CONFIG_BLOB_ITEMS = 1,
+    CONFIG_BLOB_DUMPERS = 2,
+    CONFIG_BLOB_GROUPS = 3,
+    CONFIG_BLOB_ENTRIES = 4,
+    CONFIG_BLOB_DUMPER_INDEX = 5,
+    CONFIG_BLOB_GROUP_INDEX = 6,
+    CONFIG_BLOB_PARTS = 7,
+};
+
+/**
+ * A config blob in place: the file is mapped and its records are checked
+ * once, then a record is read from it each time it is asked for, names are
+ * found through the index of the blob. Nothing is copied out of the blob.
+ *
+ *   DumpConfigBlob blob;
+ *   if (blob.Open(path)) {
+ *       int index = blob.FindDumper("dumper_vendor");
+ *       if (index > -1) {
+ *           ConfigData::DumperCfg dumper = blob.GetDumper(index);
+ *           ConfigData::ItemCfg item = blob.GetItem(index, 0);
+ *       }
+ *   }
+ */
+class DumpConfigBlob {
+public:
+    DumpConfigBlob();
+    ~DumpConfigBlob();
+    DumpConfigBlob(const DumpConfigBlob &) = delete;
+    DumpConfigBlob &operator=(const DumpConfigBlob &) = delete;
+
+    // false if there is no such file or it is not a valid blob.
+    bool Open(const std::string &path);
+    // data is not copied and must outlive the blob.
+    bool Attach(const char *data, size_t size);
+    void Close();
+
+    uint16_t GetVersion() const;
+    int GetDumperSum() const;
+    int GetGroupSum() const;
+    // index of the name, -1 if there is none.
+    int FindDumper(std::string_view name) const;
+    int FindGroup(std::string_view name) const;
+    // the strings of the configs point into the blob, valid while it is open.
+    // list_ is nullptr, the items of a dumper and the entries of a group are
+    // read by GetItem and GetEntry.
+    ConfigData::DumperCfg GetDumper(int index) const;
+    ConfigData::ItemCfg GetItem(int dumper, int item) const;
+    ConfigData::GroupCfg GetGroup(int index) const;
+    std::string_view GetEntry(int group, int entry) const;
+
+private:
+    bool Load();
+    bool LoadParts();
+    bool CheckDumpers() const;
+    bool CheckGroups() const;
+    bool CheckIndex(uint32_t part, size_t records) const;
+    bool ReadItem(uint32_t index, ConfigData::ItemCfg &item) const;
+    bool ReadDumper(uint32_t index, ConfigData::DumperCfg &dumper) const;
+    bool ReadGroup(uint32_t index, ConfigData::GroupCfg &group) const;
+    // the first item of a dumper or entry of a group.
+    uint32_t ReadFirst(uint32_t part, uint32_t index) const;
+    bool ReadString(size_t pos, std::string_view &str) const;
+    int FindSlot(uint32_t part, uint32_t seed, std::string_view name) const;
+
+private:
+    const char *data_;
+    size_t size_;
+    void *map_;
+    size_t mapSize_;
+    uint16_t version_;
+    uint32_t offsets_[CONFIG_BLOB_PARTS];
+    uint32_t counts_[CONFIG_BLOB_PARTS];
+    uint32_t dumperSeed_;
+    uint32_t groupSeed_;
+};
+} // namespace HiviewDFX
+} // namespace OHOS
+#endif // HIDUMPER_UTIL_DUMP_CONFIG_BLOB_H
@@ -0,0 +1,54 @@
+/*
+ * Copyright (C) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef HIDUMPER_UTIL_DUMP_CONFIG_COMPILER_H
+#define HIDUMPER_UTIL_DUMP_CONFIG_COMPILER_H
+#include <string>
+namespace OHOS {
+namespace HiviewDFX {
+/**
+ * Compiles a JSON config into a config blob, see dump_config_blob.h.
+ *
+ *   {
+ *       "dumpers": [{
+ *           "name": "dumper_vendor_gpu",
+ *           "desc": "GPU Information",
+ *           "items": [
+ *               { "class": "file_dumper", "target": "/sys/class/gpu/load" },
+ *               { "class": "fd_output" }
+ *           ]
+ *       }],
+ *       "groups": [{
+ *           "name": "group_system_vendor",
+ *           "desc": "Vendor Information",
+ *           "type": "type_none",
+ *           "expand": true,
+ *           "items": [ "dumper_vendor_gpu", "dumper_kernel_version" ]
+ *       }]
+ *   }
+ *
+ * The keys of an item are name, desc, target, section, class, level, loop
+ * and filter, class, level and type are spelled as DumpCfg::ToStr prints
+ * them and loop is a bool. The first item takes the name and desc of its
+ * dumper unless it has its own. Names must not be in ConfigData, the items
+ * of a group are dumpers or mini groups of the file or of ConfigData.
+ */
+class DumpConfigCompiler {
+public:
+    // false and the reason in error if the config is not valid.
+    static bool Compile(const std::string &text, std::string &blob, std::string &error);
+};
+} // namespace HiviewDFX
+} // namespace OHOS
+#endif // HIDUMPER_UTIL_DUMP_CONFIG_COMPILER_H
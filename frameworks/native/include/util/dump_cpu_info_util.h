@@ -14,7 +14,9 @@
  */
 #ifndef HIDUMPER_UTILS_DUMP_CPU_INFO_H
 #define HIDUMPER_UTILS_DUMP_CPU_INFO_H
+#include <mutex>
 #include <string>
+#include <unordered_map>
 #include <vector>
 #include "singleton.h"
 namespace OHOS {
@@ -39,33 +41,63 @@ struct ProcInfo {
     long unsigned totalUsage;
     std::string minflt;
     std::string majflt;
+    uint64_t runTime; // time spent on the cpu in ns, from schedstat
+    uint64_t waitTime; // time spent waiting on a runqueue in ns, from schedstat
+    uint64_t timeslices; // timeslices run on this cpu, from schedstat
 };
 
 class DumpCpuInfoUtil : public Singleton<DumpCpuInfoUtil> {
 public:
+    // key is pid, used to join the current and old samples.
+    using ProcInfoMap = std::unordered_map<std::string, std::shared_ptr<ProcInfo>>;
     DumpCpuInfoUtil();
     ~DumpCpuInfoUtil();
     void UpdateCpuInfo();
+    // a new base sample, the old one is dropped, used when the sampler restarts.
+    void ResetCpuInfo();
+    // sleeps until the sample the usage is taken from is MIN_SAMPLE_WINDOW old.
+    void WaitCpuInfoWindow();
     bool GetCurCPUInfo(std::shared_ptr<CPUInfo> &cpuInfo);
     bool GetCurProcInfo(std::vector<std::shared_ptr<ProcInfo>> &procInfos);
+    /**
+     * Get the latest process infos, the scan of /proc is shared by dumpers
+     * of the same request (--cpuusage, --schedstat) if it's fresh enough.
+     */
+    bool GetLatestProcInfo(std::vector<std::shared_ptr<ProcInfo>> &procInfos);
     bool GetCurSpecProcInfo(int pid, std::shared_ptr<ProcInfo> &specProc);
+    bool GetCurTaskInfo(int pid, std::vector<std::shared_ptr<ProcInfo>> &taskInfos);
     bool GetOldCPUInfo(std::shared_ptr<CPUInfo> &cpuInfo);
     bool GetOldProcInfo(std::vector<std::shared_ptr<ProcInfo>> &procInfos);
+    // tick is the tick count in ms of the sample returned.
+    bool GetOldProcInfo(std::vector<std::shared_ptr<ProcInfo>> &procInfos, uint64_t &tick);
     bool GetOldSpecProcInfo(int pid, std::shared_ptr<ProcInfo> &specProc);
+    static void BuildProcInfoMap(const std::vector<std::shared_ptr<ProcInfo>> &procInfos, ProcInfoMap &procMap);
 
 private:
+    bool ParseProcStat(const std::string& statPath, std::shared_ptr<ProcInfo> &procInfo);
+    void ParseProcSchedStat(const std::string& schedStatPath, std::shared_ptr<ProcInfo> &procInfo);
+    bool ScanProcInfo(const std::string& path, std::vector<std::shared_ptr<ProcInfo>> &procInfos);
     void SetCPUInfo(long unsigned& info, const std::string& strInfo);
     void GetProcessDirFiles(const std::string& path, const std::string& file,
         std::vector<std::string>& files);
     void CopyCpuInfo(std::shared_ptr<CPUInfo> &tar, const std::shared_ptr<CPUInfo> &source);
     void CopyProcInfo(std::shared_ptr<ProcInfo> &tar, const std::shared_ptr<ProcInfo> &source);
+    void TakeSample(bool reset);
     bool CheckFrequentDumpping();
+    bool UseOldSample();
+    bool GetOldSpecProcInfo(int pid, const std::vector<std::shared_ptr<ProcInfo>> &procInfos,
+        std::shared_ptr<ProcInfo> &specProc);
 
 private:
     static const std::string LOAD_AVG_FILE_PATH;
     static const size_t LOAD_AVG_INFO_COUNT = 3;
     static const std::string PROC_STAT_FILE_PATH;
     static const std::string SPACE;
+    static const int SCHED_STAT_RUN_TIME_INDEX = 0;
+    static const int SCHED_STAT_WAIT_TIME_INDEX = 1;
+    static const int SCHED_STAT_TIMESLICES_INDEX = 2;
+    static const uint64_t LATEST_PROC_INFO_REUSE_TIME = 1000;
+    static const uint64_t MIN_SAMPLE_WINDOW = 1000;
     static const int CPU_STAT_USER_TIME_INDEX = 1;
     static const int CPU_STAT_NICE_TIME_INDEX = 2;
     static const int CPU_STAT_SYS_TIME_INDEX = 3;
@@ -84,7 +116,12 @@ private:
     std::shared_ptr<CPUInfo> oldCPUInfo_;
     std::vector<std::shared_ptr<ProcInfo>> curProcs_;
     std::vector<std::shared_ptr<ProcInfo>> oldProcs_;
+    std::vector<std::shared_ptr<ProcInfo>> latestProcs_;
+    uint64_t curProcsTick_ {0};
+    uint64_t oldProcsTick_ {0};
+    uint64_t latestProcsTick_ {0};
     int dumpTimeSec_;
+    std::mutex mutex_;
 };
 } // namespace HiviewDFX
 } // namespace OHOS
@@ -0,0 +1,77 @@
+/*
+ * Copyright (C) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef HIDUMPER_DUMP_EXECUTOR_STATS_H
+#define HIDUMPER_DUMP_EXECUTOR_STATS_H
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+#include "util/dump_line_buffer.h"
+#include "util/dump_table.h"
+namespace OHOS {
+namespace HiviewDFX {
+/**
+ * What each executor of a request cost, collected for --stats: wall and cpu
+ * time across PreExecute, Execute and AfterExecute, the lines and bytes it
+ * produced and how many times it ran. An output is counted for the lines it
+ * wrote. Executors of one name and section, e.g. one per pid, share a row.
+ *
+ * A slot is written by the thread running its executor only, so sections
+ * running on workers need no lock.
+ */
+class DumpExecutorStats {
+public:
+    using Matrix = std::vector<std::vector<std::string>>;
+    struct Sample {
+        uint64_t wallNs;
+        uint64_t cpuNs;
+        size_t lines;
+        size_t bytes;
+    };
+
+    explicit DumpExecutorStats(size_t count);
+    ~DumpExecutorStats() = default;
+
+    void SetExecutor(size_t index, const std::string &name, const std::string &section, bool isOutput);
+    void Begin(const Matrix &matrix, const DumpLineBuffer *lines, Sample &sample) const;
+    void End(size_t index, const Sample &sample, const Matrix &matrix, const DumpLineBuffer *lines);
+
+    // rows in config order, outputs last.
+    std::shared_ptr<DumpTable> CreateTable() const;
+    void Log() const;
+
+private:
+    struct Item {
+        std::string name;
+        std::string section;
+        bool isOutput;
+        uint64_t wallNs;
+        uint64_t cpuNs;
+        uint64_t lines;
+        uint64_t bytes;
+        uint32_t loops;
+    };
+
+    static uint64_t GetWallNs();
+    static uint64_t GetThreadCpuNs();
+    static void Count(const Matrix &matrix, const DumpLineBuffer *lines, size_t &lineCount, size_t &byteCount);
+    void MergeItems(std::vector<Item> &rows) const;
+
+private:
+    std::vector<Item> items_;
+};
+} // namespace HiviewDFX
+} // namespace OHOS
+#endif // HIDUMPER_DUMP_EXECUTOR_STATS_H
@@ -0,0 +1,122 @@
+/*
+ * Copyright (C) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef HIDUMPER_UTILS_DUMP_FD_WRITER_H
+#define HIDUMPER_UTILS_DUMP_FD_WRITER_H
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include <sys/uio.h>
+namespace OHOS {
+namespace HiviewDFX {
+/**
+ * Batches small writes to a fd in a reusable buffer and writes them out with writev,
+ * instead of one write syscall per cell.
+ *
+ * After StartAsync the full buffers are handed to a writer thread through a
+ * bounded single producer, single consumer ring, so a client that reads
+ * slowly doesn't stall the dumpers until the ring is full. Only the dump
+ * thread may call the Append and Flush methods then.
+ */
+class DumpFdWriter {
+public:
+    enum FlushPolicy {
+        FLUSH_SECTION, // flush at the end of every section, the reader sees progress
+        FLUSH_REQUEST, // flush at the end of request or at the high water mark only
+    };
+    // what Append does when the ring is full.
+    enum Backpressure {
+        BACKPRESSURE_BLOCK, // wait for the client
+        BACKPRESSURE_DROP,  // drop the data and write a marker once there is room
+    };
+    struct Stats {
+        uint64_t bytes = 0;          // written to the fd
+        uint64_t writes = 0;         // writev calls
+        uint64_t clientWaitUs = 0;   // in writev and poll, waiting for the client
+        uint64_t producerWaitUs = 0; // dump thread waiting for room in the ring
+        uint64_t droppedBytes = 0;
+    };
+    explicit DumpFdWriter(int fd, size_t highWater = DEFAULT_HIGH_WATER);
+    ~DumpFdWriter();
+    DumpFdWriter(const DumpFdWriter &) = delete;
+    DumpFdWriter &operator=(const DumpFdWriter &) = delete;
+    bool Append(const std::string &str);
+    bool Append(const char *data, size_t len);
+    // append str and a line break if str hasn't one.
+    bool AppendLine(const std::string &str);
+    bool AppendLine(const char *data, size_t len);
+    // waits until the writer thread has written everything in async mode, at the end of request.
+    bool Flush();
+    // flush only if the policy flushes at the end of section.
+    bool FlushSection();
+    FlushPolicy GetFlushPolicy() const;
+    // EPIPE means the reader has gone.
+    bool IsBroken() const;
+    int GetError() const;
+    int GetFd() const;
+    // slots: the ring holds up to slots buffers of about highWater bytes.
+    bool StartAsync(size_t slots = DEFAULT_RING_SLOTS, Backpressure backpressure = BACKPRESSURE_BLOCK);
+    bool IsAsync() const;
+    Stats GetStats() const;
+
+    static const size_t DEFAULT_HIGH_WATER = 64 * 1024;
+    static const size_t DEFAULT_RING_SLOTS = 16;
+
+private:
+    bool Write(const char *data, size_t len);
+    bool WriteFully(struct iovec *iov, int iovcnt);
+    bool WaitWritable();
+    bool Push(std::string &chunk);
+    void WaitDrained();
+    void WriterLoop();
+    void StopAsync();
+    static FlushPolicy GetDefaultFlushPolicy(int fd);
+
+private:
+    static const int WRITE_POLL_TIMEOUT = 10 * 1000; // ms
+    int fd_;
+    size_t highWater_;
+    std::string buffer_;
+    FlushPolicy policy_;
+    std::atomic<bool> broken_ {false};
+    std::atomic<int> error_ {0};
+
+    // async mode, slots_ between head_ and tail_ wait for the writer thread.
+    bool async_ {false};
+    Backpressure backpressure_ {BACKPRESSURE_BLOCK};
+    std::vector<std::string> slots_;
+    std::atomic<size_t> head_ {0};
+    std::atomic<size_t> tail_ {0};
+    std::atomic<bool> producerWaiting_ {false};
+    std::atomic<bool> consumerWaiting_ {false};
+    bool stopping_ {false};
+    std::mutex mutex_;
+    std::condition_variable notEmpty_;
+    std::condition_variable notFull_;
+    std::thread thread_;
+    uint64_t droppedPending_ {0};
+
+    std::atomic<uint64_t> statBytes_ {0};
+    std::atomic<uint64_t> statWrites_ {0};
+    std::atomic<uint64_t> statClientWaitUs_ {0};
+    uint64_t statProducerWaitUs_ {0};
+    uint64_t statDroppedBytes_ {0};
+};
+} // namespace HiviewDFX
+} // namespace OHOS
+#endif // HIDUMPER_UTILS_DUMP_FD_WRITER_H
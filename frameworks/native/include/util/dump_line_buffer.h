@@ -0,0 +1,110 @@
+/*
+ * Copyright (C) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef HIDUMPER_DUMP_LINE_BUFFER_H
+#define HIDUMPER_DUMP_LINE_BUFFER_H
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+#include "util/dump_table.h"
+namespace OHOS {
+namespace HiviewDFX {
+/**
+ * Dump lines of a request until an output writes them. The bytes of cells
+ * are appended to fixed size chunks and lines are an index of cells, so a
+ * line costs no allocation of its own. Clear keeps the chunks for the next
+ * lines, once the buffer has grown to the size of an output flush it stops
+ * allocating.
+ *
+ * Executors still filling a StringMatrix are moved in with MoveFrom, and
+ * GetLine gives a line back as cells for code that wants strings.
+ *
+ * A line may also hold a whole DumpTable, it has no cells then and each
+ * output formats the table itself.
+ */
+class DumpLineBuffer {
+public:
+    struct Cell {
+        const char *data;
+        size_t size;
+    };
+
+    explicit DumpLineBuffer(size_t chunkSize = DEFAULT_CHUNK_SIZE);
+    ~DumpLineBuffer() = default;
+    DumpLineBuffer(const DumpLineBuffer &) = delete;
+    DumpLineBuffer &operator=(const DumpLineBuffer &) = delete;
+
+    // a line is the cells appended since the last EndLine.
+    void AppendCell(const char *data, size_t size);
+    void AppendCell(const std::string &str);
+    void EndLine();
+    void AppendLine(const std::vector<std::string> &cells);
+    // rows of the matrix are appended and the matrix is cleared.
+    void MoveFrom(std::vector<std::vector<std::string>> &matrix);
+    void AppendTable(const std::shared_ptr<DumpTable> &table);
+
+    size_t GetLineCount() const;
+    bool IsEmpty() const;
+    size_t GetCellCount(size_t line) const;
+    // nullptr for a line of cells.
+    DumpTable *GetTable(size_t line) const;
+    Cell GetCell(size_t line, size_t cell) const;
+    // the cell is edited in place, it may shrink only.
+    char *GetMutableCell(size_t line, size_t cell, size_t &size);
+    void ShrinkCell(size_t line, size_t cell, size_t size);
+    // cells reuses the strings it has.
+    void GetLine(size_t line, std::vector<std::string> &cells) const;
+
+    void Clear();
+    // bytes of chunks held.
+    size_t GetCapacity() const;
+    // bytes of the cells, tables not counted.
+    size_t GetByteCount() const;
+    // bytes of the cells and of the rows of tables as they were appended,
+    // what waits for an output against the chunk budget.
+    size_t GetPendingSize() const;
+
+    static const size_t DEFAULT_CHUNK_SIZE = 64 * 1024;
+
+private:
+    struct CellRef {
+        char *data;
+        size_t size;
+    };
+    struct LineRef {
+        uint32_t firstCell;
+        uint32_t cellCount;
+        uint32_t table; // index in tables_ plus 1, 0 for none
+    };
+
+    char *Allocate(size_t size);
+
+private:
+    size_t chunkSize_;
+    std::vector<std::unique_ptr<char[]>> chunks_;
+    std::vector<std::unique_ptr<char[]>> bigChunks_; // cells bigger than a chunk, freed by Clear
+    size_t bigChunkBytes_;
+    size_t chunkIndex_;
+    size_t chunkUsed_;
+    std::vector<CellRef> cells_;
+    std::vector<LineRef> lines_;
+    std::vector<std::shared_ptr<DumpTable>> tables_;
+    size_t lineStart_; // first cell of the open line
+    size_t byteCount_;
+    size_t tableBytes_;
+};
+} // namespace HiviewDFX
+} // namespace OHOS
+#endif // HIDUMPER_DUMP_LINE_BUFFER_H
@@ -0,0 +1,74 @@
+/*
+ * Copyright (C) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef HIDUMPER_UTILS_DUMP_LINE_READER_H
+#define HIDUMPER_UTILS_DUMP_LINE_READER_H
+#include <cstdint>
+#include <functional>
+#include <vector>
+namespace OHOS {
+namespace HiviewDFX {
+/**
+ * Reads lines from a fd under a deadline. The fd is made non-blocking and
+ * waited on with poll, in slices short enough to see a cancel, so a source
+ * that never writes, e.g. a command or a system ability that hangs, costs
+ * the dumper its time budget and no more. A line longer than MAX_LINE_SIZE
+ * is split there, so a source that never writes a '\n' can't grow the
+ * buffer without bound.
+ */
+class DumpLineReader {
+public:
+    enum Result {
+        READ_LINE = 0,
+        READ_END,
+        READ_TIMEOUT,
+        READ_CANCELED,
+        READ_ERROR,
+    };
+    using CancelCheck = std::function<bool()>;
+
+    explicit DumpLineReader(int fd = -1);
+    ~DumpLineReader() = default;
+    DumpLineReader(const DumpLineReader &) = delete;
+    DumpLineReader &operator=(const DumpLineReader &) = delete;
+
+    // the fd is not owned, data buffered from the last one is dropped.
+    void Reset(int fd);
+    /**
+     * Read the next line, without its '\n'. The last line may have none.
+     * data is valid until the next call.
+     *
+     * @param timeoutMs, time left to the deadline.
+     */
+    Result ReadLine(uint64_t timeoutMs, const CancelCheck &isCanceled, const char *&data, size_t &size);
+
+    static const size_t DEFAULT_BUFFER_SIZE = 4096;
+    static const size_t MAX_LINE_SIZE = 64 * 1024;
+    static const int CANCEL_POLL_MILLSEC = 100;
+
+private:
+    bool TakeLine(const char *&data, size_t &size);
+    Result Fill(uint64_t deadline, const CancelCheck &isCanceled);
+    static uint64_t GetNowMillSec();
+
+private:
+    int fd_;
+    std::vector<char> buffer_;
+    size_t begin_;
+    size_t end_;
+    bool eof_;
+};
+} // namespace HiviewDFX
+} // namespace OHOS
+#endif // HIDUMPER_UTILS_DUMP_LINE_READER_H
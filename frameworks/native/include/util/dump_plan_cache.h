@@ -0,0 +1,60 @@
+/*
+ * Copyright (C) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef HIDUMPER_UTILS_DUMP_PLAN_CACHE_H
+#define HIDUMPER_UTILS_DUMP_PLAN_CACHE_H
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+#include "singleton.h"
+#include "common/dump_cfg.h"
+namespace OHOS {
+namespace HiviewDFX {
+/**
+ * Config lists of recent requests, keyed by the options that select the configs.
+ * A plan expanded per pid or per cpu also keeps what it was expanded with, and is
+ * only reused while the processes and cpus are the same.
+ */
+class DumpPlanCache : public Singleton<DumpPlanCache> {
+public:
+    struct Plan {
+        uint32_t inputs = 0; // PLAN_INPUT_*, what the expansion used
+        std::vector<int> inputValues;
+        std::vector<std::shared_ptr<DumpCfg>> configs;
+    };
+
+    DumpPlanCache();
+    ~DumpPlanCache();
+
+    std::shared_ptr<const Plan> Find(const std::string &key);
+    void Add(const std::string &key, const std::shared_ptr<const Plan> &plan);
+    void Clear();
+    // a request owns its configs, its executors hold them.
+    static void CloneConfigs(const std::vector<std::shared_ptr<DumpCfg>> &configs,
+        std::vector<std::shared_ptr<DumpCfg>> &result);
+
+    static const uint32_t PLAN_INPUT_PIDS = 1;
+    static const uint32_t PLAN_INPUT_CPUS = 2;
+    static const size_t MAX_PLANS = 16;
+
+private:
+    std::mutex mutex_;
+    std::list<std::pair<std::string, std::shared_ptr<const Plan>>> plans_; // most recent first
+};
+} // namespace HiviewDFX
+} // namespace OHOS
+#endif // HIDUMPER_UTILS_DUMP_PLAN_CACHE_H
@@ -0,0 +1,77 @@
+/*
+ * Copyright (C) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef HIDUMPER_UTILS_DUMP_PSI_H
+#define HIDUMPER_UTILS_DUMP_PSI_H
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+#include "singleton.h"
+namespace OHOS {
+namespace HiviewDFX {
+struct PsiItem {
+    bool valid; // "full" is missing for cpu on old kernels
+    double avg10; // percentage of time stalled in the last 10s
+    double avg60;
+    double avg300;
+    uint64_t total; // accumulated stall time in us
+};
+
+struct PsiInfo {
+    PsiItem some; // at least one task stalled
+    PsiItem full; // all non-idle tasks stalled
+};
+
+class DumpPsiUtil : public Singleton<DumpPsiUtil> {
+public:
+    DumpPsiUtil();
+    ~DumpPsiUtil();
+    // take a sample of every resource for delta mode, called by the background sampler.
+    void UpdatePsiInfo();
+    bool GetCurPsiInfo(const std::string &resource, PsiInfo &psiInfo);
+    // parse a file in pressure format, such as /proc/pressure/cpu or memory.pressure of a cgroup.
+    bool GetPsiInfoFromFile(const std::string &path, PsiInfo &psiInfo);
+    bool GetOldPsiInfo(const std::string &resource, PsiInfo &psiInfo, uint64_t &tick);
+    // PSI lines of resource, with stall time since the old sample if there is one.
+    bool GetPsiLines(const std::string &resource, std::vector<std::string> &lines);
+
+    static const std::string PSI_CPU;
+    static const std::string PSI_MEMORY;
+    static const std::string PSI_IO;
+
+private:
+    struct PsiSample {
+        PsiInfo info;
+        uint64_t tick;
+    };
+    bool ParsePsiLine(const std::string &line, PsiItem &psiItem);
+    std::string CreatePsiString(const std::string &type, const PsiItem &psiItem);
+    std::string CreateStallString(const PsiInfo &curInfo, const PsiInfo &oldInfo, uint64_t window);
+    static uint64_t GetDeltaValue(uint64_t curValue, uint64_t oldValue);
+
+private:
+    static const std::string PRESSURE_PATH;
+    static const uint64_t PSI_MIN_DELTA_WINDOW = 1000; // ms
+    static const uint64_t US_PER_MS = 1000;
+    static const int PSI_STR_LENGTH = 256;
+
+    std::map<std::string, PsiSample> curSamples_;
+    std::map<std::string, PsiSample> oldSamples_;
+    std::mutex mutex_;
+};
+} // namespace HiviewDFX
+} // namespace OHOS
+#endif // HIDUMPER_UTILS_DUMP_PSI_H
@@ -0,0 +1,67 @@
+/*
+ * Copyright (C) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef HIDUMPER_DUMP_SNAPSHOT_WRITER_H
+#define HIDUMPER_DUMP_SNAPSHOT_WRITER_H
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+namespace OHOS {
+namespace HiviewDFX {
+/**
+ * Encodes a snapshot, see dump_snapshot_format.h, into a buffer the caller
+ * drains. Cell text is typed here: numbers become INT or DECIMAL cells,
+ * other cells are strings kept once in the string table of the snapshot.
+ */
+class DumpSnapshotWriter {
+public:
+    DumpSnapshotWriter();
+    ~DumpSnapshotWriter() = default;
+
+    void Begin(uint64_t timeMs);
+    void End();
+    bool IsStarted() const;
+    void WriteSection(const std::string &name);
+    // the next headerRows rows are the header of the table.
+    void BeginTable(uint32_t headerRows);
+    void WriteRow(const std::vector<std::string> &line);
+    // a row of typed cells: BeginRow, a cell per column in order, EndRow.
+    void BeginRow(size_t cellCount);
+    void AppendIntCell(size_t column, int64_t value, bool percent);
+    void AppendStringCell(const std::string &value);
+    void EndRow();
+    void WriteText(const std::string &text);
+    // encoded bytes, cleared by the caller once written.
+    std::string &GetBuffer();
+
+    static void AppendVarint(uint64_t value, std::string &out);
+    static void AppendZigzag(int64_t value, std::string &out);
+
+private:
+    uint32_t GetStringId(const std::string &str);
+    void AppendRecord(uint8_t type, const std::string &payload);
+    void AppendRecord(uint8_t type, const char *payload, size_t size);
+    static void AppendFixed(uint64_t value, size_t size, std::string &out);
+
+private:
+    std::string buffer_;
+    std::string payload_;
+    std::unordered_map<std::string, uint32_t> strings_;
+    std::vector<int64_t> lastInts_; // per column of the table
+    bool started_;
+};
+} // namespace HiviewDFX
+} // namespace OHOS
+#endif // HIDUMPER_DUMP_SNAPSHOT_WRITER_H
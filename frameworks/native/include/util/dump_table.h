@@ -0,0 +1,109 @@
+/*
+ * Copyright (C) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef HIDUMPER_DUMP_TABLE_H
+#define HIDUMPER_DUMP_TABLE_H
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+namespace OHOS {
+namespace HiviewDFX {
+/**
+ * A table a dumper fills with values instead of text. Each column keeps its
+ * cells in one vector: numbers as they are, strings as ids of a string table
+ * of the table. Sort, Top and Filter reorder rows by comparing the values,
+ * and the text of a cell is only made by an output, from the layout of its
+ * column, so text, json and snapshot outputs all start from the numbers.
+ *
+ * Rows are addressed in their current order.
+ */
+class DumpTable {
+public:
+    enum ColumnType {
+        COLUMN_UINT = 0,
+        COLUMN_PERCENT, // an integer percentage, "%" follows the padded text
+        COLUMN_STRING,
+    };
+
+    struct Column {
+        std::string name; // key of the column in structured outputs
+        ColumnType type;
+        std::string header; // header text, as is
+        // text of a cell: prefix, then value and unit padded to width.
+        std::string prefix;
+        std::string unit;
+        size_t width;
+        bool leftAlign;
+    };
+
+    struct SortKey {
+        size_t column;
+        bool descending;
+    };
+
+    using RowFilter = std::function<bool(const DumpTable &table, size_t row)>;
+    // edits a string in place, returns its new size.
+    using StringFilter = std::function<size_t(char *data, size_t size)>;
+
+    DumpTable();
+    ~DumpTable() = default;
+
+    size_t AddColumn(const Column &column);
+    size_t GetColumnCount() const;
+    const Column &GetColumn(size_t column) const;
+
+    // a new row of zeros and empty strings, returns its index.
+    size_t AddRow();
+    size_t GetRowCount() const;
+    // bytes of the text of a row, short cells padded to their width.
+    size_t GetRowWidth() const;
+    void SetValue(size_t row, size_t column, uint64_t value);
+    void SetString(size_t row, size_t column, const std::string &value);
+    uint64_t GetValue(size_t row, size_t column) const;
+    const std::string &GetString(size_t row, size_t column) const;
+
+    // stable, keys compared in order.
+    void Sort(const std::vector<SortKey> &keys);
+    // keeps the first count rows.
+    void Top(size_t count);
+    void Filter(const RowFilter &keep);
+    void FilterStrings(const StringFilter &filter);
+
+    // a table streamed in parts shows its header text once.
+    void SetHeaderVisible(bool visible);
+    bool IsHeaderVisible() const;
+
+    // append the text of a line, without the line break.
+    void FormatHeader(std::string &out) const;
+    void FormatRow(size_t row, std::string &out) const;
+    void FormatCell(size_t row, size_t column, std::string &out) const;
+
+private:
+    uint32_t GetStringId(const std::string &value);
+    static void AppendPadded(const std::string &text, size_t width, bool leftAlign, std::string &out);
+
+private:
+    std::vector<Column> columns_;
+    std::vector<std::vector<uint64_t>> values_; // per column, string ids for string columns
+    std::vector<std::string> strings_;
+    std::unordered_map<std::string, uint32_t> stringIds_;
+    std::vector<uint32_t> order_; // stored row of each row
+    uint32_t storedRows_;
+    bool headerVisible_;
+};
+} // namespace HiviewDFX
+} // namespace OHOS
+#endif // HIDUMPER_DUMP_TABLE_H
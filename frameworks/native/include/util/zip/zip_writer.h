@@ -14,15 +14,33 @@
  */
 #ifndef HIDUMPER_UTIL_ZIP_WRITER_H
 #define HIDUMPER_UTIL_ZIP_WRITER_H
+#include <condition_variable>
+#include <map>
+#include <memory>
+#include <mutex>
 #include <string>
+#include <thread>
 #include <vector>
 #include "contrib/minizip/zip.h"
+#include "util/dump_codec.h"
+#include "util/dump_compressor.h"
 #include "util/zip/zip_common_type.h"
 namespace OHOS {
 namespace HiviewDFX {
+/**
+ * Entries are read through mmap and deflated into memory on a worker pool,
+ * then appended to the archive in item order as raw data, so the archive is
+ * the same whatever the thread timing. Inputs that are already compressed,
+ * or do not shrink, are stored. Entries too big to hold in memory are
+ * streamed by the writer thread instead.
+ *
+ * Content produced on the fly, such as a dump section, is written through
+ * OpenEntry/WriteEntry/CloseEntry. It is deflated as it arrives by a
+ * DumpCompressor on the same workers and appended as raw data.
+ */
 class ZipWriter {
 public:
-    ZipWriter(const std::string &zipFilePath);
+    ZipWriter(const std::string &zipFilePath, const DumpCodec &codec = DumpCodec());
     ~ZipWriter();
 public:
     bool Open();
@@ -30,20 +48,65 @@ public:
     // zipItems: first:absolutePath, second:relativePath
     bool Write(const std::vector<std::pair<std::string, std::string>> &zipItems,
         const ZipTickNotify notify = nullptr);
+    // one entry at a time, its size is filled in when it is closed.
+    bool OpenEntry(const std::string &relativePath);
+    bool WriteEntry(const char *data, size_t len);
+    bool CloseEntry();
+    // 1 compresses on the writer thread.
+    void SetWorkers(uint32_t workers);
+    // entries bigger than this are streamed instead of deflated in memory.
+    void SetMaxMemoryEntrySize(uint64_t size);
+    // true for data starting with the magic of a compressed format, e.g. gzip.
+    static bool IsCompressedData(const unsigned char *data, size_t len);
 private:
+    class MappedFile;
+    struct Entry {
+        bool ok = false;
+        bool streamed = false;
+        int method = 0;
+        uLong crc = 0;
+        uint64_t size = 0;
+        std::shared_ptr<MappedFile> source;
+        std::vector<unsigned char> deflated;
+        const unsigned char *data = nullptr; // points into source or deflated
+        size_t dataLen = 0;
+    };
+
     bool FlushItems(const ZipTickNotify notify = nullptr);
     static bool SetTimeToZipFileInfo(zip_fileinfo &zipInfo);
     static zipFile OpenForZipping(const std::string &fileName, int append);
-    static bool ZipOpenNewFileInZip(zipFile zip_file, const std::string &strPath);
+    bool ZipOpenNewFileInZip(zipFile zip_file, const std::string &strPath, int method, bool raw, bool zip64);
     static bool AddFileContentToZip(zipFile zip_file, std::string &file_path);
-    static bool OpenNewFileEntry(zipFile zip_file, std::string &path);
     static bool CloseNewFileEntry(zipFile zip_file);
-    static bool AddFileEntryToZip(zipFile zip_file, std::string &relativePath, std::string &absolutePath);
+    static bool WriteInZip(zipFile zip_file, const unsigned char *data, size_t len);
+    bool AddFileEntryToZip(zipFile zip_file, std::string &relativePath, std::string &absolutePath);
+    bool AddPreparedEntryToZip(zipFile zip_file, std::string &relativePath, std::string &absolutePath,
+        Entry &entry);
+    std::shared_ptr<Entry> PrepareEntry(z_stream &stream, bool streamReady, const std::string &absolutePath) const;
+    bool DeflateEntry(z_stream &stream, Entry &entry) const;
+    void WorkerLoop(const std::vector<std::pair<std::string, std::string>> &zipItems);
+    std::shared_ptr<Entry> WaitEntry(size_t index);
+    void StopWorkers();
 private:
     std::vector<std::pair<std::string, std::string>> zipItems_;
     std::string zipFilePath_;
     zipFile zipFile_;
+    DumpCodec codec_;
+    uint32_t workers_;
+    uint64_t maxMemoryEntrySize_;
+    bool entryOpened_ = false;
+    bool entryRaw_ = false;
+    DumpCompressor compressor_;
+
+    std::mutex mutex_;
+    std::condition_variable readyCond_;
+    std::condition_variable roomCond_;
+    std::map<size_t, std::shared_ptr<Entry>> entries_;
+    size_t nextItem_ = 0;
+    uint64_t pendingBytes_ = 0;
+    bool stopping_ = false;
+    std::vector<std::thread> threads_;
 };
 } // namespace HiviewDFX
 } // namespace OHOS
-#endif // HIDUMPER_UTIL_ZIP_WRITER_H
\ No newline at end of file
+#endif // HIDUMPER_UTIL_ZIP_WRITER_H
@@ -15,7 +15,9 @@
 #ifndef HIDUMPER_UTIL_ZIP_H
 #define HIDUMPER_UTIL_ZIP_H
 #include <string>
+#include "util/dump_codec.h"
 #include "util/zip/zip_common_type.h"
+#include "util/zip/zip_writer.h"
 namespace OHOS {
 namespace HiviewDFX {
 class ZipUtils {
@@ -23,8 +25,12 @@ public:
     // example
     // srcPath = /data/local/tmp/zipdata/
     // dstFile = /data/local/tmp/result/result.zip
+    // codec : compression of the entries.
     // notify : zip progress notify, default is nullptr.
     static bool ZipFolder(const std::string &srcPath, const std::string &dstFile,
+        const DumpCodec &codec = DumpCodec(), const ZipTickNotify notify = nullptr);
+    // add the files of srcPath to an opened zipWriter, then close it.
+    static bool AppendFolder(const std::string &srcPath, ZipWriter &zipWriter,
         const ZipTickNotify notify = nullptr);
 };
 } // namespace HiviewDFX
@@ -22,8 +22,6 @@ DumpCfg::DumpCfg()
 
 DumpCfg::~DumpCfg()
 {
-    childs_.clear();
-    parent_ = nullptr;
 }
 
 DumpCfg& DumpCfg::operator=(const DumpCfg& dumpCfg)
@@ -47,7 +45,7 @@ void DumpCfg::Dump(int deep) const
 
 bool DumpCfg::IsGroup() const
 {
-    return ((class_ == DumperConstant::GROUP) || (!childs_.empty()));
+    return (class_ == DumperConstant::GROUP);
 }
 
 bool DumpCfg::IsDumper() const
@@ -141,13 +139,8 @@ void DumpCfg::Dump(const DumpCfg& cfg, int nest)
     if (cfg.args_ != nullptr) {
         cfg.args_->Dump();
     }
-    if (cfg.parent_ != nullptr) {
-        DUMPER_HILOGD(MODULE_COMMON, "debug|parent...name=%{public}s, desc=%{public}s",
-            cfg.parent_->name_.c_str(), cfg.parent_->desc_.c_str());
-    } else {
-        for (auto dumpCfg : cfg.childs_) {
-            dumpCfg->Dump(nest+1);
-        }
+    if (cfg.parent_ >= 0) {
+        DUMPER_HILOGD(MODULE_COMMON, "debug|parent=%{public}d", cfg.parent_);
     }
 }
 
@@ -197,6 +190,10 @@ std::string DumpCfg::ToDumperStr(int type)
         return "mem_dumper";
     } else if (type == DumperConstant::STACK_DUMPER) {
         return "stack_dumper";
+    } else if (type == DumperConstant::SCHED_DUMPER) {
+        return "sched_dumper";
+    } else if (type == DumperConstant::CGROUP_DUMPER) {
+        return "cgroup_dumper";
     }
     return "unknown_dumper";
 }
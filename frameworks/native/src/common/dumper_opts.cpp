@@ -19,10 +19,14 @@
 #include "dump_utils.h"
 #include "hilog_wrapper.h"
 #include "util/config_utils.h"
+#include "util/dump_codec.h"
 namespace OHOS {
 namespace HiviewDFX {
 namespace {
 static const std::string PATH_SEPARATOR = "/";
+static const std::string FORMAT_TEXT = "text";
+static const std::string FORMAT_JSON = "json";
+static const std::string FORMAT_SNAPSHOT = "snapshot";
 }
 
 DumperOpts::DumperOpts()
@@ -35,11 +39,14 @@ void DumperOpts::Reset()
     isDumpCpuFreq_ = false;
     isDumpCpuUsage_ = false;
     cpuUsagePid_ = -1;
+    isDumpSchedStat_ = false;
+    schedStatPid_ = -1;
     isDumpLog_ = false;
     logArgs_.clear();
     isDumpMem_ = false;
     memPid_ = -1;
     isDumpStorage_ = false;
+    isDumpCgroup_ = false;
     isDumpNet_ = false;
     isDumpList_ = false;
     isDumpService_ = false;
@@ -54,6 +61,10 @@ void DumperOpts::Reset()
     timeout_ = DEFAULT_TIMEOUT;
     limitSize_ = DEFAULT_LIMITSIZE;
     path_.clear(); // for zip
+    zipCodec_.clear();
+    format_.clear();
+    isTee_ = false;
+    isStats_ = false;
     isAppendix_ = false;
     isTest_ = false;
 }
@@ -64,11 +75,14 @@ DumperOpts& DumperOpts::operator = (const DumperOpts& opts)
     isDumpCpuFreq_ = opts.isDumpCpuFreq_;
     isDumpCpuUsage_ = opts.isDumpCpuUsage_;
     cpuUsagePid_ = opts.cpuUsagePid_;
+    isDumpSchedStat_ = opts.isDumpSchedStat_;
+    schedStatPid_ = opts.schedStatPid_;
     isDumpLog_ = opts.isDumpLog_;
     logArgs_.assign((opts.logArgs_).begin(), (opts.logArgs_).end());
     isDumpMem_ = opts.isDumpMem_;
     memPid_ = opts.memPid_;
     isDumpStorage_ = opts.isDumpStorage_;
+    isDumpCgroup_ = opts.isDumpCgroup_;
     isDumpNet_ = opts.isDumpNet_;
     isDumpList_ = opts.isDumpList_;
     isDumpService_ = opts.isDumpService_;
@@ -83,6 +97,10 @@ DumperOpts& DumperOpts::operator = (const DumperOpts& opts)
     timeout_ = opts.timeout_;
     limitSize_ = opts.limitSize_;
     path_ = opts.path_;
+    zipCodec_ = opts.zipCodec_;
+    format_ = opts.format_;
+    isTee_ = opts.isTee_;
+    isStats_ = opts.isStats_;
     isAppendix_ = opts.isAppendix_;
     isTest_ = opts.isTest_;
     return *this;
@@ -109,9 +127,19 @@ bool DumperOpts::IsDumpZip() const
     return DumpCommonUtils::StartWith(path_, PATH_SEPARATOR);
 }
 
+bool DumperOpts::IsDumpJson() const
+{
+    return (format_ == FORMAT_JSON);
+}
+
+bool DumperOpts::IsDumpSnapshot() const
+{
+    return (format_ == FORMAT_SNAPSHOT);
+}
+
 bool DumperOpts::IsSelectAny() const
 {
-    if (isDumpCpuFreq_ || isDumpCpuUsage_) {
+    if (isDumpCpuFreq_ || isDumpCpuUsage_ || isDumpSchedStat_) {
         return true;
     }
     if (isDumpLog_ || isFaultLog_) {
@@ -123,6 +151,9 @@ bool DumperOpts::IsSelectAny() const
     if (isDumpStorage_) {
         return true;
     }
+    if (isDumpCgroup_) {
+        return true;
+    }
     if (isDumpNet_) {
         return true;
     }
@@ -145,6 +176,10 @@ bool DumperOpts::CheckOptions(std::string& errStr) const
         errStr = std::to_string(cpuUsagePid_);
         return false;
     }
+    if (schedStatPid_ < -1) {
+        errStr = std::to_string(schedStatPid_);
+        return false;
+    }
     if (memPid_ < -1) {
         errStr = std::to_string(memPid_);
         return false;
@@ -158,6 +193,21 @@ bool DumperOpts::CheckOptions(std::string& errStr) const
         errStr = path_;
         return false;
     }
+    DumpCodec codec;
+    if (!DumpCodec::Parse(zipCodec_, codec)) {
+        errStr = zipCodec_;
+        return false;
+    }
+    bool isFormatKnown = format_.empty() || (format_ == FORMAT_TEXT) || IsDumpJson() || IsDumpSnapshot();
+    // the zip keeps text entries, other formats go to the client next to it only.
+    if (!isFormatKnown || ((IsDumpJson() || IsDumpSnapshot()) && IsDumpZip() && !isTee_)) {
+        errStr = format_;
+        return false;
+    }
+    if (isTee_ && !IsDumpZip()) {
+        errStr = "--tee";
+        return false;
+    }
     for (size_t i = 0; i < abilitieNames_.size(); i++) {
         if (!DumpUtils::StrToId(abilitieNames_[i])) {
             errStr = abilitieNames_[i];
@@ -193,12 +243,15 @@ void DumperOpts::Dump() const
     DUMPER_HILOGD(MODULE_COMMON, "debug|isDumpCpuFreq=%{public}d", isDumpCpuFreq_);
     DUMPER_HILOGD(MODULE_COMMON, "debug|isDumpCpuUsage=%{public}d, cpuUsagePid_=%{public}d",
         isDumpCpuUsage_, cpuUsagePid_);
+    DUMPER_HILOGD(MODULE_COMMON, "debug|isDumpSchedStat=%{public}d, schedStatPid_=%{public}d",
+        isDumpSchedStat_, schedStatPid_);
     DUMPER_HILOGD(MODULE_COMMON, "debug|isDumpLog=%{public}d", isDumpLog_);
     for (size_t i = 0; i < logArgs_.size(); i++) {
         DUMPER_HILOGD(MODULE_COMMON, "debug|    logArgs[%{public}zu]_=%{public}s", i, logArgs_[i].c_str());
     }
     DUMPER_HILOGD(MODULE_COMMON, "debug|isDumpMem=%{public}d, memPid=%{public}d", isDumpMem_, memPid_);
     DUMPER_HILOGD(MODULE_COMMON, "debug|isDumpStorage=%{public}d", isDumpStorage_);
+    DUMPER_HILOGD(MODULE_COMMON, "debug|isDumpCgroup=%{public}d", isDumpCgroup_);
     DUMPER_HILOGD(MODULE_COMMON, "debug|isDumpNet=%{public}d", isDumpNet_);
     DUMPER_HILOGD(MODULE_COMMON, "debug|isDumpList=%{public}d,"
         " isDumpService=%{public}d, isDumpSystemAbility=%{public}d, isDumpSystem=%{public}d",
@@ -218,6 +271,10 @@ void DumperOpts::Dump() const
     DUMPER_HILOGD(MODULE_COMMON, "debug|timeout=%{public}d", timeout_);
     DUMPER_HILOGD(MODULE_COMMON, "debug|limitSize=%{public}d", limitSize_);
     DUMPER_HILOGD(MODULE_COMMON, "debug|path=%{public}s", path_.c_str());
+    DUMPER_HILOGD(MODULE_COMMON, "debug|zipCodec=%{public}s", zipCodec_.c_str());
+    DUMPER_HILOGD(MODULE_COMMON, "debug|format=%{public}s", format_.c_str());
+    DUMPER_HILOGD(MODULE_COMMON, "debug|isTee=%{public}d", isTee_);
+    DUMPER_HILOGD(MODULE_COMMON, "debug|isStats=%{public}d", isStats_);
     DUMPER_HILOGD(MODULE_COMMON, "debug|isAppendix=%{public}d", isAppendix_);
     DUMPER_HILOGD(MODULE_COMMON, "debug|isTest=%{public}d", isTest_);
 }
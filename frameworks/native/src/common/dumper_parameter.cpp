@@ -75,6 +75,61 @@ std::shared_ptr<RawParam> DumperParameter::getClientCallback()
     return mPtrReqCtl;
 }
 
+std::shared_ptr<DumpFdWriter> DumperParameter::GetOutputWriter()
+{
+    if (ptrOutputWriter_ != nullptr) {
+        return ptrOutputWriter_;
+    }
+    if ((mPtrReqCtl == nullptr) || (mPtrReqCtl->GetOutputFd() < 0)) {
+        return nullptr;
+    }
+    ptrOutputWriter_ = std::make_shared<DumpFdWriter>(mPtrReqCtl->GetOutputFd());
+    // a client reading a pipe or socket, e.g. over hdc, must not stall the dumpers.
+    if (ptrOutputWriter_->GetFlushPolicy() == DumpFdWriter::FLUSH_SECTION) {
+        ptrOutputWriter_->StartAsync();
+    }
+    return ptrOutputWriter_;
+}
+
+bool DumperParameter::FlushOutputWriter()
+{
+    if (ptrOutputWriter_ == nullptr) {
+        return true;
+    }
+    bool ret = ptrOutputWriter_->Flush();
+    DumpFdWriter::Stats stats = ptrOutputWriter_->GetStats();
+    DUMPER_HILOGD(MODULE_COMMON, "debug|output bytes=%{public}llu, writes=%{public}llu, client wait=%{public}llu us,"
+        " dumper wait=%{public}llu us, dropped=%{public}llu",
+        static_cast<unsigned long long>(stats.bytes), static_cast<unsigned long long>(stats.writes),
+        static_cast<unsigned long long>(stats.clientWaitUs), static_cast<unsigned long long>(stats.producerWaitUs),
+        static_cast<unsigned long long>(stats.droppedBytes));
+    return ret;
+}
+
+std::shared_ptr<DumpLineBuffer> DumperParameter::GetLineBuffer()
+{
+    if (ptrLineBuffer_ == nullptr) {
+        ptrLineBuffer_ = std::make_shared<DumpLineBuffer>();
+    }
+    return ptrLineBuffer_;
+}
+
+void DumperParameter::SetLineBuffer(const std::shared_ptr<DumpLineBuffer> &lineBuffer)
+{
+    ptrLineBuffer_ = lineBuffer;
+}
+
+std::shared_ptr<DumperParameter> DumperParameter::CreateSectionParameter() const
+{
+    std::shared_ptr<DumperParameter> parameter = std::make_shared<DumperParameter>();
+    parameter->SetOpts(opts_);
+    parameter->SetUid(uid_);
+    parameter->SetPid(pid_);
+    parameter->SetChunkBudget(chunkBudget_);
+    parameter->setClientCallback(mPtrReqCtl);
+    return parameter;
+}
+
 void DumperParameter::Dump() const
 {
     opts_.Dump();
@@ -0,0 +1,150 @@
+/*
+ * Copyright (C) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "executor/cgroup_dumper.h"
+#include <chrono>
+#include <cinttypes>
+#include <thread>
+#include "datetime_ex.h"
+#include "securec.h"
+namespace OHOS {
+namespace HiviewDFX {
+const int CgroupDumper::CGROUP_INFO_LENGTH = 512;
+const uint64_t CgroupDumper::US_PER_MS = 1000;
+const uint64_t CgroupDumper::BYTES_PER_KB = 1024;
+const int CgroupDumper::CGROUP_SAMPLE_INTERVAL = 500; // ms
+
+CgroupDumper::CgroupDumper()
+{
+}
+
+CgroupDumper::~CgroupDumper()
+{
+}
+
+DumpStatus CgroupDumper::PreExecute(const std::shared_ptr<DumperParameter> &parameter, StringMatrix dumpDatas)
+{
+    DUMPER_HILOGD(MODULE_COMMON, "debug|CgroupDumper PreExecute");
+    dumpCgroupDatas_ = dumpDatas;
+    return DumpStatus::DUMP_OK;
+}
+
+DumpStatus CgroupDumper::Execute()
+{
+    DUMPER_HILOGD(MODULE_COMMON, "debug|CgroupDumper Execute");
+    if (dumpCgroupDatas_ == nullptr) {
+        return DumpStatus::DUMP_FAIL;
+    }
+    return DumpCgroupInfo();
+}
+
+DumpStatus CgroupDumper::AfterExecute()
+{
+    curCgroups_.clear();
+    oldCgroups_.clear();
+    return DumpStatus::DUMP_OK;
+}
+
+DumpStatus CgroupDumper::DumpCgroupInfo()
+{
+    std::string root;
+    if (!DumpCgroupUtil::GetInstance().GetCgroupRoot(root)) {
+        AddStrLineToDumpInfo("cgroup v2 is not mounted");
+        return DumpStatus::DUMP_FAIL;
+    }
+
+    uint64_t oldTick = 0;
+    if (!DumpCgroupUtil::GetInstance().GetOldCgroupInfo(oldCgroups_, oldTick)) {
+        // first dump since start, take our own window for cpu.stat.
+        DumpCgroupUtil::GetInstance().GetCurCgroupInfo(oldCgroups_);
+        oldTick = static_cast<uint64_t>(GetTickCount());
+        std::this_thread::sleep_for(std::chrono::milliseconds(CGROUP_SAMPLE_INTERVAL));
+    }
+    if (!DumpCgroupUtil::GetInstance().GetCurCgroupInfo(curCgroups_)) {
+        DUMPER_HILOGE(MODULE_COMMON, "Get cgroup info failed!.");
+        return DumpStatus::DUMP_FAIL;
+    }
+    uint64_t curTick = static_cast<uint64_t>(GetTickCount());
+    DumpCgroupUtil::GetInstance().SetOldCgroupInfo(curCgroups_, curTick);
+
+    DumpCgroupUtil::CgroupInfoMap oldCgroupMap;
+    DumpCgroupUtil::BuildCgroupInfoMap(oldCgroups_, oldCgroupMap);
+
+    AddStrLineToDumpInfo("Cgroup usage under " + root + ", cpu in the last " +
+        std::to_string(curTick - oldTick) + " ms:");
+    char format[CGROUP_INFO_LENGTH] = {0};
+    int ret = sprintf_s(format, CGROUP_INFO_LENGTH,
+        "    %10s  %10s  %10s  %12s  %10s  %10s  %10s  %8s  %-18s  %s",
+        "Cpu(ms)", "User(ms)", "Sys(ms)", "Memory(kB)", "Anon(kB)", "File(kB)", "Kernel(kB)", "Sock(kB)",
+        "MemPressure(some)", "Path");
+    if (ret >= 0) {
+        AddStrLineToDumpInfo(std::string(format));
+    }
+    for (const auto &curInfo : curCgroups_) {
+        auto it = oldCgroupMap.find(curInfo->path);
+        DumpCgroupLine(curInfo, (it != oldCgroupMap.end()) ? it->second : nullptr);
+    }
+    return DumpStatus::DUMP_OK;
+}
+
+void CgroupDumper::DumpCgroupLine(const std::shared_ptr<CgroupInfo> &curInfo,
+    const std::shared_ptr<CgroupInfo> &oldInfo)
+{
+    uint64_t usage = curInfo->usageUsec;
+    uint64_t user = curInfo->userUsec;
+    uint64_t system = curInfo->systemUsec;
+    if (oldInfo != nullptr) {
+        usage = GetDeltaValue(curInfo->usageUsec, oldInfo->usageUsec);
+        user = GetDeltaValue(curInfo->userUsec, oldInfo->userUsec);
+        system = GetDeltaValue(curInfo->systemUsec, oldInfo->systemUsec);
+    }
+    // memory stall in the same window as cpu, in us.
+    std::string pressure = "-";
+    if (curInfo->hasMemPressure) {
+        uint64_t stall = curInfo->memPressure.some.total;
+        if ((oldInfo != nullptr) && oldInfo->hasMemPressure) {
+            stall = GetDeltaValue(curInfo->memPressure.some.total, oldInfo->memPressure.some.total);
+        }
+        pressure = std::to_string(stall) + "us";
+    }
+    char format[CGROUP_INFO_LENGTH] = {0};
+    int ret = sprintf_s(format, CGROUP_INFO_LENGTH,
+        "    %10" PRIu64 "  %10" PRIu64 "  %10" PRIu64 "  %12" PRIu64 "  %10" PRIu64 "  %10" PRIu64
+        "  %10" PRIu64 "  %8" PRIu64 "  %-18s  %s",
+        usage / US_PER_MS, user / US_PER_MS, system / US_PER_MS, curInfo->memCurrent / BYTES_PER_KB,
+        curInfo->anon / BYTES_PER_KB, curInfo->file / BYTES_PER_KB, curInfo->kernel / BYTES_PER_KB,
+        curInfo->sock / BYTES_PER_KB, pressure.c_str(), curInfo->path.c_str());
+    if (ret < 0) {
+        return;
+    }
+    AddStrLineToDumpInfo(std::string(format));
+}
+
+void CgroupDumper::AddStrLineToDumpInfo(const std::string &strLine)
+{
+    std::vector<std::string> vec;
+    vec.push_back(strLine);
+    dumpCgroupDatas_->push_back(vec);
+}
+
+uint64_t CgroupDumper::GetDeltaValue(uint64_t curValue, uint64_t oldValue)
+{
+    // cgroup recreated with the same path, its counters started from zero.
+    if (curValue < oldValue) {
+        return curValue;
+    }
+    return curValue - oldValue;
+}
+} // namespace HiviewDFX
+} // namespace OHOS
@@ -13,26 +13,23 @@
  * limitations under the License.
  */
 #include "executor/cmd_dumper.h"
+#include <cstring>
 #include "securec.h"
 
 namespace OHOS {
 namespace HiviewDFX {
-CMDDumper::CMDDumper() : fp_(nullptr)
+CMDDumper::CMDDumper()
 {
 }
 
 CMDDumper::~CMDDumper()
 {
-    if (fp_ != nullptr) {
-        pclose(fp_);
-        fp_ = nullptr;
-    }
 }
 
 DumpStatus CMDDumper::PreExecute(const std::shared_ptr<DumperParameter>& parameter,
     StringMatrix dumpDatas)
 {
-    if (dumpDatas.get() == nullptr) {
+    if ((parameter == nullptr) || (dumpDatas.get() == nullptr)) {
         return DumpStatus::DUMP_FAIL;
     }
     std::string cmd = ptrDumpCfg_->target_;
@@ -48,10 +45,12 @@ DumpStatus CMDDumper::PreExecute(const std::shared_ptr<DumperParameter>& paramet
     }
     cmd_ = cmd;
     needLoop_ = (ptrDumpCfg_->loop_ == DumperConstant::LOOP);
-    if (fp_ == nullptr) {
-        if ((fp_ = popen(cmd_.c_str(), "r")) == nullptr) {
+    if (!command_.IsRunning()) {
+        if (!command_.Start(cmd_)) {
             return DumpStatus::DUMP_FAIL;
         }
+        reader_.Reset(command_.GetOutputFd());
+        timedOut_ = false;
     }
     dumpDatas_ = dumpDatas;
 
@@ -62,6 +61,9 @@ DumpStatus CMDDumper::PreExecute(const std::shared_ptr<DumperParameter>& paramet
         lineData_.push_back(lineStr);
         dumpDatas_->push_back(lineData_);
     }
+    // lines are read into the line buffer, after the rows already in the matrix.
+    lineBuffer_ = parameter->GetLineBuffer();
+    lineBuffer_->MoveFrom(*dumpDatas_);
     return DumpStatus::DUMP_OK;
 }
 
@@ -72,31 +74,33 @@ DumpStatus CMDDumper::Execute()
         // dump one line
         return ReadLine();
     } else {
-        // dump all line
+        // dump all line, or as many as the chunk budget takes
         do {
             if (IsCanceled()) {
                 break;
             }
             ret = ReadLine();
-        } while (ret == DumpStatus::DUMP_MORE_DATA);
+        } while ((ret == DumpStatus::DUMP_MORE_DATA) && !IsChunkFull());
     }
     return ret;
 }
 
 DumpStatus CMDDumper::AfterExecute()
 {
-    if (moreData_ && IsTimeout()) {
-        DUMPER_HILOGE(MODULE_COMMON, "error|cmd timeout");
-        std::vector<std::string> line_vector_timeout;
-        line_vector_timeout.push_back(GetTimeoutStr());
-        dumpDatas_->push_back(line_vector_timeout);
+    if (timedOut_ || (moreData_ && IsTimeout())) {
+        DUMPER_HILOGE(MODULE_COMMON, "error|cmd timeout, %{public}s", cmd_.c_str());
+        lineBuffer_->AppendCell(GetTimeoutStr());
+        lineBuffer_->EndLine();
+        timedOut_ = true;
         moreData_ = false;
     }
 
     if (!moreData_) {
-        if (fp_ != nullptr) {
-            pclose(fp_);
-            fp_ = nullptr;
+        // the output has ended, a command still running after the deadline is killed.
+        if (timedOut_ || IsCanceled()) {
+            command_.Kill();
+        } else {
+            command_.Stop(GetTimeRemain());
         }
         return DumpStatus::DUMP_OK;
     }
@@ -147,13 +151,31 @@ DumpStatus CMDDumper::GetLineData(FILE* fp, StringMatrix dumpDatas)
     return ret;
 }
 
-// read one line
+// read one line, waiting no longer than the time left.
 DumpStatus CMDDumper::ReadLine()
 {
-    if (fp_ == nullptr) {
+    if (!command_.IsRunning() || (lineBuffer_ == nullptr)) {
         return DumpStatus::DUMP_FAIL;
     }
-    DumpStatus ret = GetLineData(fp_, dumpDatas_);
+    DumpStatus ret = DumpStatus::DUMP_MORE_DATA;
+    const char *data = nullptr;
+    size_t size = 0;
+    DumpLineReader::Result result = reader_.ReadLine(GetTimeRemain(), [this] { return IsCanceled(); }, data, size);
+    if (result == DumpLineReader::READ_LINE) {
+        // a line stops at the first NUL, as the string of it did.
+        lineBuffer_->AppendCell(data, strnlen(data, size));
+        lineBuffer_->EndLine();
+    } else if (result == DumpLineReader::READ_TIMEOUT) {
+        timedOut_ = true;
+        ret = DumpStatus::DUMP_OK;
+    } else if (result == DumpLineReader::READ_ERROR) {
+        // AfterExecute is skipped on a failure, the command is reaped here.
+        DUMPER_HILOGE(MODULE_COMMON, "error|read cmd output failed, %{public}s", cmd_.c_str());
+        command_.Kill();
+        ret = DumpStatus::DUMP_FAIL;
+    } else {
+        ret = DumpStatus::DUMP_OK;
+    }
     moreData_ = (ret == DumpStatus::DUMP_MORE_DATA);
     return ret;
 }
@@ -13,19 +13,34 @@
  * limitations under the License.
  */
 #include "executor/cpu_dumper.h"
+#include <cstdlib>
 #include "file_ex.h"
 #include "datetime_ex.h"
 #include "dump_utils.h"
-#include "securec.h"
-#include "util/string_utils.h"
+#include "util/dump_psi_util.h"
 namespace OHOS {
 namespace HiviewDFX {
 const std::string CPUDumper::LOAD_AVG_FILE_PATH = "/proc/loadavg";
 const size_t CPUDumper::LOAD_AVG_INFO_COUNT = 3;
 const int CPUDumper::TM_START_YEAR = 1900;
 const int CPUDumper::DEC_SYSTEM_VALUE = 10;
-const int CPUDumper::PROC_CPU_LENGTH = 256;
+const int CPUDumper::PID_WIDTH = 5;
+const int CPUDumper::USAGE_WIDTH = 3;
+const int CPUDumper::FAULT_WIDTH = 8;
+const int CPUDumper::COMM_WIDTH = 15;
 const long unsigned CPUDumper::HUNDRED_PERCENT_VALUE = 100;
+namespace {
+enum ProcColumn {
+    PROC_PID = 0,
+    PROC_TOTAL,
+    PROC_USER,
+    PROC_KERNEL,
+    PROC_MINFLT,
+    PROC_MAJFLT,
+    PROC_NAME,
+};
+static const int DEC_BASE = 10;
+} // namespace
 
 CPUDumper::CPUDumper()
 {
@@ -38,7 +53,8 @@ CPUDumper::~CPUDumper()
 DumpStatus CPUDumper::PreExecute(const std::shared_ptr<DumperParameter> &parameter, StringMatrix dumpDatas)
 {
     DUMPER_HILOGD(MODULE_COMMON, "debug|CPUDumper PreExecute");
-    dumpCPUDatas_ = dumpDatas;
+    lineBuffer_ = parameter->GetLineBuffer();
+    lineBuffer_->MoveFrom(*dumpDatas);
     isDumpCpuUsage_ = (parameter->GetOpts()).isDumpCpuUsage_;
     cpuUsagePid_ = (parameter->GetOpts()).cpuUsagePid_;
     if (cpuUsagePid_ != -1) {
@@ -68,6 +84,7 @@ DumpStatus CPUDumper::AfterExecute()
     oldCPUInfo_.reset();
     curProcs_.clear();
     oldProcs_.clear();
+    oldProcMap_.clear();
     if (cpuUsagePid_ != -1) {
         curSpecProc_.reset();
         oldSpecProc_.reset();
@@ -77,6 +94,7 @@ DumpStatus CPUDumper::AfterExecute()
 
 DumpStatus CPUDumper::DumpCpuUsageData()
 {
+    DumpCpuInfoUtil::GetInstance().WaitCpuInfoWindow();
     GetDateAndTime(startTime_);
     if (!DumpCpuInfoUtil::GetInstance().GetCurCPUInfo(curCPUInfo_)) {
         DUMPER_HILOGE(MODULE_COMMON, "Get current cpu info failed!.");
@@ -97,7 +115,7 @@ DumpStatus CPUDumper::DumpCpuUsageData()
             return DumpStatus::DUMP_FAIL;
         }
     } else {
-        if (!DumpCpuInfoUtil::GetInstance().GetCurProcInfo(curProcs_)) {
+        if (!DumpCpuInfoUtil::GetInstance().GetLatestProcInfo(curProcs_)) {
             DUMPER_HILOGE(MODULE_COMMON, "Get current process info failed!.");
             return DumpStatus::DUMP_FAIL;
         }
@@ -105,6 +123,7 @@ DumpStatus CPUDumper::DumpCpuUsageData()
             DUMPER_HILOGE(MODULE_COMMON, "Get old process info failed!.");
             return DumpStatus::DUMP_FAIL;
         }
+        DumpCpuInfoUtil::BuildProcInfoMap(oldProcs_, oldProcMap_);
     }
     std::string avgInfo;
     DumpStatus ret = ReadLoadAvgInfo(LOAD_AVG_FILE_PATH, avgInfo);
@@ -113,6 +132,8 @@ DumpStatus CPUDumper::DumpCpuUsageData()
         return DumpStatus::DUMP_FAIL;
     }
     AddStrLineToDumpInfo(avgInfo);
+    AddPsiInfo(DumpPsiUtil::PSI_CPU);
+    AddPsiInfo(DumpPsiUtil::PSI_IO);
 
     GetDateAndTime(endTime_);
     std::string dumpTimeStr;
@@ -202,9 +223,19 @@ void CPUDumper::CreateDumpTimeString(const std::string &startTime, const std::st
 
 void CPUDumper::AddStrLineToDumpInfo(const std::string &strLine)
 {
-    std::vector<std::string> vec;
-    vec.push_back(strLine);
-    dumpCPUDatas_->push_back(vec);
+    lineBuffer_->AppendCell(strLine);
+    lineBuffer_->EndLine();
+}
+
+void CPUDumper::AddPsiInfo(const std::string &resource)
+{
+    std::vector<std::string> lines;
+    if (!DumpPsiUtil::GetInstance().GetPsiLines(resource, lines)) {
+        return;
+    }
+    for (const auto &line : lines) {
+        AddStrLineToDumpInfo(line);
+    }
 }
 
 void CPUDumper::CreateCPUStatString(std::string &str)
@@ -213,6 +244,10 @@ void CPUDumper::CreateCPUStatString(std::string &str)
                                     + curCPUInfo_->iowTime + curCPUInfo_->irqTime + curCPUInfo_->sirqTime)
                                    - (oldCPUInfo_->uTime + oldCPUInfo_->nTime + oldCPUInfo_->sTime + oldCPUInfo_->iTime
                                       + oldCPUInfo_->iowTime + oldCPUInfo_->irqTime + oldCPUInfo_->sirqTime);
+    if (totalDeltaTime == 0) {
+        // no tick since the base sample, every usage is 0.
+        totalDeltaTime = 1;
+    }
     if (cpuUsagePid_ != -1) {
         curSpecProc_->userSpaceUsage =
             (curSpecProc_->uTime - oldSpecProc_->uTime) * HUNDRED_PERCENT_VALUE / totalDeltaTime;
@@ -258,69 +293,50 @@ void CPUDumper::CreateCPUStatString(std::string &str)
 
 std::shared_ptr<ProcInfo> CPUDumper::GetOldProc(const std::string &pid)
 {
-    for (size_t i = 0; i < oldProcs_.size(); i++) {
-        if (StringUtils::GetInstance().IsSameStr(oldProcs_[i]->pid, pid)) {
-            return oldProcs_[i];
-        }
+    auto it = oldProcMap_.find(pid);
+    if (it == oldProcMap_.end()) {
+        return nullptr;
     }
-    return nullptr;
+    return it->second;
 }
 
 void CPUDumper::DumpProcInfo()
 {
-    std::vector<std::shared_ptr<ProcInfo>> sortedInfos;
-    sortedInfos.assign(curProcs_.begin(), curProcs_.end());
-    std::sort(sortedInfos.begin(), sortedInfos.end(), SortProcInfo);
-
     AddStrLineToDumpInfo("Details of Processes:");
-    AddStrLineToDumpInfo("    PID   Total Usage	   User Space    Kernel Space    Page Fault Minor"
-                         "    Page Fault Major    Name");
+    // the text output lays the columns out as the padded strings were.
+    auto table = std::make_shared<DumpTable>();
+    table->AddColumn({"pid", DumpTable::COLUMN_UINT, "    PID", "    ", "", PID_WIDTH, true});
+    table->AddColumn({"total_usage", DumpTable::COLUMN_PERCENT, "   Total Usage", "    ", "", USAGE_WIDTH, false});
+    table->AddColumn({"user_space", DumpTable::COLUMN_PERCENT, "\t   User Space", "             ", "", USAGE_WIDTH,
+        false});
+    table->AddColumn({"kernel_space", DumpTable::COLUMN_PERCENT, "    Kernel Space", "           ", "", USAGE_WIDTH,
+        false});
+    table->AddColumn({"page_fault_minor", DumpTable::COLUMN_UINT, "    Page Fault Minor", "            ", "",
+        FAULT_WIDTH, false});
+    table->AddColumn({"page_fault_major", DumpTable::COLUMN_UINT, "    Page Fault Major", "            ", "",
+        FAULT_WIDTH, false});
+    table->AddColumn({"name", DumpTable::COLUMN_STRING, "    Name", "        ", "", COMM_WIDTH, true});
     if (cpuUsagePid_ != -1) {
-        char format[PROC_CPU_LENGTH] = {0};
-        int ret = sprintf_s(format, PROC_CPU_LENGTH,
-                            "    %-5s    %3d%%             %3d%%"
-                            "           %3d%%            %8s            %8s        %-15s",
-                            (curSpecProc_->pid).c_str(), curSpecProc_->totalUsage,
-                            curSpecProc_->userSpaceUsage, curSpecProc_->sysSpaceUsage,
-                            (curSpecProc_->minflt).c_str(), (curSpecProc_->majflt).c_str(),
-                            (curSpecProc_->comm).c_str());
-        AddStrLineToDumpInfo(std::string(format));
-        if (ret < 0) {
-            DUMPER_HILOGE(MODULE_COMMON, "Dump process %{public}d cpu info failed!.", cpuUsagePid_);
-        }
-        return;
-    }
-    for (size_t i = 0; i < sortedInfos.size(); i++) {
-        char format[PROC_CPU_LENGTH] = {0};
-        int ret = sprintf_s(format, PROC_CPU_LENGTH,
-                            "    %-5s    %3d%%             %3d%%"
-                            "           %3d%%            %8s            %8s        %-15s",
-                            (sortedInfos[i]->pid).c_str(), sortedInfos[i]->totalUsage,
-                            sortedInfos[i]->userSpaceUsage, sortedInfos[i]->sysSpaceUsage,
-                            (sortedInfos[i]->minflt).c_str(), (sortedInfos[i]->majflt).c_str(),
-                            (sortedInfos[i]->comm).c_str());
-        if (ret < 0) {
-            continue;
+        AddProcInfoToTable(*curSpecProc_, *table);
+    } else {
+        for (const auto &proc : curProcs_) {
+            AddProcInfoToTable(*proc, *table);
         }
-        AddStrLineToDumpInfo(std::string(format));
+        table->Sort({{PROC_TOTAL, true}, {PROC_USER, true}, {PROC_KERNEL, true}, {PROC_PID, true}});
     }
+    lineBuffer_->AppendTable(table);
 }
 
-bool CPUDumper::SortProcInfo(std::shared_ptr<ProcInfo> &left, std::shared_ptr<ProcInfo> &right)
+void CPUDumper::AddProcInfoToTable(const ProcInfo &info, DumpTable &table)
 {
-    if (right->totalUsage != left->totalUsage) {
-        return right->totalUsage < left->totalUsage;
-    }
-    if (right->userSpaceUsage != left->userSpaceUsage) {
-        return right->userSpaceUsage < left->userSpaceUsage;
-    }
-    if (right->sysSpaceUsage != left->sysSpaceUsage) {
-        return right->sysSpaceUsage < left->sysSpaceUsage;
-    }
-    if (right->pid.length() != left->pid.length()) {
-        return right->pid.length() < left->pid.length();
-    }
-    return (right->pid.compare(left->pid) < 0);
+    size_t row = table.AddRow();
+    table.SetValue(row, PROC_PID, strtoull(info.pid.c_str(), nullptr, DEC_BASE));
+    table.SetValue(row, PROC_TOTAL, info.totalUsage);
+    table.SetValue(row, PROC_USER, info.userSpaceUsage);
+    table.SetValue(row, PROC_KERNEL, info.sysSpaceUsage);
+    table.SetValue(row, PROC_MINFLT, strtoull(info.minflt.c_str(), nullptr, DEC_BASE));
+    table.SetValue(row, PROC_MAJFLT, strtoull(info.majflt.c_str(), nullptr, DEC_BASE));
+    table.SetString(row, PROC_NAME, info.comm);
 }
 
 float CPUDumper::GetCpuUsage(int pid)
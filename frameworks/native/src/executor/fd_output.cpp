@@ -14,8 +14,9 @@
  */
 
 #include "executor/fd_output.h"
-#include<unistd.h>
-#include<fcntl.h>
+#include <cerrno>
+#include <unistd.h>
+#include <fcntl.h>
 
 namespace OHOS {
 namespace HiviewDFX {
@@ -27,6 +28,7 @@ FDOutput::FDOutput() : fd_(-1)
 
 FDOutput::~FDOutput()
 {
+    ptrFileWriter_.reset(); // flush before close
     if (fd_ >= 0) {
         close(fd_);
     }
@@ -42,20 +44,37 @@ DumpStatus FDOutput::PreExecute(const std::shared_ptr<DumperParameter>& paramete
         return DumpStatus::DUMP_FAIL;
     }
     ptrReqCtl_ = parameter->getClientCallback();
+    ptrOutputWriter_ = parameter->GetOutputWriter();
+    lineBuffer_ = parameter->GetLineBuffer();
+    lineBuffer_->MoveFrom(*dumpDatas_);
     path_ = parameter->GetOutputFilePath();
-    if ((fd_ < 0) && (!path_.empty())) {
+    // with --zip the path is the archive, written by the zip output.
+    if ((fd_ < 0) && (!path_.empty()) && !parameter->GetOpts().IsDumpZip()) {
         fd_ = open(path_.c_str(), O_WRONLY | O_CREAT | O_APPEND, OPEN_ARGV);
         if (fd_ < 0) {
             return DumpStatus::DUMP_FAIL;
         }
+        ptrFileWriter_ = std::make_shared<DumpFdWriter>(fd_);
     }
     return DumpStatus::DUMP_OK;
 }
 
 DumpStatus FDOutput::Execute()
 {
-    if ((ptrReqCtl_ != nullptr) && (dumpDatas_ != nullptr)) {
+    if ((ptrReqCtl_ != nullptr) && (lineBuffer_ != nullptr)) {
         OutMethod();
+        // end of section.
+        if (ptrOutputWriter_ != nullptr) {
+            ptrOutputWriter_->FlushSection();
+        }
+        if (ptrFileWriter_ != nullptr) {
+            ptrFileWriter_->FlushSection();
+        }
+        if ((ptrOutputWriter_ != nullptr) && ptrOutputWriter_->IsBroken() && (ptrOutputWriter_->GetError() == EPIPE)) {
+            // the client has gone, stop the rest of request.
+            DUMPER_HILOGE(MODULE_COMMON, "error|client output is closed, cancel request");
+            ptrReqCtl_->Cancel();
+        }
     }
     return DumpStatus::DUMP_OK;
 }
@@ -65,30 +84,66 @@ DumpStatus FDOutput::AfterExecute()
     if (dumpDatas_ != nullptr) {
         dumpDatas_->clear();
     }
+    if (lineBuffer_ != nullptr) {
+        lineBuffer_->Clear();
+    }
     return DumpStatus::DUMP_OK;
 }
 
 void FDOutput::OutMethod()
 {
-    for (size_t i = 0; i < dumpDatas_->size(); i++) {
-        std::vector<std::string> line = dumpDatas_->at(i);
-        for (size_t j = 0; j < line.size(); j++) {
-            std::string str = line[j];
-            if ((i < dumpDatas_->size()) && (j == (line.size() - 1))) {
-                NewLineMethod(str);
-            }
-            int rawParamFd = ptrReqCtl_->GetOutputFd();
-            if (rawParamFd > -1) {
-                write(rawParamFd, str.c_str(), strlen(str.c_str()));
-                fsync(rawParamFd);
-            }
-            if (fd_ > -1) {
-                dprintf(fd_, "%s", str.c_str());
-            }
+    size_t lineCount = lineBuffer_->GetLineCount();
+    for (size_t i = 0; i < lineCount; i++) {
+        DumpTable *table = lineBuffer_->GetTable(i);
+        if (table != nullptr) {
+            WriteTable(*table);
+            continue;
+        }
+        size_t cellCount = lineBuffer_->GetCellCount(i);
+        for (size_t j = 0; j < cellCount; j++) {
+            bool isLineEnd = (j == (cellCount - 1));
+            DumpLineBuffer::Cell cell = lineBuffer_->GetCell(i, j);
+            WriteCell(ptrOutputWriter_, cell, isLineEnd);
+            WriteCell(ptrFileWriter_, cell, isLineEnd);
         }
     }
 }
 
+void FDOutput::WriteCell(const std::shared_ptr<DumpFdWriter> &writer, const DumpLineBuffer::Cell &cell,
+    bool isLineEnd)
+{
+    if ((writer == nullptr) || writer->IsBroken()) {
+        return;
+    }
+    if (isLineEnd) {
+        writer->AppendLine(cell.data, cell.size);
+    } else {
+        writer->Append(cell.data, cell.size);
+    }
+}
+
+void FDOutput::WriteTable(const DumpTable &table)
+{
+    if (table.IsHeaderVisible()) {
+        dataStr_.clear();
+        table.FormatHeader(dataStr_);
+        WriteTextLine(dataStr_);
+    }
+    size_t rowCount = table.GetRowCount();
+    for (size_t row = 0; row < rowCount; row++) {
+        dataStr_.clear();
+        table.FormatRow(row, dataStr_);
+        WriteTextLine(dataStr_);
+    }
+}
+
+void FDOutput::WriteTextLine(const std::string &text)
+{
+    DumpLineBuffer::Cell cell = { text.data(), text.size() };
+    WriteCell(ptrOutputWriter_, cell, true);
+    WriteCell(ptrFileWriter_, cell, true);
+}
+
 void FDOutput::NewLineMethod(std::string &str)
 {
     if (str.find("\n") == std::string::npos) { // No line breaks
@@ -34,24 +34,39 @@ FileFormatDumpFilter::FileFormatDumpFilter()
 FileFormatDumpFilter::~FileFormatDumpFilter()
 {
     dumpDatas_ = nullptr;
+    lineBuffer_ = nullptr;
 }
 
 DumpStatus FileFormatDumpFilter::PreExecute(const std::shared_ptr<DumperParameter>& parameter,
     StringMatrix dumpDatas)
 {
+    if ((parameter == nullptr) || (dumpDatas == nullptr)) {
+        return DumpStatus::DUMP_FAIL;
+    }
     dumpDatas_ = dumpDatas;
+    lineBuffer_ = parameter->GetLineBuffer();
+    lineBuffer_->MoveFrom(*dumpDatas_);
     return DumpStatus::DUMP_OK;
 }
 
 DumpStatus FileFormatDumpFilter::Execute()
 {
-    if (dumpDatas_ == nullptr) {
+    if (lineBuffer_ == nullptr) {
         return DumpStatus::DUMP_FAIL;
     }
 
-    for (auto &lineItems : (*dumpDatas_)) {
-        for (auto &item : lineItems) {
-            FilterControlChar(item);
+    size_t lineCount = lineBuffer_->GetLineCount();
+    for (size_t i = 0; i < lineCount; i++) {
+        DumpTable *table = lineBuffer_->GetTable(i);
+        if (table != nullptr) {
+            table->FilterStrings(FilterControlChar);
+            continue;
+        }
+        size_t cellCount = lineBuffer_->GetCellCount(i);
+        for (size_t j = 0; j < cellCount; j++) {
+            size_t size = 0;
+            char *data = lineBuffer_->GetMutableCell(i, j, size);
+            lineBuffer_->ShrinkCell(i, j, FilterControlChar(data, size));
         }
     }
 
@@ -61,21 +76,20 @@ DumpStatus FileFormatDumpFilter::Execute()
 DumpStatus FileFormatDumpFilter::AfterExecute()
 {
     dumpDatas_ = nullptr;
+    lineBuffer_ = nullptr;
     return DumpStatus::DUMP_OK;
 }
 
-void FileFormatDumpFilter::FilterControlChar(std::string &str)
+size_t FileFormatDumpFilter::FilterControlChar(char *data, size_t size)
 {
-    std::string newStr;
-
+    // characters are only removed, so the output never passes the input.
+    size_t out = 0;
     bool skip = false;
-    const size_t sum = str.size();
-    for (size_t pos = 0; pos < sum; pos++) {
-        char &c = str.at(pos);
+    for (size_t pos = 0; pos < size; pos++) {
+        char c = data[pos];
 
-        if ((!skip) && (c == ASCII_ESC) && ((pos + 1) < sum)) {
-            char &next_c = str.at(pos + 1);
-            skip = (next_c == ASCII_OB);
+        if ((!skip) && (c == ASCII_ESC) && ((pos + 1) < size)) {
+            skip = (data[pos + 1] == ASCII_OB);
         }
 
         if (skip && (((c >= ASCII_UA) && (c <= ASCII_UZ)) || ((c >= ASCII_LA) && (c <= ASCII_LZ)))) {
@@ -87,10 +101,9 @@ void FileFormatDumpFilter::FilterControlChar(std::string &str)
             continue;
         }
 
-        newStr.append(1, c);
+        data[out++] = c;
     }
-
-    str = newStr;
+    return out;
 }
 } // namespace HiviewDFX
 } // namespace OHOS
@@ -13,6 +13,7 @@
  * limitations under the License.
  */
 #include "executor/file_stream_dumper.h"
+#include <cstring>
 #include <dirent.h>
 #include <unistd.h>
 #include "dump_utils.h"
@@ -20,11 +21,11 @@
 namespace OHOS {
 namespace HiviewDFX {
 FileStreamDumper::FileStreamDumper()
-    :fp_(nullptr),
-    fd_(-1),
+    :fd_(-1),
     next_file_index_(0),
     more_data_(false),
-    need_loop_(false)
+    need_loop_(false),
+    timed_out_(false)
 {
 }
 
@@ -36,9 +37,13 @@ FileStreamDumper::~FileStreamDumper()
 DumpStatus FileStreamDumper::PreExecute(const std::shared_ptr<DumperParameter>& parameter,
     StringMatrix dumpDatas)
 {
-    if (dumpDatas.get()) {
-        result_ = dumpDatas;
+    if ((parameter == nullptr) || (dumpDatas.get() == nullptr)) {
+        return DumpStatus::DUMP_FAIL;
     }
+    result_ = dumpDatas;
+    // lines are read into the line buffer, after the rows already in the matrix.
+    lineBuffer_ = parameter->GetLineBuffer();
+    lineBuffer_->MoveFrom(*result_);
 
     // open first file!
     if (next_file_index_ <= 0) {
@@ -55,6 +60,7 @@ DumpStatus FileStreamDumper::PreExecute(const std::shared_ptr<DumperParameter>&
         }
         BuildFileNames(target, arg_pid, pid, arg_cpuid, cpuid);
         need_loop_ = (ptrDumpCfg_->loop_ == DumperConstant::LOOP);
+        timed_out_ = false;
 
         int ret = OpenNextFile();
         if (ret <= 0) {
@@ -75,53 +81,38 @@ int FileStreamDumper::OpenNextFile()
     }
     // Next file
     std::string filename = filenames_[next_file_index_];
-    // Open fd and fp
+    // Open fd
     if ((fd_ = DumpUtils::FdToRead(filename)) == -1) {
         return -1;
     }
-    if ((fp_ = fdopen(fd_, "r")) == nullptr) {
-        close(fd_);
-        fd_ = -1;
-        return -1;
-    }
+    reader_.Reset(fd_);
     next_file_index_ ++;
     // add file name into buffer
-    std::vector<std::string> line_vector_blank;
-    line_vector_blank.push_back("");
-    std::vector<std::string> line_vector_filename;
-    line_vector_filename.push_back(filename);
-    result_->push_back(line_vector_blank);
-    result_->push_back(line_vector_filename);
-    result_->push_back(line_vector_blank);
+    lineBuffer_->AppendCell("", 0);
+    lineBuffer_->EndLine();
+    lineBuffer_->AppendCell(filename);
+    lineBuffer_->EndLine();
+    lineBuffer_->AppendCell("", 0);
+    lineBuffer_->EndLine();
     return next_file_index_;
 }
 
-// read one line
+// read one line, waiting no longer than the time left.
 DumpStatus FileStreamDumper::ReadLine()
 {
     DumpStatus ret = DumpStatus::DUMP_MORE_DATA;
-    if (fp_ == nullptr) {
+    if (fd_ < 0) {
         return DumpStatus::DUMP_FAIL;
     }
-    char* line_buffer = nullptr;
-    size_t len = 0;
-    ssize_t read = 0;
-    read = getline(&line_buffer, &len, fp_);
-    if (read != -1) {
-        if (line_buffer[read-1] == '\n') {
-            line_buffer[read-1] = '\0'; // replease \n
-        }
-        std::string line = line_buffer;
-        std::vector<std::string> line_vector;
-        line_vector.push_back(line);
-        result_->push_back(line_vector);
-    } else {
-        if (feof(fp_) == 0) { // ferror()
-            ret = DumpStatus::DUMP_FAIL;
-        }
-    }
-    // end of file
-    if (feof(fp_) != 0) {
+    const char *data = nullptr;
+    size_t size = 0;
+    DumpLineReader::Result result = reader_.ReadLine(GetTimeRemain(), [this] { return IsCanceled(); }, data, size);
+    if (result == DumpLineReader::READ_LINE) {
+        // a line stops at the first NUL, as the string of it did.
+        lineBuffer_->AppendCell(data, strnlen(data, size));
+        lineBuffer_->EndLine();
+    } else if (result == DumpLineReader::READ_END) {
+        // end of file
         int more_file = OpenNextFile();
         if (more_file > 0) {
             ret = DumpStatus::DUMP_MORE_DATA;
@@ -130,10 +121,13 @@ DumpStatus FileStreamDumper::ReadLine()
         } else { // Error!
             ret = DumpStatus::DUMP_FAIL;
         }
-    }
-    if (line_buffer != nullptr) {
-        free(line_buffer);
-        line_buffer = nullptr;
+    } else if (result == DumpLineReader::READ_TIMEOUT) {
+        timed_out_ = true;
+        ret = DumpStatus::DUMP_OK;
+    } else if (result == DumpLineReader::READ_CANCELED) {
+        ret = DumpStatus::DUMP_OK;
+    } else {
+        ret = DumpStatus::DUMP_FAIL;
     }
     more_data_ = (ret == DumpStatus::DUMP_MORE_DATA);
     return ret;
@@ -146,24 +140,23 @@ DumpStatus FileStreamDumper::Execute()
         // dump one line
         return ReadLine();
     } else {
-        // dump all line
+        // dump all line, or as many as the chunk budget takes
         do {
             if (IsCanceled()) {
                 break;
             }
             ret = ReadLine();
-        } while (ret == DumpStatus::DUMP_MORE_DATA);
+        } while ((ret == DumpStatus::DUMP_MORE_DATA) && !IsChunkFull());
     }
     return ret;
 }
 
 DumpStatus FileStreamDumper::AfterExecute()
 {
-    if (more_data_ && IsTimeout()) {
+    if (timed_out_ || (more_data_ && IsTimeout())) {
         DUMPER_HILOGE(MODULE_COMMON, "error|file timeout");
-        std::vector<std::string> line_vector_timeout;
-        line_vector_timeout.push_back(GetTimeoutStr());
-        result_->push_back(line_vector_timeout);
+        lineBuffer_->AppendCell(GetTimeoutStr());
+        lineBuffer_->EndLine();
         more_data_ = false;
     }
 
@@ -234,10 +227,7 @@ void FileStreamDumper::ReplaceCpuidInFilename(std::string& filename, int cpuid)
 
 void FileStreamDumper::CloseFd()
 {
-    if (fp_ != nullptr) {
-        fclose(fp_);
-        fp_ = nullptr;
-    }
+    reader_.Reset(-1);
     if (fd_ >= 0) {
         close(fd_);
         fd_ = -1;
@@ -26,6 +26,8 @@ void HidumperExecutor::Reset()
 {
     rawParam_ = nullptr;
     ptrParent_ = nullptr;
+    chunkLines_ = nullptr;
+    chunkBudget_ = 0;
     hasOnce_ = false;
     hasOnceTimeout_ = false;
     hitTickCount_ = 0;
@@ -36,6 +38,8 @@ DumpStatus HidumperExecutor::DoPreExecute(const std::shared_ptr<DumperParameter>
 {
     if (parameter != nullptr) {
         rawParam_ = parameter->getClientCallback();
+        chunkLines_ = parameter->GetLineBuffer();
+        chunkBudget_ = parameter->GetChunkBudget();
         // to mill-second.
         timeOutMillSec_ = parameter->GetOpts().timeout_ * SEC_TO_MILLISEC;
     }
@@ -77,6 +81,7 @@ DumpStatus HidumperExecutor::DoAfterExecute()
     DumpStatus ret = AfterExecute();
 
     rawParam_ = nullptr;
+    chunkLines_ = nullptr;
     return ret;
 }
 
@@ -88,10 +93,11 @@ void HidumperExecutor::SetDumpConfig(const std::shared_ptr<DumpCfg>& config)
     }
 
     ptrDumpCfg_ = config;
+}
 
-    if ((!ptrDumpCfg_->IsOutput()) && (ptrDumpCfg_->parent_ != nullptr)) {
-        ptrParent_ = ptrDumpCfg_->parent_->executor_;
-    }
+void HidumperExecutor::SetParent(const HidumperExecutor *parent)
+{
+    ptrParent_ = parent;
 }
 
 const std::shared_ptr<DumpCfg>& HidumperExecutor::GetDumpConfig() const
@@ -128,6 +134,11 @@ bool HidumperExecutor::IsCanceled() const
     return ((rawParam_ != nullptr) && rawParam_->IsCanceled());
 }
 
+bool HidumperExecutor::IsChunkFull() const
+{
+    return (chunkBudget_ > 0) && (chunkLines_ != nullptr) && (chunkLines_->GetPendingSize() >= chunkBudget_);
+}
+
 std::string HidumperExecutor::GetTimeoutStr(std::string head) const
 {
     return head + TIME_OUT_STR;
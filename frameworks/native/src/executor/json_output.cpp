@@ -0,0 +1,426 @@
+/*
+ * Copyright (C) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "executor/json_output.h"
+#include <cerrno>
+#include <cstdio>
+#include <unistd.h>
+#include "dump_utils.h"
+#include "util/dump_cell_utils.h"
+
+namespace OHOS {
+namespace HiviewDFX {
+namespace {
+static const char NEW_LINE_BREAKS_CHAR = '\n';
+static const char PERCENT_CHAR = '%';
+static const size_t ESCAPE_SIZE = 8; // fits a \\u00XX escape
+static const unsigned char CONTROL_CHAR_END = 0x20;
+static const char REPLACEMENT_CHAR[] = "\\ufffd";
+static const char EMPTY_DOCUMENT[] = "{\"sections\":[]}\n";
+static const unsigned char UTF8_TAIL_MASK = 0xc0;
+static const unsigned char UTF8_TAIL_MIN = 0x80;
+static const unsigned char UTF8_TAIL_MAX = 0xbf;
+static const unsigned char UTF8_LEAD2_MIN = 0xc2;
+static const unsigned char UTF8_LEAD3_MIN = 0xe0;
+static const unsigned char UTF8_LEAD4_MIN = 0xf0;
+static const unsigned char UTF8_LEAD_END = 0xf5;
+static const unsigned char UTF8_E0_TAIL_MIN = 0xa0; // below is overlong
+static const unsigned char UTF8_ED_LEAD = 0xed;
+static const unsigned char UTF8_ED_TAIL_MAX = 0x9f; // above is a surrogate
+static const unsigned char UTF8_F0_TAIL_MIN = 0x90; // below is overlong
+static const unsigned char UTF8_F4_LEAD = 0xf4;
+static const unsigned char UTF8_F4_TAIL_MAX = 0x8f; // above is beyond U+10FFFF
+
+// size of the valid UTF-8 sequence at pos, 0 if it's not one.
+size_t GetUtf8Size(const std::string &str, size_t pos)
+{
+    unsigned char lead = static_cast<unsigned char>(str[pos]);
+    if ((lead < UTF8_LEAD2_MIN) || (lead >= UTF8_LEAD_END)) {
+        return 0;
+    }
+    size_t size = 2; // 2: lead and one tail
+    unsigned char low = UTF8_TAIL_MIN;
+    unsigned char high = UTF8_TAIL_MAX;
+    if (lead >= UTF8_LEAD4_MIN) {
+        size = 4; // 4: lead and three tails
+        low = (lead == UTF8_LEAD4_MIN) ? UTF8_F0_TAIL_MIN : low;
+        high = (lead == UTF8_F4_LEAD) ? UTF8_F4_TAIL_MAX : high;
+    } else if (lead >= UTF8_LEAD3_MIN) {
+        size = 3; // 3: lead and two tails
+        low = (lead == UTF8_LEAD3_MIN) ? UTF8_E0_TAIL_MIN : low;
+        high = (lead == UTF8_ED_LEAD) ? UTF8_ED_TAIL_MAX : high;
+    }
+    if (str.size() - pos < size) {
+        return 0;
+    }
+    unsigned char first = static_cast<unsigned char>(str[pos + 1]);
+    if ((first < low) || (first > high)) {
+        return 0;
+    }
+    for (size_t i = 2; i < size; i++) { // 2: the first tail is checked above
+        if ((static_cast<unsigned char>(str[pos + i]) & UTF8_TAIL_MASK) != UTF8_TAIL_MIN) {
+            return 0;
+        }
+    }
+    return size;
+}
+} // namespace
+
+JsonOutput::JsonOutput() : JsonOutput("")
+{
+}
+
+JsonOutput::JsonOutput(const std::string &path)
+    : filePath_(path), fileFd_(-1), started_(false), firstSection_(true), sectionOpened_(false), firstBlock_(true),
+      block_(BLOCK_NONE), inHeader_(false), firstItem_(true)
+{
+}
+
+JsonOutput::~JsonOutput()
+{
+    CloseFile();
+}
+
+DumpStatus JsonOutput::PreExecute(const std::shared_ptr<DumperParameter>& parameter,
+    StringMatrix dumpDatas)
+{
+    if ((parameter == nullptr) || (dumpDatas == nullptr)) {
+        DUMPER_HILOGE(MODULE_COMMON, "PreExecute error|parameter or dumpDatas is nullptr");
+        return DumpStatus::DUMP_FAIL;
+    }
+    dumpDatas_ = dumpDatas;
+    lineBuffer_ = parameter->GetLineBuffer();
+    lineBuffer_->MoveFrom(*dumpDatas_);
+    ptrReqCtl_ = parameter->getClientCallback();
+    if (filePath_.empty()) {
+        ptrOutputWriter_ = parameter->GetOutputWriter();
+    } else if (!OpenFile()) {
+        return DumpStatus::DUMP_FAIL;
+    }
+    if (!started_) {
+        started_ = true;
+        buffer_.append("{\"sections\":[");
+    }
+    if (!sectionOpened_ || (section_ != parameter->GetCurrentSection())) {
+        EndSection();
+        BeginSection(parameter->GetCurrentSection());
+    }
+    return DumpStatus::DUMP_OK;
+}
+
+DumpStatus JsonOutput::Execute()
+{
+    if ((ptrReqCtl_ == nullptr) || (lineBuffer_ == nullptr)) {
+        return DumpStatus::DUMP_OK;
+    }
+    std::vector<std::string> line;
+    size_t lineCount = lineBuffer_->GetLineCount();
+    for (size_t i = 0; i < lineCount; i++) {
+        DumpTable *table = lineBuffer_->GetTable(i);
+        if (table != nullptr) {
+            WriteTable(*table);
+            continue;
+        }
+        lineBuffer_->GetLine(i, line);
+        if (line.size() > 1) {
+            if (DumpCellUtils::IsSeparatorRow(line)) {
+                continue;
+            }
+            if (block_ != BLOCK_TABLE) {
+                BeginBlock(BLOCK_TABLE);
+            }
+            WriteTableRow(line);
+        } else if (line.empty() || (DumpCellUtils::Trim(line[0]).empty())) {
+            // a blank line ends a table, inside text it is kept.
+            if (block_ == BLOCK_TEXT) {
+                WriteText("");
+            } else {
+                EndBlock();
+            }
+        } else {
+            if (block_ != BLOCK_TEXT) {
+                BeginBlock(BLOCK_TEXT);
+            }
+            // one cell may hold several lines, e.g. output of a command.
+            std::string text = line[0];
+            if (text.back() == NEW_LINE_BREAKS_CHAR) {
+                text.pop_back();
+            }
+            size_t start = 0;
+            for (size_t pos = text.find(NEW_LINE_BREAKS_CHAR); pos != std::string::npos;
+                pos = text.find(NEW_LINE_BREAKS_CHAR, start)) {
+                WriteText(text.substr(start, pos - start));
+                start = pos + 1;
+            }
+            WriteText(text.substr(start));
+        }
+        if (buffer_.size() >= DumpFdWriter::DEFAULT_HIGH_WATER) {
+            Write();
+        }
+    }
+    Write();
+    // end of section.
+    if (ptrOutputWriter_ != nullptr) {
+        ptrOutputWriter_->FlushSection();
+        if (filePath_.empty() && ptrOutputWriter_->IsBroken() && (ptrOutputWriter_->GetError() == EPIPE)) {
+            // the client has gone, stop the rest of request.
+            DUMPER_HILOGE(MODULE_COMMON, "error|client output is closed, cancel request");
+            ptrReqCtl_->Cancel();
+        }
+    }
+    return DumpStatus::DUMP_OK;
+}
+
+DumpStatus JsonOutput::AfterExecute()
+{
+    if (dumpDatas_ != nullptr) {
+        dumpDatas_->clear();
+    }
+    if (lineBuffer_ != nullptr) {
+        lineBuffer_->Clear();
+    }
+    return DumpStatus::DUMP_OK;
+}
+
+void JsonOutput::Reset()
+{
+    if (started_) {
+        EndSection();
+        buffer_.append("]}\n");
+        Write();
+    }
+    CloseFile();
+    buffer_.clear();
+    started_ = false;
+    firstSection_ = true;
+    sectionOpened_ = false;
+    section_.clear();
+    dumpDatas_ = nullptr;
+    lineBuffer_ = nullptr;
+    ptrReqCtl_ = nullptr;
+    ptrOutputWriter_ = nullptr;
+    HidumperExecutor::Reset();
+}
+
+void JsonOutput::AppendString(const std::string &str, std::string &out)
+{
+    out.push_back('"');
+    for (size_t i = 0; i < str.size(); i++) {
+        char c = str[i];
+        switch (c) {
+            case '"':
+                out.append("\\\"");
+                break;
+            case '\\':
+                out.append("\\\\");
+                break;
+            case '\n':
+                out.append("\\n");
+                break;
+            case '\r':
+                out.append("\\r");
+                break;
+            case '\t':
+                out.append("\\t");
+                break;
+            default:
+                if (static_cast<unsigned char>(c) < CONTROL_CHAR_END) {
+                    char escape[ESCAPE_SIZE] = {0};
+                    (void)snprintf(escape, sizeof(escape), "\\u%04x", static_cast<unsigned char>(c));
+                    out.append(escape);
+                } else if (static_cast<unsigned char>(c) < UTF8_TAIL_MIN) {
+                    out.push_back(c);
+                } else {
+                    // a byte of no valid sequence would make the document invalid.
+                    size_t size = GetUtf8Size(str, i);
+                    if (size == 0) {
+                        out.append(REPLACEMENT_CHAR);
+                    } else {
+                        out.append(str, i, size);
+                        i += size - 1;
+                    }
+                }
+                break;
+        }
+    }
+    out.push_back('"');
+}
+
+void JsonOutput::AppendEmptyDocument(DumpFdWriter &writer)
+{
+    writer.Append(EMPTY_DOCUMENT);
+}
+
+void JsonOutput::AppendCell(const std::string &cell, std::string &out)
+{
+    std::string value = DumpCellUtils::Trim(cell);
+    if (DumpCellUtils::IsNumber(value)) {
+        if (value.back() == PERCENT_CHAR) {
+            value.pop_back();
+        }
+        out.append(value);
+    } else {
+        AppendString(value, out);
+    }
+}
+
+void JsonOutput::BeginSection(const std::string &name)
+{
+    buffer_.append(firstSection_ ? "\n{\"name\":" : ",\n{\"name\":");
+    AppendString(name, buffer_);
+    buffer_.append(",\"blocks\":[");
+    firstSection_ = false;
+    sectionOpened_ = true;
+    section_ = name;
+    firstBlock_ = true;
+    block_ = BLOCK_NONE;
+}
+
+void JsonOutput::EndSection()
+{
+    if (!sectionOpened_) {
+        return;
+    }
+    EndBlock();
+    buffer_.append("]}");
+    sectionOpened_ = false;
+}
+
+void JsonOutput::BeginBlock(BlockType type)
+{
+    EndBlock();
+    buffer_.append(firstBlock_ ? "\n" : ",\n");
+    buffer_.append((type == BLOCK_TABLE) ? "{\"type\":\"table\",\"header\":[" : "{\"type\":\"text\",\"lines\":[");
+    firstBlock_ = false;
+    block_ = type;
+    inHeader_ = (type == BLOCK_TABLE);
+    firstItem_ = true;
+}
+
+void JsonOutput::EndBlock()
+{
+    if (block_ == BLOCK_NONE) {
+        return;
+    }
+    buffer_.append(inHeader_ ? "],\"rows\":[]}" : "]}");
+    block_ = BLOCK_NONE;
+    inHeader_ = false;
+}
+
+void JsonOutput::BeginItem()
+{
+    buffer_.append(firstItem_ ? "\n" : ",\n");
+    firstItem_ = false;
+}
+
+void JsonOutput::WriteText(const std::string &text)
+{
+    BeginItem();
+    AppendString(text, buffer_);
+}
+
+void JsonOutput::WriteTableRow(const std::vector<std::string> &line)
+{
+    if (inHeader_ && DumpCellUtils::HasNumber(line)) {
+        buffer_.append("],\"rows\":[");
+        inHeader_ = false;
+        firstItem_ = true;
+    }
+    BeginItem();
+    buffer_.push_back('[');
+    for (size_t i = 0; i < line.size(); i++) {
+        if (i > 0) {
+            buffer_.push_back(',');
+        }
+        AppendCell(line[i], buffer_);
+    }
+    buffer_.push_back(']');
+}
+
+void JsonOutput::WriteTable(const DumpTable &table)
+{
+    BeginBlock(BLOCK_TABLE);
+    size_t columnCount = table.GetColumnCount();
+    BeginItem();
+    buffer_.push_back('[');
+    for (size_t column = 0; column < columnCount; column++) {
+        if (column > 0) {
+            buffer_.push_back(',');
+        }
+        AppendString(table.GetColumn(column).name, buffer_);
+    }
+    buffer_.append("]],\"rows\":[");
+    inHeader_ = false;
+    firstItem_ = true;
+    size_t rowCount = table.GetRowCount();
+    for (size_t row = 0; row < rowCount; row++) {
+        BeginItem();
+        buffer_.push_back('[');
+        for (size_t column = 0; column < columnCount; column++) {
+            if (column > 0) {
+                buffer_.push_back(',');
+            }
+            if (table.GetColumn(column).type == DumpTable::COLUMN_STRING) {
+                AppendString(table.GetString(row, column), buffer_);
+            } else {
+                buffer_.append(std::to_string(table.GetValue(row, column)));
+            }
+        }
+        buffer_.push_back(']');
+        if (buffer_.size() >= DumpFdWriter::DEFAULT_HIGH_WATER) {
+            Write();
+        }
+    }
+    EndBlock();
+}
+
+bool JsonOutput::OpenFile()
+{
+    if (fileWriter_ != nullptr) {
+        return true;
+    }
+    fileFd_ = DumpUtils::FdToWrite(filePath_);
+    if (fileFd_ < 0) {
+        DUMPER_HILOGE(MODULE_COMMON, "OpenFile error|open %{public}s failed", filePath_.c_str());
+        return false;
+    }
+    fileWriter_ = std::make_shared<DumpFdWriter>(fileFd_);
+    ptrOutputWriter_ = fileWriter_;
+    return true;
+}
+
+void JsonOutput::CloseFile()
+{
+    if (fileWriter_ != nullptr) {
+        (void)fileWriter_->Flush();
+        fileWriter_ = nullptr;
+    }
+    if (fileFd_ >= 0) {
+        close(fileFd_);
+        fileFd_ = -1;
+    }
+}
+
+void JsonOutput::Write()
+{
+    if (buffer_.empty()) {
+        return;
+    }
+    if ((ptrOutputWriter_ != nullptr) && !ptrOutputWriter_->IsBroken()) {
+        ptrOutputWriter_->Append(buffer_);
+    }
+    buffer_.clear();
+}
+} // namespace HiviewDFX
+} // namespace OHOS
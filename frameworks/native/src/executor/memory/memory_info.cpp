@@ -27,6 +27,7 @@
 #include "executor/memory/parse/parse_meminfo.h"
 #include "dump_common_utils.h"
 #include "hilog_wrapper.h"
+#include "util/dump_psi_util.h"
 #include "util/string_utils.h"
 #include "executor/memory/parse/meminfo_data.h"
 #include "executor/memory/parse/parse_smaps_rollup_info.h"
@@ -34,6 +35,17 @@
 using namespace std;
 namespace OHOS {
 namespace HiviewDFX {
+namespace {
+enum MemUsageColumnIndex {
+    MEM_USAGE_PID = 0,
+    MEM_USAGE_NAME,
+    MEM_USAGE_PSS,
+    MEM_USAGE_VSS,
+    MEM_USAGE_RSS,
+    MEM_USAGE_USS,
+};
+} // namespace
+
 MemoryInfo::MemoryInfo()
 {
 }
@@ -42,7 +54,7 @@ MemoryInfo::~MemoryInfo()
 {
 }
 
-void MemoryInfo::insertMemoryTitle(StringMatrix result)
+void MemoryInfo::insertMemoryTitle()
 {
     // Pss        Shared   ---- this line is line1
     // Total      Clean    ---- this line is line2
@@ -84,15 +96,15 @@ void MemoryInfo::insertMemoryTitle(StringMatrix result)
             line4.push_back(separator);
         }
     }
-    result->push_back(line1);
-    result->push_back(line2);
-    result->push_back(line3);
-    result->push_back(line4);
+    lineBuffer_->AppendLine(line1);
+    lineBuffer_->AppendLine(line2);
+    lineBuffer_->AppendLine(line3);
+    lineBuffer_->AppendLine(line4);
 }
 
-void MemoryInfo::BuildResult(const PairMatrixGroup &infos, StringMatrix result)
+void MemoryInfo::BuildResult(const PairMatrixGroup &infos)
 {
-    insertMemoryTitle(result);
+    insertMemoryTitle();
     for (auto info : infos) {
         vector<string> tempResult;
         string group = info.first;
@@ -105,7 +117,7 @@ void MemoryInfo::BuildResult(const PairMatrixGroup &infos, StringMatrix result)
             StringUtils::GetInstance().SetWidth(LINE_WIDTH_, BLANK_, false, value);
             tempResult.push_back(value);
         }
-        result->push_back(tempResult);
+        lineBuffer_->AppendLine(tempResult);
     }
 }
 
@@ -119,7 +131,7 @@ void MemoryInfo::SetValue(const string &value, vector<string> &lines, vector<str
     values.push_back(tempValue);
 }
 
-void MemoryInfo::CalcGroup(const PairMatrixGroup &infos, StringMatrix result)
+void MemoryInfo::CalcGroup(const PairMatrixGroup &infos)
 {
     string separator = "-";
     StringUtils::GetInstance().SetWidth(LINE_WIDTH_, SEPARATOR_, false, separator);
@@ -161,19 +173,23 @@ void MemoryInfo::CalcGroup(const PairMatrixGroup &infos, StringMatrix result)
     SetValue(to_string(meminfo.swap), lines, values);
     SetValue(to_string(meminfo.swapPss), lines, values);
 
-    result->push_back(lines);
-    result->push_back(values);
+    lineBuffer_->AppendLine(lines);
+    lineBuffer_->AppendLine(values);
 }
 
-bool MemoryInfo::GetMemoryInfoByPid(const int &pid, StringMatrix result)
+bool MemoryInfo::GetMemoryInfoByPid(const int &pid, const shared_ptr<DumpLineBuffer> &lines)
 {
     DUMPER_HILOGD(MODULE_SERVICE, "GetMemoryInfoByPid (%d) begin\n", pid);
+    if (lines == nullptr) {
+        return false;
+    }
+    lineBuffer_ = lines;
     PairMatrixGroup smapsInfo;
     unique_ptr<ParseSmapsInfo> parseSmapsInfo = make_unique<ParseSmapsInfo>();
     bool success = parseSmapsInfo->GetInfo(MemoryFilter::APPOINT_PID, pid, smapsInfo);
     if (success) {
-        BuildResult(smapsInfo, result);
-        CalcGroup(smapsInfo, result);
+        BuildResult(smapsInfo);
+        CalcGroup(smapsInfo);
     }
     DUMPER_HILOGD(MODULE_SERVICE, "GetMemoryInfoByPid (%d) end,result:(%d)\n", pid, success);
     return success;
@@ -202,7 +218,7 @@ bool MemoryInfo::GetMeminfo(PairMatrix &result)
     return success;
 }
 
-bool MemoryInfo::GetHardWareUsage(StringMatrix result)
+bool MemoryInfo::GetHardWareUsage()
 {
     DUMPER_HILOGD(MODULE_SERVICE, "GetHardWareUsage begin\n");
     uint64_t value;
@@ -214,13 +230,13 @@ bool MemoryInfo::GetHardWareUsage(StringMatrix result)
         StringUtils::GetInstance().SetWidth(RAM_WIDTH_, BLANK_, false, title);
         hardware.push_back(title);
         hardware.push_back(AddKbUnit(value));
-        result->push_back(hardware);
+        lineBuffer_->AppendLine(hardware);
     }
     DUMPER_HILOGD(MODULE_SERVICE, "GetHardWareUsage end,success:(%d)\n", success);
     return success;
 }
 
-bool MemoryInfo::GetCMAUsage(StringMatrix result)
+bool MemoryInfo::GetCMAUsage()
 {
     DUMPER_HILOGD(MODULE_SERVICE, "GetCMAUsage begin\n");
     uint64_t value = 0;
@@ -232,13 +248,13 @@ bool MemoryInfo::GetCMAUsage(StringMatrix result)
         StringUtils::GetInstance().SetWidth(RAM_WIDTH_, BLANK_, false, title);
         cma.push_back(title);
         cma.push_back(AddKbUnit(value));
-        result->push_back(cma);
+        lineBuffer_->AppendLine(cma);
     }
     DUMPER_HILOGD(MODULE_SERVICE, "GetCMAUsage end,success:(%d)\n", success);
     return success;
 }
 
-bool MemoryInfo::GetKernelUsage(const PairMatrix &infos, StringMatrix result)
+bool MemoryInfo::GetKernelUsage(const PairMatrix &infos)
 {
     DUMPER_HILOGD(MODULE_SERVICE, "GetKernelUsage begin");
     uint64_t value = 0;
@@ -250,13 +266,13 @@ bool MemoryInfo::GetKernelUsage(const PairMatrix &infos, StringMatrix result)
         StringUtils::GetInstance().SetWidth(RAM_WIDTH_, BLANK_, false, title);
         kernel.push_back(title);
         kernel.push_back(AddKbUnit(value));
-        result->push_back(kernel);
+        lineBuffer_->AppendLine(kernel);
     }
     DUMPER_HILOGD(MODULE_SERVICE, "GetKernelUsage end,success:(%d)\n", success);
     return success;
 }
 
-void MemoryInfo::GetProcesses(const PairMatrixGroup &infos, StringMatrix result)
+void MemoryInfo::GetProcesses(const PairMatrixGroup &infos)
 {
     DUMPER_HILOGD(MODULE_SERVICE, "GetProcesses begin");
     uint64_t value = 0;
@@ -269,16 +285,16 @@ void MemoryInfo::GetProcesses(const PairMatrixGroup &infos, StringMatrix result)
     StringUtils::GetInstance().SetWidth(RAM_WIDTH_, BLANK_, false, title);
     process.push_back(title);
     process.push_back(AddKbUnit(value));
-    result->push_back(process);
+    lineBuffer_->AppendLine(process);
     DUMPER_HILOGD(MODULE_SERVICE, "GetProcesses end");
 }
 
-void MemoryInfo::GetPssTotal(const PairMatrixGroup &infos, StringMatrix result)
+void MemoryInfo::GetPssTotal(const PairMatrixGroup &infos)
 {
     DUMPER_HILOGD(MODULE_SERVICE, "GetPssTotal begin");
     vector<string> title;
     title.push_back("Total PSS by Category:");
-    result->push_back(title);
+    lineBuffer_->AppendLine(title);
     for (auto info : infos) {
         vector<string> pss;
         string group = info.first;
@@ -299,12 +315,12 @@ void MemoryInfo::GetPssTotal(const PairMatrixGroup &infos, StringMatrix result)
         pss.push_back(":");
         pss.push_back(group);
 
-        result->push_back(pss);
+        lineBuffer_->AppendLine(pss);
         DUMPER_HILOGD(MODULE_SERVICE, "GetPssTotal end");
     }
 }
 
-void MemoryInfo::GetRamUsage(const PairMatrixGroup &smapsinfos, const PairMatrix &meminfo, StringMatrix result)
+void MemoryInfo::GetRamUsage(const PairMatrixGroup &smapsinfos, const PairMatrix &meminfo)
 {
     DUMPER_HILOGD(MODULE_SERVICE, "GetRamUsage begin");
     unique_ptr<GetRamInfo> getRamInfo = make_unique<GetRamInfo>();
@@ -315,7 +331,7 @@ void MemoryInfo::GetRamUsage(const PairMatrixGroup &smapsinfos, const PairMatrix
     StringUtils::GetInstance().SetWidth(RAM_WIDTH_, BLANK_, false, totalTitle);
     total.push_back(totalTitle);
     total.push_back(AddKbUnit(ram.total));
-    result->push_back(total);
+    lineBuffer_->AppendLine(total);
 
     vector<string> free;
     string freeTitle = "Free RAM:";
@@ -323,7 +339,7 @@ void MemoryInfo::GetRamUsage(const PairMatrixGroup &smapsinfos, const PairMatrix
     free.push_back(freeTitle);
     free.push_back(AddKbUnit(ram.free));
     free.push_back(" (" + to_string(ram.cachedInfo) + " cached + " + to_string(ram.freeInfo) + " free)");
-    result->push_back(free);
+    lineBuffer_->AppendLine(free);
 
     vector<string> used;
     string usedTitle = "Used RAM:";
@@ -331,49 +347,49 @@ void MemoryInfo::GetRamUsage(const PairMatrixGroup &smapsinfos, const PairMatrix
     used.push_back(usedTitle);
     used.push_back(AddKbUnit(ram.used));
     used.push_back(" (" + to_string(ram.totalPss) + " total pss + " + to_string(ram.kernelUsed) + " kernel)");
-    result->push_back(used);
+    lineBuffer_->AppendLine(used);
 
     vector<string> lost;
     string lostTitle = "Lost RAM:";
     StringUtils::GetInstance().SetWidth(RAM_WIDTH_, BLANK_, false, lostTitle);
     lost.push_back(lostTitle);
     lost.push_back(AddKbUnit(ram.lost));
-    result->push_back(lost);
+    lineBuffer_->AppendLine(lost);
     DUMPER_HILOGD(MODULE_SERVICE, "GetRamUsage end");
 }
 
-void MemoryInfo::GetRamCategory(const PairMatrixGroup &smapsInfos, const PairMatrix &meminfos, StringMatrix result)
+void MemoryInfo::GetRamCategory(const PairMatrixGroup &smapsInfos, const PairMatrix &meminfos)
 {
     DUMPER_HILOGD(MODULE_SERVICE, "GetRamCategory begin");
     vector<string> title;
     title.push_back("Total RAM by Category:");
-    result->push_back(title);
+    lineBuffer_->AppendLine(title);
 
-    bool hardWareSuccess = GetHardWareUsage(result);
+    bool hardWareSuccess = GetHardWareUsage();
     if (!hardWareSuccess) {
         DUMPER_HILOGE(MODULE_SERVICE, "Get hardWare usage fail.\n");
     }
 
-    bool cmaSuccess = GetCMAUsage(result);
+    bool cmaSuccess = GetCMAUsage();
     if (!cmaSuccess) {
         DUMPER_HILOGE(MODULE_SERVICE, "Get CMA fail.\n");
     }
 
-    bool kernelSuccess = GetKernelUsage(meminfos, result);
+    bool kernelSuccess = GetKernelUsage(meminfos);
     if (!kernelSuccess) {
         DUMPER_HILOGE(MODULE_SERVICE, "Get kernel usage fail.\n");
     }
 
-    GetProcesses(smapsInfos, result);
+    GetProcesses(smapsInfos);
     DUMPER_HILOGD(MODULE_SERVICE, "GetRamCategory end");
 }
 
-void MemoryInfo::AddBlankLine(StringMatrix result)
+void MemoryInfo::AddBlankLine()
 {
     DUMPER_HILOGD(MODULE_SERVICE, "AddBlankLine begin");
     vector<string> blank;
     blank.push_back("\n");
-    result->push_back(blank);
+    lineBuffer_->AppendLine(blank);
     DUMPER_HILOGD(MODULE_SERVICE, "AddBlankLine end");
 }
 
@@ -561,85 +577,77 @@ void MemoryInfo::GetMemProcessGroup(const vector<int> &pids, PairMatrixGroup &re
     DUMPER_HILOGD(MODULE_SERVICE, "GetMemProcessGroup end");
 }
 
-void MemoryInfo::MemUsageToMatrix(const vector<MemInfoData::MemUsage> &memInfos, StringMatrix result)
+DumpTable::Column MemoryInfo::MemUsageColumn(const string &name, DumpTable::ColumnType type, const string &title,
+    int width, const string &unit)
 {
-    DUMPER_HILOGD(MODULE_SERVICE, "MemUsageToMatrix begin");
-    for (auto memUsage : memInfos) {
-        vector<string> strs;
-        string pid = to_string(memUsage.pid);
-        StringUtils::GetInstance().SetWidth(PID_WIDTH_, BLANK_, true, pid);
-        strs.push_back(pid);
+    string header = title;
+    StringUtils::GetInstance().SetWidth(width, BLANK_, true, header);
+    return { name, type, header, "", unit, static_cast<size_t>(width), true };
+}
 
+shared_ptr<DumpTable> MemoryInfo::CreateMemUsageTable(const vector<MemInfoData::MemUsage> &memInfos)
+{
+    DUMPER_HILOGD(MODULE_SERVICE, "CreateMemUsageTable begin");
+    auto table = make_shared<DumpTable>();
+    const string &kbUnit = MemoryUtil::GetInstance().KB_UNIT_;
+    table->AddColumn(MemUsageColumn("pid", DumpTable::COLUMN_UINT, "PID", PID_WIDTH_, ""));
+    table->AddColumn(MemUsageColumn("name", DumpTable::COLUMN_STRING, "Name", NAME_WIDTH_, ""));
+    table->AddColumn(MemUsageColumn("pss_kb", DumpTable::COLUMN_UINT, "Total PSS", KB_WIDTH_, kbUnit));
+    table->AddColumn(MemUsageColumn("vss_kb", DumpTable::COLUMN_UINT, "Total VSS", KB_WIDTH_, kbUnit));
+    table->AddColumn(MemUsageColumn("rss_kb", DumpTable::COLUMN_UINT, "Total RSS", KB_WIDTH_, kbUnit));
+    table->AddColumn(MemUsageColumn("uss_kb", DumpTable::COLUMN_UINT, "Total USS", KB_WIDTH_, kbUnit));
+    for (const auto &memUsage : memInfos) {
+        size_t row = table->AddRow();
+        table->SetValue(row, MEM_USAGE_PID, static_cast<uint64_t>(memUsage.pid));
         string name = memUsage.name;
         StringUtils::GetInstance().ReplaceAll(name, " ", "");
-        StringUtils::GetInstance().SetWidth(NAME_WIDTH_, BLANK_, true, name);
-        strs.push_back(name);
-
-        uint64_t pss = memUsage.pss;
-        string totalPss = AddKbUnit(pss);
-        StringUtils::GetInstance().SetWidth(KB_WIDTH_, BLANK_, true, totalPss);
-        strs.push_back(totalPss);
-
-        uint64_t vss = memUsage.vss;
-        string totalVss = AddKbUnit(vss);
-        StringUtils::GetInstance().SetWidth(KB_WIDTH_, BLANK_, true, totalVss);
-        strs.push_back(totalVss);
-
-        uint64_t rss = memUsage.rss;
-        string totalRss = AddKbUnit(rss);
-        StringUtils::GetInstance().SetWidth(KB_WIDTH_, BLANK_, true, totalRss);
-        strs.push_back(totalRss);
+        table->SetString(row, MEM_USAGE_NAME, name);
+        table->SetValue(row, MEM_USAGE_PSS, memUsage.pss);
+        table->SetValue(row, MEM_USAGE_VSS, memUsage.vss);
+        table->SetValue(row, MEM_USAGE_RSS, memUsage.rss);
+        table->SetValue(row, MEM_USAGE_USS, memUsage.uss);
+    }
+    DUMPER_HILOGD(MODULE_SERVICE, "CreateMemUsageTable end");
+    return table;
+}
 
-        uint64_t uss = memUsage.uss;
-        string totalUss = AddKbUnit(uss);
-        StringUtils::GetInstance().SetWidth(KB_WIDTH_, BLANK_, true, totalUss);
-        strs.push_back(totalUss);
+void MemoryInfo::AddMemUsageTable(const shared_ptr<DumpTable> &table)
+{
+    lineBuffer_->AppendTable(table);
+}
 
-        result->emplace_back(strs);
+void MemoryInfo::AddMemPressure()
+{
+    vector<string> lines;
+    if (!DumpPsiUtil::GetInstance().GetPsiLines(DumpPsiUtil::PSI_MEMORY, lines)) {
+        return;
+    }
+    for (const auto &line : lines) {
+        vector<string> pressure;
+        pressure.push_back(line);
+        lineBuffer_->AppendLine(pressure);
     }
-    DUMPER_HILOGD(MODULE_SERVICE, "MemUsageToMatrix end");
+    AddBlankLine();
 }
 
-void MemoryInfo::AddMemByProcessTitle(StringMatrix result)
+void MemoryInfo::AddMemByProcessTitle()
 {
     DUMPER_HILOGD(MODULE_SERVICE, "AddMemByProcessTitle begin");
     vector<string> process;
     string processTitle = "Total Memory Usage by Process:";
     process.push_back(processTitle);
-    result->push_back(process);
-
-    vector<string> title;
-    string pid = "PID";
-    StringUtils::GetInstance().SetWidth(PID_WIDTH_, BLANK_, true, pid);
-    title.push_back(pid);
-
-    string name = "Name";
-    StringUtils::GetInstance().SetWidth(NAME_WIDTH_, BLANK_, true, name);
-    title.push_back(name);
-
-    string totalPss = "Total PSS";
-    StringUtils::GetInstance().SetWidth(KB_WIDTH_, BLANK_, true, totalPss);
-    title.push_back(totalPss);
-
-    string totalVss = "Total VSS";
-    StringUtils::GetInstance().SetWidth(KB_WIDTH_, BLANK_, true, totalVss);
-    title.push_back(totalVss);
-
-    string totalRss = "Total RSS";
-    StringUtils::GetInstance().SetWidth(KB_WIDTH_, BLANK_, true, totalRss);
-    title.push_back(totalRss);
-
-    string totalUss = "Total USS";
-    StringUtils::GetInstance().SetWidth(KB_WIDTH_, BLANK_, true, totalUss);
-    title.push_back(totalUss);
-
-    result->push_back(title);
+    lineBuffer_->AppendLine(process);
+    // the header of the columns is shown by the table of processes.
     DUMPER_HILOGD(MODULE_SERVICE, "AddMemByProcessTitle end");
 }
 
-DumpStatus MemoryInfo::GetMemoryInfoNoPid(StringMatrix result)
+DumpStatus MemoryInfo::GetMemoryInfoNoPid(const shared_ptr<DumpLineBuffer> &lines)
 {
     DUMPER_HILOGD(MODULE_SERVICE, "GetMemoryInfoNoPid begin");
+    if (lines == nullptr) {
+        return DUMP_FAIL;
+    }
+    lineBuffer_ = lines;
     if (!getPidDone_) {
         pidSuccess_ = GetPids();
         getPidDone_ = true;
@@ -650,7 +658,8 @@ DumpStatus MemoryInfo::GetMemoryInfoNoPid(StringMatrix result)
     }
 
     if (!addMemProcessTitle_) {
-        AddMemByProcessTitle(result);
+        AddMemPressure();
+        AddMemByProcessTitle();
         addMemProcessTitle_ = true;
         return DUMP_MORE_DATA;
     }
@@ -659,8 +668,12 @@ DumpStatus MemoryInfo::GetMemoryInfoNoPid(StringMatrix result)
     if (!memProcessDone_) {
         vector<MemInfoData::MemUsage> memUsages;
         GetMemProcessGroup(pids_, pairMatrixGroup, memUsages);
-        if (memUsages.size() > 0) {
-            MemUsageToMatrix(memUsages, result);
+        // groups are parts of one table, its header is shown once.
+        if ((memUsages.size() > 0) || !memUsageHeaderShown_) {
+            auto table = CreateMemUsageTable(memUsages);
+            table->SetHeaderVisible(!memUsageHeaderShown_);
+            memUsageHeaderShown_ = true;
+            AddMemUsageTable(table);
         }
         MemoryUtil::GetInstance().ClacTotalByGroup(pairMatrixGroup, smapsResult_);
         return DUMP_MORE_DATA;
@@ -673,43 +686,29 @@ DumpStatus MemoryInfo::GetMemoryInfoNoPid(StringMatrix result)
         return DUMP_FAIL;
     }
 
-    GetSortedMemoryInfoNoPid(result);
-    AddBlankLine(result);
-    GetPssTotal(smapsResult_, result);
-    AddBlankLine(result);
+    GetSortedMemoryInfoNoPid();
+    AddBlankLine();
+    GetPssTotal(smapsResult_);
+    AddBlankLine();
 
-    GetRamUsage(smapsResult_, meminfoResult, result);
-    AddBlankLine(result);
+    GetRamUsage(smapsResult_, meminfoResult);
+    AddBlankLine();
 
-    GetRamCategory(smapsResult_, meminfoResult, result);
+    GetRamCategory(smapsResult_, meminfoResult);
     DUMPER_HILOGD(MODULE_SERVICE, "GetMemoryInfoNoPid end");
     return DUMP_OK;
 }
 
-void MemoryInfo::GetSortedMemoryInfoNoPid(StringMatrix result)
+void MemoryInfo::GetSortedMemoryInfoNoPid()
 {
     DUMPER_HILOGD(MODULE_SERVICE, "GetSortedMemoryInfoNoPid begin");
-    AddBlankLine(result);
-    AddMemByProcessTitle(result);
-
-    std::sort(memUsages_.begin(), memUsages_.end(),
-        [] (MemInfoData::MemUsage &left, MemInfoData::MemUsage &right) {
-        if (right.pss != left.pss) {
-            return right.pss < left.pss;
-        }
-        if (right.vss != left.vss) {
-            return right.vss < left.vss;
-        }
-        if (right.rss != left.rss) {
-            return right.rss < left.rss;
-        }
-        if (right.uss != left.uss) {
-            return right.uss < left.uss;
-        }
-        return right.pid < left.pid;
-    });
+    AddBlankLine();
+    AddMemByProcessTitle();
 
-    MemUsageToMatrix(memUsages_, result);
+    auto table = CreateMemUsageTable(memUsages_);
+    table->Sort({{MEM_USAGE_PSS, true}, {MEM_USAGE_VSS, true}, {MEM_USAGE_RSS, true}, {MEM_USAGE_USS, true},
+        {MEM_USAGE_PID, true}});
+    AddMemUsageTable(table);
 
     memUsages_.clear();
     DUMPER_HILOGD(MODULE_SERVICE, "GetSortedMemoryInfoNoPid end");
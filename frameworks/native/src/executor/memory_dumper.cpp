@@ -33,22 +33,26 @@ DumpStatus MemoryDumper::PreExecute(const shared_ptr<DumperParameter> &parameter
 {
     pid_ = parameter->GetOpts().memPid_;
     DUMPER_HILOGD(MODULE_SERVICE, "MemoryDumper pid:%d\n", pid_);
-    dumpDatas_ = dumpDatas;
+    lineBuffer_ = parameter->GetLineBuffer();
+    lineBuffer_->MoveFrom(*dumpDatas);
     return DumpStatus::DUMP_OK;
 }
 
 DumpStatus MemoryDumper::Execute()
 {
-    if (dumpDatas_ != nullptr && memoryInfo_ != nullptr) {
+    if (lineBuffer_ != nullptr && memoryInfo_ != nullptr) {
         if (pid_ >= 0) {
-            bool success = memoryInfo_->GetMemoryInfoByPid(pid_, dumpDatas_);
+            bool success = memoryInfo_->GetMemoryInfoByPid(pid_, lineBuffer_);
             if (success) {
                 status_ = DumpStatus::DUMP_OK;
             } else {
                 status_ = DumpStatus::DUMP_FAIL;
             }
         } else {
-            status_ = memoryInfo_->GetMemoryInfoNoPid(dumpDatas_);
+            // groups of processes are dumped until the chunk budget is reached.
+            do {
+                status_ = memoryInfo_->GetMemoryInfoNoPid(lineBuffer_);
+            } while ((status_ == DumpStatus::DUMP_MORE_DATA) && !IsChunkFull());
         }
     }
 
@@ -14,6 +14,9 @@
  */
 #include "executor/sa_dumper.h"
 #include <cstdio>
+#include <fcntl.h>
+#include <map>
+#include <mutex>
 #include <thread>
 #include <unistd.h>
 #include "dump_utils.h"
@@ -23,11 +26,14 @@ namespace OHOS {
 namespace HiviewDFX {
 namespace {
 const int PIPE_LENGTH = 2;
-const int PIPE_INIT = 0;
 const int PIPE_READ = 0;
 const int PIPE_WRITE = 1;
 const int LINE_LENGTH = 256;
 const char *SEPARATOR_TEMPLATE = "\n----------------------------------%s---------------------------------\n";
+const char *BUSY_STR = "busy, an earlier dump has not returned";
+// a Dump thread outliving the deadline is left behind, these bound how many a wedged ability keeps.
+const uint32_t MAX_DUMP_THREADS = 16;
+const uint32_t MAX_DUMP_THREADS_PER_ABILITY = 2;
 
 using StringMatrix = std::shared_ptr<std::vector<std::vector<std::string>>>;
 
@@ -53,89 +59,50 @@ private:
     std::string string_;
 };
 
-// MatrixWriter
-class MatrixWriter {
+// Dump threads still running in the process, by ability id.
+class DumpThreads {
 public:
-    explicit MatrixWriter(StringMatrix Data) : spData_(Data)
+    static bool Acquire(int id)
     {
-    }
-
-public:
-    void WriteLine(const char *Line)
-    {
-        if (spData_) {
-            std::vector<std::string> lines;
-            lines.push_back(Line);
-            spData_->push_back(lines);
-        } else {
-            printf("%s\n", Line);
-        }
-    }
-
-private:
-    StringMatrix spData_;
-};
-
-// PipeReader
-class PipeReader {
-public:
-    PipeReader(int Id, StringMatrix Data) : id_(Id), spData_(Data)
-    {
-        fds_[PIPE_READ] = PIPE_INIT;
-        fds_[PIPE_WRITE] = PIPE_INIT;
-        pipe(fds_);
-    }
-    ~PipeReader()
-    {
-        if (wt_.joinable()) {
-            wt_.join();
+        DumpThreads &threads = GetInstance();
+        std::lock_guard<std::mutex> lock(threads.mutex_);
+        uint32_t &count = threads.counts_[id];
+        if ((threads.total_ >= MAX_DUMP_THREADS) || (count >= MAX_DUMP_THREADS_PER_ABILITY)) {
+            if (count == 0) {
+                threads.counts_.erase(id);
+            }
+            return false;
         }
-        close(fds_[PIPE_READ]);
-        close(fds_[PIPE_WRITE]);
+        count++;
+        threads.total_++;
+        return true;
     }
 
-public:
-    int GetWritePipe()
-    {
-        return fds_[PIPE_WRITE];
-    }
-    void Run()
+    static void Release(int id)
     {
-        wt_ = std::thread(Execute, id_, fds_[PIPE_READ], spData_);
-    }
-    void Stop()
-    {
-        close(fds_[PIPE_WRITE]);
-    }
-    static void Execute(int id, int fd, StringMatrix Data)
-    {
-        char *buff = (char *)malloc(LINE_LENGTH);
-        if (buff == nullptr) {
+        DumpThreads &threads = GetInstance();
+        std::lock_guard<std::mutex> lock(threads.mutex_);
+        auto it = threads.counts_.find(id);
+        if ((it == threads.counts_.end()) || (threads.total_ == 0)) {
             return;
         }
-        FILE *fp = fdopen(fd, "r");
-        if (fp != nullptr) {
-            size_t size = LINE_LENGTH;
-            for (int i = 1;; ++i) {
-                int len = getline(&buff, &size, fp);
-                if (len <= 0) {
-                    break;
-                }
-                if (buff[--len] == '\n') {
-                    buff[len] = 0;
-                }
-                MatrixWriter(Data).WriteLine(buff);
-            }
-            fclose(fp);
+        if (--(it->second) == 0) {
+            threads.counts_.erase(it);
         }
-        free(buff);
+        threads.total_--;
     }
 
 private:
-    int id_;
-    StringMatrix spData_;
-    int fds_[PIPE_LENGTH];
-    std::thread wt_;
+    static DumpThreads &GetInstance()
+    {
+        // never destroyed, detached threads may still release at exit.
+        static DumpThreads *threads = new DumpThreads();
+        return *threads;
+    }
+
+    std::mutex mutex_;
+    std::map<int, uint32_t> counts_;
+    uint32_t total_ = 0;
 };
 } // namespace
 
@@ -145,11 +112,21 @@ SADumper::SADumper(void)
 
 SADumper::~SADumper(void)
 {
+    ClosePipe();
 }
 
 DumpStatus SADumper::PreExecute(const std::shared_ptr<DumperParameter> &parameter, StringMatrix dump_datas)
 {
-    result_ = dump_datas;
+    // lines are read into the line buffer, after the rows already in the matrix.
+    lineBuffer_ = parameter->GetLineBuffer();
+    lineBuffer_->MoveFrom(*dump_datas);
+    // run again after the output of a chunk, the abilities left go on.
+    if (started_) {
+        return DumpStatus::DUMP_OK;
+    }
+    started_ = true;
+    timedOut_ = false;
+    nextName_ = 0;
     names_ = ptrDumpCfg_->args_->GetNameList();
     StringVector args = ptrDumpCfg_->args_->GetArgList();
     if (!args.empty() && names_.size() == 1) {
@@ -174,38 +151,104 @@ DumpStatus SADumper::GetData(const std::string &name, const sptr<ISystemAbilityM
     (void)sprintf_s(line, sizeof(line), SEPARATOR_TEMPLATE,
                     DumpUtils::ConvertSaIdToSaName(name).c_str());
 
-    MatrixWriter(result_).WriteLine(line);
-    PipeReader reader(id, result_);
-    reader.Run();
-    if (sa->Dump(reader.GetWritePipe(), args_) != ERR_OK) {
-        DUMPER_HILOGD(MODULE_SERVICE, "system ability:%{public}s dump fail!\n", name.c_str());
+    lineBuffer_->AppendCell(line);
+    lineBuffer_->EndLine();
+    // an ability still stuck in the Dump of an earlier request would only block this one too.
+    if (!DumpThreads::Acquire(id)) {
+        DUMPER_HILOGE(MODULE_SERVICE, "system ability:%{public}s skipped, earlier dump running\n", name.c_str());
+        lineBuffer_->AppendCell(BUSY_STR);
+        lineBuffer_->EndLine();
+        return DumpStatus::DUMP_FAIL;
+    }
+    int fds[PIPE_LENGTH] = { -1, -1 };
+    if (pipe2(fds, O_CLOEXEC) != 0) {
+        DUMPER_HILOGE(MODULE_SERVICE, "system ability:%{public}s pipe fail!\n", name.c_str());
+        DumpThreads::Release(id);
+        return DumpStatus::DUMP_FAIL;
     }
-    reader.Stop();
+    // Dump is a blocking IPC, it runs on its own thread, which is left behind if it outlives the deadline.
+    int writeFd = fds[PIPE_WRITE];
+    U16StringVector args = args_;
+    std::thread([sa, writeFd, args, name, id]() {
+        if (sa->Dump(writeFd, args) != ERR_OK) {
+            DUMPER_HILOGD(MODULE_SERVICE, "system ability:%{public}s dump fail!\n", name.c_str());
+        }
+        DumpThreads::Release(id);
+        close(writeFd);
+    }).detach();
+    readFd_ = fds[PIPE_READ];
+    readName_ = name;
+    reader_.Reset(readFd_);
     return DumpStatus::DUMP_OK;
 }
 
-DumpStatus SADumper::Execute()
+bool SADumper::OpenNextDump()
 {
     sptr<ISystemAbilityManager> sam = SystemAbilityManagerClient::GetInstance().GetSystemAbilityManager();
     if (sam == nullptr) {
         DUMPER_HILOGD(MODULE_SERVICE, "get samgr fail!");
-        return DumpStatus::DUMP_FAIL;
+        return false;
     }
     if (names_.empty()) {
         U16StringVector vct = sam->ListSystemAbilities();
         std::transform(vct.begin(), vct.end(), std::back_inserter(names_), Str16ToStr8);
     }
-    for (size_t i = 0; i < names_.size(); ++i) {
-        if (GetData(names_[i], sam) != DumpStatus::DUMP_OK) {
-            DUMPER_HILOGD(MODULE_SERVICE, "system ability:%{public}s execute fail!\n", names_[i].c_str());
+    // the abilities after a timeout are not dumped, their Dump could only block as well.
+    while (!timedOut_ && !IsCanceled() && (nextName_ < names_.size())) {
+        const std::string &name = names_[nextName_++];
+        if (GetData(name, sam) == DumpStatus::DUMP_OK) {
+            return true;
         }
+        DUMPER_HILOGD(MODULE_SERVICE, "system ability:%{public}s execute fail!\n", name.c_str());
     }
-    return DumpStatus::DUMP_OK;
+    return false;
+}
+
+void SADumper::ReadDumpLine()
+{
+    const char *data = nullptr;
+    size_t size = 0;
+    DumpLineReader::Result result = reader_.ReadLine(GetTimeRemain(), [this] { return IsCanceled(); }, data, size);
+    if (result == DumpLineReader::READ_LINE) {
+        lineBuffer_->AppendCell(data, size);
+        lineBuffer_->EndLine();
+        return;
+    }
+    if (result == DumpLineReader::READ_TIMEOUT) {
+        DUMPER_HILOGE(MODULE_SERVICE, "system ability:%{public}s dump timeout!\n", readName_.c_str());
+        lineBuffer_->AppendCell(GetTimeoutStr());
+        lineBuffer_->EndLine();
+        timedOut_ = true;
+    }
+    ClosePipe();
+}
+
+void SADumper::ClosePipe()
+{
+    reader_.Reset(-1);
+    if (readFd_ >= 0) {
+        close(readFd_);
+        readFd_ = -1;
+    }
+}
+
+DumpStatus SADumper::Execute()
+{
+    // the ability being dumped is read until its end, then the next one is started.
+    do {
+        if ((readFd_ < 0) && !OpenNextDump()) {
+            moreData_ = false;
+            return DumpStatus::DUMP_OK;
+        }
+        ReadDumpLine();
+    } while (!IsChunkFull());
+    moreData_ = true;
+    return DumpStatus::DUMP_MORE_DATA;
 }
 
 DumpStatus SADumper::AfterExecute()
 {
-    return DumpStatus::DUMP_OK;
+    return moreData_ ? DumpStatus::DUMP_MORE_DATA : DumpStatus::DUMP_OK;
 }
 } // namespace HiviewDFX
 } // namespace OHOS
@@ -0,0 +1,204 @@
+/*
+ * Copyright (C) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "executor/sched_dumper.h"
+#include <algorithm>
+#include <chrono>
+#include <cinttypes>
+#include <thread>
+#include "datetime_ex.h"
+#include "securec.h"
+namespace OHOS {
+namespace HiviewDFX {
+const int SchedDumper::SCHED_STAT_LENGTH = 256;
+const uint64_t SchedDumper::NS_PER_US = 1000;
+const int SchedDumper::TASK_SAMPLE_INTERVAL = 500; // ms
+
+SchedDumper::SchedDumper()
+{
+}
+
+SchedDumper::~SchedDumper()
+{
+}
+
+DumpStatus SchedDumper::PreExecute(const std::shared_ptr<DumperParameter> &parameter, StringMatrix dumpDatas)
+{
+    DUMPER_HILOGD(MODULE_COMMON, "debug|SchedDumper PreExecute");
+    dumpSchedDatas_ = dumpDatas;
+    schedStatPid_ = (parameter->GetOpts()).schedStatPid_;
+    deltas_.clear();
+    return DumpStatus::DUMP_OK;
+}
+
+DumpStatus SchedDumper::Execute()
+{
+    DUMPER_HILOGD(MODULE_COMMON, "debug|SchedDumper Execute");
+    if (dumpSchedDatas_ == nullptr) {
+        return DumpStatus::DUMP_FAIL;
+    }
+    if (schedStatPid_ != -1) {
+        return DumpTaskSchedStat();
+    }
+    return DumpProcSchedStat();
+}
+
+DumpStatus SchedDumper::AfterExecute()
+{
+    deltas_.clear();
+    return DumpStatus::DUMP_OK;
+}
+
+DumpStatus SchedDumper::DumpProcSchedStat()
+{
+    DumpCpuInfoUtil::GetInstance().WaitCpuInfoWindow();
+    std::vector<std::shared_ptr<ProcInfo>> curProcs;
+    if (!DumpCpuInfoUtil::GetInstance().GetLatestProcInfo(curProcs)) {
+        DUMPER_HILOGE(MODULE_COMMON, "Get current process info failed!.");
+        return DumpStatus::DUMP_FAIL;
+    }
+    uint64_t curTick = static_cast<uint64_t>(GetTickCount());
+
+    std::vector<std::shared_ptr<ProcInfo>> oldProcs;
+    uint64_t oldTick = 0;
+    DumpCpuInfoUtil::GetInstance().GetOldProcInfo(oldProcs, oldTick);
+    if (oldProcs.empty() || (oldTick == 0) || (oldTick > curTick)) {
+        // the background sampler has nothing yet, take our own window.
+        oldProcs.swap(curProcs);
+        oldTick = curTick;
+        std::this_thread::sleep_for(std::chrono::milliseconds(TASK_SAMPLE_INTERVAL));
+        if (!DumpCpuInfoUtil::GetInstance().GetCurProcInfo(curProcs)) {
+            DUMPER_HILOGE(MODULE_COMMON, "Get current process info failed!.");
+            return DumpStatus::DUMP_FAIL;
+        }
+        curTick = static_cast<uint64_t>(GetTickCount());
+    }
+
+    CreateSchedDeltas(curProcs, oldProcs);
+    AddStrLineToDumpInfo("Scheduler latency of processes in the last " + std::to_string(curTick - oldTick) +
+        " ms (main thread of each process):");
+    DumpSchedDeltas("PID");
+    return DumpStatus::DUMP_OK;
+}
+
+DumpStatus SchedDumper::DumpTaskSchedStat()
+{
+    // /proc/<pid>/schedstat only counts the main thread, so sample every task of the process.
+    std::vector<std::shared_ptr<ProcInfo>> oldTasks;
+    if (!DumpCpuInfoUtil::GetInstance().GetCurTaskInfo(schedStatPid_, oldTasks)) {
+        DUMPER_HILOGE(MODULE_COMMON, "Get tasks of process %{public}d failed!.", schedStatPid_);
+        return DumpStatus::DUMP_FAIL;
+    }
+    uint64_t oldTick = static_cast<uint64_t>(GetTickCount());
+    std::this_thread::sleep_for(std::chrono::milliseconds(TASK_SAMPLE_INTERVAL));
+    std::vector<std::shared_ptr<ProcInfo>> curTasks;
+    if (!DumpCpuInfoUtil::GetInstance().GetCurTaskInfo(schedStatPid_, curTasks)) {
+        DUMPER_HILOGE(MODULE_COMMON, "Get tasks of process %{public}d failed!.", schedStatPid_);
+        return DumpStatus::DUMP_FAIL;
+    }
+    uint64_t curTick = static_cast<uint64_t>(GetTickCount());
+
+    CreateSchedDeltas(curTasks, oldTasks);
+    SchedDelta total = {
+        .pid = std::to_string(schedStatPid_), .comm = "Total", .runTime = 0, .waitTime = 0, .timeslices = 0
+    };
+    for (const auto &delta : deltas_) {
+        total.runTime += delta.runTime;
+        total.waitTime += delta.waitTime;
+        total.timeslices += delta.timeslices;
+    }
+    AddStrLineToDumpInfo("Scheduler latency of threads of process " + std::to_string(schedStatPid_) +
+        " in the last " + std::to_string(curTick - oldTick) + " ms:");
+    deltas_.insert(deltas_.begin(), total);
+    DumpSchedDeltas("TID");
+    return DumpStatus::DUMP_OK;
+}
+
+void SchedDumper::CreateSchedDeltas(const std::vector<std::shared_ptr<ProcInfo>> &curInfos,
+    const std::vector<std::shared_ptr<ProcInfo>> &oldInfos)
+{
+    DumpCpuInfoUtil::ProcInfoMap oldInfoMap;
+    DumpCpuInfoUtil::BuildProcInfoMap(oldInfos, oldInfoMap);
+
+    deltas_.clear();
+    deltas_.reserve(curInfos.size());
+    for (const auto &curInfo : curInfos) {
+        SchedDelta delta = {
+            .pid = curInfo->pid, .comm = curInfo->comm,
+            .runTime = curInfo->runTime, .waitTime = curInfo->waitTime, .timeslices = curInfo->timeslices
+        };
+        auto it = oldInfoMap.find(curInfo->pid);
+        if (it != oldInfoMap.end()) {
+            delta.runTime = GetDeltaValue(curInfo->runTime, it->second->runTime);
+            delta.waitTime = GetDeltaValue(curInfo->waitTime, it->second->waitTime);
+            delta.timeslices = GetDeltaValue(curInfo->timeslices, it->second->timeslices);
+        }
+        deltas_.push_back(delta);
+    }
+    std::sort(deltas_.begin(), deltas_.end(), SortSchedDelta);
+}
+
+void SchedDumper::DumpSchedDeltas(const std::string &idTitle)
+{
+    char format[SCHED_STAT_LENGTH] = {0};
+    int ret = sprintf_s(format, SCHED_STAT_LENGTH, "    %-5s    %14s    %14s    %10s    %12s    %-15s",
+        idTitle.c_str(), "Run Time(us)", "Wait Time(us)", "Timeslices", "Avg Wait(us)", "Name");
+    if (ret < 0) {
+        return;
+    }
+    AddStrLineToDumpInfo(std::string(format));
+    for (const auto &delta : deltas_) {
+        uint64_t avgWait = (delta.timeslices != 0) ? (delta.waitTime / delta.timeslices) : 0;
+        ret = sprintf_s(format, SCHED_STAT_LENGTH,
+            "    %-5s    %14" PRIu64 "    %14" PRIu64 "    %10" PRIu64 "    %12" PRIu64 "    %-15s",
+            delta.pid.c_str(), delta.runTime / NS_PER_US, delta.waitTime / NS_PER_US, delta.timeslices,
+            avgWait / NS_PER_US, delta.comm.c_str());
+        if (ret < 0) {
+            continue;
+        }
+        AddStrLineToDumpInfo(std::string(format));
+    }
+}
+
+void SchedDumper::AddStrLineToDumpInfo(const std::string &strLine)
+{
+    std::vector<std::string> vec;
+    vec.push_back(strLine);
+    dumpSchedDatas_->push_back(vec);
+}
+
+uint64_t SchedDumper::GetDeltaValue(uint64_t curValue, uint64_t oldValue)
+{
+    // pid reused by a new process, its counters started from zero.
+    if (curValue < oldValue) {
+        return curValue;
+    }
+    return curValue - oldValue;
+}
+
+bool SchedDumper::SortSchedDelta(const SchedDelta &left, const SchedDelta &right)
+{
+    if (right.waitTime != left.waitTime) {
+        return right.waitTime < left.waitTime;
+    }
+    if (right.runTime != left.runTime) {
+        return right.runTime < left.runTime;
+    }
+    if (right.pid.length() != left.pid.length()) {
+        return right.pid.length() < left.pid.length();
+    }
+    return (right.pid.compare(left.pid) < 0);
+}
+} // namespace HiviewDFX
+} // namespace OHOS
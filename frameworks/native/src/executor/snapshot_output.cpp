@@ -0,0 +1,237 @@
+/*
+ * Copyright (C) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "executor/snapshot_output.h"
+#include <cerrno>
+#include <chrono>
+#include "util/dump_cell_utils.h"
+
+namespace OHOS {
+namespace HiviewDFX {
+namespace {
+static const char NEW_LINE_BREAKS_CHAR = '\n';
+} // namespace
+
+SnapshotOutput::SnapshotOutput()
+    : sectionWritten_(false), inTable_(false), inText_(false), headerWritten_(false)
+{
+}
+
+SnapshotOutput::~SnapshotOutput()
+{
+}
+
+DumpStatus SnapshotOutput::PreExecute(const std::shared_ptr<DumperParameter>& parameter,
+    StringMatrix dumpDatas)
+{
+    if ((parameter == nullptr) || (dumpDatas == nullptr)) {
+        DUMPER_HILOGE(MODULE_COMMON, "PreExecute error|parameter or dumpDatas is nullptr");
+        return DumpStatus::DUMP_FAIL;
+    }
+    dumpDatas_ = dumpDatas;
+    lineBuffer_ = parameter->GetLineBuffer();
+    lineBuffer_->MoveFrom(*dumpDatas_);
+    ptrReqCtl_ = parameter->getClientCallback();
+    ptrOutputWriter_ = parameter->GetOutputWriter();
+    if (!snapshot_.IsStarted()) {
+        auto now = std::chrono::system_clock::now().time_since_epoch();
+        snapshot_.Begin(static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::milliseconds>(now).count()));
+    }
+    if (!sectionWritten_ || (section_ != parameter->GetCurrentSection())) {
+        EndTable();
+        section_ = parameter->GetCurrentSection();
+        snapshot_.WriteSection(section_);
+        sectionWritten_ = true;
+        inText_ = false;
+    }
+    return DumpStatus::DUMP_OK;
+}
+
+DumpStatus SnapshotOutput::Execute()
+{
+    if ((ptrReqCtl_ == nullptr) || (lineBuffer_ == nullptr)) {
+        return DumpStatus::DUMP_OK;
+    }
+    std::vector<std::string> line;
+    size_t lineCount = lineBuffer_->GetLineCount();
+    for (size_t i = 0; i < lineCount; i++) {
+        DumpTable *table = lineBuffer_->GetTable(i);
+        if (table != nullptr) {
+            WriteTable(*table);
+            continue;
+        }
+        lineBuffer_->GetLine(i, line);
+        if (line.size() > 1) {
+            if (!DumpCellUtils::IsSeparatorRow(line)) {
+                WriteTableRow(line);
+            }
+        } else if (line.empty() || (DumpCellUtils::Trim(line[0]).empty())) {
+            // a blank line ends a table, inside text it is kept.
+            if (inTable_) {
+                EndTable();
+            } else if (inText_) {
+                WriteText("");
+            }
+        } else {
+            EndTable();
+            // one cell may hold several lines, e.g. output of a command.
+            std::string text = line[0];
+            if (text.back() == NEW_LINE_BREAKS_CHAR) {
+                text.pop_back();
+            }
+            size_t start = 0;
+            for (size_t pos = text.find(NEW_LINE_BREAKS_CHAR); pos != std::string::npos;
+                pos = text.find(NEW_LINE_BREAKS_CHAR, start)) {
+                WriteText(text.substr(start, pos - start));
+                start = pos + 1;
+            }
+            WriteText(text.substr(start));
+        }
+        if (snapshot_.GetBuffer().size() >= DumpFdWriter::DEFAULT_HIGH_WATER) {
+            Write();
+        }
+    }
+    Write();
+    // end of section.
+    if (ptrOutputWriter_ != nullptr) {
+        ptrOutputWriter_->FlushSection();
+        if (ptrOutputWriter_->IsBroken() && (ptrOutputWriter_->GetError() == EPIPE)) {
+            // the client has gone, stop the rest of request.
+            DUMPER_HILOGE(MODULE_COMMON, "error|client output is closed, cancel request");
+            ptrReqCtl_->Cancel();
+        }
+    }
+    return DumpStatus::DUMP_OK;
+}
+
+DumpStatus SnapshotOutput::AfterExecute()
+{
+    if (dumpDatas_ != nullptr) {
+        dumpDatas_->clear();
+    }
+    if (lineBuffer_ != nullptr) {
+        lineBuffer_->Clear();
+    }
+    return DumpStatus::DUMP_OK;
+}
+
+void SnapshotOutput::Reset()
+{
+    if (snapshot_.IsStarted()) {
+        EndTable();
+        snapshot_.End();
+        Write();
+    }
+    snapshot_.GetBuffer().clear();
+    sectionWritten_ = false;
+    section_.clear();
+    inText_ = false;
+    dumpDatas_ = nullptr;
+    lineBuffer_ = nullptr;
+    ptrReqCtl_ = nullptr;
+    ptrOutputWriter_ = nullptr;
+    HidumperExecutor::Reset();
+}
+
+void SnapshotOutput::WriteTableRow(const std::vector<std::string> &line)
+{
+    if (!inTable_) {
+        inTable_ = true;
+        inText_ = false;
+        headerWritten_ = false;
+    }
+    if (headerWritten_) {
+        snapshot_.WriteRow(line);
+        return;
+    }
+    // rows before the first one holding a number are the header.
+    if (!DumpCellUtils::HasNumber(line)) {
+        header_.push_back(line);
+        return;
+    }
+    WriteHeader();
+    snapshot_.WriteRow(line);
+}
+
+void SnapshotOutput::WriteHeader()
+{
+    snapshot_.BeginTable(static_cast<uint32_t>(header_.size()));
+    for (const auto &row : header_) {
+        snapshot_.WriteRow(row);
+    }
+    header_.clear();
+    headerWritten_ = true;
+}
+
+void SnapshotOutput::WriteTable(const DumpTable &table)
+{
+    EndTable();
+    inText_ = false;
+    size_t columnCount = table.GetColumnCount();
+    snapshot_.BeginTable(1);
+    snapshot_.BeginRow(columnCount);
+    for (size_t column = 0; column < columnCount; column++) {
+        snapshot_.AppendStringCell(table.GetColumn(column).name);
+    }
+    snapshot_.EndRow();
+    size_t rowCount = table.GetRowCount();
+    for (size_t row = 0; row < rowCount; row++) {
+        snapshot_.BeginRow(columnCount);
+        for (size_t column = 0; column < columnCount; column++) {
+            DumpTable::ColumnType type = table.GetColumn(column).type;
+            if (type == DumpTable::COLUMN_STRING) {
+                snapshot_.AppendStringCell(table.GetString(row, column));
+            } else {
+                snapshot_.AppendIntCell(column, static_cast<int64_t>(table.GetValue(row, column)),
+                    type == DumpTable::COLUMN_PERCENT);
+            }
+        }
+        snapshot_.EndRow();
+        if (snapshot_.GetBuffer().size() >= DumpFdWriter::DEFAULT_HIGH_WATER) {
+            Write();
+        }
+    }
+}
+
+void SnapshotOutput::EndTable()
+{
+    if (!inTable_) {
+        return;
+    }
+    if (!headerWritten_) {
+        WriteHeader();
+    }
+    inTable_ = false;
+    headerWritten_ = false;
+}
+
+void SnapshotOutput::WriteText(const std::string &text)
+{
+    snapshot_.WriteText(text);
+    inText_ = true;
+}
+
+void SnapshotOutput::Write()
+{
+    std::string &buffer = snapshot_.GetBuffer();
+    if (buffer.empty()) {
+        return;
+    }
+    if ((ptrOutputWriter_ != nullptr) && !ptrOutputWriter_->IsBroken()) {
+        ptrOutputWriter_->Append(buffer);
+    }
+    buffer.clear();
+}
+} // namespace HiviewDFX
+} // namespace OHOS
@@ -0,0 +1,78 @@
+/*
+ * Copyright (C) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "executor/tee_output.h"
+
+namespace OHOS {
+namespace HiviewDFX {
+TeeOutput::TeeOutput(const std::vector<std::shared_ptr<HidumperExecutor>> &sinks)
+    : sinks_(sinks), ready_(sinks.size(), false)
+{
+}
+
+TeeOutput::~TeeOutput()
+{
+}
+
+DumpStatus TeeOutput::PreExecute(const std::shared_ptr<DumperParameter>& parameter,
+    StringMatrix dumpDatas)
+{
+    if ((parameter == nullptr) || (dumpDatas == nullptr)) {
+        DUMPER_HILOGE(MODULE_COMMON, "PreExecute error|parameter or dumpDatas is nullptr");
+        return DumpStatus::DUMP_FAIL;
+    }
+    bool anyReady = false;
+    for (size_t i = 0; i < sinks_.size(); i++) {
+        sinks_[i]->SetDumpConfig(ptrDumpCfg_);
+        // a failed sink, e.g. a full disk for the archive, doesn't stop the others.
+        ready_[i] = (sinks_[i]->DoPreExecute(parameter, dumpDatas) == DumpStatus::DUMP_OK);
+        if (!ready_[i]) {
+            DUMPER_HILOGE(MODULE_COMMON, "PreExecute error|sink %{public}zu failed", i);
+        }
+        anyReady = anyReady || ready_[i];
+    }
+    return anyReady ? DumpStatus::DUMP_OK : DumpStatus::DUMP_FAIL;
+}
+
+DumpStatus TeeOutput::Execute()
+{
+    for (size_t i = 0; i < sinks_.size(); i++) {
+        if (ready_[i] && (sinks_[i]->DoExecute() != DumpStatus::DUMP_OK)) {
+            DUMPER_HILOGE(MODULE_COMMON, "Execute error|sink %{public}zu failed", i);
+        }
+    }
+    return DumpStatus::DUMP_OK;
+}
+
+DumpStatus TeeOutput::AfterExecute()
+{
+    // sinks clear the chunk here, so all of them have written it before.
+    for (size_t i = 0; i < sinks_.size(); i++) {
+        if (ready_[i]) {
+            sinks_[i]->DoAfterExecute();
+        }
+    }
+    return DumpStatus::DUMP_OK;
+}
+
+void TeeOutput::Reset()
+{
+    for (auto &sink : sinks_) {
+        sink->Reset();
+    }
+    ready_.assign(sinks_.size(), false);
+    HidumperExecutor::Reset();
+}
+} // namespace HiviewDFX
+} // namespace OHOS
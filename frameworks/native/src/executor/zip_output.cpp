@@ -14,7 +14,6 @@
  */
 #include "executor/zip_output.h"
 #include <unistd.h>
-#include "securec.h"
 #include "dump_utils.h"
 #include "util/file_utils.h"
 #include "common/dumper_constant.h"
@@ -26,30 +25,33 @@ ZipOutput::ZipOutput() : fd_(-1)
 
 ZipOutput::~ZipOutput()
 {
-    if (fd_ >= 0) {
-        close(fd_);
-    }
+    FinishStream();
 }
 
 DumpStatus ZipOutput::PreExecute(const std::shared_ptr<DumperParameter>& parameter,
     StringMatrix dumpDatas)
 {
     mDumpDatas_ = dumpDatas;
-    if (mDumpDatas_.get() == nullptr) {
+    if ((parameter == nullptr) || (mDumpDatas_.get() == nullptr)) {
         return DumpStatus::DUMP_FAIL;
     }
+    lineBuffer_ = parameter->GetLineBuffer();
+    lineBuffer_->MoveFrom(*mDumpDatas_);
 
     // init myself once
     if (mFilePath_.empty()) {
         FileUtils().GetInstance().CreateFolder(ZIP_FOLDER);
         mFilePath_ =  parameter->GetOpts().path_;
-        srcBuffer_ = std::make_shared<CompressBuffer>();
-        destBuffer_ = std::make_shared<CompressBuffer>();
-        ClearBuffer();
         fd_= DumpUtils::FdToWrite(mFilePath_);
         if (fd_ < 0) {
             return DumpStatus::DUMP_FAIL;
         }
+        DumpCodec codec;
+        (void)DumpCodec::Parse(parameter->GetOpts().zipCodec_, codec); // checked by DumperOpts::CheckOptions
+        if (compressor_.Init(fd_, codec, DumpCompressor::GetDefaultWorkers()) != DumpStatus::DUMP_OK) {
+            LOG_DEBUG("ZipOutput::PreExecute() init compressor failed!\n");
+            return DumpStatus::DUMP_FAIL;
+        }
     }
 
     return DumpStatus::DUMP_OK;
@@ -57,127 +59,90 @@ DumpStatus ZipOutput::PreExecute(const std::shared_ptr<DumperParameter>& paramet
 
 DumpStatus ZipOutput::Execute()
 {
-    if (!mDumpDatas_.get() || (fd_ < 0)) {
-        return DumpStatus::DUMP_FAIL;
-    }
-    CompressBuffer* srcBuffer = srcBuffer_.get();
-    CompressBuffer* destBuffer = destBuffer_.get();
-    if (!srcBuffer || !destBuffer) {
+    if ((lineBuffer_ == nullptr) || (fd_ < 0) || !compressor_.IsActive()) {
         return DumpStatus::DUMP_FAIL;
     }
-    DumpCompressor compressor;
-    for (auto v_line : *(mDumpDatas_.get())) {
-        // whole line
-        std::string line;
-        for (auto v_content : v_line)  {
-            line.append(v_content);
+    static const char lineEnd = '\n';
+    DumpStatus ret = DumpStatus::DUMP_OK;
+    size_t lineCount = lineBuffer_->GetLineCount();
+    for (size_t i = 0; i < lineCount; i++) {
+        DumpTable *table = lineBuffer_->GetTable(i);
+        if (table != nullptr) {
+            ret = AppendTable(*table);
+            if (ret != DumpStatus::DUMP_OK) {
+                LOG_DEBUG("ZipOutput::Execute() compress failed!\n");
+                break;
+            }
+            continue;
         }
-        const char* content = line.c_str();
-        uint16_t content_size = strlen(content);
-        uint16_t size = strlen(content) + 1; // include \n
-        // buffer is full
-        if ((srcBuffer->offset + size) > MAX_COMPRESS_BUFFER_SIZE) {
-            // compress and write to file
-            CompressAndWriteToFd();
+        size_t cellCount = lineBuffer_->GetCellCount(i);
+        for (size_t j = 0; j < cellCount; j++) {
+            DumpLineBuffer::Cell cell = lineBuffer_->GetCell(i, j);
+            ret = compressor_.Append(cell.data, cell.size);
+            if (ret != DumpStatus::DUMP_OK) {
+                break;
+            }
         }
-        // Process big line.
-        if (size > MAX_COMPRESS_BUFFER_SIZE) {
-            CompressAndWriteToFd(); // clear buffer
-            CompressBigLine(content, size);
-            continue;
+        if (ret == DumpStatus::DUMP_OK) {
+            ret = compressor_.Append(&lineEnd, sizeof(lineEnd));
         }
-        // Add to buffer end with \n
-        if (memcpy_s(srcBuffer->content + srcBuffer->offset,
-            MAX_COMPRESS_BUFFER_SIZE - srcBuffer->offset, content, content_size) != EOK) {
-            LOG_DEBUG("ZipOutput::Execute() memcpy_s failed!\n");
-            return DumpStatus::DUMP_FAIL;
+        if (ret != DumpStatus::DUMP_OK) {
+            LOG_DEBUG("ZipOutput::Execute() compress failed!\n");
+            break;
         }
-        srcBuffer->offset = srcBuffer->offset + content_size;
-        srcBuffer->content[srcBuffer->offset] = '\n';
-        srcBuffer->offset = srcBuffer->offset + 1;
     }
-    // compress and write to file
-    CompressAndWriteToFd();
     // clear dump data.
     mDumpDatas_->clear();
-    return DumpStatus::DUMP_OK;
+    lineBuffer_->Clear();
+    return ret;
 }
 
-DumpStatus ZipOutput::CompressAndWriteToFd()
+DumpStatus ZipOutput::AfterExecute()
 {
-    CompressBuffer* srcBuffer = srcBuffer_.get();
-    CompressBuffer* destBuffer = destBuffer_.get();
-    if (!srcBuffer || !destBuffer) {
-        return DumpStatus::DUMP_FAIL;
-    }
-    DumpStatus ret = DumpStatus::DUMP_OK;
-    if (srcBuffer->offset > 0) {
-        DumpStatus ret = compressor_.Compress(srcBuffer, destBuffer);
-        if (ret == DumpStatus::DUMP_OK) {
-            if (write(fd_, destBuffer->content, destBuffer->offset) < 0) {
-                ret = DumpStatus::DUMP_FAIL;
-                LOG_DEBUG("ZipOutput::CompressAndWriteToFd() Write to FD failed!\n");
-            }
-        } else {
-            ret = DumpStatus::DUMP_FAIL;
-            LOG_DEBUG("ZipOutput::CompressAndWriteToFd() Compress failed!\n");
-        }
-        ClearBuffer();
-    }
+    // the stream stays open, later sections keep the same dictionary.
+    return DumpStatus::DUMP_OK;
+}
 
-    return ret;
+void ZipOutput::Reset()
+{
+    FinishStream();
+    mFilePath_.clear();
+    lineBuffer_ = nullptr;
+    HidumperExecutor::Reset();
 }
 
-DumpStatus ZipOutput::CompressBigLine(const char* content, uint16_t size)
+DumpStatus ZipOutput::AppendTable(const DumpTable &table)
 {
-    if (!content) {
-        return DumpStatus::DUMP_FAIL;
+    text_.clear();
+    if (table.IsHeaderVisible()) {
+        table.FormatHeader(text_);
+        text_.push_back('\n');
     }
-    CompressBuffer* srcBuffer = srcBuffer_.get();
-    CompressBuffer* destBuffer = destBuffer_.get();
-    if (!srcBuffer || !destBuffer) {
-        return DumpStatus::DUMP_FAIL;
+    size_t rowCount = table.GetRowCount();
+    for (size_t row = 0; row < rowCount; row++) {
+        table.FormatRow(row, text_);
+        text_.push_back('\n');
     }
-    DumpStatus ret = DumpStatus::DUMP_OK;
-    uint16_t remain_size = size - 1; // size include \n
-    uint16_t complete_size = 0;
-    while (remain_size > 0) {
-        uint16_t process_size = remain_size;
-        if ((srcBuffer->offset + remain_size) > MAX_COMPRESS_BUFFER_SIZE) {
-            process_size = MAX_COMPRESS_BUFFER_SIZE - srcBuffer->offset;
-        }
-        if (memcpy_s(srcBuffer->content + srcBuffer->offset,
-            MAX_COMPRESS_BUFFER_SIZE - srcBuffer->offset,
-            content + complete_size, process_size) != EOK) {
-            LOG_DEBUG("ZipOutput::CompressBigLine() memcpy_s failed!\n");
-            return DumpStatus::DUMP_FAIL;
-        }
-        srcBuffer->offset = srcBuffer->offset + process_size;
-        complete_size += process_size;
-        remain_size -= process_size;
-        CompressAndWriteToFd();
+    if (text_.empty()) {
+        return DumpStatus::DUMP_OK;
     }
-    // process \n
-    srcBuffer->content[srcBuffer->offset] = '\n';
-    srcBuffer->offset = srcBuffer->offset + 1;
-    CompressAndWriteToFd();
-    return ret;
+    return compressor_.Append(text_.data(), text_.size());
 }
 
-
-DumpStatus ZipOutput::AfterExecute()
-{
-    return DumpStatus::DUMP_OK;
-}
-
-void ZipOutput::ClearBuffer()
+DumpStatus ZipOutput::FinishStream()
 {
-    if (srcBuffer_.get()) {
-        (void)memset_s(srcBuffer_.get(), sizeof(CompressBuffer), 0, sizeof(CompressBuffer));
+    DumpStatus ret = DumpStatus::DUMP_OK;
+    if (compressor_.IsActive()) {
+        ret = compressor_.Finish();
+        if (ret != DumpStatus::DUMP_OK) {
+            LOG_DEBUG("ZipOutput::FinishStream() finish compressor failed!\n");
+        }
     }
-    if (destBuffer_.get()) {
-        (void)memset_s(destBuffer_.get(), sizeof(CompressBuffer), 0, sizeof(CompressBuffer));
+    if (fd_ >= 0) {
+        close(fd_);
+        fd_ = -1;
     }
+    return ret;
 }
 } // namespace HiviewDFX
 } // namespace OHOS
@@ -13,9 +13,7 @@
  * limitations under the License.
  */
 #include "executor/zipfolder_output.h"
-#include <unistd.h>
 #include "dump_utils.h"
-#include "file_ex.h"
 #include "directory_ex.h"
 #include "hilog_wrapper.h"
 #include "util/zip_utils.h"
@@ -23,11 +21,13 @@
 namespace OHOS {
 namespace HiviewDFX {
 namespace {
-static const int FD_UNSET = -1;
 static const char NEW_LINE_BREAKS_CHAR = '\n';
 static const std::string NEW_LINE_BREAKS_STR = "\n";
+static const std::string ENTRY_EXTENSION = ".txt";
+static const std::string ENTRY_INDEX_SPLIT = "_";
+static const size_t WRITE_BUFFER_SIZE = 64 * 1024;
 } // namespace
-ZipFolderOutput::ZipFolderOutput() : fd_(FD_UNSET)
+ZipFolderOutput::ZipFolderOutput() : entryOpened_(false)
 {
     DUMPER_HILOGD(MODULE_COMMON, "create|");
 }
@@ -35,12 +35,6 @@ ZipFolderOutput::ZipFolderOutput() : fd_(FD_UNSET)
 ZipFolderOutput::~ZipFolderOutput()
 {
     DUMPER_HILOGD(MODULE_COMMON, "release|");
-
-    if (fd_ > FD_UNSET) {
-        close(fd_);
-    }
-
-    fd_ = FD_UNSET;
 }
 
 DumpStatus ZipFolderOutput::PreExecute(const std::shared_ptr<DumperParameter>& parameter,
@@ -51,55 +45,63 @@ DumpStatus ZipFolderOutput::PreExecute(const std::shared_ptr<DumperParameter>& p
         return DumpStatus::DUMP_FAIL;
     }
     // init myself once
-    if (logDefaultPath_.empty()) {
+    if (zipWriter_ == nullptr) {
         param_ = parameter;
         auto callback = param_->getClientCallback();
         if (callback == nullptr) {
             DUMPER_HILOGE(MODULE_COMMON, "PreExecute error|callback is nullptr");
             return DumpStatus::DUMP_FAIL;
         }
-        logDefaultPath_ = callback->GetFolder() + LOG_DEFAULT;
-        fd_= DumpUtils::FdToWrite(logDefaultPath_);
+        DumpCodec codec;
+        (void)DumpCodec::Parse(param_->GetOpts().zipCodec_, codec); // checked by DumperOpts::CheckOptions
+        zipWriter_ = std::make_unique<ZipWriter>(param_->GetOpts().path_, codec);
+        if (!zipWriter_->Open()) {
+            DUMPER_HILOGE(MODULE_COMMON, "PreExecute error|open zip failed");
+            zipWriter_ = nullptr;
+            return DumpStatus::DUMP_FAIL;
+        }
     }
 
-    if (fd_ < 0) {
-        DUMPER_HILOGE(MODULE_COMMON, "PreExecute error|fd has issue");
+    if ((!entryOpened_ || (entrySection_ != parameter->GetCurrentSection())) &&
+        !OpenSectionEntry(parameter->GetCurrentSection())) {
+        DUMPER_HILOGE(MODULE_COMMON, "PreExecute error|entry has issue");
         return DumpStatus::DUMP_FAIL;
     }
 
     dumpDatas_ = dumpDatas;
+    lineBuffer_ = parameter->GetLineBuffer();
+    lineBuffer_->MoveFrom(*dumpDatas_);
     return DumpStatus::DUMP_OK;
 }
 
 DumpStatus ZipFolderOutput::Execute()
 {
-    if ((dumpDatas_ == nullptr) || (fd_ < 0)) {
-        DUMPER_HILOGE(MODULE_COMMON, "Execute error|dumpDatas or fd has issue");
+    if ((lineBuffer_ == nullptr) || !entryOpened_) {
+        DUMPER_HILOGE(MODULE_COMMON, "Execute error|dumpDatas or entry has issue");
         return DumpStatus::DUMP_FAIL;
     }
 
-    std::string outstr;
-
-    std::string line;
-    for (auto &lineItems : (*dumpDatas_)) {
-        for (auto &item : lineItems) {
-            line.append(item);
+    size_t lineCount = lineBuffer_->GetLineCount();
+    for (size_t i = 0; i < lineCount; i++) {
+        DumpTable *table = lineBuffer_->GetTable(i);
+        if (table != nullptr) {
+            if (!AppendTable(*table)) {
+                return DumpStatus::DUMP_FAIL;
+            }
+            continue;
         }
-        lineItems.clear();
-
-        if (line.empty() || (line.at(line.length() - 1) != NEW_LINE_BREAKS_CHAR)) { // No line breaks
-            line.append(NEW_LINE_BREAKS_STR);
+        size_t start = buffer_.size();
+        size_t cellCount = lineBuffer_->GetCellCount(i);
+        for (size_t j = 0; j < cellCount; j++) {
+            DumpLineBuffer::Cell cell = lineBuffer_->GetCell(i, j);
+            buffer_.append(cell.data, cell.size);
+        }
+        if (!EndBufferLine(start)) {
+            return DumpStatus::DUMP_FAIL;
         }
-
-        outstr.append(line);
-        line.clear();
     }
 
-    SaveStringToFd(fd_, outstr);
-
-    outstr.clear();
-
-    return DumpStatus::DUMP_OK;
+    return WriteBuffer() ? DumpStatus::DUMP_OK : DumpStatus::DUMP_FAIL;
 }
 
 DumpStatus ZipFolderOutput::AfterExecute()
@@ -107,32 +109,96 @@ DumpStatus ZipFolderOutput::AfterExecute()
     if (dumpDatas_ != nullptr) {
         dumpDatas_->clear();
     }
+    if (lineBuffer_ != nullptr) {
+        lineBuffer_->Clear();
+    }
 
     return DumpStatus::DUMP_OK;
 }
 
 void ZipFolderOutput::Reset()
 {
-    if (fd_ > FD_UNSET) {
-        DUMPER_HILOGD(MODULE_COMMON, "Reset debug|close");
-        close(fd_);
-    }
-    fd_ = FD_UNSET;
-
     const std::shared_ptr<RawParam> callback = (param_ == nullptr) ? nullptr : param_->getClientCallback();
-    if ((param_ != nullptr) && (callback != nullptr)) {
-        DUMPER_HILOGD(MODULE_COMMON, "Reset debug|ZipFolder");
-        auto logZipPath = param_->GetOpts().path_;
-        auto logFolder = callback->GetFolder();
-        ZipUtils::ZipFolder(logFolder, logZipPath, [callback] (int progress, int subprogress) {
+    if ((zipWriter_ != nullptr) && (callback != nullptr)) {
+        if (entryOpened_) {
+            (void)zipWriter_->CloseEntry();
+        }
+        DUMPER_HILOGD(MODULE_COMMON, "Reset debug|AppendFolder");
+        ZipUtils::AppendFolder(callback->GetFolder(), *zipWriter_, [callback] (int progress, int subprogress) {
             callback->UpdateProgress(0);
             return callback->IsCanceled();
         });
     }
 
+    zipWriter_ = nullptr; // closes the zip if AppendFolder did not
+    entryOpened_ = false;
+    entrySection_.clear();
+    entryNames_.clear();
+    buffer_.clear();
     param_ = nullptr;
+    lineBuffer_ = nullptr;
 
     HidumperExecutor::Reset();
 }
+
+bool ZipFolderOutput::OpenSectionEntry(const std::string &section)
+{
+    if (entryOpened_) {
+        (void)zipWriter_->CloseEntry();
+        entryOpened_ = false;
+    }
+
+    // a section met again after another one gets an entry of its own.
+    std::string base = section.empty() ? LOG_DEFAULT : (section + ENTRY_EXTENSION);
+    std::string name = base;
+    for (int index = 1; entryNames_.count(name) > 0; index++) {
+        name = base.substr(0, base.length() - ENTRY_EXTENSION.length()) + ENTRY_INDEX_SPLIT +
+            std::to_string(index) + ENTRY_EXTENSION;
+    }
+    entryNames_.insert(name);
+
+    entryOpened_ = zipWriter_->OpenEntry(name);
+    entrySection_ = section;
+    DUMPER_HILOGD(MODULE_COMMON, "OpenSectionEntry|name=[%{public}s], ret=%{public}d", name.c_str(), entryOpened_);
+    return entryOpened_;
+}
+
+bool ZipFolderOutput::AppendTable(const DumpTable &table)
+{
+    if (table.IsHeaderVisible()) {
+        size_t start = buffer_.size();
+        table.FormatHeader(buffer_);
+        if (!EndBufferLine(start)) {
+            return false;
+        }
+    }
+    size_t rowCount = table.GetRowCount();
+    for (size_t row = 0; row < rowCount; row++) {
+        size_t start = buffer_.size();
+        table.FormatRow(row, buffer_);
+        if (!EndBufferLine(start)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool ZipFolderOutput::EndBufferLine(size_t start)
+{
+    if ((buffer_.size() == start) || (buffer_.back() != NEW_LINE_BREAKS_CHAR)) { // No line breaks
+        buffer_.append(NEW_LINE_BREAKS_STR);
+    }
+    return (buffer_.size() < WRITE_BUFFER_SIZE) || WriteBuffer();
+}
+
+bool ZipFolderOutput::WriteBuffer()
+{
+    bool ret = zipWriter_->WriteEntry(buffer_.data(), buffer_.size());
+    buffer_.clear();
+    if (!ret) {
+        DUMPER_HILOGE(MODULE_COMMON, "WriteBuffer error|write entry failed");
+    }
+    return ret;
+}
 } // namespace HiviewDFX
 } // namespace OHOS
@@ -0,0 +1,29 @@
+/*
+ * Copyright (C) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "factory/json_output_factory.h"
+#include "executor/json_output.h"
+
+namespace OHOS {
+namespace HiviewDFX {
+JsonOutputFactory::JsonOutputFactory(const std::string &path) : path_(path)
+{
+}
+
+std::shared_ptr<HidumperExecutor> JsonOutputFactory::CreateExecutor()
+{
+    return std::make_shared<JsonOutput>(path_);
+}
+} // namespace HiviewDFX
+} // namespace OHOS
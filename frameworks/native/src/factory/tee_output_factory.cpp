@@ -0,0 +1,37 @@
+/*
+ * Copyright (C) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "factory/tee_output_factory.h"
+#include "executor/tee_output.h"
+
+namespace OHOS {
+namespace HiviewDFX {
+TeeOutputFactory::TeeOutputFactory(const std::vector<std::shared_ptr<ExecutorFactory>> &sinkFactories)
+    : sinkFactories_(sinkFactories)
+{
+}
+
+std::shared_ptr<HidumperExecutor> TeeOutputFactory::CreateExecutor()
+{
+    std::vector<std::shared_ptr<HidumperExecutor>> sinks;
+    for (auto &factory : sinkFactories_) {
+        std::shared_ptr<HidumperExecutor> sink = factory->CreateExecutor();
+        if (sink != nullptr) {
+            sinks.push_back(sink);
+        }
+    }
+    return std::make_shared<TeeOutput>(sinks);
+}
+} // namespace HiviewDFX
+} // namespace OHOS
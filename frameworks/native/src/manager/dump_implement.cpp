@@ -13,6 +13,10 @@
  * limitations under the License.
  */
 #include "manager/dump_implement.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <thread>
 #include "iservice_registry.h"
 #include "hilog_wrapper.h"
 #include "util/config_utils.h"
@@ -29,16 +33,39 @@
 #include "factory/file_format_dump_filter_factory.h"
 #include "factory/fd_output_factory.h"
 #include "factory/zip_output_factory.h"
+#include "factory/json_output_factory.h"
+#include "factory/snapshot_output_factory.h"
+#include "factory/tee_output_factory.h"
 #include "factory/dumper_group_factory.h"
 #include "factory/memory_dumper_factory.h"
+#include "factory/sched_dumper_factory.h"
+#include "factory/cgroup_dumper_factory.h"
+#include "executor/json_output.h"
 #include "dump_utils.h"
 #include "string_ex.h"
 #include "file_ex.h"
 #include "util/string_utils.h"
 #include "common/dumper_constant.h"
 #include "securec_p.h"
+#include "parameter.h"
 namespace OHOS {
 namespace HiviewDFX {
+namespace {
+static const char SECTION_WORKERS_PARAM[] = "persist.hidumper.dump.workers";
+static const int PARAM_VALUE_LEN = 32;
+static const int DECIMAL_BASE = 10;
+static const uint32_t DEFAULT_SECTION_WORKERS = 4;
+static const uint32_t MAX_SECTION_WORKERS = 8;
+static const char CHUNK_BUDGET_PARAM[] = "persist.hidumper.dump.chunk_budget";
+static const size_t DEFAULT_CHUNK_BUDGET = 1024 * 1024; // 1M
+static const size_t MAX_PENDING_SECTION_BYTES = 16 * 1024 * 1024; // 16M
+static const size_t MAX_FREE_SECTION_LINES = 2; // drained buffers a job keeps for its next batches
+static const int CANCEL_POLL_MILLSEC = 100;
+static const std::string STATS_SECTION = "stats";
+static const std::string ZIP_SUFFIX = ".zip";
+static const std::string JSON_SUFFIX = ".json";
+} // namespace
+
 DumpImplement::DumpImplement()
 {
     AddExecutorFactoryToMap();
@@ -70,6 +97,10 @@ void DumpImplement::AddExecutorFactoryToMap()
     ptrExecutorFactoryMap_->insert(std::make_pair(DumperConstant::GROUP, std::make_shared<DumperGroupFactory>()));
     ptrExecutorFactoryMap_->insert(
         std::make_pair(DumperConstant::MEMORY_DUMPER, std::make_shared<MemoryDumperFactory>()));
+    ptrExecutorFactoryMap_->insert(
+        std::make_pair(DumperConstant::SCHED_DUMPER, std::make_shared<SchedDumperFactory>()));
+    ptrExecutorFactoryMap_->insert(
+        std::make_pair(DumperConstant::CGROUP_DUMPER, std::make_shared<CgroupDumperFactory>()));
 }
 
 DumpStatus DumpImplement::Main(int argc, char *argv[], const std::shared_ptr<RawParam> &reqCtl)
@@ -93,21 +124,37 @@ DumpStatus DumpImplement::Main(int argc, char *argv[], const std::shared_ptr<Raw
     }
     bool isZip = ptrDumperParameter->GetOpts().IsDumpZip();
     std::vector<std::shared_ptr<HidumperExecutor>> hidumperExecutors;
-    setExecutorList(hidumperExecutors, configs, isZip);
+    setExecutorList(hidumperExecutors, configs, ptrDumperParameter->GetOpts());
 
     if (hidumperExecutors.empty()) {
         DUMPER_HILOGE(MODULE_COMMON, "Executor list is empty, so dump fail.");
         return DumpStatus::DUMP_FAIL;
     }
 
-    reqCtl->SetProgressEnabled(isZip);
-    if (isZip) {
-        reqCtl->SetTitle(",The result is:" + path_);
+    // with --tee the client reads the dump, a progress bar would break into it.
+    bool isTee = isZip && ptrDumperParameter->GetOpts().isTee_;
+    const std::string &path = ptrDumperParameter->GetOpts().path_;
+    reqCtl->SetProgressEnabled(isZip && !isTee);
+    if (isZip && !isTee) {
+        reqCtl->SetTitle(",The result is:" + path);
     } else {
         reqCtl->SetTitle("");
     }
     HidumperExecutor::StringMatrix dumpDatas = std::make_shared<std::vector<std::vector<std::string>>>();
     ret = DumpDatas(hidumperExecutors, ptrDumperParameter, dumpDatas);
+    if (isTee && !ptrDumperParameter->GetOpts().IsDumpJson() && !ptrDumperParameter->GetOpts().IsDumpSnapshot() &&
+        (ptrDumperParameter->GetOutputWriter() != nullptr)) {
+        ptrDumperParameter->GetOutputWriter()->AppendLine("The result is:" + path);
+        ptrDumperParameter->GetOutputWriter()->AppendLine("The json result is:" + GetTeeJsonPath(path));
+    }
+    ptrDumperParameter->FlushOutputWriter();
+    bool isJsonClient = ptrDumperParameter->GetOpts().IsDumpJson() && (!isZip || isTee);
+    auto writer = ptrDumperParameter->GetOutputWriter();
+    if (isJsonClient && (writer != nullptr) && (writer->GetStats().bytes == 0)) {
+        // no section has started, the client still reads a document.
+        JsonOutput::AppendEmptyDocument(*writer);
+        ptrDumperParameter->FlushOutputWriter();
+    }
     if (ret != DumpStatus::DUMP_OK) {
         DUMPER_HILOGE(MODULE_COMMON, "DUMP FAIL!!!");
         return ret;
@@ -182,11 +229,16 @@ DumpStatus DumpImplement::CmdParseWithParameter(int argc, char *argv[], DumperOp
         int optionIndex = 0;
         static struct option longOptions[] = {{"cpufreq", no_argument, 0, 0},
                                               {"cpuusage", optional_argument, 0, 0},
+                                              {"schedstat", optional_argument, 0, 0},
                                               {"log", optional_argument, 0, 0},
                                               {"mem", optional_argument, 0, 0},
                                               {"net", no_argument, 0, 0},
                                               {"storage", no_argument, 0, 0},
-                                              {"zip", no_argument, 0, 0},
+                                              {"cgroup", no_argument, 0, 0},
+                                              {"zip", optional_argument, 0, 0},
+                                              {"format", required_argument, 0, 0},
+                                              {"tee", no_argument, 0, 0},
+                                              {"stats", no_argument, 0, 0},
                                               {"test", no_argument, 0, 0},
                                               {0, 0, 0, 0}};
         size_t longOptionsSize = sizeof(longOptions) / sizeof(option);
@@ -246,6 +298,8 @@ DumpStatus DumpImplement::SetCmdParameter(int argc, char *argv[], DumperOpts &op
     if (optind > 1 && optind <= argc) {
         if (StringUtils::GetInstance().IsSameStr(argv[optind - ARG_INDEX_OFFSET_LAST_OPTION], "--cpuusage")) {
             status = SetCmdIntegerParameter(argv[optind - 1], opts_.cpuUsagePid_);
+        } else if (StringUtils::GetInstance().IsSameStr(argv[optind - ARG_INDEX_OFFSET_LAST_OPTION], "--schedstat")) {
+            status = SetCmdIntegerParameter(argv[optind - 1], opts_.schedStatPid_);
         } else if (StringUtils::GetInstance().IsSameStr(argv[optind - ARG_INDEX_OFFSET_LAST_OPTION], "--log")) {
             opts_.logArgs_.push_back(argv[optind - 1]);
         } else if (StringUtils::GetInstance().IsSameStr(argv[optind - ARG_INDEX_OFFSET_LAST_OPTION], "--mem")) {
@@ -288,11 +342,12 @@ std::string DumpImplement::GetTime()
 DumpStatus DumpImplement::ParseLongCmdOption(DumperOpts &opts_, const struct option longOptions[],
                                              const int &optionIndex, char *argv[])
 {
-    path_ = "";
     if (StringUtils::GetInstance().IsSameStr(longOptions[optionIndex].name, "cpufreq")) {
         opts_.isDumpCpuFreq_ = true;
     } else if (StringUtils::GetInstance().IsSameStr(longOptions[optionIndex].name, "cpuusage")) {
         opts_.isDumpCpuUsage_ = true;
+    } else if (StringUtils::GetInstance().IsSameStr(longOptions[optionIndex].name, "schedstat")) {
+        opts_.isDumpSchedStat_ = true;
     } else if (StringUtils::GetInstance().IsSameStr(longOptions[optionIndex].name, "log")) {
         opts_.isDumpLog_ = true;
     } else if (StringUtils::GetInstance().IsSameStr(longOptions[optionIndex].name, "mem")) {
@@ -301,9 +356,19 @@ DumpStatus DumpImplement::ParseLongCmdOption(DumperOpts &opts_, const struct opt
         opts_.isDumpNet_ = true;
     } else if (StringUtils::GetInstance().IsSameStr(longOptions[optionIndex].name, "storage")) {
         opts_.isDumpStorage_ = true;
+    } else if (StringUtils::GetInstance().IsSameStr(longOptions[optionIndex].name, "cgroup")) {
+        opts_.isDumpCgroup_ = true;
     } else if (StringUtils::GetInstance().IsSameStr(longOptions[optionIndex].name, "zip")) {
-        path_ = ZIP_FOLDER + GetTime() + ".zip";
-        opts_.path_ = path_;
+        opts_.path_ = ZIP_FOLDER + GetTime() + ZIP_SUFFIX;
+        if (optarg != nullptr) {
+            opts_.zipCodec_ = optarg;
+        }
+    } else if (StringUtils::GetInstance().IsSameStr(longOptions[optionIndex].name, "format")) {
+        opts_.format_ = optarg;
+    } else if (StringUtils::GetInstance().IsSameStr(longOptions[optionIndex].name, "tee")) {
+        opts_.isTee_ = true;
+    } else if (StringUtils::GetInstance().IsSameStr(longOptions[optionIndex].name, "stats")) {
+        opts_.isStats_ = true;
     } else if (StringUtils::GetInstance().IsSameStr(longOptions[optionIndex].name, "test")) {
         opts_.isTest_ = true;
     }
@@ -384,16 +449,26 @@ void DumpImplement::CmdHelp()
         "  -e                          |faultlogs of crash history\n"
         "  --net                       |dump network information\n"
         "  --storage                   |dump storage information\n"
+        "  --cgroup                    |dump cpu, memory and memory pressure of each cgroup v2 group\n"
         "  -p                          |processes information, include list and infromation of processes"
         " and threads\n"
         "  -p [pid]                    |dump threads under pid, includes smap, block channel,"
         " execute time, mountinfo\n"
         "  --cpuusage [pid]            |dump cpu usage by processes and category; if PID is specified,"
         " dump category usage of specified pid\n"
+        "  --schedstat [pid]           |dump run time, runqueue wait time and timeslices by processes;"
+        " if PID is specified, dump them by threads of specified pid\n"
         "  --cpufreq                   |dump real CPU frequency of each core\n"
         "  --mem [pid]                 |dump memory usage of total; dump memory usage of specified"
         " pid if pid was specified\n"
-        "  --zip                       |compress output to /data/dumper\n";
+        "  --zip                       |compress output to /data/dumper\n"
+        "  --zip=codec[:level]         |compress output with codec deflate[:0-9] (default deflate:6)"
+        " or store\n"
+        "  --format json               |print sections, tables and text blocks as streamed JSON\n"
+        "  --format snapshot           |write a binary snapshot of the tables, read by hidumper_snapshot\n"
+        "  --zip --tee                 |compress output, print it in the --format and write it as .json too,"
+        " collected once\n"
+        "  --stats                     |append wall time, cpu time, lines, bytes and loops of each executor\n";
     if (ptrReqCtl_ == nullptr) {
         return;
     }
@@ -404,22 +479,50 @@ void DumpImplement::CmdHelp()
     SaveStringToFd(rawParamFd, str);
 }
 
+std::shared_ptr<ExecutorFactory> DumpImplement::CreateOutputFactory(const DumperOpts &opts)
+{
+    std::shared_ptr<ExecutorFactory> clientFactory;
+    if (opts.IsDumpJson()) {
+        clientFactory = std::make_shared<JsonOutputFactory>();
+    } else if (opts.IsDumpSnapshot()) {
+        clientFactory = std::make_shared<SnapshotOutputFactory>();
+    } else {
+        clientFactory = std::make_shared<FDOutputFactory>();
+    }
+    if (!opts.IsDumpZip()) {
+        return clientFactory;
+    }
+    std::shared_ptr<ExecutorFactory> zipFactory = std::make_shared<ZipOutputFactory>();
+    if (!opts.isTee_) {
+        return zipFactory;
+    }
+    std::vector<std::shared_ptr<ExecutorFactory>> sinkFactories = { clientFactory, zipFactory,
+        std::make_shared<JsonOutputFactory>(GetTeeJsonPath(opts.path_)) };
+    return std::make_shared<TeeOutputFactory>(sinkFactories);
+}
+
+std::string DumpImplement::GetTeeJsonPath(const std::string &zipPath)
+{
+    std::string path = zipPath;
+    if ((path.size() >= ZIP_SUFFIX.size()) &&
+        (path.compare(path.size() - ZIP_SUFFIX.size(), ZIP_SUFFIX.size(), ZIP_SUFFIX) == 0)) {
+        path.resize(path.size() - ZIP_SUFFIX.size());
+    }
+    return path + JSON_SUFFIX;
+}
+
 void DumpImplement::setExecutorList(std::vector<std::shared_ptr<HidumperExecutor>> &executors,
-                                    const std::vector<std::shared_ptr<DumpCfg>> &configs, bool isZip)
+                                    const std::vector<std::shared_ptr<DumpCfg>> &configs, const DumperOpts &opts)
 {
     std::shared_ptr<HidumperExecutor> ptrOutput;
+    // executor of each config, a config points to its group by index.
+    std::vector<const HidumperExecutor *> configExecutors(configs.size(), nullptr);
 
     for (size_t i = 0; i < configs.size(); i++) {
         std::shared_ptr<ExecutorFactory> ptrExecutorFactory;
         if ((configs[i]->class_) == DumperConstant::FD_OUTPUT) {
-            if (isZip) {
-                ptrExecutorFactory = std::make_shared<ZipOutputFactory>();
-            } else {
-                ptrExecutorFactory = std::make_shared<FDOutputFactory>();
-            }
-
             if (ptrOutput.get() == nullptr) {
-                ptrOutput = ptrExecutorFactory->CreateExecutor();
+                ptrOutput = CreateOutputFactory(opts)->CreateExecutor();
             }
             ptrOutput->SetDumpConfig(configs[i]);
             executors.push_back(ptrOutput);
@@ -437,16 +540,15 @@ void DumpImplement::setExecutorList(std::vector<std::shared_ptr<HidumperExecutor
         }
         std::shared_ptr<HidumperExecutor> ptrExecutor = ptrExecutorFactory->CreateExecutor();
         if (ptrExecutor != nullptr) {
-            configs[i]->executor_ = ptrExecutor;
             ptrExecutor->SetDumpConfig(configs[i]);
+            int parent = configs[i]->parent_;
+            if ((parent >= 0) && (static_cast<size_t>(parent) < i)) {
+                ptrExecutor->SetParent(configExecutors[parent]);
+            }
+            configExecutors[i] = ptrExecutor.get();
         }
         executors.push_back(ptrExecutor);
     }
-
-    // must clear.
-    for (auto cfg : configs) {
-        cfg->executor_ = nullptr;
-    }
 }
 
 DumpStatus DumpImplement::DumpDatas(const std::vector<std::shared_ptr<HidumperExecutor>> &executors,
@@ -455,48 +557,351 @@ DumpStatus DumpImplement::DumpDatas(const std::vector<std::shared_ptr<HidumperEx
 {
     auto callback = dumpParameter->getClientCallback();
 
+    // stats cost nothing unless asked for.
+    std::shared_ptr<DumpExecutorStats> stats;
+    if (dumpParameter->GetOpts().isStats_) {
+        stats = CreateExecutorStats(executors);
+    }
+    dumpParameter->SetChunkBudget(GetChunkBudget());
+    SectionSchedule schedule;
+    schedule.stats = stats.get();
+    schedule.maxPendingBytes = MAX_PENDING_SECTION_BYTES;
+    SplitSections(executors, schedule.jobs);
+    uint32_t workers = static_cast<uint32_t>(std::min<size_t>(GetSectionWorkers(), schedule.jobs.size()));
+    DUMPER_HILOGD(MODULE_COMMON, "debug|sections=%{public}zu, workers=%{public}u", schedule.jobs.size(), workers);
+    if (workers > 1) {
+        DumpSections(executors, dumpParameter, schedule, workers);
+    } else {
+        DumpRange(executors, 0, executors.size(), dumpParameter, dumpDatas, nullptr, 0, stats.get());
+    }
+    if ((stats != nullptr) && !callback->IsCanceled()) {
+        stats->Log();
+        DumpExecutorStatsTable(executors, dumpParameter, *stats);
+    }
+    for (auto executor : executors) {
+        executor->Reset();
+    }
+    callback->UpdateProgress(executors.size(), executors.size());
+    return DumpStatus::DUMP_OK;
+}
+
+uint32_t DumpImplement::GetSectionWorkers()
+{
+    uint32_t workers = DEFAULT_SECTION_WORKERS;
+    long long count = GetNumberParameter(SECTION_WORKERS_PARAM, DEFAULT_SECTION_WORKERS);
+    if (count > 0) {
+        workers = static_cast<uint32_t>(std::min<long long>(count, MAX_SECTION_WORKERS));
+    }
+    uint32_t cpus = std::thread::hardware_concurrency();
+    if ((cpus > 0) && (workers > cpus)) {
+        workers = cpus;
+    }
+    return workers;
+}
+
+size_t DumpImplement::GetChunkBudget()
+{
+    return static_cast<size_t>(GetNumberParameter(CHUNK_BUDGET_PARAM, DEFAULT_CHUNK_BUDGET));
+}
+
+long long DumpImplement::GetNumberParameter(const char *key, long long defaultValue)
+{
+    char value[PARAM_VALUE_LEN] = {0};
+    if (GetParameter(key, "", value, sizeof(value)) <= 0) {
+        return defaultValue;
+    }
+    char *end = nullptr;
+    long long number = strtoll(value, &end, DECIMAL_BASE);
+    if ((end == value) || (number < 0)) {
+        return defaultValue;
+    }
+    return number;
+}
+
+void DumpImplement::SplitSections(const std::vector<std::shared_ptr<HidumperExecutor>> &executors,
+                                  std::vector<SectionJob> &jobs)
+{
+    size_t begin = 0;
+    size_t outputEnd = 0; // after the last output of the job
+    std::string section;
+    for (size_t index = 0; index < executors.size(); index++) {
+        auto dumpCfg = executors[index]->GetDumpConfig();
+        if (dumpCfg->IsOutput()) {
+            outputEnd = index + 1;
+            continue;
+        }
+        if (!dumpCfg->IsDumper() || dumpCfg->section_.empty() || (dumpCfg->section_ == section)) {
+            continue;
+        }
+        // the groups between the last output and this dumper belong to the new section.
+        if (!section.empty() && (outputEnd > begin)) {
+            jobs.push_back({begin, outputEnd, {}, {}, false});
+            begin = outputEnd;
+        }
+        section = dumpCfg->section_;
+    }
+    if (begin < executors.size()) {
+        jobs.push_back({begin, executors.size(), {}, {}, false});
+    }
+}
+
+void DumpImplement::DumpRange(const std::vector<std::shared_ptr<HidumperExecutor>> &executors, size_t begin,
+                              size_t end, const std::shared_ptr<DumperParameter> &dumpParameter,
+                              HidumperExecutor::StringMatrix dumpDatas, SectionSchedule *schedule, size_t job,
+                              DumpExecutorStats *stats)
+{
+    auto callback = dumpParameter->getClientCallback();
+
     std::string groupName = "";
-    std::vector<size_t> loopStack;
-    const size_t executorSum = executors.size();
-    for (size_t index = 0; index < executorSum; index++) {
-        callback->UpdateProgress(executors.size(), index);
+    // json and snapshot carry the section as a field.
+    bool isStructured = dumpParameter->GetOpts().IsDumpJson() || dumpParameter->GetOpts().IsDumpSnapshot();
+    size_t moreDumper = end; // the dumper having more data, the next output brings back to it
+    for (size_t index = begin; index < end; index++) {
+        if (schedule == nullptr) {
+            callback->UpdateProgress(executors.size(), index);
+        }
         if (callback->IsCanceled()) {
             break;
         }
 
         auto dumpCfg = executors[index]->GetDumpConfig();
+        if (dumpCfg->IsDumper() && (index > moreDumper)) {
+            continue;
+        }
         if (dumpCfg->IsDumper() && CheckGroupName(groupName, dumpCfg->section_)) {
-            AddGroupTitle(groupName, dumpDatas);
+            if (!isStructured) {
+                AddGroupTitle(groupName, dumpDatas);
+            }
+            dumpParameter->SetCurrentSection(groupName);
         }
 
-        DumpStatus ret = DumpStatus::DUMP_FAIL;
-        ret = executors[index]->DoPreExecute(dumpParameter, dumpDatas);
-        if (ret != DumpStatus::DUMP_OK) {
+        DumpStatus ret = DumpStatus::DUMP_OK;
+        if ((schedule != nullptr) && dumpCfg->IsOutput()) {
+            AddSectionBatch(*schedule, job, index, dumpParameter, dumpDatas);
+        } else if (!ExecuteOne(executors[index], index, dumpParameter, dumpDatas, stats, ret)) {
             continue;
         }
 
-        ret = executors[index]->DoExecute();
-        if ((ret != DumpStatus::DUMP_OK) && (ret != DumpStatus::DUMP_MORE_DATA)) {
-            continue;
+        if (dumpCfg->IsDumper() && (ret == DumpStatus::DUMP_MORE_DATA)) {
+            moreDumper = index;
+        }
+
+        if ((dumpCfg->IsOutput() || dumpCfg->IsGroup()) && (moreDumper < end)) {
+            index = moreDumper - 1; // the 1 will add back by end for.
+            moreDumper = end;
         }
+    }
+}
+
+bool DumpImplement::ExecuteOne(const std::shared_ptr<HidumperExecutor> &executor, size_t index,
+                               const std::shared_ptr<DumperParameter> &dumpParameter,
+                               HidumperExecutor::StringMatrix dumpDatas, DumpExecutorStats *stats, DumpStatus &ret)
+{
+    if ((stats == nullptr) || executor->GetDumpConfig()->IsGroup()) {
+        return RunExecutor(executor, dumpParameter, dumpDatas, ret);
+    }
+    const DumpLineBuffer *lines = dumpParameter->GetLineBuffer().get();
+    DumpExecutorStats::Sample sample;
+    stats->Begin(*dumpDatas, lines, sample);
+    bool executed = RunExecutor(executor, dumpParameter, dumpDatas, ret);
+    stats->End(index, sample, *dumpDatas, lines);
+    return executed;
+}
+
+bool DumpImplement::RunExecutor(const std::shared_ptr<HidumperExecutor> &executor,
+                                const std::shared_ptr<DumperParameter> &dumpParameter,
+                                HidumperExecutor::StringMatrix dumpDatas, DumpStatus &ret)
+{
+    ret = executor->DoPreExecute(dumpParameter, dumpDatas);
+    if (ret != DumpStatus::DUMP_OK) {
+        return false;
+    }
 
-        ret = executors[index]->DoAfterExecute();
-        if (dumpCfg->IsDumper() && dumpCfg->CanLoop() && (ret == DumpStatus::DUMP_MORE_DATA)) {
-            loopStack.push_back(index);
+    ret = executor->DoExecute();
+    if ((ret != DumpStatus::DUMP_OK) && (ret != DumpStatus::DUMP_MORE_DATA)) {
+        return false;
+    }
+
+    ret = executor->DoAfterExecute();
+    return true;
+}
+
+void DumpImplement::AddSectionBatch(SectionSchedule &schedule, size_t job, size_t index,
+                                    const std::shared_ptr<DumperParameter> &sectionParameter,
+                                    HidumperExecutor::StringMatrix dumpDatas)
+{
+    SectionBatch batch;
+    batch.index = index;
+    batch.section = sectionParameter->GetCurrentSection();
+    batch.lines = sectionParameter->GetLineBuffer();
+    batch.lines->MoveFrom(*dumpDatas);
+    batch.bytes = batch.lines->GetByteCount();
+    std::shared_ptr<DumpLineBuffer> nextLines;
+    {
+        // a job ahead of the output waits until the main thread drains the batches before it.
+        std::unique_lock<std::mutex> lock(schedule.mutex);
+        schedule.roomCond.wait(lock, [&schedule, job, &batch] {
+            return schedule.stopping || (job == schedule.outputJob) || (schedule.maxPendingBytes == 0) ||
+                (schedule.pendingBytes == 0) || (schedule.pendingBytes + batch.bytes <= schedule.maxPendingBytes);
+        });
+        if (schedule.stopping) {
+            batch.lines->Clear(); // canceled, nobody outputs it
+            return;
         }
+        schedule.pendingBytes += batch.bytes;
+        schedule.jobs[job].batches.push_back(std::move(batch));
+        // the batch is output by the main thread, the next dumpers of the job fill a drained buffer.
+        std::vector<std::shared_ptr<DumpLineBuffer>> &freeLines = schedule.jobs[job].freeLines;
+        if (!freeLines.empty()) {
+            nextLines = freeLines.back();
+            freeLines.pop_back();
+        }
+    }
+    schedule.cond.notify_all();
+    sectionParameter->SetLineBuffer((nextLines != nullptr) ? nextLines : std::make_shared<DumpLineBuffer>());
+}
 
-        if (dumpCfg->IsOutput() || dumpCfg->IsGroup()) {
-            if (!loopStack.empty()) {
-                index = loopStack.back() - 1; // the 1 will add back by end for.
+void DumpImplement::RecycleSectionLines(SectionSchedule &schedule, size_t job,
+                                        const std::shared_ptr<DumpLineBuffer> &lines)
+{
+    if (lines == nullptr) {
+        return;
+    }
+    // Clear keeps the chunks, a buffer grown past the pending bytes is not kept though.
+    lines->Clear();
+    if ((schedule.maxPendingBytes > 0) && (lines->GetCapacity() > schedule.maxPendingBytes)) {
+        return;
+    }
+    std::lock_guard<std::mutex> lock(schedule.mutex);
+    SectionJob &sectionJob = schedule.jobs[job];
+    if (!sectionJob.done && (sectionJob.freeLines.size() < MAX_FREE_SECTION_LINES)) {
+        sectionJob.freeLines.push_back(lines);
+    }
+}
+
+void DumpImplement::RunSectionJobs(const std::vector<std::shared_ptr<HidumperExecutor>> &executors,
+                                   const std::shared_ptr<DumperParameter> &dumpParameter,
+                                   SectionSchedule &schedule)
+{
+    while (true) {
+        size_t job = 0;
+        {
+            std::lock_guard<std::mutex> lock(schedule.mutex);
+            if (schedule.stopping || (schedule.nextJob >= schedule.jobs.size())) {
+                return;
             }
-            loopStack.clear(); // clear now.
+            job = schedule.nextJob++;
+        }
+        std::shared_ptr<DumperParameter> sectionParameter = dumpParameter->CreateSectionParameter();
+        HidumperExecutor::StringMatrix sectionDatas = std::make_shared<std::vector<std::vector<std::string>>>();
+        DumpRange(executors, schedule.jobs[job].begin, schedule.jobs[job].end, sectionParameter, sectionDatas,
+            &schedule, job, schedule.stats);
+        {
+            std::lock_guard<std::mutex> lock(schedule.mutex);
+            schedule.jobs[job].done = true;
         }
+        schedule.cond.notify_all();
     }
-    for (auto executor : executors) {
-        executor->Reset();
+}
+
+bool DumpImplement::WaitSectionBatch(SectionSchedule &schedule, size_t job, const std::shared_ptr<RawParam> &callback,
+                                     SectionBatch &batch)
+{
+    std::unique_lock<std::mutex> lock(schedule.mutex);
+    SectionJob &sectionJob = schedule.jobs[job];
+    if (schedule.outputJob != job) {
+        schedule.outputJob = job;
+        schedule.roomCond.notify_all();
     }
-    callback->UpdateProgress(executors.size(), executors.size());
-    return DumpStatus::DUMP_OK;
+    // the client may go away while a job blocks, so the cancel flag is polled.
+    while (!schedule.cond.wait_for(lock, std::chrono::milliseconds(CANCEL_POLL_MILLSEC),
+        [&sectionJob] { return !sectionJob.batches.empty() || sectionJob.done; })) {
+        if (callback->IsCanceled()) {
+            return false;
+        }
+    }
+    if (sectionJob.batches.empty()) {
+        sectionJob.freeLines.clear(); // the job is done
+        return false;
+    }
+    batch = std::move(sectionJob.batches.front());
+    sectionJob.batches.pop_front();
+    schedule.pendingBytes -= batch.bytes;
+    schedule.roomCond.notify_all();
+    return true;
+}
+
+void DumpImplement::DumpSections(const std::vector<std::shared_ptr<HidumperExecutor>> &executors,
+                                 const std::shared_ptr<DumperParameter> &dumpParameter, SectionSchedule &schedule,
+                                 uint32_t workers)
+{
+    auto callback = dumpParameter->getClientCallback();
+    std::vector<std::thread> threads;
+    for (uint32_t i = 0; i < workers; i++) {
+        threads.emplace_back([this, &executors, &dumpParameter, &schedule] {
+            RunSectionJobs(executors, dumpParameter, schedule);
+        });
+    }
+
+    // the output executor is shared, so batches are output here, in config order.
+    HidumperExecutor::StringMatrix outputDatas = std::make_shared<std::vector<std::vector<std::string>>>();
+    for (size_t job = 0; (job < schedule.jobs.size()) && !callback->IsCanceled(); job++) {
+        SectionBatch batch;
+        while (WaitSectionBatch(schedule, job, callback, batch) && !callback->IsCanceled()) {
+            callback->UpdateProgress(executors.size(), batch.index);
+            dumpParameter->SetCurrentSection(batch.section);
+            dumpParameter->SetLineBuffer(batch.lines);
+            DumpStatus ret = DumpStatus::DUMP_OK;
+            (void)ExecuteOne(executors[batch.index], batch.index, dumpParameter, outputDatas, schedule.stats, ret);
+            dumpParameter->SetLineBuffer(nullptr);
+            RecycleSectionLines(schedule, job, batch.lines);
+            batch.lines = nullptr;
+        }
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(schedule.mutex);
+        schedule.stopping = true;
+    }
+    // wakes the workers waiting for room after a cancel.
+    schedule.roomCond.notify_all();
+    for (auto &thread : threads) {
+        thread.join();
+    }
+    dumpParameter->SetLineBuffer(nullptr);
+}
+
+std::shared_ptr<DumpExecutorStats> DumpImplement::CreateExecutorStats(
+    const std::vector<std::shared_ptr<HidumperExecutor>> &executors)
+{
+    std::shared_ptr<DumpExecutorStats> stats = std::make_shared<DumpExecutorStats>(executors.size());
+    for (size_t index = 0; index < executors.size(); index++) {
+        auto dumpCfg = executors[index]->GetDumpConfig();
+        stats->SetExecutor(index, dumpCfg->name_, dumpCfg->section_, dumpCfg->IsOutput());
+    }
+    return stats;
+}
+
+void DumpImplement::DumpExecutorStatsTable(const std::vector<std::shared_ptr<HidumperExecutor>> &executors,
+                                           const std::shared_ptr<DumperParameter> &dumpParameter,
+                                           const DumpExecutorStats &stats)
+{
+    auto it = std::find_if(executors.rbegin(), executors.rend(),
+        [](const std::shared_ptr<HidumperExecutor> &executor) { return executor->GetDumpConfig()->IsOutput(); });
+    if (it == executors.rend()) {
+        return;
+    }
+    bool isStructured = dumpParameter->GetOpts().IsDumpJson() || dumpParameter->GetOpts().IsDumpSnapshot();
+    HidumperExecutor::StringMatrix dumpDatas = std::make_shared<std::vector<std::vector<std::string>>>();
+    if (!isStructured) {
+        AddGroupTitle(STATS_SECTION, dumpDatas);
+    }
+    dumpParameter->SetCurrentSection(STATS_SECTION);
+    std::shared_ptr<DumpLineBuffer> lines = dumpParameter->GetLineBuffer();
+    lines->MoveFrom(*dumpDatas);
+    lines->AppendTable(stats.CreateTable());
+    DumpStatus ret = DumpStatus::DUMP_OK;
+    (void)RunExecutor(*it, dumpParameter, dumpDatas, ret);
 }
 
 void DumpImplement::AddGroupTitle(const std::string &groupName, HidumperExecutor::StringMatrix dumpDatas)
@@ -643,6 +1048,10 @@ DumpStatus DumpImplement::CheckProcessAlive(const DumperOpts &opts_)
         SendPidErrorMessage(opts_.cpuUsagePid_);
         return DumpStatus::DUMP_FAIL;
     }
+    if ((opts_.schedStatPid_ > -1) && !DumpUtils::CheckProcessAlive(opts_.schedStatPid_)) {
+        SendPidErrorMessage(opts_.schedStatPid_);
+        return DumpStatus::DUMP_FAIL;
+    }
     if ((opts_.memPid_ > -1) && !DumpUtils::CheckProcessAlive(opts_.memPid_)) {
         SendPidErrorMessage(opts_.memPid_);
         return DumpStatus::DUMP_FAIL;
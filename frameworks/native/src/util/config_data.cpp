@@ -13,10 +13,111 @@
  * limitations under the License.
  */
 #include "util/config_data.h"
+#include <cstdint>
 #include <pubdef.h>
 #include "common/dumper_constant.h"
 namespace OHOS {
 namespace HiviewDFX {
+namespace {
+static constexpr uint32_t SEED_MAX = 1024;
+static constexpr int SLOTS_PER_NAME = 4;
+static constexpr std::string_view NAME_DUMPER = "dumper_";
+static constexpr std::string_view NAME_MINIGROUP = "groupmini_";
+
+constexpr size_t GetSlotSize(int size)
+{
+    size_t slots = 1;
+    while (slots < static_cast<size_t>(size * SLOTS_PER_NAME)) {
+        slots <<= 1;
+    }
+    return slots;
+}
+
+// slots of a table hashed without collision, the seed is searched at compile time.
+// it can't be built if two names of the table are the same.
+template<size_t SLOTS>
+class NameIndex {
+public:
+    template<typename T>
+    constexpr NameIndex(const T *table, int size)
+    {
+        for (seed_ = 0; seed_ < SEED_MAX; seed_++) {
+            if (Build(table, size)) {
+                break;
+            }
+        }
+    }
+
+    constexpr bool IsValid() const
+    {
+        return seed_ < SEED_MAX;
+    }
+
+    template<typename T>
+    constexpr int Find(const T *table, std::string_view name) const
+    {
+        int index = slots_[ConfigData::HashName(name, seed_) & (SLOTS - 1)];
+        return ((index >= 0) && (table[index].name_ == name)) ? index : -1;
+    }
+private:
+    template<typename T>
+    constexpr bool Build(const T *table, int size)
+    {
+        for (auto &slot : slots_) {
+            slot = -1;
+        }
+        for (int i = 0; i < size; i++) {
+            if (table[i].name_.empty()) {
+                continue;
+            }
+            auto &slot = slots_[ConfigData::HashName(table[i].name_, seed_) & (SLOTS - 1)];
+            if (slot >= 0) {
+                return false;
+            }
+            slot = static_cast<int16_t>(i);
+        }
+        return true;
+    }
+
+    uint32_t seed_ = 0;
+    int16_t slots_[SLOTS] = {};
+};
+
+template<typename T>
+constexpr bool HasName(const T *table, int size, std::string_view name)
+{
+    for (int i = 0; i < size; i++) {
+        if (table[i].name_ == name) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// every item of a group is a dumper or a mini-group of the tables.
+template<typename G, typename D>
+constexpr bool HasValidItems(const G *groups, int groupSum, const D *dumpers, int dumperSum)
+{
+    for (int i = 0; i < groupSum; i++) {
+        for (int j = 0; j < groups[i].size_; j++) {
+            std::string_view item = groups[i].list_[j];
+            if (item.substr(0, NAME_DUMPER.size()) == NAME_DUMPER) {
+                if (!HasName(dumpers, dumperSum, item)) {
+                    return false;
+                }
+            } else if (item.substr(0, NAME_MINIGROUP.size()) == NAME_MINIGROUP) {
+                if (!HasName(groups, groupSum, item)) {
+                    return false;
+                }
+            } else if (!item.empty()) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+} // namespace
+
 const std::string ConfigData::CONFIG_NAME_SPLIT = "_";
 const std::string ConfigData::CONFIG_GROUP = "group";
 const std::string ConfigData::CONFIG_GROUP_ = ConfigData::CONFIG_GROUP + ConfigData::CONFIG_NAME_SPLIT;
@@ -31,6 +132,7 @@ const std::string ConfigData::CONFIG_DUMPER_LIST_SYSTEM_ABILITY = ConfigData::CO
 const std::string ConfigData::CONFIG_DUMPER_LIST_SYSTEM = ConfigData::CONFIG_DUMPER_LIST_ + "system";
 const std::string ConfigData::CONFIG_GROUP_CPU_FREQ = ConfigData::CONFIG_GROUP_ + "cpufreq";
 const std::string ConfigData::CONFIG_GROUP_CPU_USAGE = ConfigData::CONFIG_GROUP_ + "cpuusage";
+const std::string ConfigData::CONFIG_GROUP_SCHED_STAT = ConfigData::CONFIG_GROUP_ + "schedstat";
 const std::string ConfigData::CONFIG_GROUP_LOG = ConfigData::CONFIG_GROUP_ + "log";
 const std::string ConfigData::CONFIG_GROUP_LOG_ = ConfigData::CONFIG_GROUP_LOG + ConfigData::CONFIG_NAME_SPLIT;
 const std::string ConfigData::CONFIG_GROUP_LOG_KERNEL = ConfigData::CONFIG_GROUP_LOG_ + "kernel";
@@ -38,6 +140,7 @@ const std::string ConfigData::CONFIG_GROUP_LOG_HILOG = ConfigData::CONFIG_GROUP_
 const std::string ConfigData::CONFIG_GROUP_LOG_INIT = ConfigData::CONFIG_GROUP_LOG_ + "init";
 const std::string ConfigData::CONFIG_GROUP_MEMORY = ConfigData::CONFIG_GROUP_ + "memory";
 const std::string ConfigData::CONFIG_GROUP_STORAGE = ConfigData::CONFIG_GROUP_ + "storage";
+const std::string ConfigData::CONFIG_GROUP_CGROUP = ConfigData::CONFIG_GROUP_ + "cgroup";
 const std::string ConfigData::CONFIG_GROUP_NET = ConfigData::CONFIG_GROUP_ + "net";
 const std::string ConfigData::CONFIG_GROUP_SERVICE = ConfigData::CONFIG_GROUP_ + "service";
 const std::string ConfigData::CONFIG_GROUP_ABILITY = ConfigData::CONFIG_GROUP_ + "ability";
@@ -56,7 +159,7 @@ const std::string ConfigData::STR_ABILITY = "ability";
 const std::string ConfigData::STR_BASE = "base";
 const std::string ConfigData::STR_SERVICE = "service";
 const std::string ConfigData::STR_SYSTEM = "system";
-const ConfigData::ItemCfg ConfigData::baseInfoDumper_[] = {
+constexpr ConfigData::ItemCfg ConfigData::baseInfoDumper_[] = {
     {
         .name_ = "dumper_base_info",
         .desc_ = "Base Information",
@@ -79,7 +182,7 @@ const ConfigData::ItemCfg ConfigData::baseInfoDumper_[] = {
     },
 };
 
-const ConfigData::ItemCfg ConfigData::kernelVersionDumper_[] = {
+constexpr ConfigData::ItemCfg ConfigData::kernelVersionDumper_[] = {
     {
         .name_ = "dumper_kernel_version",
         .desc_ = "Kernel Version",
@@ -102,7 +205,7 @@ const ConfigData::ItemCfg ConfigData::kernelVersionDumper_[] = {
     },
 };
 
-const ConfigData::ItemCfg ConfigData::cmdlineDumper_[] = {
+constexpr ConfigData::ItemCfg ConfigData::cmdlineDumper_[] = {
     {
         .name_ = "dumper_command_line",
         .desc_ = "Command Line",
@@ -125,7 +228,7 @@ const ConfigData::ItemCfg ConfigData::cmdlineDumper_[] = {
     },
 };
 
-const ConfigData::ItemCfg ConfigData::kernelWakeSourcesDumper_[] = {
+constexpr ConfigData::ItemCfg ConfigData::kernelWakeSourcesDumper_[] = {
     {
         .name_ = "dumper_kernel_wake_sources",
         .desc_ = "KERNEL WAKE SOURCES",
@@ -148,7 +251,7 @@ const ConfigData::ItemCfg ConfigData::kernelWakeSourcesDumper_[] = {
     },
 };
 
-const ConfigData::ItemCfg ConfigData::kernelCpufreqDumper_[] = {
+constexpr ConfigData::ItemCfg ConfigData::kernelCpufreqDumper_[] = {
     {
         .name_ = "dumper_kernel_cpu_freq",
         .desc_ = "KERNEL CPUFREQ",
@@ -191,7 +294,7 @@ const ConfigData::ItemCfg ConfigData::kernelCpufreqDumper_[] = {
     },
 };
 
-const ConfigData::ItemCfg ConfigData::uptimeDumper_[] = {
+constexpr ConfigData::ItemCfg ConfigData::uptimeDumper_[] = {
     {
         .name_ = "dumper_uptime",
         .desc_ = "Up Time",
@@ -214,7 +317,7 @@ const ConfigData::ItemCfg ConfigData::uptimeDumper_[] = {
     },
 };
 
-const ConfigData::ItemCfg ConfigData::cpuUsageDumper_[] = {
+constexpr ConfigData::ItemCfg ConfigData::cpuUsageDumper_[] = {
     {
         .name_ = "dumper_cpu_usage",
         .desc_ = "CPU Usage",
@@ -237,7 +340,53 @@ const ConfigData::ItemCfg ConfigData::cpuUsageDumper_[] = {
     },
 };
 
-const ConfigData::ItemCfg ConfigData::cpuFreqDumper_[] = {
+constexpr ConfigData::ItemCfg ConfigData::schedStatDumper_[] = {
+    {
+        .name_ = "dumper_sched_stat",
+        .desc_ = "Scheduler Latency",
+        .target_ = "%pid",
+        .section_ = "",
+        .class_ = DumperConstant::SCHED_DUMPER,
+        .level_ = DumperConstant::NONE,
+        .loop_ = DumperConstant::NONE,
+        .filterCfg_ = "",
+    },
+    {
+        .name_ = "",
+        .desc_ = "",
+        .target_ = "",
+        .section_ = "",
+        .class_ = DumperConstant::FD_OUTPUT,
+        .level_ = DumperConstant::NONE,
+        .loop_ = DumperConstant::NONE,
+        .filterCfg_ = "",
+    },
+};
+
+constexpr ConfigData::ItemCfg ConfigData::cgroupDumper_[] = {
+    {
+        .name_ = "dumper_cgroup",
+        .desc_ = "Cgroup Usage",
+        .target_ = "",
+        .section_ = "",
+        .class_ = DumperConstant::CGROUP_DUMPER,
+        .level_ = DumperConstant::NONE,
+        .loop_ = DumperConstant::NONE,
+        .filterCfg_ = "",
+    },
+    {
+        .name_ = "",
+        .desc_ = "",
+        .target_ = "",
+        .section_ = "",
+        .class_ = DumperConstant::FD_OUTPUT,
+        .level_ = DumperConstant::NONE,
+        .loop_ = DumperConstant::NONE,
+        .filterCfg_ = "",
+    },
+};
+
+constexpr ConfigData::ItemCfg ConfigData::cpuFreqDumper_[] = {
     {
         .name_ = "dumper_cpu_freq",
         .desc_ = "CPU Frequency",
@@ -280,7 +429,7 @@ const ConfigData::ItemCfg ConfigData::cpuFreqDumper_[] = {
     },
 };
 
-const ConfigData::ItemCfg ConfigData::memDumper_[] = {
+constexpr ConfigData::ItemCfg ConfigData::memDumper_[] = {
     {
         .name_ = "dumper_mem",
         .desc_ = "Memory Information",
@@ -303,7 +452,7 @@ const ConfigData::ItemCfg ConfigData::memDumper_[] = {
     },
 };
 
-const ConfigData::ItemCfg ConfigData::envDumper_[] = {
+constexpr ConfigData::ItemCfg ConfigData::envDumper_[] = {
     {
         .name_ = "dumper_env",
         .desc_ = "Environment Variable",
@@ -326,7 +475,7 @@ const ConfigData::ItemCfg ConfigData::envDumper_[] = {
     },
 };
 
-const ConfigData::ItemCfg ConfigData::kernelModuleDumper_[] = {
+constexpr ConfigData::ItemCfg ConfigData::kernelModuleDumper_[] = {
     {
         .name_ = "dumper_kernel_module",
         .desc_ = "Kernel Module",
@@ -369,7 +518,7 @@ const ConfigData::ItemCfg ConfigData::kernelModuleDumper_[] = {
     },
 };
 
-const ConfigData::ItemCfg ConfigData::dumpFormatVersionDumper_[] = {
+constexpr ConfigData::ItemCfg ConfigData::dumpFormatVersionDumper_[] = {
     {
         .name_ = "dumper_dump_format_version",
         .desc_ = "HiDumper Version",
@@ -392,7 +541,7 @@ const ConfigData::ItemCfg ConfigData::dumpFormatVersionDumper_[] = {
     },
 };
 
-const ConfigData::ItemCfg ConfigData::slabinfoDumper_[] = {
+constexpr ConfigData::ItemCfg ConfigData::slabinfoDumper_[] = {
     {
         .name_ = "dumper_slabinfo",
         .desc_ = "SLAB INFO",
@@ -415,7 +564,7 @@ const ConfigData::ItemCfg ConfigData::slabinfoDumper_[] = {
     },
 };
 
-const ConfigData::ItemCfg ConfigData::zoneinfoDumper_[] = {
+constexpr ConfigData::ItemCfg ConfigData::zoneinfoDumper_[] = {
     {
         .name_ = "dumper_zoneinfo",
         .desc_ = "ZONE INFO",
@@ -438,7 +587,7 @@ const ConfigData::ItemCfg ConfigData::zoneinfoDumper_[] = {
     },
 };
 
-const ConfigData::ItemCfg ConfigData::vmStatDumper_[] = {
+constexpr ConfigData::ItemCfg ConfigData::vmStatDumper_[] = {
     {
         .name_ = "dumper_vmstat",
         .desc_ = "VIRTUAL MEMORY STATS",
@@ -461,7 +610,7 @@ const ConfigData::ItemCfg ConfigData::vmStatDumper_[] = {
     },
 };
 
-const ConfigData::ItemCfg ConfigData::vmAllocInfoDumper_[] = {
+constexpr ConfigData::ItemCfg ConfigData::vmAllocInfoDumper_[] = {
     {
         .name_ = "dumper_vmallocinfo",
         .desc_ = "VIRTUAL MEMORY STATS",
@@ -484,7 +633,7 @@ const ConfigData::ItemCfg ConfigData::vmAllocInfoDumper_[] = {
     },
 };
 
-const ConfigData::ItemCfg ConfigData::crashDumper_[] = {
+constexpr ConfigData::ItemCfg ConfigData::crashDumper_[] = {
     {
         .name_ = "dumper_crash",
         .desc_ = "Crash Log",
@@ -507,7 +656,7 @@ const ConfigData::ItemCfg ConfigData::crashDumper_[] = {
     },
 };
 
-const ConfigData::ItemCfg ConfigData::kernelLogDumper_[] = {
+constexpr ConfigData::ItemCfg ConfigData::kernelLogDumper_[] = {
     {
         .name_ = "dumper_kernel_log",
         .desc_ = "Kernel Log",
@@ -530,7 +679,7 @@ const ConfigData::ItemCfg ConfigData::kernelLogDumper_[] = {
     },
 };
 
-const ConfigData::ItemCfg ConfigData::hilogDumper_[] = {
+constexpr ConfigData::ItemCfg ConfigData::hilogDumper_[] = {
     {
         .name_ = "dumper_hilog",
         .desc_ = "Hilog",
@@ -553,7 +702,7 @@ const ConfigData::ItemCfg ConfigData::hilogDumper_[] = {
     },
 };
 
-const ConfigData::ItemCfg ConfigData::portDumper_[] = {
+constexpr ConfigData::ItemCfg ConfigData::portDumper_[] = {
     {
         .name_ = "dumper_port",
         .desc_ = "Port Information",
@@ -576,7 +725,7 @@ const ConfigData::ItemCfg ConfigData::portDumper_[] = {
     },
 };
 
-const ConfigData::ItemCfg ConfigData::packetDumper_[] = {
+constexpr ConfigData::ItemCfg ConfigData::packetDumper_[] = {
     {
         .name_ = "dumper_packet",
         .desc_ = "Packet State",
@@ -679,7 +828,7 @@ const ConfigData::ItemCfg ConfigData::packetDumper_[] = {
     },
 };
 
-const ConfigData::ItemCfg ConfigData::ipDumper_[] = {
+constexpr ConfigData::ItemCfg ConfigData::ipDumper_[] = {
     {
         .name_ = "dumper_ip",
         .desc_ = "IP v4/6 State",
@@ -702,7 +851,7 @@ const ConfigData::ItemCfg ConfigData::ipDumper_[] = {
     },
 };
 
-const ConfigData::ItemCfg ConfigData::ipTableDumper_[] = {
+constexpr ConfigData::ItemCfg ConfigData::ipTableDumper_[] = {
     {
         .name_ = "dumper_ip_table",
         .desc_ = "IPTable v4/6 Information",
@@ -845,7 +994,7 @@ const ConfigData::ItemCfg ConfigData::ipTableDumper_[] = {
     },
 };
 
-const ConfigData::ItemCfg ConfigData::routeTableDumper_[] = {
+constexpr ConfigData::ItemCfg ConfigData::routeTableDumper_[] = {
     {
         .name_ = "dumper_route_table",
         .desc_ = "IP Table v4/6 Information",
@@ -868,7 +1017,7 @@ const ConfigData::ItemCfg ConfigData::routeTableDumper_[] = {
     },
 };
 
-const ConfigData::ItemCfg ConfigData::ipcDumper_[] = {
+constexpr ConfigData::ItemCfg ConfigData::ipcDumper_[] = {
     {
         .name_ = "dumper_ipc",
         .desc_ = "IPC Information",
@@ -971,7 +1120,7 @@ const ConfigData::ItemCfg ConfigData::ipcDumper_[] = {
     },
 };
 
-const ConfigData::ItemCfg ConfigData::ipRulesDumper_[] = {
+constexpr ConfigData::ItemCfg ConfigData::ipRulesDumper_[] = {
     {
         .name_ = "dumper_ip_rules",
         .desc_ = "IP RULES v4/6",
@@ -1074,7 +1223,7 @@ const ConfigData::ItemCfg ConfigData::ipRulesDumper_[] = {
     },
 };
 
-const ConfigData::ItemCfg ConfigData::storageStateDumper_[] = {
+constexpr ConfigData::ItemCfg ConfigData::storageStateDumper_[] = {
     {
         .name_ = "dumper_storage_state",
         .desc_ = "Storage State",
@@ -1097,7 +1246,7 @@ const ConfigData::ItemCfg ConfigData::storageStateDumper_[] = {
     },
 };
 
-const ConfigData::ItemCfg ConfigData::blockDumper_[] = {
+constexpr ConfigData::ItemCfg ConfigData::blockDumper_[] = {
     {
         .name_ = "dumper_block",
         .desc_ = "Block Information",
@@ -1120,7 +1269,7 @@ const ConfigData::ItemCfg ConfigData::blockDumper_[] = {
     },
 };
 
-const ConfigData::ItemCfg ConfigData::fileDumper_[] = {
+constexpr ConfigData::ItemCfg ConfigData::fileDumper_[] = {
     {
         .name_ = "dumper_file",
         .desc_ = "File Information",
@@ -1143,7 +1292,7 @@ const ConfigData::ItemCfg ConfigData::fileDumper_[] = {
     },
 };
 
-const ConfigData::ItemCfg ConfigData::topIoDumper_[] = {
+constexpr ConfigData::ItemCfg ConfigData::topIoDumper_[] = {
     {
         .name_ = "dumper_top_io",
         .desc_ = "TOP IO Information",
@@ -1176,7 +1325,7 @@ const ConfigData::ItemCfg ConfigData::topIoDumper_[] = {
     },
 };
 
-const ConfigData::ItemCfg ConfigData::mountsDumper_[] = {
+constexpr ConfigData::ItemCfg ConfigData::mountsDumper_[] = {
     {
         .name_ = "dumper_mounts",
         .desc_ = "Mount List",
@@ -1199,7 +1348,7 @@ const ConfigData::ItemCfg ConfigData::mountsDumper_[] = {
     },
 };
 
-const ConfigData::ItemCfg ConfigData::threadsDumper_[] = {
+constexpr ConfigData::ItemCfg ConfigData::threadsDumper_[] = {
     {
         .name_ = "dumper_threads",
         .desc_ = "Processes/Threads List",
@@ -1222,7 +1371,7 @@ const ConfigData::ItemCfg ConfigData::threadsDumper_[] = {
     },
 };
 
-const ConfigData::ItemCfg ConfigData::threadsPidDumper_[] = {
+constexpr ConfigData::ItemCfg ConfigData::threadsPidDumper_[] = {
     {
         .name_ = "dumper_threads_pid",
         .desc_ = "Processes/Threads List",
@@ -1245,7 +1394,7 @@ const ConfigData::ItemCfg ConfigData::threadsPidDumper_[] = {
     },
 };
 
-const ConfigData::ItemCfg ConfigData::smapDumper_[] = {
+constexpr ConfigData::ItemCfg ConfigData::smapDumper_[] = {
     {
         .name_ = "dumper_smap",
         .desc_ = "Process SMAP Information",
@@ -1268,7 +1417,7 @@ const ConfigData::ItemCfg ConfigData::smapDumper_[] = {
     },
 };
 
-const ConfigData::ItemCfg ConfigData::mapDumper_[] = {
+constexpr ConfigData::ItemCfg ConfigData::mapDumper_[] = {
     {
         .name_ = "dumper_map",
         .desc_ = "Process MAP Information",
@@ -1291,7 +1440,7 @@ const ConfigData::ItemCfg ConfigData::mapDumper_[] = {
     },
 };
 
-const ConfigData::ItemCfg ConfigData::blockChannelDumper_[] = {
+constexpr ConfigData::ItemCfg ConfigData::blockChannelDumper_[] = {
     {
         .name_ = "dumper_block_channel",
         .desc_ = "Block Channel",
@@ -1314,7 +1463,7 @@ const ConfigData::ItemCfg ConfigData::blockChannelDumper_[] = {
     },
 };
 
-const ConfigData::ItemCfg ConfigData::excuteTimeDumper_[] = {
+constexpr ConfigData::ItemCfg ConfigData::excuteTimeDumper_[] = {
     {
         .name_ = "dumper_excute_time",
         .desc_ = "Excute Time",
@@ -1337,7 +1486,7 @@ const ConfigData::ItemCfg ConfigData::excuteTimeDumper_[] = {
     },
 };
 
-const ConfigData::ItemCfg ConfigData::mountInfoDumper_[] = {
+constexpr ConfigData::ItemCfg ConfigData::mountInfoDumper_[] = {
     {
         .name_ = "dumper_mount_info",
         .desc_ = "Mount Information",
@@ -1360,11 +1509,11 @@ const ConfigData::ItemCfg ConfigData::mountInfoDumper_[] = {
     },
 };
 
-const ConfigData::ItemCfg ConfigData::systemAbilityDumper_[] = {
+constexpr ConfigData::ItemCfg ConfigData::systemAbilityDumper_[] = {
     {
         .name_ = "dumper_system_ability",
         .desc_ = "System Ability Information",
-        .target_ = ConfigData::STR_ABILITY,
+        .target_ = "ability",
         .section_ = "",
         .class_ = DumperConstant::SA_DUMPER,
         .level_ = DumperConstant::NONE,
@@ -1383,7 +1532,7 @@ const ConfigData::ItemCfg ConfigData::systemAbilityDumper_[] = {
     },
 };
 
-const ConfigData::ItemCfg ConfigData::stackDumper_[] = {
+constexpr ConfigData::ItemCfg ConfigData::stackDumper_[] = {
     {
         .name_ = "dumper_stack",
         .desc_ = "Dump Stack Info",
@@ -1406,11 +1555,11 @@ const ConfigData::ItemCfg ConfigData::stackDumper_[] = {
     },
 };
 
-const ConfigData::ItemCfg ConfigData::listServiceDumper_[] = {
+constexpr ConfigData::ItemCfg ConfigData::listServiceDumper_[] = {
     {
-        .name_ = ConfigData::CONFIG_DUMPER_LIST_SERVICE,
+        .name_ = "dumper_list_service",
         .desc_ = "list service",
-        .target_ = ConfigData::STR_SERVICE,
+        .target_ = "service",
         .section_ = "",
         .class_ = DumperConstant::LIST_DUMPER,
         .level_ = DumperConstant::NONE,
@@ -1429,11 +1578,11 @@ const ConfigData::ItemCfg ConfigData::listServiceDumper_[] = {
     },
 };
 
-const ConfigData::ItemCfg ConfigData::listSystemAbilityDumper_[] = {
+constexpr ConfigData::ItemCfg ConfigData::listSystemAbilityDumper_[] = {
     {
-        .name_ = ConfigData::CONFIG_DUMPER_LIST_SYSTEM_ABILITY,
+        .name_ = "dumper_list_system_ability",
         .desc_ = "list system ability",
-        .target_ = ConfigData::STR_ABILITY,
+        .target_ = "ability",
         .section_ = "",
         .class_ = DumperConstant::LIST_DUMPER,
         .level_ = DumperConstant::NONE,
@@ -1452,11 +1601,11 @@ const ConfigData::ItemCfg ConfigData::listSystemAbilityDumper_[] = {
     },
 };
 
-const ConfigData::ItemCfg ConfigData::listSystemDumper_[] = {
+constexpr ConfigData::ItemCfg ConfigData::listSystemDumper_[] = {
     {
-        .name_ = ConfigData::CONFIG_DUMPER_LIST_SYSTEM,
+        .name_ = "dumper_list_system",
         .desc_ = "list system",
-        .target_ = ConfigData::STR_SYSTEM,
+        .target_ = "system",
         .section_ = "",
         .class_ = DumperConstant::LIST_DUMPER,
         .level_ = DumperConstant::NONE,
@@ -1475,7 +1624,7 @@ const ConfigData::ItemCfg ConfigData::listSystemDumper_[] = {
     },
 };
 
-const ConfigData::ItemCfg ConfigData::testDumper_[] = {
+constexpr ConfigData::ItemCfg ConfigData::testDumper_[] = {
     {
         .name_ = "dumper_test",
         .desc_ = "test used dumper",
@@ -1518,7 +1667,7 @@ const ConfigData::ItemCfg ConfigData::testDumper_[] = {
     },
 };
 
-const ConfigData::DumperCfg ConfigData::dumpers_[] = {
+constexpr ConfigData::DumperCfg ConfigData::dumpers_[] = {
     {.name_ = baseInfoDumper_[0].name_,
      .desc_ = baseInfoDumper_[0].desc_,
      .list_ = baseInfoDumper_,
@@ -1547,6 +1696,14 @@ const ConfigData::DumperCfg ConfigData::dumpers_[] = {
      .desc_ = cpuUsageDumper_[0].desc_,
      .list_ = cpuUsageDumper_,
      .size_ = ARRAY_SIZE(cpuUsageDumper_)},
+    {.name_ = schedStatDumper_[0].name_,
+     .desc_ = schedStatDumper_[0].desc_,
+     .list_ = schedStatDumper_,
+     .size_ = ARRAY_SIZE(schedStatDumper_)},
+    {.name_ = cgroupDumper_[0].name_,
+     .desc_ = cgroupDumper_[0].desc_,
+     .list_ = cgroupDumper_,
+     .size_ = ARRAY_SIZE(cgroupDumper_)},
     {.name_ = cpuFreqDumper_[0].name_,
      .desc_ = cpuFreqDumper_[0].desc_,
      .list_ = cpuFreqDumper_,
@@ -1682,57 +1839,57 @@ const ConfigData::DumperCfg ConfigData::dumpers_[] = {
      .size_ = ARRAY_SIZE(testDumper_)},
 };
 
-const std::string ConfigData::cpuFreqGroup_[] = {
+constexpr std::string_view ConfigData::cpuFreqGroup_[] = {
     "dumper_cpu_freq",
 };
 
-const std::string ConfigData::cpuUsageGroup_[] = {
+constexpr std::string_view ConfigData::cpuUsageGroup_[] = {
     "dumper_cpu_usage",
 };
 
-const std::string ConfigData::logKernelGroup_[] = {
-    "dumper_kernel_log",
+constexpr std::string_view ConfigData::schedStatGroup_[] = {
+    "dumper_sched_stat",
 };
 
-const std::string ConfigData::logHilogGroup_[] = {
-    "dumper_hilog",
+constexpr std::string_view ConfigData::logKernelGroup_[] = {
+    "dumper_kernel_log",
 };
 
-const std::string ConfigData::logInitGroup_[] = {
-    "cpu_dumper_name_000",
+constexpr std::string_view ConfigData::logHilogGroup_[] = {
+    "dumper_hilog",
 };
 
-const std::string ConfigData::memoryGroup_[] = {
+constexpr std::string_view ConfigData::memoryGroup_[] = {
     "dumper_mem",
 };
 
-const std::string ConfigData::storageGroup_[] = {
+constexpr std::string_view ConfigData::storageGroup_[] = {
     "dumper_storage_state", "dumper_block", "dumper_file", "dumper_top_io", "dumper_mounts",
 };
 
-const std::string ConfigData::netGroup_[] = {
-    "dumper_port",        "dumper_packet", "dumper_ip",       "dumper_ip_table",
-    "dumper_route_table", "dumper_ipc",    "dumper_ip_rules",
+constexpr std::string_view ConfigData::cgroupGroup_[] = {
+    "dumper_cgroup",
 };
 
-const std::string ConfigData::serviceGroup_[] = {
-    "mem_dumper_name_000",
+constexpr std::string_view ConfigData::netGroup_[] = {
+    "dumper_port",        "dumper_packet", "dumper_ip",       "dumper_ip_table",
+    "dumper_route_table", "dumper_ipc",    "dumper_ip_rules",
 };
 
-const std::string ConfigData::systemAbilityGroup_[] = {
+constexpr std::string_view ConfigData::systemAbilityGroup_[] = {
     "dumper_system_ability",
 };
 
-const std::string ConfigData::systemBaseGroup_[] = {
+constexpr std::string_view ConfigData::systemBaseGroup_[] = {
     "dumper_base_info",           "dumper_kernel_version", "dumper_command_line",
     "dumper_kernel_wake_sources", "dumper_uptime",         "groupmini_cpuid_expand_systemBaseGroup",
 };
 
-const std::string ConfigData::systemBaseCpuIdGroupMini_[] = {
+constexpr std::string_view ConfigData::systemBaseCpuIdGroupMini_[] = {
     "dumper_kernel_cpu_freq",
 };
 
-const std::string ConfigData::systemSystemGroup_[] = {
+constexpr std::string_view ConfigData::systemSystemGroup_[] = {
     "dumper_env",
     "dumper_kernel_module",
     "dumper_dump_format_version",
@@ -1744,54 +1901,54 @@ const std::string ConfigData::systemSystemGroup_[] = {
     "groupmini_pid_nonexpand_systemSystemGroup",
 };
 
-const std::string ConfigData::systemSystemCpuIdGroupMini_[] = {
+constexpr std::string_view ConfigData::systemSystemCpuIdGroupMini_[] = {
     "dumper_cpu_freq",
 };
 
-const std::string ConfigData::systemSystemPidGroupMini_[] = {
+constexpr std::string_view ConfigData::systemSystemPidGroupMini_[] = {
     "dumper_cpu_usage",
     "dumper_mem",
 };
 
-const std::string ConfigData::processesGroup_[] = {
+constexpr std::string_view ConfigData::processesGroup_[] = {
     "dumper_threads",
     "groupmini_expand_processesGroup",
 };
 
-const std::string ConfigData::processesGroup_eng_[] = {
+constexpr std::string_view ConfigData::processesGroup_eng_[] = {
     "dumper_threads",
     "groupmini_expand_processesGroup_eng",
 };
 
-const std::string ConfigData::processesPidGroup_[] = {
+constexpr std::string_view ConfigData::processesPidGroup_[] = {
     "groupmini_pid_expand_processesGroup",
 };
 
-const std::string ConfigData::processesPidGroup_eng_[] = {
+constexpr std::string_view ConfigData::processesPidGroup_eng_[] = {
     "groupmini_pid_expand_processesGroup_eng",
 };
 
-const std::string ConfigData::processesGroupMini_[] = {
+constexpr std::string_view ConfigData::processesGroupMini_[] = {
     "dumper_block_channel",
     "dumper_excute_time",
     "dumper_mount_info",
 };
 
-const std::string ConfigData::processesGroupMini_eng_[] = {
+constexpr std::string_view ConfigData::processesGroupMini_eng_[] = {
     "dumper_map",
     "dumper_block_channel",
     "dumper_excute_time",
     "dumper_mount_info",
 };
 
-const std::string ConfigData::processesPidGroupMini_[] = {
+constexpr std::string_view ConfigData::processesPidGroupMini_[] = {
     "dumper_threads_pid",
     "dumper_block_channel",
     "dumper_excute_time",
     "dumper_mount_info",
 };
 
-const std::string ConfigData::processesPidGroupMini_eng_[] = {
+constexpr std::string_view ConfigData::processesPidGroupMini_eng_[] = {
     "dumper_threads_pid",
     "dumper_map",
     "dumper_block_channel",
@@ -1799,21 +1956,21 @@ const std::string ConfigData::processesPidGroupMini_eng_[] = {
     "dumper_mount_info",
 };
 
-const std::string ConfigData::faultLogGroup_[] = {
+constexpr std::string_view ConfigData::faultLogGroup_[] = {
     "dumper_crash",
 };
 
-const std::string ConfigData::stackGroup_[] = {
+constexpr std::string_view ConfigData::stackGroup_[] = {
     "dumper_stack",
 };
 
-const std::string ConfigData::testGroup_[] = {
+constexpr std::string_view ConfigData::testGroup_[] = {
     "dumper_test",
 };
 
-const ConfigData::GroupCfg ConfigData::groups_[] = {
+constexpr ConfigData::GroupCfg ConfigData::groups_[] = {
     {
-        .name_ = ConfigData::CONFIG_GROUP_CPU_FREQ,
+        .name_ = "group_cpufreq",
         .desc_ = "group of cpu freq dumper",
         .list_ = cpuFreqGroup_,
         .size_ = ARRAY_SIZE(cpuFreqGroup_),
@@ -1821,7 +1978,7 @@ const ConfigData::GroupCfg ConfigData::groups_[] = {
         .expand_ = true,
     },
     {
-        .name_ = ConfigData::CONFIG_GROUP_CPU_USAGE,
+        .name_ = "group_cpuusage",
         .desc_ = "group of cpu usage dumper",
         .list_ = cpuUsageGroup_,
         .size_ = ARRAY_SIZE(cpuUsageGroup_),
@@ -1829,7 +1986,15 @@ const ConfigData::GroupCfg ConfigData::groups_[] = {
         .expand_ = false,
     },
     {
-        .name_ = ConfigData::CONFIG_GROUP_LOG_KERNEL,
+        .name_ = "group_schedstat",
+        .desc_ = "group of scheduler latency dumper",
+        .list_ = schedStatGroup_,
+        .size_ = ARRAY_SIZE(schedStatGroup_),
+        .type_ = DumperConstant::GROUPTYPE_PID,
+        .expand_ = false,
+    },
+    {
+        .name_ = "group_log_kernel",
         .desc_ = "group of kernel log dumper",
         .list_ = logKernelGroup_,
         .size_ = ARRAY_SIZE(logKernelGroup_),
@@ -1837,7 +2002,7 @@ const ConfigData::GroupCfg ConfigData::groups_[] = {
         .expand_ = false,
     },
     {
-        .name_ = ConfigData::CONFIG_GROUP_LOG_HILOG,
+        .name_ = "group_log_hilog",
         .desc_ = "group of hilog dumper",
         .list_ = logHilogGroup_,
         .size_ = ARRAY_SIZE(logHilogGroup_),
@@ -1845,15 +2010,15 @@ const ConfigData::GroupCfg ConfigData::groups_[] = {
         .expand_ = false,
     },
     {
-        .name_ = ConfigData::CONFIG_GROUP_LOG_INIT,
+        .name_ = "group_log_init",
         .desc_ = "group of init log dumper",
-        .list_ = logInitGroup_,
-        .size_ = ARRAY_SIZE(logInitGroup_),
+        .list_ = nullptr,
+        .size_ = 0,
         .type_ = DumperConstant::NONE,
         .expand_ = false,
     },
     {
-        .name_ = ConfigData::CONFIG_GROUP_MEMORY,
+        .name_ = "group_memory",
         .desc_ = "group of memory dumper",
         .list_ = memoryGroup_,
         .size_ = ARRAY_SIZE(memoryGroup_),
@@ -1861,7 +2026,7 @@ const ConfigData::GroupCfg ConfigData::groups_[] = {
         .expand_ = false,
     },
     {
-        .name_ = ConfigData::CONFIG_GROUP_STORAGE,
+        .name_ = "group_storage",
         .desc_ = "group of storage dumper",
         .list_ = storageGroup_,
         .size_ = ARRAY_SIZE(storageGroup_),
@@ -1869,7 +2034,15 @@ const ConfigData::GroupCfg ConfigData::groups_[] = {
         .expand_ = false,
     },
     {
-        .name_ = ConfigData::CONFIG_GROUP_NET,
+        .name_ = "group_cgroup",
+        .desc_ = "group of cgroup dumper",
+        .list_ = cgroupGroup_,
+        .size_ = ARRAY_SIZE(cgroupGroup_),
+        .type_ = DumperConstant::NONE,
+        .expand_ = false,
+    },
+    {
+        .name_ = "group_net",
         .desc_ = "group of net dumper",
         .list_ = netGroup_,
         .size_ = ARRAY_SIZE(netGroup_),
@@ -1877,15 +2050,15 @@ const ConfigData::GroupCfg ConfigData::groups_[] = {
         .expand_ = false,
     },
     {
-        .name_ = ConfigData::CONFIG_GROUP_SERVICE,
+        .name_ = "group_service",
         .desc_ = "group of service dumper",
-        .list_ = serviceGroup_,
-        .size_ = ARRAY_SIZE(serviceGroup_),
+        .list_ = nullptr,
+        .size_ = 0,
         .type_ = DumperConstant::NONE,
         .expand_ = false,
     },
     {
-        .name_ = ConfigData::CONFIG_GROUP_ABILITY,
+        .name_ = "group_ability",
         .desc_ = "group of ability dumper",
         .list_ = systemAbilityGroup_,
         .size_ = ARRAY_SIZE(systemAbilityGroup_),
@@ -1893,7 +2066,7 @@ const ConfigData::GroupCfg ConfigData::groups_[] = {
         .expand_ = false,
     },
     {
-        .name_ = ConfigData::CONFIG_GROUP_SYSTEM_BASE,
+        .name_ = "group_system_base",
         .desc_ = "group of base log dumper",
         .list_ = systemBaseGroup_,
         .size_ = ARRAY_SIZE(systemBaseGroup_),
@@ -1901,7 +2074,7 @@ const ConfigData::GroupCfg ConfigData::groups_[] = {
         .expand_ = false,
     },
     {
-        .name_ = ConfigData::CONFIG_GROUP_SYSTEM_SYSTEM,
+        .name_ = "group_system_system",
         .desc_ = "group of system log dumper",
         .list_ = systemSystemGroup_,
         .size_ = ARRAY_SIZE(systemSystemGroup_),
@@ -1909,7 +2082,7 @@ const ConfigData::GroupCfg ConfigData::groups_[] = {
         .expand_ = false,
     },
     {
-        .name_ = ConfigData::CONFIG_GROUP_PROCESSES,
+        .name_ = "group_processes",
         .desc_ = "group of processes dumper",
         .list_ = processesGroup_,
         .size_ = ARRAY_SIZE(processesGroup_),
@@ -1917,7 +2090,7 @@ const ConfigData::GroupCfg ConfigData::groups_[] = {
         .expand_ = false,
     },
     {
-        .name_ = ConfigData::CONFIG_GROUP_PROCESSES_ENG,
+        .name_ = "group_processesEng",
         .desc_ = "group of processes dumper by eng ",
         .list_ = processesGroup_eng_,
         .size_ = ARRAY_SIZE(processesGroup_eng_),
@@ -1925,7 +2098,7 @@ const ConfigData::GroupCfg ConfigData::groups_[] = {
         .expand_ = false,
     },
     {
-        .name_ = ConfigData::CONFIG_GROUP_PROCESSES_PID,
+        .name_ = "group_pid_processes",
         .desc_ = "group of processes pid dumper",
         .list_ = processesPidGroup_,
         .size_ = ARRAY_SIZE(processesPidGroup_),
@@ -1933,7 +2106,7 @@ const ConfigData::GroupCfg ConfigData::groups_[] = {
         .expand_ = false,
     },
     {
-        .name_ = ConfigData::CONFIG_GROUP_PROCESSES_PID_ENG,
+        .name_ = "group_pid_processesEng",
         .desc_ = "group of processes pid dumper by eng",
         .list_ = processesPidGroup_eng_,
         .size_ = ARRAY_SIZE(processesPidGroup_eng_),
@@ -1941,7 +2114,7 @@ const ConfigData::GroupCfg ConfigData::groups_[] = {
         .expand_ = false,
     },
     {
-        .name_ = ConfigData::CONFIG_GROUP_FAULT_LOG,
+        .name_ = "group_faultlog",
         .desc_ = "group of fault log dumper",
         .list_ = faultLogGroup_,
         .size_ = ARRAY_SIZE(faultLogGroup_),
@@ -1949,7 +2122,7 @@ const ConfigData::GroupCfg ConfigData::groups_[] = {
         .expand_ = false,
     },
     {
-        .name_ = ConfigData::CONFIG_GROUP_STACK,
+        .name_ = "group_stack",
         .desc_ = "group of stack dumper",
         .list_ = stackGroup_,
         .size_ = ARRAY_SIZE(stackGroup_),
@@ -1957,7 +2130,7 @@ const ConfigData::GroupCfg ConfigData::groups_[] = {
         .expand_ = true,
     },
     {
-        .name_ = ConfigData::CONFIG_GROUP_TEST,
+        .name_ = "group_test",
         .desc_ = "group of test dumper",
         .list_ = testGroup_,
         .size_ = ARRAY_SIZE(testGroup_),
@@ -2022,9 +2195,24 @@ const ConfigData::GroupCfg ConfigData::groups_[] = {
     },
 };
 
-const int ConfigData::dumperSum_ = ARRAY_SIZE(dumpers_);
-const int ConfigData::groupSum_ = ARRAY_SIZE(groups_);
-const int ConfigData::NEST_MAX = 10;
+constexpr int ConfigData::dumperSum_ = ARRAY_SIZE(dumpers_);
+constexpr int ConfigData::groupSum_ = ARRAY_SIZE(groups_);
+constexpr int ConfigData::NEST_MAX = 10;
+
+int ConfigData::FindDumper(std::string_view name)
+{
+    static constexpr NameIndex<GetSlotSize(dumperSum_)> index(dumpers_, dumperSum_);
+    static_assert(index.IsValid(), "dumper names must be unique");
+    return index.Find(dumpers_, name);
+}
+
+int ConfigData::FindGroup(std::string_view name)
+{
+    static constexpr NameIndex<GetSlotSize(groupSum_)> index(groups_, groupSum_);
+    static_assert(index.IsValid(), "group names must be unique");
+    static_assert(HasValidItems(groups_, groupSum_, dumpers_, dumperSum_), "group items must be known names");
+    return index.Find(groups_, name);
+}
 
 ConfigData::ConfigData()
 {
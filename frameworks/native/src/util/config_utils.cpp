@@ -13,12 +13,16 @@
  * limitations under the License.
  */
 #include "util/config_utils.h"
+#include <climits>
+#include <mutex>
+#include <unistd.h>
 #include "directory_ex.h"
 #include "hilog_wrapper.h"
 #include "dump_common_utils.h"
 #include "dump_utils.h"
 #include "parameter.h"
 #include "common/dumper_constant.h"
+#include "util/dump_plan_cache.h"
 namespace OHOS {
 namespace HiviewDFX {
 namespace {
@@ -27,9 +31,39 @@ constexpr int APP_FIRST_UID = 10000;
 static const std::string SMAPS_PATH = "smaps/";
 static const std::string SMAPS_PATH_START = "/proc/";
 static const std::string SMAPS_PATH_END = "/smaps";
+static const char PLAN_KEY_SEPARATOR = ',';
+static const std::string CONFIG_BLOB_PATHS[] = {
+    "/system/etc/hidumper/dumper_config.bin",
+    "/vendor/etc/hidumper/dumper_config.bin",
+};
+std::mutex g_configBlobsMutex;
+std::shared_ptr<const std::vector<std::shared_ptr<const DumpConfigBlob>>> g_configBlobs;
+
+// smaps are copied while the configs are got, a plan would skip it.
+bool IsPlanUsable(const DumperOpts &opts)
+{
+    return !(opts.isDumpProcesses_ && opts.IsDumpZip());
+}
+
+void AppendPlanKey(std::string &key, int value)
+{
+    key += std::to_string(value);
+    key += PLAN_KEY_SEPARATOR;
+}
+
+void AppendPlanKey(std::string &key, const std::vector<std::string> &values)
+{
+    AppendPlanKey(key, static_cast<int>(values.size()));
+    for (auto &value : values) {
+        // sized, so a separator in an argument can not make two keys equal.
+        AppendPlanKey(key, static_cast<int>(value.size()));
+        key += value;
+    }
+}
 } // namespace
 
-ConfigUtils::ConfigUtils(const std::shared_ptr<DumperParameter> &param) : dumperParam_(param)
+ConfigUtils::ConfigUtils(const std::shared_ptr<DumperParameter> &param)
+    : dumperParam_(param), blobs_(GetConfigBlobs())
 {
 }
 
@@ -37,7 +71,7 @@ ConfigUtils::~ConfigUtils()
 {
     pidInfos_.clear();
     cpuInfos_.clear();
-    currentPidInfos_.clear();
+    ClearCurrentPidInfos();
     currentPidInfo_.Reset();
 }
 
@@ -47,8 +81,13 @@ DumpStatus ConfigUtils::GetDumperConfigs(const std::shared_ptr<DumperParameter>
     DumpStatus ret = DumpStatus::DUMP_FAIL;
 
     if (param != nullptr) {
-        ConfigUtils configUtils(param);
-        ret = configUtils.GetDumperConfigs();
+        std::string key = GetPlanKey(param->GetOpts(), param->GetUid());
+        if (IsPlanUsable(param->GetOpts()) && GetPlanDumperConfigs(param, key)) {
+            ret = DumpStatus::DUMP_OK;
+        } else {
+            ConfigUtils configUtils(param);
+            ret = configUtils.GetDumperConfigs();
+        }
     }
 
     if (ret == DumpStatus::DUMP_OK) {
@@ -66,21 +105,18 @@ DumpStatus ConfigUtils::GetDumperConfigs()
 {
     DUMPER_HILOGD(MODULE_COMMON, "enter|");
 
-    DumpCommonUtils::GetPidInfos(pidInfos_);
-    DumpCommonUtils::GetCpuInfos(cpuInfos_);
-    DUMPER_HILOGD(MODULE_COMMON, "debug|pidInfos=%{public}zu, cpuInfos=%{public}zu",
-        pidInfos_.size(), cpuInfos_.size());
-
     std::vector<std::shared_ptr<DumpCfg>> dumpCfgs;
 
     currentPidInfo_.Reset();
-    currentPidInfos_.clear();
+    ClearCurrentPidInfos();
 
     HandleDumpCpuFreq(dumpCfgs);  // cpuid
     HandleDumpCpuUsage(dumpCfgs); // pid
+    HandleDumpSchedStat(dumpCfgs); // pid
     HandleDumpLog(dumpCfgs);
     HandleDumpMem(dumpCfgs);
     HandleDumpStorage(dumpCfgs);
+    HandleDumpCgroup(dumpCfgs);
     HandleDumpNet(dumpCfgs);
     HandleDumpList(dumpCfgs);
     HandleDumpAbility(dumpCfgs);
@@ -91,7 +127,17 @@ DumpStatus ConfigUtils::GetDumperConfigs()
     HandleDumpAppendix(dumpCfgs);
     HandleDumpTest(dumpCfgs);
 
-    DUMPER_HILOGD(MODULE_COMMON, "debug|dumpCfgs=%{public}zu", dumpCfgs.size());
+    DUMPER_HILOGD(MODULE_COMMON, "debug|dumpCfgs=%{public}zu, pidInfos=%{public}zu, cpuInfos=%{public}zu",
+        dumpCfgs.size(), pidInfos_.size(), cpuInfos_.size());
+
+    const DumperOpts &dumperOpts = dumperParam_->GetOpts();
+    if (IsPlanUsable(dumperOpts)) {
+        auto plan = std::make_shared<DumpPlanCache::Plan>();
+        plan->inputs = planInputs_;
+        GetPlanInputValues(dumperOpts, planInputs_, pidInfos_, cpuInfos_, plan->inputValues);
+        DumpPlanCache::CloneConfigs(dumpCfgs, plan->configs);
+        DumpPlanCache::GetInstance().Add(GetPlanKey(dumperOpts, dumperParam_->GetUid()), plan);
+    }
 
     dumperParam_->SetExecutorConfigList(dumpCfgs);
 
@@ -99,6 +145,129 @@ DumpStatus ConfigUtils::GetDumperConfigs()
     return DumpStatus::DUMP_OK;
 }
 
+bool ConfigUtils::GetPlanDumperConfigs(const std::shared_ptr<DumperParameter> &param, const std::string &key)
+{
+    std::shared_ptr<const DumpPlanCache::Plan> plan = DumpPlanCache::GetInstance().Find(key);
+    if (plan == nullptr) {
+        return false;
+    }
+    // the expansion is the part of a plan which may be out of date.
+    std::vector<DumpCommonUtils::PidInfo> pidInfos;
+    std::vector<DumpCommonUtils::CpuInfo> cpuInfos;
+    if ((plan->inputs & DumpPlanCache::PLAN_INPUT_PIDS) != 0) {
+        DumpCommonUtils::GetPidUids(pidInfos);
+    }
+    if ((plan->inputs & DumpPlanCache::PLAN_INPUT_CPUS) != 0) {
+        DumpCommonUtils::GetCpuInfos(cpuInfos);
+    }
+    std::vector<int> values;
+    GetPlanInputValues(param->GetOpts(), plan->inputs, pidInfos, cpuInfos, values);
+    if (values != plan->inputValues) {
+        DUMPER_HILOGD(MODULE_COMMON, "debug|plan out of date");
+        return false;
+    }
+    std::vector<std::shared_ptr<DumpCfg>> dumpCfgs;
+    DumpPlanCache::CloneConfigs(plan->configs, dumpCfgs);
+    DUMPER_HILOGD(MODULE_COMMON, "debug|plan, dumpCfgs=%{public}zu", dumpCfgs.size());
+    param->SetExecutorConfigList(dumpCfgs);
+    return true;
+}
+
+std::string ConfigUtils::GetPlanKey(const DumperOpts &opts, int uid)
+{
+    // the options read by the HandleDump* functions, the uid selects the levels.
+    std::string key;
+    AppendPlanKey(key, uid);
+    AppendPlanKey(key, opts.isDumpCpuFreq_);
+    AppendPlanKey(key, opts.isDumpCpuUsage_ ? opts.cpuUsagePid_ : INT_MIN);
+    AppendPlanKey(key, opts.isDumpSchedStat_ ? opts.schedStatPid_ : INT_MIN);
+    AppendPlanKey(key, opts.isDumpLog_);
+    AppendPlanKey(key, opts.logArgs_);
+    AppendPlanKey(key, opts.isDumpMem_ ? opts.memPid_ : INT_MIN);
+    AppendPlanKey(key, opts.isDumpStorage_);
+    AppendPlanKey(key, opts.isDumpCgroup_);
+    AppendPlanKey(key, opts.isDumpNet_);
+    AppendPlanKey(key, opts.isDumpList_);
+    AppendPlanKey(key, opts.isDumpService_);
+    AppendPlanKey(key, opts.isDumpSystemAbility_);
+    AppendPlanKey(key, opts.abilitieNames_);
+    AppendPlanKey(key, opts.abilitieArgs_);
+    AppendPlanKey(key, opts.isDumpSystem_);
+    AppendPlanKey(key, opts.systemArgs_);
+    AppendPlanKey(key, opts.isDumpProcesses_ ? opts.processPid_ : INT_MIN);
+    AppendPlanKey(key, opts.isFaultLog_);
+    AppendPlanKey(key, opts.isAppendix_);
+    AppendPlanKey(key, opts.isTest_);
+    return key;
+}
+
+void ConfigUtils::GetPlanInputValues(const DumperOpts &opts, uint32_t inputs,
+                                     const std::vector<DumpCommonUtils::PidInfo> &pidInfos,
+                                     const std::vector<DumpCommonUtils::CpuInfo> &cpuInfos, std::vector<int> &values)
+{
+    // a process given by pid is looked up whatever the inputs, its level depends on its uid.
+    const int pids[] = {
+        opts.isDumpCpuUsage_ ? opts.cpuUsagePid_ : -1,
+        opts.isDumpSchedStat_ ? opts.schedStatPid_ : -1,
+        opts.isDumpMem_ ? opts.memPid_ : -1,
+        opts.isDumpProcesses_ ? opts.processPid_ : -1,
+    };
+    for (int pid : pids) {
+        if (pid < 0) {
+            continue;
+        }
+        int uid = -1;
+        (void)DumpCommonUtils::GetProcessUid(pid, uid);
+        values.push_back(uid);
+    }
+    if ((inputs & DumpPlanCache::PLAN_INPUT_PIDS) != 0) {
+        for (auto &pidInfo : pidInfos) {
+            values.push_back(pidInfo.pid_);
+            values.push_back(pidInfo.uid_);
+        }
+    }
+    if ((inputs & DumpPlanCache::PLAN_INPUT_CPUS) != 0) {
+        for (auto &cpuInfo : cpuInfos) {
+            values.push_back(cpuInfo.id_);
+        }
+    }
+}
+
+void ConfigUtils::LoadConfigBlobs()
+{
+    ConfigBlobs blobs;
+    for (auto &path : CONFIG_BLOB_PATHS) {
+        if (access(path.c_str(), F_OK) != 0) {
+            continue;
+        }
+        auto blob = std::make_shared<DumpConfigBlob>();
+        if (!blob->Open(path)) {
+            DUMPER_HILOGE(MODULE_COMMON, "error|invalid config blob, path=%{public}s", path.c_str());
+            continue;
+        }
+        DUMPER_HILOGI(MODULE_COMMON, "info|config blob, path=%{public}s, dumpers=%{public}d, groups=%{public}d",
+            path.c_str(), blob->GetDumperSum(), blob->GetGroupSum());
+        blobs.push_back(blob);
+    }
+    SetConfigBlobs(blobs);
+}
+
+void ConfigUtils::SetConfigBlobs(const std::vector<std::shared_ptr<const DumpConfigBlob>> &blobs)
+{
+    {
+        std::lock_guard<std::mutex> lock(g_configBlobsMutex);
+        g_configBlobs = std::make_shared<const ConfigBlobs>(blobs);
+    }
+    // the plans were made from the configs before.
+    DumpPlanCache::GetInstance().Clear();
+}
+
+std::shared_ptr<const ConfigUtils::ConfigBlobs> ConfigUtils::GetConfigBlobs()
+{
+    std::lock_guard<std::mutex> lock(g_configBlobsMutex);
+    return g_configBlobs;
+}
+
 DumpStatus ConfigUtils::GetSectionNames(const std::string &name, std::vector<std::string> &nameList)
 {
     std::vector<std::string> tmpUse;
@@ -119,7 +288,20 @@ DumpStatus ConfigUtils::GetGroupNames(const std::string &name, std::vector<std::
         if (check && (groups_[i].name_.find(name) != 0)) {
             continue;
         }
-        nameList.push_back(groups_[i].name_);
+        nameList.push_back(std::string(groups_[i].name_));
+    }
+    auto blobs = GetConfigBlobs();
+    if (blobs == nullptr) {
+        return DumpStatus::DUMP_OK;
+    }
+    for (auto &blob : *blobs) {
+        for (int i = 0; i < blob->GetGroupSum(); i++) {
+            const GroupCfg groupCfg = blob->GetGroup(i);
+            if (groupCfg.name_.empty() || (check && (groupCfg.name_.find(name) != 0))) {
+                continue;
+            }
+            nameList.push_back(std::string(groupCfg.name_));
+        }
     }
     return DumpStatus::DUMP_OK;
 }
@@ -137,10 +319,12 @@ std::string ConfigUtils::GetSectionName(const std::string &name)
 bool ConfigUtils::MergePidInfos(std::vector<DumpCommonUtils::PidInfo> &pidInfos, int pid)
 {
     pidInfos.clear();
+    allPids_ = false;
     if (pid < 0) {
         currentPidInfo_.pid_ = pid;
         currentPidInfo_.uid_ = -1;
-        pidInfos.assign(pidInfos_.begin(), pidInfos_.end());
+        // the processes are listed when a group is expanded by them, most groups only take the pid -1.
+        allPids_ = true;
     } else {
         if (DumpCommonUtils::GetProcessInfo(pid, currentPidInfo_)) {
             pidInfos.push_back(currentPidInfo_);
@@ -149,6 +333,36 @@ bool ConfigUtils::MergePidInfos(std::vector<DumpCommonUtils::PidInfo> &pidInfos,
     return true;
 }
 
+void ConfigUtils::ClearCurrentPidInfos()
+{
+    currentPidInfos_.clear();
+    allPids_ = false;
+}
+
+const std::vector<DumpCommonUtils::PidInfo> &ConfigUtils::GetCurrentPidInfos()
+{
+    if (!allPids_) {
+        return currentPidInfos_;
+    }
+    if (!pidInfosDone_) {
+        // the uid is all a group expanded by process needs, for the level of the process.
+        DumpCommonUtils::GetPidUids(pidInfos_);
+        pidInfosDone_ = true;
+        planInputs_ |= DumpPlanCache::PLAN_INPUT_PIDS;
+    }
+    return pidInfos_;
+}
+
+const std::vector<DumpCommonUtils::CpuInfo> &ConfigUtils::GetCpuInfos()
+{
+    if (!cpuInfosDone_) {
+        DumpCommonUtils::GetCpuInfos(cpuInfos_);
+        cpuInfosDone_ = true;
+        planInputs_ |= DumpPlanCache::PLAN_INPUT_CPUS;
+    }
+    return cpuInfos_;
+}
+
 bool ConfigUtils::HandleDumpLog(std::vector<std::shared_ptr<DumpCfg>> &dumpCfgs)
 {
     const DumperOpts &dumperOpts = dumperParam_->GetOpts();
@@ -158,7 +372,7 @@ bool ConfigUtils::HandleDumpLog(std::vector<std::shared_ptr<DumpCfg>> &dumpCfgs)
 
     DUMPER_HILOGD(MODULE_COMMON, "debug|log");
     currentPidInfo_.Reset();
-    currentPidInfos_.clear();
+    ClearCurrentPidInfos();
 
     auto args = OptionArgs::Create();
     args->SetStrList(dumperOpts.logArgs_);
@@ -167,7 +381,7 @@ bool ConfigUtils::HandleDumpLog(std::vector<std::shared_ptr<DumpCfg>> &dumpCfgs)
         GetConfig(name, dumpCfgs, args);
     }
 
-    currentPidInfos_.clear();
+    ClearCurrentPidInfos();
     currentPidInfo_.Reset();
     return true;
 }
@@ -181,7 +395,7 @@ bool ConfigUtils::HandleDumpList(std::vector<std::shared_ptr<DumpCfg>> &dumpCfgs
 
     DUMPER_HILOGD(MODULE_COMMON, "debug|list");
     currentPidInfo_.Reset();
-    currentPidInfos_.clear();
+    ClearCurrentPidInfos();
 
     if (dumperOpts.isDumpSystemAbility_) {
         DUMPER_HILOGD(MODULE_COMMON, "debug|list ability");
@@ -201,7 +415,7 @@ bool ConfigUtils::HandleDumpList(std::vector<std::shared_ptr<DumpCfg>> &dumpCfgs
         GetConfig(CONFIG_DUMPER_LIST_SYSTEM, dumpCfgs, args);
     }
 
-    currentPidInfos_.clear();
+    ClearCurrentPidInfos();
     currentPidInfo_.Reset();
     return true;
 }
@@ -215,12 +429,12 @@ bool ConfigUtils::HandleDumpService(std::vector<std::shared_ptr<DumpCfg>> &dumpC
 
     DUMPER_HILOGD(MODULE_COMMON, "debug|service");
     currentPidInfo_.Reset();
-    currentPidInfos_.clear();
+    ClearCurrentPidInfos();
 
     std::shared_ptr<OptionArgs> args;
     GetConfig(CONFIG_GROUP_SERVICE, dumpCfgs, args);
 
-    currentPidInfos_.clear();
+    ClearCurrentPidInfos();
     currentPidInfo_.Reset();
     return true;
 }
@@ -234,13 +448,13 @@ bool ConfigUtils::HandleDumpAbility(std::vector<std::shared_ptr<DumpCfg>> &dumpC
 
     DUMPER_HILOGD(MODULE_COMMON, "debug|ability");
     currentPidInfo_.Reset();
-    currentPidInfos_.clear();
+    ClearCurrentPidInfos();
 
     auto args = OptionArgs::Create();
     args->SetNamesAndArgs(dumperOpts.abilitieNames_, dumperOpts.abilitieArgs_);
     GetConfig(CONFIG_GROUP_ABILITY, dumpCfgs, args);
 
-    currentPidInfos_.clear();
+    ClearCurrentPidInfos();
     currentPidInfo_.Reset();
     return true;
 }
@@ -254,7 +468,7 @@ bool ConfigUtils::HandleDumpSystem(std::vector<std::shared_ptr<DumpCfg>> &dumpCf
 
     DUMPER_HILOGD(MODULE_COMMON, "debug|system");
     currentPidInfo_.Reset();
-    currentPidInfos_.clear();
+    ClearCurrentPidInfos();
 
     if (dumperOpts.systemArgs_.empty()) {
         std::shared_ptr<OptionArgs> args;
@@ -270,7 +484,7 @@ bool ConfigUtils::HandleDumpSystem(std::vector<std::shared_ptr<DumpCfg>> &dumpCf
         GetConfig(name, dumpCfgs, args);
     }
 
-    currentPidInfos_.clear();
+    ClearCurrentPidInfos();
     currentPidInfo_.Reset();
     return true;
 }
@@ -284,12 +498,12 @@ bool ConfigUtils::HandleDumpCpuFreq(std::vector<std::shared_ptr<DumpCfg>> &dumpC
 
     DUMPER_HILOGD(MODULE_COMMON, "debug|cpu freq");
     currentPidInfo_.Reset();
-    currentPidInfos_.clear();
+    ClearCurrentPidInfos();
 
     std::shared_ptr<OptionArgs> args;
     GetConfig(CONFIG_GROUP_CPU_FREQ, dumpCfgs, args);
 
-    currentPidInfos_.clear();
+    ClearCurrentPidInfos();
     currentPidInfo_.Reset();
     return true;
 }
@@ -303,13 +517,33 @@ bool ConfigUtils::HandleDumpCpuUsage(std::vector<std::shared_ptr<DumpCfg>> &dump
 
     DUMPER_HILOGD(MODULE_COMMON, "debug|cpu usage");
     currentPidInfo_.Reset();
-    currentPidInfos_.clear();
+    ClearCurrentPidInfos();
     MergePidInfos(currentPidInfos_, dumperOpts.cpuUsagePid_);
 
     std::shared_ptr<OptionArgs> args;
     GetConfig(CONFIG_GROUP_CPU_USAGE, dumpCfgs, args);
 
-    currentPidInfos_.clear();
+    ClearCurrentPidInfos();
+    currentPidInfo_.Reset();
+    return true;
+}
+
+bool ConfigUtils::HandleDumpSchedStat(std::vector<std::shared_ptr<DumpCfg>> &dumpCfgs)
+{
+    const DumperOpts &dumperOpts = dumperParam_->GetOpts();
+    if (!dumperOpts.isDumpSchedStat_) {
+        return false;
+    }
+
+    DUMPER_HILOGD(MODULE_COMMON, "debug|sched stat");
+    currentPidInfo_.Reset();
+    ClearCurrentPidInfos();
+    MergePidInfos(currentPidInfos_, dumperOpts.schedStatPid_);
+
+    std::shared_ptr<OptionArgs> args;
+    GetConfig(CONFIG_GROUP_SCHED_STAT, dumpCfgs, args);
+
+    ClearCurrentPidInfos();
     currentPidInfo_.Reset();
     return true;
 }
@@ -323,13 +557,13 @@ bool ConfigUtils::HandleDumpMem(std::vector<std::shared_ptr<DumpCfg>> &dumpCfgs)
 
     DUMPER_HILOGD(MODULE_COMMON, "debug|mem");
     currentPidInfo_.Reset();
-    currentPidInfos_.clear();
+    ClearCurrentPidInfos();
     MergePidInfos(currentPidInfos_, dumperOpts.memPid_);
 
     std::shared_ptr<OptionArgs> args;
     GetConfig(CONFIG_GROUP_MEMORY, dumpCfgs, args);
 
-    currentPidInfos_.clear();
+    ClearCurrentPidInfos();
     currentPidInfo_.Reset();
     return true;
 }
@@ -343,12 +577,31 @@ bool ConfigUtils::HandleDumpStorage(std::vector<std::shared_ptr<DumpCfg>> &dumpC
 
     DUMPER_HILOGD(MODULE_COMMON, "debug|storage");
     currentPidInfo_.Reset();
-    currentPidInfos_.clear();
+    ClearCurrentPidInfos();
 
     std::shared_ptr<OptionArgs> args;
     GetConfig(CONFIG_GROUP_STORAGE, dumpCfgs, args);
 
-    currentPidInfos_.clear();
+    ClearCurrentPidInfos();
+    currentPidInfo_.Reset();
+    return true;
+}
+
+bool ConfigUtils::HandleDumpCgroup(std::vector<std::shared_ptr<DumpCfg>> &dumpCfgs)
+{
+    const DumperOpts &dumperOpts = dumperParam_->GetOpts();
+    if (!dumperOpts.isDumpCgroup_) {
+        return false;
+    }
+
+    DUMPER_HILOGD(MODULE_COMMON, "debug|cgroup");
+    currentPidInfo_.Reset();
+    ClearCurrentPidInfos();
+
+    std::shared_ptr<OptionArgs> args;
+    GetConfig(CONFIG_GROUP_CGROUP, dumpCfgs, args);
+
+    ClearCurrentPidInfos();
     currentPidInfo_.Reset();
     return true;
 }
@@ -362,12 +615,12 @@ bool ConfigUtils::HandleDumpNet(std::vector<std::shared_ptr<DumpCfg>> &dumpCfgs)
 
     DUMPER_HILOGD(MODULE_COMMON, "debug|net");
     currentPidInfo_.Reset();
-    currentPidInfos_.clear();
+    ClearCurrentPidInfos();
 
     std::shared_ptr<OptionArgs> args;
     GetConfig(CONFIG_GROUP_NET, dumpCfgs, args);
 
-    currentPidInfos_.clear();
+    ClearCurrentPidInfos();
     currentPidInfo_.Reset();
     return true;
 }
@@ -382,7 +635,7 @@ bool ConfigUtils::HandleDumpProcesses(std::vector<std::shared_ptr<DumpCfg>> &dum
 
     DUMPER_HILOGD(MODULE_COMMON, "debug|processes");
     currentPidInfo_.Reset();
-    currentPidInfos_.clear();
+    ClearCurrentPidInfos();
     MergePidInfos(currentPidInfos_, dumperOpts.processPid_);
 
     std::string mode = GetBuildType();
@@ -405,7 +658,7 @@ bool ConfigUtils::HandleDumpProcesses(std::vector<std::shared_ptr<DumpCfg>> &dum
         }
     }
 
-    currentPidInfos_.clear();
+    ClearCurrentPidInfos();
     currentPidInfo_.Reset();
     return true;
 }
@@ -419,12 +672,12 @@ bool ConfigUtils::HandleDumpFaultLog(std::vector<std::shared_ptr<DumpCfg>> &dump
 
     DUMPER_HILOGD(MODULE_COMMON, "debug|fault log");
     currentPidInfo_.Reset();
-    currentPidInfos_.clear();
+    ClearCurrentPidInfos();
 
     std::shared_ptr<OptionArgs> args;
     GetConfig(CONFIG_GROUP_FAULT_LOG, dumpCfgs, args);
 
-    currentPidInfos_.clear();
+    ClearCurrentPidInfos();
     currentPidInfo_.Reset();
     return true;
 }
@@ -438,7 +691,7 @@ bool ConfigUtils::HandleDumpAppendix(std::vector<std::shared_ptr<DumpCfg>> &dump
 
     DUMPER_HILOGD(MODULE_COMMON, "debug|appendix");
     currentPidInfo_.Reset();
-    currentPidInfos_.clear();
+    ClearCurrentPidInfos();
 
     MergePidInfos(currentPidInfos_, -1);
     std::shared_ptr<OptionArgs> args;
@@ -448,7 +701,7 @@ bool ConfigUtils::HandleDumpAppendix(std::vector<std::shared_ptr<DumpCfg>> &dump
     GetConfig(CONFIG_GROUP_LOG_HILOG, dumpCfgs, args);
     GetConfig(CONFIG_GROUP_STACK, dumpCfgs, args);
 
-    currentPidInfos_.clear();
+    ClearCurrentPidInfos();
     currentPidInfo_.Reset();
     return true;
 }
@@ -462,12 +715,12 @@ bool ConfigUtils::HandleDumpTest(std::vector<std::shared_ptr<DumpCfg>> &dumpCfgs
 
     DUMPER_HILOGD(MODULE_COMMON, "debug|test");
     currentPidInfo_.Reset();
-    currentPidInfos_.clear();
+    ClearCurrentPidInfos();
 
     std::shared_ptr<OptionArgs> args;
     GetConfig(CONFIG_GROUP_TEST, dumpCfgs, args);
 
-    currentPidInfos_.clear();
+    ClearCurrentPidInfos();
     currentPidInfo_.Reset();
     return true;
 }
@@ -507,26 +760,28 @@ DumpStatus ConfigUtils::GetConfig(const std::string &name, std::vector<std::shar
 DumpStatus ConfigUtils::GetDumper(int index, std::vector<std::shared_ptr<DumpCfg>> &result,
                                   std::shared_ptr<OptionArgs> args, int level)
 {
-    if ((index < 0) || (index >= dumperSum_)) {
+    DumperCfg dumperCfg {};
+    BlobRef ref {};
+    if (!GetDumperCfg(index, dumperCfg, ref)) {
         return DumpStatus::DUMP_INVALID_ARG;
     }
-    auto itemlist = dumpers_[index].list_;
-    auto itemsize = dumpers_[index].size_;
-    for (int i = 0; i < itemsize; i++) {
-        if (DumpCfg::IsFilter(itemlist[i].class_) && DumpCfg::IsLevel(level)) {
-            if ((itemlist[i].level_ != DumperConstant::LEVEL_ALL) && (itemlist[i].level_ != level)) {
+    for (int i = 0; i < dumperCfg.size_; i++) {
+        // the items of a blob are read from it one by one.
+        const ItemCfg item = (ref.blob == nullptr) ? dumperCfg.list_[i] : ref.blob->GetItem(ref.index, i);
+        if (DumpCfg::IsFilter(item.class_) && DumpCfg::IsLevel(level)) {
+            if ((item.level_ != DumperConstant::LEVEL_ALL) && (item.level_ != level)) {
                 continue;
             }
         }
         auto dumpCfg = DumpCfg::Create();
-        dumpCfg->name_ = itemlist[i].name_;
-        dumpCfg->desc_ = itemlist[i].desc_;
-        dumpCfg->target_ = itemlist[i].target_;
-        dumpCfg->section_ = itemlist[i].section_;
-        dumpCfg->class_ = itemlist[i].class_;
-        dumpCfg->level_ = itemlist[i].level_;
-        dumpCfg->loop_ = itemlist[i].loop_;
-        dumpCfg->filterCfg_ = itemlist[i].filterCfg_;
+        dumpCfg->name_ = item.name_;
+        dumpCfg->desc_ = item.desc_;
+        dumpCfg->target_ = item.target_;
+        dumpCfg->section_ = item.section_;
+        dumpCfg->class_ = item.class_;
+        dumpCfg->level_ = item.level_;
+        dumpCfg->loop_ = item.loop_;
+        dumpCfg->filterCfg_ = item.filterCfg_;
         dumpCfg->args_ = dumpCfg->IsDumper() ? args : nullptr;
         result.push_back(dumpCfg);
     }
@@ -537,107 +792,111 @@ DumpStatus ConfigUtils::GetDumper(const std::string &name, std::vector<std::shar
                                   std::shared_ptr<OptionArgs> args, int level)
 {
     DumpStatus ret = DumpStatus::DUMP_FAIL;
-    int index = -1;
-    for (int i = 0; i < dumperSum_; i++) {
-        if (dumpers_[i].name_.empty()) {
-            continue;
-        }
-        if (name != dumpers_[i].name_) {
-            continue;
-        }
-        index = i;
-        break;
-    }
+    int index = FindDumperIndex(name);
     if (index > -1) {
         ret = GetDumper(index, result, args, level);
     }
     return ret;
 }
 
-DumpStatus ConfigUtils::GetGroupSimple(const GroupCfg &groupCfg, std::vector<std::shared_ptr<DumpCfg>> &result,
+DumpStatus ConfigUtils::GetGroupSimple(const GroupCfg &groupCfg, const BlobRef &ref,
+                                       std::vector<std::shared_ptr<DumpCfg>> &result,
                                        std::shared_ptr<OptionArgs> args, int level, int nest)
 {
     if (nest > NEST_MAX) {
         return DumpStatus::DUMP_INVALID_ARG;
     }
-    if ((groupCfg.list_ == nullptr) || (groupCfg.size_ < 1)) {
+    if (((groupCfg.list_ == nullptr) && (ref.blob == nullptr)) || (groupCfg.size_ < 1)) {
         return DumpStatus::DUMP_OK;
     }
 
-    auto dumpGroup = DumpCfg::Create();
+    int parent = -1;
     if (groupCfg.expand_) {
+        auto dumpGroup = DumpCfg::Create();
         dumpGroup->class_ = DumperConstant::GROUP;
         dumpGroup->name_ = groupCfg.name_;
         dumpGroup->desc_ = groupCfg.desc_;
         dumpGroup->type_ = groupCfg.type_;
         dumpGroup->expand_ = groupCfg.expand_;
         result.push_back(dumpGroup);
+        parent = static_cast<int>(result.size()) - 1;
     }
-    auto &outlist = (groupCfg.expand_) ? dumpGroup->childs_ : result;
+    size_t begin = result.size();
 
+    DumpStatus ret = DumpStatus::DUMP_OK;
     for (int i = 0; i < groupCfg.size_; i++) {
-        if (groupCfg.list_[i].empty()) {
+        std::string_view entry = (ref.blob == nullptr) ? groupCfg.list_[i] : ref.blob->GetEntry(ref.index, i);
+        if (entry.empty()) {
             continue;
         }
-        if (DumpCommonUtils::StartWith(groupCfg.list_[i], CONFIG_DUMPER_)) {
-            GetDumper(groupCfg.list_[i], outlist, args, level);
-        } else if (DumpCommonUtils::StartWith(groupCfg.list_[i], CONFIG_MINIGROUP_)) {
-            GetGroup(groupCfg.list_[i], outlist, args, level, nest + 1);
+        std::string name(entry);
+        if (DumpCommonUtils::StartWith(name, CONFIG_DUMPER_)) {
+            GetDumper(name, result, args, level);
+        } else if (DumpCommonUtils::StartWith(name, CONFIG_MINIGROUP_)) {
+            GetGroup(name, result, args, level, nest + 1);
         } else {
-            DUMPER_HILOGE(MODULE_COMMON, "error|name=%{public}s", groupCfg.name_.c_str());
-            return DumpStatus::DUMP_INVALID_ARG;
+            DUMPER_HILOGE(MODULE_COMMON, "error|name=%{public}s", std::string(groupCfg.name_).c_str());
+            ret = DumpStatus::DUMP_INVALID_ARG;
+            break;
         }
     }
+    if (parent >= 0) {
+        SetParent(result, begin, parent);
+    }
 
-    return DumpStatus::DUMP_OK;
+    return ret;
 }
 
 DumpStatus ConfigUtils::GetGroup(int index, std::vector<std::shared_ptr<DumpCfg>> &result,
                                  std::shared_ptr<OptionArgs> args, int level, int nest)
 {
-    if (nest > NEST_MAX) {
+    GroupCfg groupCfg {};
+    BlobRef ref {};
+    if ((nest > NEST_MAX) || !GetGroupCfg(index, groupCfg, ref)) {
         return DumpStatus::DUMP_INVALID_ARG;
     }
     auto dumpGroup = DumpCfg::Create();
     dumpGroup->class_ = DumperConstant::GROUP;
-    dumpGroup->name_ = groups_[index].name_;
-    dumpGroup->desc_ = groups_[index].desc_;
-    dumpGroup->type_ = groups_[index].type_;
-    dumpGroup->expand_ = groups_[index].expand_;
+    dumpGroup->name_ = groupCfg.name_;
+    dumpGroup->desc_ = groupCfg.desc_;
+    dumpGroup->type_ = groupCfg.type_;
+    dumpGroup->expand_ = groupCfg.expand_;
     result.push_back(dumpGroup);
+    size_t begin = result.size();
     if (dumpGroup->expand_ && (dumpGroup->type_ == DumperConstant::GROUPTYPE_PID)) {
-        for (auto pidInfo : currentPidInfos_) {
+        for (auto pidInfo : GetCurrentPidInfos()) {
             int newLevel = GetDumpLevelByPid(dumperParam_->GetUid(), pidInfo);
             if (newLevel == DumperConstant::LEVEL_NONE) {
                 continue;
             }
             auto newArgs = OptionArgs::Clone(args);
             newArgs->SetPid(pidInfo.pid_, pidInfo.uid_);
-            GetGroupSimple(groups_[index], dumpGroup->childs_, newArgs, newLevel, nest);
+            GetGroupSimple(groupCfg, ref, result, newArgs, newLevel, nest);
         }
     } else if (dumpGroup->expand_ && (dumpGroup->type_ == DumperConstant::GROUPTYPE_CPUID)) {
-        for (auto cpuInfo : cpuInfos_) {
+        for (auto cpuInfo : GetCpuInfos()) {
             auto newArgs = OptionArgs::Clone(args);
             newArgs->SetCpuId(cpuInfo.id_);
-            GetGroupSimple(groups_[index], dumpGroup->childs_, newArgs, level, nest);
+            GetGroupSimple(groupCfg, ref, result, newArgs, level, nest);
         }
     } else if (dumpGroup->type_ == DumperConstant::GROUPTYPE_PID) {
         int newLevel = GetDumpLevelByPid(dumperParam_->GetUid(), currentPidInfo_);
         if (newLevel != DumperConstant::LEVEL_NONE) {
             auto newArgs = OptionArgs::Clone(args);
             newArgs->SetPid(currentPidInfo_.pid_, currentPidInfo_.uid_);
-            GetGroupSimple(groups_[index], dumpGroup->childs_, newArgs, level, nest);
+            GetGroupSimple(groupCfg, ref, result, newArgs, level, nest);
         }
     } else if (dumpGroup->type_ == DumperConstant::GROUPTYPE_CPUID) {
         auto newArgs = OptionArgs::Clone(args);
         newArgs->SetCpuId(-1);
-        GetGroupSimple(groups_[index], dumpGroup->childs_, newArgs, level, nest);
+        GetGroupSimple(groupCfg, ref, result, newArgs, level, nest);
     } else if (dumpGroup->type_ == DumperConstant::NONE) {
-        GetGroupSimple(groups_[index], dumpGroup->childs_, args, level, nest);
+        GetGroupSimple(groupCfg, ref, result, args, level, nest);
     } else {
         DUMPER_HILOGE(MODULE_COMMON, "error|type=%{public}d", dumpGroup->type_);
         return DumpStatus::DUMP_INVALID_ARG;
     }
+    SetParent(result, begin, static_cast<int>(begin) - 1);
     return DumpStatus::DUMP_OK;
 }
 
@@ -648,79 +907,118 @@ DumpStatus ConfigUtils::GetGroup(const std::string &name, std::vector<std::share
         return DumpStatus::DUMP_INVALID_ARG;
     }
     DumpStatus ret = DumpStatus::DUMP_FAIL;
-    int index = -1;
-    // find group
-    for (int i = 0; i < groupSum_; i++) {
-        if (groups_[i].name_.empty()) {
-            continue;
-        }
-        if (name != groups_[i].name_) {
-            continue;
-        }
-        index = i;
-        break;
-    }
+    int index = FindGroupIndex(name);
 
-    // add dump config to tmpUse
-    std::vector<std::shared_ptr<DumpCfg>> tmpUse;
+    size_t begin = result.size();
     if (index > -1) {
-        ret = GetGroup(index, tmpUse, args, level);
+        ret = GetGroup(index, result, args, level);
     }
 
-    if (nest) {
-        result.insert(result.end(), tmpUse.begin(), tmpUse.end());
-    } else {
-        // add section & add config to result
-        SetSection(tmpUse, GetSectionName(name));
-        ConvertTreeToList(tmpUse, result);
+    if (!nest) {
+        SetSection(result, begin, GetSectionName(name));
     }
 
     return ret;
 }
 
-void ConfigUtils::ConvertTreeToList(std::vector<std::shared_ptr<DumpCfg>> &tree,
-                                    std::vector<std::shared_ptr<DumpCfg>> &list, int nest)
+int ConfigUtils::FindDumperIndex(const std::string &name) const
 {
-    if (nest > NEST_MAX) {
-        return;
+    int index = FindDumper(name);
+    if ((index > -1) || (blobs_ == nullptr)) {
+        return index;
     }
-
-    std::vector<std::shared_ptr<DumpCfg>> tmpUsed;
-    for (auto item : tree) {
-        if (item == nullptr) {
-            continue;
+    int base = dumperSum_;
+    for (auto &blob : *blobs_) {
+        index = blob->FindDumper(name);
+        if (index > -1) {
+            return base + index;
         }
-        tmpUsed.push_back(item);
-        if (item->childs_.empty()) {
-            continue;
-        }
-        for (auto child : item->childs_) {
-            child->parent_ = item; // after point to parent, childs must be cleared.
-        }
-        ConvertTreeToList(item->childs_, tmpUsed, nest + 1);
-        item->childs_.clear(); // must clear
+        base += blob->GetDumperSum();
     }
+    return -1;
+}
 
-    list.insert(list.end(), tmpUsed.begin(), tmpUsed.end());
+int ConfigUtils::FindGroupIndex(const std::string &name) const
+{
+    int index = FindGroup(name);
+    if ((index > -1) || (blobs_ == nullptr)) {
+        return index;
+    }
+    int base = groupSum_;
+    for (auto &blob : *blobs_) {
+        index = blob->FindGroup(name);
+        if (index > -1) {
+            return base + index;
+        }
+        base += blob->GetGroupSum();
+    }
+    return -1;
 }
 
-void ConfigUtils::SetSection(std::vector<std::shared_ptr<DumpCfg>> &dumpCfgs, const std::string &section, int nest)
+bool ConfigUtils::GetDumperCfg(int index, DumperCfg &dumperCfg, BlobRef &ref) const
 {
-    if (nest > NEST_MAX) {
-        return;
+    ref = { nullptr, -1 };
+    if (index < 0) {
+        return false;
+    }
+    if (index < dumperSum_) {
+        dumperCfg = dumpers_[index];
+        return true;
+    }
+    index -= dumperSum_;
+    if (blobs_ != nullptr) {
+        for (auto &blob : *blobs_) {
+            if (index < blob->GetDumperSum()) {
+                dumperCfg = blob->GetDumper(index);
+                ref = { blob.get(), index };
+                return true;
+            }
+            index -= blob->GetDumperSum();
+        }
     }
+    return false;
+}
 
-    for (auto dumpCfg : dumpCfgs) {
-        if (dumpCfg == nullptr) {
-            continue;
+bool ConfigUtils::GetGroupCfg(int index, GroupCfg &groupCfg, BlobRef &ref) const
+{
+    ref = { nullptr, -1 };
+    if (index < 0) {
+        return false;
+    }
+    if (index < groupSum_) {
+        groupCfg = groups_[index];
+        return true;
+    }
+    index -= groupSum_;
+    if (blobs_ != nullptr) {
+        for (auto &blob : *blobs_) {
+            if (index < blob->GetGroupSum()) {
+                groupCfg = blob->GetGroup(index);
+                ref = { blob.get(), index };
+                return true;
+            }
+            index -= blob->GetGroupSum();
         }
-        if (dumpCfg->IsDumper()) {
-            dumpCfg->section_ = section;
+    }
+    return false;
+}
+
+void ConfigUtils::SetParent(std::vector<std::shared_ptr<DumpCfg>> &list, size_t begin, int parent)
+{
+    // the configs from begin are in the group, but the ones of a nested group.
+    for (size_t i = begin; i < list.size(); i++) {
+        if ((list[i] != nullptr) && (list[i]->parent_ < 0)) {
+            list[i]->parent_ = parent;
         }
-        if (dumpCfg->childs_.empty()) {
-            continue;
+    }
+}
+
+void ConfigUtils::SetSection(std::vector<std::shared_ptr<DumpCfg>> &dumpCfgs, size_t begin, const std::string &section)
+{
+    for (size_t i = begin; i < dumpCfgs.size(); i++) {
+        if ((dumpCfgs[i] != nullptr) && dumpCfgs[i]->IsDumper()) {
+            dumpCfgs[i]->section_ = section;
         }
-        SetSection(dumpCfg->childs_, section, nest + 1);
     }
 }
 
@@ -737,7 +1035,7 @@ bool ConfigUtils::CopySmaps()
     callback->SetProgressEnabled(true);
     std::string logFolder = callback->GetFolder();
     int uid = dumperParam_->GetUid();
-    for (auto &pidInfo : currentPidInfos_) {
+    for (auto pidInfo : GetCurrentPidInfos()) {
         int newLevel = GetDumpLevelByPid(uid, pidInfo);
         if (newLevel == DumperConstant::LEVEL_NONE) {
             continue;
@@ -747,8 +1045,16 @@ bool ConfigUtils::CopySmaps()
             break;
         }
         callback->UpdateProgress(0);
+        std::string name = pidInfo.name_;
+        if (name.empty()) {
+            // a listed process only has its uid.
+            DumpCommonUtils::PidInfo info;
+            if (DumpCommonUtils::GetProcessInfo(pidInfo.pid_, info)) {
+                name = info.name_;
+            }
+        }
         std::string pid = std::to_string(pidInfo.pid_);
-        std::string desfolder = logFolder + SMAPS_PATH + pidInfo.name_ + "-" + pid;
+        std::string desfolder = logFolder + SMAPS_PATH + name + "-" + pid;
         std::string src = SMAPS_PATH_START + pid + SMAPS_PATH_END;
         std::string des = desfolder + SMAPS_PATH_END;
         ForceCreateDirectory(IncludeTrailingPathDelimiter(desfolder));
@@ -0,0 +1,107 @@
+/*
+ * Copyright (C) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "util/dump_cell_utils.h"
+#include <cctype>
+#include <limits>
+namespace OHOS {
+namespace HiviewDFX {
+namespace {
+static const char PERCENT_CHAR = '%';
+static const char SEPARATOR_CHAR = '-';
+static const std::string BLANK_CHARS = " \t\r\n";
+static const int DECIMAL_BASE = 10;
+} // namespace
+
+std::string DumpCellUtils::Trim(const std::string &str)
+{
+    size_t start = str.find_first_not_of(BLANK_CHARS);
+    if (start == std::string::npos) {
+        return "";
+    }
+    size_t end = str.find_last_not_of(BLANK_CHARS);
+    return str.substr(start, end - start + 1);
+}
+
+bool DumpCellUtils::IsNumber(const std::string &str)
+{
+    size_t len = ((!str.empty()) && (str.back() == PERCENT_CHAR)) ? (str.length() - 1) : str.length();
+    size_t pos = ((len > 0) && (str[0] == '-')) ? 1 : 0;
+    size_t digits = pos;
+    while ((pos < len) && isdigit(static_cast<unsigned char>(str[pos]))) {
+        pos++;
+    }
+    if ((pos == digits) || ((str[digits] == '0') && (pos - digits > 1))) {
+        return false;
+    }
+    if ((pos < len) && (str[pos] == '.')) {
+        size_t fraction = ++pos;
+        while ((pos < len) && isdigit(static_cast<unsigned char>(str[pos]))) {
+            pos++;
+        }
+        if (pos == fraction) {
+            return false;
+        }
+    }
+    return (pos == len);
+}
+
+bool DumpCellUtils::ParseNumber(const std::string &str, int64_t &mantissa, uint8_t &scale, bool &percent)
+{
+    if (!IsNumber(str)) {
+        return false;
+    }
+    percent = (str.back() == PERCENT_CHAR);
+    size_t len = percent ? (str.length() - 1) : str.length();
+    bool negative = (str[0] == '-');
+    uint64_t value = 0;
+    bool fraction = false;
+    scale = 0;
+    for (size_t i = negative ? 1 : 0; i < len; i++) {
+        if (str[i] == '.') {
+            fraction = true;
+            continue;
+        }
+        uint64_t digit = static_cast<uint64_t>(str[i] - '0');
+        if (value > (static_cast<uint64_t>(std::numeric_limits<int64_t>::max()) - digit) / DECIMAL_BASE) {
+            return false; // too long for 64 bits, kept as text
+        }
+        value = value * DECIMAL_BASE + digit;
+        scale += fraction ? 1 : 0;
+    }
+    mantissa = negative ? -static_cast<int64_t>(value) : static_cast<int64_t>(value);
+    return true;
+}
+
+bool DumpCellUtils::IsSeparatorRow(const std::vector<std::string> &line)
+{
+    for (const auto &cell : line) {
+        if (Trim(cell).find_first_not_of(SEPARATOR_CHAR) != std::string::npos) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool DumpCellUtils::HasNumber(const std::vector<std::string> &line)
+{
+    for (const auto &cell : line) {
+        if (IsNumber(Trim(cell))) {
+            return true;
+        }
+    }
+    return false;
+}
+} // namespace HiviewDFX
+} // namespace OHOS
@@ -0,0 +1,219 @@
+/*
+ * Copyright (C) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "util/dump_cgroup_util.h"
+#include <cstdlib>
+#include <dirent.h>
+#include "file_ex.h"
+#include "string_ex.h"
+#include "hilog_wrapper.h"
+namespace OHOS {
+namespace HiviewDFX {
+namespace {
+static const int DECIMAL_BASE = 10;
+static const std::string CGROUP2_FS_TYPE = "cgroup2";
+}
+const std::string DumpCgroupUtil::DEFAULT_CGROUP_ROOT = "/sys/fs/cgroup";
+const std::string DumpCgroupUtil::MOUNTS_FILE_PATH = "/proc/mounts";
+
+DumpCgroupUtil::DumpCgroupUtil()
+{
+    DUMPER_HILOGD(MODULE_COMMON, "create debug|");
+}
+
+DumpCgroupUtil::~DumpCgroupUtil()
+{
+    DUMPER_HILOGD(MODULE_COMMON, "release debug|");
+    oldCgroups_.clear();
+}
+
+bool DumpCgroupUtil::GetCgroupRoot(std::string &root)
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    if (!cgroupRoot_.empty()) {
+        root = cgroupRoot_;
+        return true;
+    }
+    // <device> <mount point> <fs type> <options> 0 0
+    std::string rawData;
+    std::vector<std::string> lines;
+    if (LoadStringFromFile(MOUNTS_FILE_PATH, rawData)) {
+        SplitStr(rawData, "\n", lines);
+    }
+    for (const auto &line : lines) {
+        std::vector<std::string> fields;
+        SplitStr(line, " ", fields);
+        if ((fields.size() > MOUNT_INFO_TYPE_INDEX) && (fields[MOUNT_INFO_TYPE_INDEX] == CGROUP2_FS_TYPE)) {
+            cgroupRoot_ = fields[1];
+            root = cgroupRoot_;
+            return true;
+        }
+    }
+    // mounted in another mount namespace, try the usual place.
+    if (FileExists(DEFAULT_CGROUP_ROOT + "/cgroup.controllers")) {
+        cgroupRoot_ = DEFAULT_CGROUP_ROOT;
+        root = cgroupRoot_;
+        return true;
+    }
+    DUMPER_HILOGE(MODULE_COMMON, "cgroup2 isn't mounted.");
+    return false;
+}
+
+bool DumpCgroupUtil::GetCurCgroupInfo(std::vector<std::shared_ptr<CgroupInfo>> &cgroupInfos)
+{
+    cgroupInfos.clear();
+    std::string root;
+    if (!GetCgroupRoot(root)) {
+        return false;
+    }
+
+    // breadth first, so the parents are listed before their children.
+    std::vector<std::pair<std::string, size_t>> pendings;
+    pendings.push_back(std::make_pair("/", 0));
+    for (size_t i = 0; i < pendings.size(); i++) {
+        std::string path = pendings[i].first;
+        size_t depth = pendings[i].second;
+        std::shared_ptr<CgroupInfo> cgroupInfo = std::make_shared<CgroupInfo>();
+        ReadCgroupInfo(root, path, cgroupInfo);
+        cgroupInfos.push_back(cgroupInfo);
+        if (depth >= MAX_CGROUP_DEPTH) {
+            continue;
+        }
+
+        DIR *dir = opendir((root + path).c_str());
+        if (dir == nullptr) {
+            continue;
+        }
+        while (true) {
+            struct dirent *child = readdir(dir);
+            if (child == nullptr) {
+                break;
+            }
+            std::string name(child->d_name);
+            if ((child->d_type != DT_DIR) || (name == ".") || (name == "..")) {
+                continue;
+            }
+            pendings.push_back(std::make_pair(path + name + "/", depth + 1));
+        }
+        closedir(dir);
+    }
+    return true;
+}
+
+bool DumpCgroupUtil::GetOldCgroupInfo(std::vector<std::shared_ptr<CgroupInfo>> &cgroupInfos, uint64_t &tick)
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    if (oldCgroups_.empty()) {
+        return false;
+    }
+    cgroupInfos.assign(oldCgroups_.begin(), oldCgroups_.end());
+    tick = oldCgroupsTick_;
+    return true;
+}
+
+void DumpCgroupUtil::SetOldCgroupInfo(const std::vector<std::shared_ptr<CgroupInfo>> &cgroupInfos, uint64_t tick)
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    oldCgroups_.assign(cgroupInfos.begin(), cgroupInfos.end());
+    oldCgroupsTick_ = tick;
+}
+
+void DumpCgroupUtil::BuildCgroupInfoMap(const std::vector<std::shared_ptr<CgroupInfo>> &cgroupInfos,
+    CgroupInfoMap &cgroupMap)
+{
+    cgroupMap.clear();
+    cgroupMap.reserve(cgroupInfos.size());
+    for (const auto &cgroupInfo : cgroupInfos) {
+        if (cgroupInfo == nullptr) {
+            continue;
+        }
+        cgroupMap.emplace(cgroupInfo->path, cgroupInfo);
+    }
+}
+
+void DumpCgroupUtil::ReadCgroupInfo(const std::string &root, const std::string &path,
+    std::shared_ptr<CgroupInfo> &cgroupInfo)
+{
+    std::string dir = root + path;
+    cgroupInfo->path = path;
+    cgroupInfo->hasCpuStat = ReadCpuStat(dir, cgroupInfo);
+    cgroupInfo->hasMemory = ReadMemoryStat(dir, cgroupInfo);
+    cgroupInfo->hasMemPressure = DumpPsiUtil::GetInstance().GetPsiInfoFromFile(dir + "memory.pressure",
+        cgroupInfo->memPressure);
+}
+
+bool DumpCgroupUtil::ReadCpuStat(const std::string &dir, std::shared_ptr<CgroupInfo> &cgroupInfo)
+{
+    cgroupInfo->usageUsec = 0;
+    cgroupInfo->userUsec = 0;
+    cgroupInfo->systemUsec = 0;
+    std::unordered_map<std::string, uint64_t> values;
+    if (!ReadKeyValues(dir + "cpu.stat", values)) {
+        return false;
+    }
+    cgroupInfo->usageUsec = values["usage_usec"];
+    cgroupInfo->userUsec = values["user_usec"];
+    cgroupInfo->systemUsec = values["system_usec"];
+    return true;
+}
+
+bool DumpCgroupUtil::ReadMemoryStat(const std::string &dir, std::shared_ptr<CgroupInfo> &cgroupInfo)
+{
+    cgroupInfo->memCurrent = 0;
+    cgroupInfo->anon = 0;
+    cgroupInfo->file = 0;
+    cgroupInfo->kernel = 0;
+    cgroupInfo->sock = 0;
+    // the root cgroup has memory.stat but no memory.current.
+    std::string current;
+    bool hasCurrent = LoadStringFromFile(dir + "memory.current", current);
+    if (hasCurrent) {
+        cgroupInfo->memCurrent = strtoull(current.c_str(), nullptr, DECIMAL_BASE);
+    }
+    std::unordered_map<std::string, uint64_t> values;
+    if (!ReadKeyValues(dir + "memory.stat", values)) {
+        return hasCurrent;
+    }
+    cgroupInfo->anon = values["anon"];
+    cgroupInfo->file = values["file"];
+    cgroupInfo->sock = values["sock"];
+    auto it = values.find("kernel");
+    if (it != values.end()) {
+        cgroupInfo->kernel = it->second;
+    } else {
+        // "kernel" is only there since 5.18.
+        cgroupInfo->kernel = values["kernel_stack"] + values["pagetables"] + values["slab"];
+    }
+    return true;
+}
+
+bool DumpCgroupUtil::ReadKeyValues(const std::string &filePath, std::unordered_map<std::string, uint64_t> &values)
+{
+    std::string rawData;
+    if (!LoadStringFromFile(filePath, rawData)) {
+        return false;
+    }
+    std::vector<std::string> lines;
+    SplitStr(rawData, "\n", lines);
+    for (const auto &line : lines) {
+        size_t pos = line.find(' ');
+        if (pos == std::string::npos) {
+            continue;
+        }
+        values[line.substr(0, pos)] = strtoull(line.c_str() + pos + 1, nullptr, DECIMAL_BASE);
+    }
+    return true;
+}
+} // namespace HiviewDFX
+} // namespace OHOS
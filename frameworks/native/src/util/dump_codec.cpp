@@ -0,0 +1,110 @@
+/*
+ * Copyright (C) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "util/dump_codec.h"
+#include <cstdlib>
+#include <zlib.h>
+namespace OHOS {
+namespace HiviewDFX {
+namespace {
+static const char LEVEL_SEPARATOR = ':';
+static const int DECIMAL_BASE = 10;
+struct CodecName {
+    const char *name;
+    DumpCodec::Type type;
+    bool hasLevel;
+};
+static const CodecName CODEC_NAMES[] = {
+    { "deflate", DumpCodec::CODEC_DEFLATE, true },
+    { "store", DumpCodec::CODEC_STORE, false },
+};
+} // namespace
+
+const int DumpCodec::DEFAULT_LEVEL = 6;
+const int DumpCodec::MIN_LEVEL = 0;
+const int DumpCodec::MAX_LEVEL = 9;
+const int DumpCodec::ZIP_METHOD_STORE = 0;
+
+DumpCodec::DumpCodec() : type_(CODEC_DEFLATE), level_(DEFAULT_LEVEL)
+{
+}
+
+DumpCodec::DumpCodec(Type type, int level) : type_(type), level_(level)
+{
+}
+
+bool DumpCodec::Parse(const std::string &text, DumpCodec &codec)
+{
+    if (text.empty()) {
+        codec = DumpCodec();
+        return true;
+    }
+    size_t pos = text.find(LEVEL_SEPARATOR);
+    std::string name = text.substr(0, pos);
+    for (auto &item : CODEC_NAMES) {
+        if (name != item.name) {
+            continue;
+        }
+        int level = (item.type == CODEC_STORE) ? MIN_LEVEL : DEFAULT_LEVEL;
+        if (pos != std::string::npos) {
+            std::string levelStr = text.substr(pos + 1);
+            char *end = nullptr;
+            long value = strtol(levelStr.c_str(), &end, DECIMAL_BASE);
+            if (!item.hasLevel || levelStr.empty() || (*end != '\0') || (value < MIN_LEVEL) || (value > MAX_LEVEL)) {
+                return false;
+            }
+            level = static_cast<int>(value);
+        }
+        codec = DumpCodec(item.type, level);
+        return true;
+    }
+    return false;
+}
+
+DumpCodec::Type DumpCodec::GetType() const
+{
+    return type_;
+}
+
+int DumpCodec::GetLevel() const
+{
+    return level_;
+}
+
+std::string DumpCodec::GetName() const
+{
+    for (auto &item : CODEC_NAMES) {
+        if (item.type != type_) {
+            continue;
+        }
+        std::string name = item.name;
+        if (item.hasLevel) {
+            name += LEVEL_SEPARATOR + std::to_string(level_);
+        }
+        return name;
+    }
+    return "";
+}
+
+int DumpCodec::GetZipMethod() const
+{
+    return (type_ == CODEC_STORE) ? ZIP_METHOD_STORE : Z_DEFLATED;
+}
+
+int DumpCodec::GetZlibLevel() const
+{
+    return (type_ == CODEC_STORE) ? Z_NO_COMPRESSION : level_;
+}
+} // namespace HiviewDFX
+} // namespace OHOS
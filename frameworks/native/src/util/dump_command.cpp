@@ -0,0 +1,127 @@
+/*
+ * Copyright (C) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "util/dump_command.h"
+#include <cerrno>
+#include <csignal>
+#include <fcntl.h>
+#include <paths.h>
+#include <unistd.h>
+#include <sys/wait.h>
+#include "hilog_wrapper.h"
+namespace OHOS {
+namespace HiviewDFX {
+namespace {
+static const int PIPE_READ = 0;
+static const int PIPE_WRITE = 1;
+static const int EXEC_FAIL_CODE = 127;
+} // namespace
+
+DumpCommand::DumpCommand() : pid_(-1), fd_(-1)
+{
+}
+
+DumpCommand::~DumpCommand()
+{
+    Kill();
+}
+
+bool DumpCommand::Start(const std::string &cmd)
+{
+    Kill();
+    int fds[] = { -1, -1 };
+    if (pipe2(fds, O_CLOEXEC) != 0) {
+        DUMPER_HILOGE(MODULE_COMMON, "error|pipe, errno=%{public}d", errno);
+        return false;
+    }
+    pid_t pid = fork();
+    if (pid < 0) {
+        DUMPER_HILOGE(MODULE_COMMON, "error|fork, errno=%{public}d", errno);
+        close(fds[PIPE_READ]);
+        close(fds[PIPE_WRITE]);
+        return false;
+    }
+    if (pid == 0) {
+        // only async-signal-safe calls until exec.
+        (void)setpgid(0, 0);
+        if (dup2(fds[PIPE_WRITE], STDOUT_FILENO) < 0) {
+            _exit(EXEC_FAIL_CODE);
+        }
+        execl(_PATH_BSHELL, "sh", "-c", cmd.c_str(), nullptr);
+        _exit(EXEC_FAIL_CODE);
+    }
+    // set in the parent too, the child may not have run yet when it is killed.
+    (void)setpgid(pid, pid);
+    close(fds[PIPE_WRITE]);
+    pid_ = pid;
+    fd_ = fds[PIPE_READ];
+    return true;
+}
+
+bool DumpCommand::IsRunning() const
+{
+    return pid_ > 0;
+}
+
+int DumpCommand::GetOutputFd() const
+{
+    return fd_;
+}
+
+void DumpCommand::Stop(uint64_t waitMs)
+{
+    CloseOutput();
+    for (uint64_t waited = 0; IsRunning(); waited += WAIT_SLICE_MILLSEC) {
+        if (Reap(false)) {
+            return;
+        }
+        if (waited >= waitMs) {
+            DUMPER_HILOGI(MODULE_COMMON, "info|kill command, pid=%{public}d", pid_);
+            Kill();
+            return;
+        }
+        (void)usleep(WAIT_SLICE_MILLSEC * 1000); // 1000: us of a ms
+    }
+}
+
+void DumpCommand::Kill()
+{
+    CloseOutput();
+    if (!IsRunning()) {
+        return;
+    }
+    (void)kill(-pid_, SIGKILL);
+    (void)Reap(true);
+}
+
+void DumpCommand::CloseOutput()
+{
+    if (fd_ >= 0) {
+        close(fd_);
+        fd_ = -1;
+    }
+}
+
+bool DumpCommand::Reap(bool block)
+{
+    int status = 0;
+    pid_t ret = TEMP_FAILURE_RETRY(waitpid(pid_, &status, block ? 0 : WNOHANG));
+    if (ret == 0) {
+        return false;
+    }
+    pid_ = -1;
+    return true;
+}
+} // namespace HiviewDFX
+} // namespace OHOS
@@ -13,128 +13,465 @@
  * limitations under the License.
  */
 #include "util/dump_compressor.h"
+#include <algorithm>
+#include <cerrno>
+#include <climits>
+#include <cstdlib>
+#include <unistd.h>
 #include <securec.h>
+#include "parameter.h"
 
 using namespace std;
 namespace OHOS {
 namespace HiviewDFX {
+namespace {
+static const char WORKERS_PARAM[] = "persist.hidumper.zip.workers";
+static const int PARAM_VALUE_LEN = 32;
+static const int DECIMAL_BASE = 10;
+static const uint32_t DEFAULT_WORKERS = 4;
+static const uint32_t PENDING_BLOCKS_PER_WORKER = 2;
+// a sync flush appends an empty stored block which deflateBound does not count.
+static const size_t SYNC_FLUSH_MARGIN = 16;
+static const unsigned char GZIP_HEADER[] = { 0x1f, 0x8b, Z_DEFLATED, 0, 0, 0, 0, 0, 0, 0x03 };
+static const int GZIP_TRAILER_SIZE = 8;
+static const int BYTE_BITS = 8;
+static const uint32_t BYTE_MASK = 0xff;
+} // namespace
+
+const size_t DumpCompressor::PARALLEL_BLOCK_SIZE = 128 * 1024;
+const size_t DumpCompressor::DICTIONARY_SIZE = 32 * 1024;
+const uint32_t DumpCompressor::MAX_WORKERS = 8;
+
 DumpCompressor::DumpCompressor()
 {
 }
 
-void DumpCompressor::DeleteZData()
+DumpCompressor::~DumpCompressor()
+{
+    Reset();
+    Release();
+}
+
+uint32_t DumpCompressor::GetDefaultWorkers()
+{
+    uint32_t workers = DEFAULT_WORKERS;
+    char value[PARAM_VALUE_LEN] = {0};
+    if (GetParameter(WORKERS_PARAM, "", value, sizeof(value)) > 0) {
+        char *end = nullptr;
+        long long count = strtoll(value, &end, DECIMAL_BASE);
+        if ((end != value) && (count > 0)) {
+            workers = static_cast<uint32_t>(std::min<long long>(count, MAX_WORKERS));
+        }
+    }
+    uint32_t cpus = std::thread::hardware_concurrency();
+    if ((cpus > 0) && (workers > cpus)) {
+        workers = cpus;
+    }
+    return workers;
+}
+
+DumpStatus DumpCompressor::Init(int fd, const DumpCodec &codec, uint32_t workers, Format format)
+{
+    if (fd < 0) {
+        return DumpStatus::DUMP_FAIL;
+    }
+    Reset();
+    fd_ = fd;
+    return Start(codec, workers, format);
+}
+
+DumpStatus DumpCompressor::Init(const Sink &sink, const DumpCodec &codec, uint32_t workers, Format format)
 {
-    if (zData_ != nullptr) {
-        delete zData_;
-    };
-    zData_ = nullptr;
+    if (sink == nullptr) {
+        return DumpStatus::DUMP_FAIL;
+    }
+    Reset();
+    sink_ = sink;
+    return Start(codec, workers, format);
 }
 
-DumpStatus DumpCompressor::Compress(CompressBuffer*& srcBuffer, CompressBuffer*& destBuffer)
+DumpStatus DumpCompressor::Start(const DumpCodec &codec, uint32_t workers, Format format)
 {
-    char buffIn[CHUNK] = { 0 };
-    char buffOut[CHUNK] = { 0 };
+    level_ = codec.GetZlibLevel();
+    format_ = format;
+    crc_ = crc32(0L, Z_NULL, 0);
+    totalIn_ = 0;
+    if (workers > 1) {
+        if ((format_ == FORMAT_GZIP) && (WriteFd(GZIP_HEADER, sizeof(GZIP_HEADER)) != DumpStatus::DUMP_OK)) {
+            Reset();
+            return DumpStatus::DUMP_FAIL;
+        }
+        return StartWorkers(std::min(workers, MAX_WORKERS));
+    }
+    StopWorkers();
+    int windowBits = (format_ == FORMAT_RAW) ? -MAX_WBITS : (MAX_WBITS + WINDOWS_BITS);
+    if (streamReady_ && (streamBits_ == windowBits) && (streamLevel_ == level_)) {
+        // the stream of the previous entry is reused, a reset keeps its allocations.
+        streamReady_ = (deflateReset(&zStream_) == Z_OK);
+    } else if (streamReady_) {
+        (void)deflateEnd(&zStream_);
+        streamReady_ = false;
+    }
+    if (!streamReady_) {
+        zStream_.zalloc = Z_NULL;
+        zStream_.zfree = Z_NULL;
+        zStream_.opaque = Z_NULL;
+        if (deflateInit2(&zStream_, level_, Z_DEFLATED, windowBits, MEM_LEVEL, Z_DEFAULT_STRATEGY) != Z_OK) {
+            Reset();
+            return DumpStatus::DUMP_FAIL;
+        }
+        streamReady_ = true;
+        streamBits_ = windowBits;
+        streamLevel_ = level_;
+    }
+    // the buffers are kept across streams, only allocate them once.
+    inBuffer_.resize(MAX_COMPRESS_BUFFER_SIZE);
+    outBuffer_.resize(MAX_COMPRESS_BUFFER_SIZE);
+    inOffset_ = 0;
+    outOffset_ = 0;
+    active_ = true;
+    return DumpStatus::DUMP_OK;
+}
 
-    uint32_t bound = compressBound(srcBuffer->offset);
-    if (bound == 0) {
+DumpStatus DumpCompressor::Append(const char* data, size_t len)
+{
+    if (!active_ || ((data == nullptr) && (len > 0))) {
         return DumpStatus::DUMP_FAIL;
     }
-    zDataSize_ = (bound < CHUNK) ? CHUNK : bound;
-    zData_ = new unsigned char[zDataSize_];
-    if (zData_ == nullptr) {
+    const unsigned char* src = reinterpret_cast<const unsigned char*>(data);
+    if (!workers_.empty()) {
+        return AppendParallel(src, len);
+    }
+    UpdateCrc(src, len);
+    size_t room = inBuffer_.size() - inOffset_;
+    if (len <= room) {
+        if ((len > 0) && (memcpy_s(inBuffer_.data() + inOffset_, room, src, len) != EOK)) {
+            return DumpStatus::DUMP_FAIL;
+        }
+        inOffset_ += len;
+        return (inOffset_ == inBuffer_.size()) ? FlushInput() : DumpStatus::DUMP_OK;
+    }
+    if (FlushInput() != DumpStatus::DUMP_OK) {
         return DumpStatus::DUMP_FAIL;
     }
-    if (memset_s(zData_, zDataSize_, 0, zDataSize_) != EOK) {
-        DeleteZData();
+    if (len >= inBuffer_.size()) {
+        // no point staging a block bigger than the buffer, deflate it in place.
+        return Deflate(src, len, Z_NO_FLUSH);
+    }
+    if (memcpy_s(inBuffer_.data(), inBuffer_.size(), src, len) != EOK) {
         return DumpStatus::DUMP_FAIL;
-    };
-
-    size_t const toRead = CHUNK;
-    size_t srcPos = 0;
-    size_t dstPos = 0;
-    size_t srcBufferOffset = srcBuffer->offset;
-    int flush = 0;
-    zStream_.zalloc = Z_NULL;
-    zStream_.zfree = Z_NULL;
-    zStream_.opaque = Z_NULL;
-
-    if (deflateInit2(&zStream_, Z_DEFAULT_COMPRESSION, Z_DEFLATED, MAX_WBITS + WINDOWS_BITS,
-        MEM_LEVEL, Z_DEFAULT_STRATEGY) != Z_OK) {
-        DeleteZData();
+    }
+    inOffset_ = len;
+    return DumpStatus::DUMP_OK;
+}
+
+DumpStatus DumpCompressor::Finish()
+{
+    if (!active_) {
         return DumpStatus::DUMP_FAIL;
     }
+    if (!workers_.empty()) {
+        return FinishParallel();
+    }
+    DumpStatus ret = FlushInput();
+    if (ret == DumpStatus::DUMP_OK) {
+        ret = Deflate(nullptr, 0, Z_FINISH);
+    }
+    if ((ret == DumpStatus::DUMP_OK) && (outOffset_ > 0)) {
+        ret = WriteOutput();
+    }
+    if (ret == DumpStatus::DUMP_OK) {
+        active_ = false; // done, the deflate state is kept for the next stream
+    }
+    Reset();
+    return ret;
+}
+
+void DumpCompressor::Reset()
+{
+    // a dropped stream may be half way through a deflate or have blocks on the workers.
+    if (active_) {
+        Release();
+    }
+    active_ = false;
+    fd_ = -1;
+    sink_ = nullptr;
+    inOffset_ = 0;
+    outOffset_ = 0;
+}
+
+void DumpCompressor::Release()
+{
+    if (streamReady_) {
+        (void)deflateEnd(&zStream_);
+        streamReady_ = false;
+    }
+    StopWorkers();
+}
 
-    char* buffInV = buffIn;
-    char* buffOutV = buffOut;
+DumpStatus DumpCompressor::FlushInput()
+{
+    if (inOffset_ == 0) {
+        return DumpStatus::DUMP_OK;
+    }
+    DumpStatus ret = Deflate(inBuffer_.data(), inOffset_, Z_NO_FLUSH);
+    inOffset_ = 0;
+    return ret;
+}
 
+DumpStatus DumpCompressor::Deflate(const unsigned char* data, size_t len, int flush)
+{
+    size_t pos = 0;
+    int zret = Z_OK;
     do {
-        if (FillBuffer(flush, srcBuffer, buffInV, toRead, srcPos, srcBufferOffset) == DumpStatus::DUMP_FAIL) {
-            return DumpStatus::DUMP_FAIL;
+        size_t piece = len - pos;
+        if (piece > UINT_MAX) {
+            piece = UINT_MAX;
         }
-        if (DeflateBuffer(flush, buffOutV, dstPos) == DumpStatus::DUMP_FAIL) {
+        zStream_.next_in = const_cast<Bytef*>(data + pos);
+        zStream_.avail_in = static_cast<uInt>(piece);
+        pos += piece;
+        do {
+            zStream_.next_out = outBuffer_.data() + outOffset_;
+            zStream_.avail_out = static_cast<uInt>(outBuffer_.size() - outOffset_);
+            zret = deflate(&zStream_, flush);
+            if (zret == Z_STREAM_ERROR) {
+                return DumpStatus::DUMP_FAIL;
+            }
+            outOffset_ = outBuffer_.size() - zStream_.avail_out;
+            if ((outOffset_ == outBuffer_.size()) && (WriteOutput() != DumpStatus::DUMP_OK)) {
+                return DumpStatus::DUMP_FAIL;
+            }
+        } while ((zStream_.avail_in > 0) || ((flush == Z_FINISH) && (zret != Z_STREAM_END)));
+    } while (pos < len);
+    return DumpStatus::DUMP_OK;
+}
+
+DumpStatus DumpCompressor::WriteOutput()
+{
+    DumpStatus ret = WriteFd(outBuffer_.data(), outOffset_);
+    outOffset_ = 0;
+    return ret;
+}
+
+DumpStatus DumpCompressor::WriteFd(const unsigned char* data, size_t len)
+{
+    if (sink_ != nullptr) {
+        return sink_(data, len) ? DumpStatus::DUMP_OK : DumpStatus::DUMP_FAIL;
+    }
+    size_t done = 0;
+    while (done < len) {
+        ssize_t ret = write(fd_, data + done, len - done);
+        if (ret < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
             return DumpStatus::DUMP_FAIL;
         }
-    } while (flush != Z_FINISH);
+        done += static_cast<size_t>(ret);
+    }
+    return DumpStatus::DUMP_OK;
+}
 
-    /* clean up and return */
-    (void)deflateEnd(&zStream_);
+void DumpCompressor::UpdateCrc(const unsigned char* data, size_t len)
+{
+    totalIn_ += len;
+    for (size_t pos = 0; pos < len;) {
+        uInt piece = static_cast<uInt>(std::min<size_t>(len - pos, UINT_MAX));
+        crc_ = crc32(crc_, data + pos, piece);
+        pos += piece;
+    }
+}
 
-    if (memcpy_s(destBuffer->content + destBuffer->offset,
-        MAX_COMPRESS_BUFFER_SIZE - destBuffer->offset, zData_, dstPos) != EOK) {
-        DeleteZData();
-        return DumpStatus::DUMP_FAIL;
+DumpStatus DumpCompressor::StartWorkers(uint32_t workers)
+{
+    // the threads of the previous stream are idle once it is finished, keep them.
+    if ((workers_.size() != workers) || (workerLevel_ != level_)) {
+        StopWorkers();
+        workerLevel_ = level_;
+        for (uint32_t i = 0; i < workers; i++) {
+            workers_.emplace_back(&DumpCompressor::WorkerLoop, this);
+        }
     }
-    destBuffer->offset += dstPos;
-    DeleteZData();
+    nextSeq_ = 0;
+    nextWrite_ = 0;
+    prevTail_.clear();
+    curBlock_ = std::make_shared<Block>();
+    curBlock_->in.reserve(PARALLEL_BLOCK_SIZE);
+    active_ = true;
     return DumpStatus::DUMP_OK;
 }
 
-DumpStatus DumpCompressor::FillBuffer(int& flush, CompressBuffer*& srcBuffer, char*& buffIn,
-    size_t const toRead, size_t& src_pos, size_t srcBufferOffset)
+void DumpCompressor::StopWorkers()
 {
-    bool flag = (srcBufferOffset - src_pos) < toRead;
-    (void)memset_s(buffIn, CHUNK, 0, CHUNK);
+    if (workers_.empty()) {
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+        jobs_.clear();
+    }
+    jobCond_.notify_all();
+    for (auto &worker : workers_) {
+        if (worker.joinable()) {
+            worker.join();
+        }
+    }
+    workers_.clear();
+    done_.clear();
+    curBlock_ = nullptr;
+    prevTail_.clear();
+    stopping_ = false;
+}
 
-    if (flag) {
-        if (memmove_s(buffIn, CHUNK, srcBuffer->content + src_pos, srcBufferOffset - src_pos) != EOK) {
-            DeleteZData();
-            return DumpStatus::DUMP_FAIL;
+void DumpCompressor::WorkerLoop()
+{
+    // each worker keeps its own raw deflate state and resets it per block.
+    z_stream stream = {0};
+    stream.zalloc = Z_NULL;
+    stream.zfree = Z_NULL;
+    stream.opaque = Z_NULL;
+    bool ready = (deflateInit2(&stream, workerLevel_, Z_DEFLATED, -MAX_WBITS, MEM_LEVEL, Z_DEFAULT_STRATEGY) == Z_OK);
+    while (true) {
+        std::shared_ptr<Block> block;
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            jobCond_.wait(lock, [this] { return stopping_ || !jobs_.empty(); });
+            if (stopping_) {
+                break;
+            }
+            block = jobs_.front();
+            jobs_.pop_front();
         }
-        zStream_.avail_in = srcBufferOffset - src_pos;
-        src_pos += srcBufferOffset - src_pos;
-    } else {
-        if (memmove_s(buffIn, CHUNK, srcBuffer->content + src_pos, toRead) != EOK) {
-            DeleteZData();
-            return DumpStatus::DUMP_FAIL;
-        };
-        zStream_.avail_in = toRead;
-        src_pos += toRead;
+        block->ok = ready && CompressBlock(stream, *block);
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            done_[block->seq] = block;
+        }
+        doneCond_.notify_all();
+    }
+    if (ready) {
+        (void)deflateEnd(&stream);
     }
+}
 
-    flush = flag ? Z_FINISH : Z_NO_FLUSH;
-    zStream_.next_in = (Bytef*)buffIn;
+bool DumpCompressor::CompressBlock(z_stream &stream, Block &block)
+{
+    if (deflateReset(&stream) != Z_OK) {
+        return false;
+    }
+    if (!block.dict.empty() &&
+        (deflateSetDictionary(&stream, block.dict.data(), static_cast<uInt>(block.dict.size())) != Z_OK)) {
+        return false;
+    }
+    block.crc = crc32(0L, block.in.data(), static_cast<uInt>(block.in.size()));
+    block.out.resize(deflateBound(&stream, block.in.size()) + SYNC_FLUSH_MARGIN);
+    stream.next_in = block.in.data();
+    stream.avail_in = static_cast<uInt>(block.in.size());
+    // only the last block sets BFINAL, the others end byte aligned on a sync flush.
+    int flush = block.last ? Z_FINISH : Z_SYNC_FLUSH;
+    size_t have = 0;
+    int ret = Z_OK;
+    do {
+        if (have == block.out.size()) {
+            block.out.resize(block.out.size() * 2); // 2: grow, should not happen with deflateBound
+        }
+        stream.next_out = block.out.data() + have;
+        stream.avail_out = static_cast<uInt>(block.out.size() - have);
+        ret = deflate(&stream, flush);
+        if (ret == Z_STREAM_ERROR) {
+            return false;
+        }
+        have = block.out.size() - stream.avail_out;
+    } while ((stream.avail_out == 0) || (block.last && (ret != Z_STREAM_END)));
+    block.out.resize(have);
+    block.dict.clear();
+    return true;
+}
+
+DumpStatus DumpCompressor::AppendParallel(const unsigned char* data, size_t len)
+{
+    while (len > 0) {
+        size_t piece = std::min(len, PARALLEL_BLOCK_SIZE - curBlock_->in.size());
+        curBlock_->in.insert(curBlock_->in.end(), data, data + piece);
+        data += piece;
+        len -= piece;
+        if ((curBlock_->in.size() == PARALLEL_BLOCK_SIZE) && (SubmitBlock(false) != DumpStatus::DUMP_OK)) {
+            return DumpStatus::DUMP_FAIL;
+        }
+    }
     return DumpStatus::DUMP_OK;
 }
 
-DumpStatus DumpCompressor::DeflateBuffer(int flush, char*& buffOut, size_t& dstPos)
+DumpStatus DumpCompressor::SubmitBlock(bool last)
 {
-    /* run deflate() on input , finish compression until all of source has been read in. */
-    do {
-        zStream_.avail_out = CHUNK;
-        zStream_.next_out = (Bytef*)buffOut;
-        if (deflate(&zStream_, flush) == Z_STREAM_ERROR) {
-            DeleteZData();
+    std::shared_ptr<Block> block = curBlock_;
+    block->seq = nextSeq_++;
+    block->last = last;
+    block->dict.swap(prevTail_);
+    size_t tail = std::min(block->in.size(), DICTIONARY_SIZE);
+    prevTail_.assign(block->in.end() - tail, block->in.end());
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        jobs_.push_back(block);
+    }
+    jobCond_.notify_one();
+    curBlock_ = std::make_shared<Block>();
+    curBlock_->in.reserve(PARALLEL_BLOCK_SIZE);
+    return WriteBlocks(false);
+}
+
+DumpStatus DumpCompressor::WriteBlocks(bool all)
+{
+    const uint64_t maxPending = workers_.size() * PENDING_BLOCKS_PER_WORKER;
+    while (nextWrite_ < nextSeq_) {
+        std::shared_ptr<Block> block;
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            if (all || ((nextSeq_ - nextWrite_) > maxPending)) {
+                doneCond_.wait(lock, [this] { return done_.count(nextWrite_) > 0; });
+            }
+            auto it = done_.find(nextWrite_);
+            if (it == done_.end()) {
+                break;
+            }
+            block = it->second;
+            done_.erase(it);
+        }
+        if (!block->ok) {
             return DumpStatus::DUMP_FAIL;
         }
-        unsigned have = CHUNK - zStream_.avail_out;
-        if (memmove_s(zData_ + dstPos, zDataSize_ - dstPos, buffOut, have) != EOK) {
-            DeleteZData();
+        crc_ = crc32_combine(crc_, block->crc, static_cast<z_off_t>(block->in.size()));
+        totalIn_ += block->in.size();
+        if (WriteFd(block->out.data(), block->out.size()) != DumpStatus::DUMP_OK) {
             return DumpStatus::DUMP_FAIL;
         }
-        dstPos += have;
-    } while (zStream_.avail_out == 0);
-
+        nextWrite_++;
+    }
     return DumpStatus::DUMP_OK;
 }
+
+DumpStatus DumpCompressor::FinishParallel()
+{
+    DumpStatus ret = SubmitBlock(true);
+    if (ret == DumpStatus::DUMP_OK) {
+        ret = WriteBlocks(true);
+    }
+    if ((ret == DumpStatus::DUMP_OK) && (format_ == FORMAT_GZIP)) {
+        unsigned char trailer[GZIP_TRAILER_SIZE] = {0};
+        uint32_t isize = static_cast<uint32_t>(totalIn_);
+        for (int i = 0; i < GZIP_TRAILER_SIZE / 2; i++) { // 2: crc32 then isize, little endian
+            trailer[i] = static_cast<unsigned char>((crc_ >> (BYTE_BITS * i)) & BYTE_MASK);
+            trailer[i + GZIP_TRAILER_SIZE / 2] = static_cast<unsigned char>((isize >> (BYTE_BITS * i)) & BYTE_MASK);
+        }
+        ret = WriteFd(trailer, sizeof(trailer));
+    }
+    if (ret == DumpStatus::DUMP_OK) {
+        active_ = false; // every block is written, the workers are idle
+    }
+    Reset();
+    return ret;
+}
 } // namespace HiviewDFX
 } // namespace OHOS
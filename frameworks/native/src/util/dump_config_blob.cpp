@@ -0,0 +1,366 @@
+/*
+ * Copyright (C) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "util/dump_config_blob.h"
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "common/dumper_constant.h"
+namespace OHOS {
+namespace HiviewDFX {
+namespace {
+static const int BYTE_BITS = 8;
+static const size_t SIZE_U16 = 2;
+static const size_t SIZE_U32 = 4;
+static const size_t POS_VERSION = CONFIG_BLOB_MAGIC_SIZE;
+static const size_t POS_HEADER_SIZE = POS_VERSION + SIZE_U16;
+static const size_t POS_FILE_SIZE = POS_HEADER_SIZE + SIZE_U16;
+static const size_t POS_CONSTANTS = POS_FILE_SIZE + SIZE_U32;
+static const size_t POS_PARTS = POS_CONSTANTS + SIZE_U32;
+static const size_t PART_SIZE = SIZE_U32 + SIZE_U32;
+static const size_t POS_DUMPER_SEED = POS_PARTS + PART_SIZE * CONFIG_BLOB_PARTS;
+static const size_t POS_GROUP_SEED = POS_DUMPER_SEED + SIZE_U32;
+static const size_t ITEM_STRINGS = 5;
+static const size_t NAME_STRINGS = 2;
+static const size_t POS_RECORD_FIRST = CONFIG_BLOB_STRING_SIZE * NAME_STRINGS;
+static const size_t RECORD_SIZES[CONFIG_BLOB_PARTS] = {
+    1, CONFIG_BLOB_ITEM_SIZE, CONFIG_BLOB_DUMPER_SIZE, CONFIG_BLOB_GROUP_SIZE, CONFIG_BLOB_ENTRY_SIZE,
+    CONFIG_BLOB_SLOT_SIZE, CONFIG_BLOB_SLOT_SIZE,
+};
+
+uint32_t ReadFixed(const char *data, size_t size)
+{
+    uint32_t value = 0;
+    for (size_t i = 0; i < size; i++) {
+        value |= static_cast<uint32_t>(static_cast<uint8_t>(data[i])) << (i * BYTE_BITS);
+    }
+    return value;
+}
+
+bool IsItemClass(int value)
+{
+    return ((value > DumperConstant::DUMPER_BEGIN) && (value < DumperConstant::DUMPER_END)) ||
+        ((value > DumperConstant::FILTER_BEGIN) && (value < DumperConstant::FILTER_END)) ||
+        ((value > DumperConstant::OUTPUT_BEGIN) && (value < DumperConstant::OUTPUT_END));
+}
+
+bool IsItemLevel(int value)
+{
+    return (value == DumperConstant::NONE) ||
+        ((value > DumperConstant::LEVEL_BEGIN) && (value < DumperConstant::LEVEL_END));
+}
+
+bool IsGroupType(int value)
+{
+    return (value == DumperConstant::NONE) || (value == DumperConstant::GROUPTYPE_PID) ||
+        (value == DumperConstant::GROUPTYPE_CPUID);
+}
+} // namespace
+
+DumpConfigBlob::DumpConfigBlob()
+    : data_(nullptr), size_(0), map_(nullptr), mapSize_(0), version_(0), offsets_(), counts_(), dumperSeed_(0),
+      groupSeed_(0)
+{
+}
+
+DumpConfigBlob::~DumpConfigBlob()
+{
+    Close();
+}
+
+bool DumpConfigBlob::Open(const std::string &path)
+{
+    Close();
+    int fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        return false;
+    }
+    struct stat st;
+    if ((fstat(fd, &st) != 0) || (st.st_size < static_cast<off_t>(CONFIG_BLOB_HEADER_SIZE))) {
+        close(fd);
+        return false;
+    }
+    size_t size = static_cast<size_t>(st.st_size);
+    void *map = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (map == MAP_FAILED) {
+        return false;
+    }
+    if (!Attach(static_cast<const char *>(map), size)) {
+        munmap(map, size);
+        return false;
+    }
+    map_ = map;
+    mapSize_ = size;
+    return true;
+}
+
+bool DumpConfigBlob::Attach(const char *data, size_t size)
+{
+    Close();
+    if (data == nullptr) {
+        return false;
+    }
+    data_ = data;
+    size_ = size;
+    if (!Load()) {
+        Close();
+        return false;
+    }
+    return true;
+}
+
+void DumpConfigBlob::Close()
+{
+    if (map_ != nullptr) {
+        munmap(map_, mapSize_);
+    }
+    map_ = nullptr;
+    mapSize_ = 0;
+    data_ = nullptr;
+    size_ = 0;
+    version_ = 0;
+    for (uint32_t part = 0; part < CONFIG_BLOB_PARTS; part++) {
+        offsets_[part] = 0;
+        counts_[part] = 0;
+    }
+    dumperSeed_ = 0;
+    groupSeed_ = 0;
+}
+
+uint16_t DumpConfigBlob::GetVersion() const
+{
+    return version_;
+}
+
+int DumpConfigBlob::GetDumperSum() const
+{
+    return static_cast<int>(counts_[CONFIG_BLOB_DUMPERS]);
+}
+
+int DumpConfigBlob::GetGroupSum() const
+{
+    return static_cast<int>(counts_[CONFIG_BLOB_GROUPS]);
+}
+
+int DumpConfigBlob::FindDumper(std::string_view name) const
+{
+    int index = FindSlot(CONFIG_BLOB_DUMPER_INDEX, dumperSeed_, name);
+    return ((index > -1) && (GetDumper(index).name_ == name)) ? index : -1;
+}
+
+int DumpConfigBlob::FindGroup(std::string_view name) const
+{
+    int index = FindSlot(CONFIG_BLOB_GROUP_INDEX, groupSeed_, name);
+    return ((index > -1) && (GetGroup(index).name_ == name)) ? index : -1;
+}
+
+ConfigData::DumperCfg DumpConfigBlob::GetDumper(int index) const
+{
+    ConfigData::DumperCfg dumper {};
+    (void)ReadDumper(static_cast<uint32_t>(index), dumper);
+    return dumper;
+}
+
+ConfigData::ItemCfg DumpConfigBlob::GetItem(int dumper, int item) const
+{
+    ConfigData::ItemCfg itemCfg {};
+    (void)ReadItem(ReadFirst(CONFIG_BLOB_DUMPERS, static_cast<uint32_t>(dumper)) + static_cast<uint32_t>(item),
+        itemCfg);
+    return itemCfg;
+}
+
+ConfigData::GroupCfg DumpConfigBlob::GetGroup(int index) const
+{
+    ConfigData::GroupCfg group {};
+    (void)ReadGroup(static_cast<uint32_t>(index), group);
+    return group;
+}
+
+std::string_view DumpConfigBlob::GetEntry(int group, int entry) const
+{
+    uint32_t index = ReadFirst(CONFIG_BLOB_GROUPS, static_cast<uint32_t>(group)) + static_cast<uint32_t>(entry);
+    std::string_view str;
+    (void)ReadString(offsets_[CONFIG_BLOB_ENTRIES] + index * CONFIG_BLOB_ENTRY_SIZE, str);
+    return str;
+}
+
+bool DumpConfigBlob::Load()
+{
+    if ((size_ < CONFIG_BLOB_HEADER_SIZE) || (memcmp(data_, CONFIG_BLOB_MAGIC, CONFIG_BLOB_MAGIC_SIZE) != 0)) {
+        return false;
+    }
+    version_ = static_cast<uint16_t>(ReadFixed(data_ + POS_VERSION, SIZE_U16));
+    size_t headerSize = ReadFixed(data_ + POS_HEADER_SIZE, SIZE_U16);
+    if ((version_ == 0) || (version_ > CONFIG_BLOB_VERSION) || (headerSize < CONFIG_BLOB_HEADER_SIZE) ||
+        (ReadFixed(data_ + POS_FILE_SIZE, SIZE_U32) != size_)) {
+        return false;
+    }
+    // the classes, levels and types are stored as numbers.
+    if (ReadFixed(data_ + POS_CONSTANTS, SIZE_U32) != static_cast<uint32_t>(DumperConstant::LOOP)) {
+        return false;
+    }
+    // every record is checked here, so the getters read them without checks.
+    return LoadParts() && CheckDumpers() && CheckGroups() &&
+        CheckIndex(CONFIG_BLOB_DUMPER_INDEX, counts_[CONFIG_BLOB_DUMPERS]) &&
+        CheckIndex(CONFIG_BLOB_GROUP_INDEX, counts_[CONFIG_BLOB_GROUPS]);
+}
+
+bool DumpConfigBlob::LoadParts()
+{
+    for (uint32_t part = 0; part < CONFIG_BLOB_PARTS; part++) {
+        offsets_[part] = ReadFixed(data_ + POS_PARTS + part * PART_SIZE, SIZE_U32);
+        counts_[part] = ReadFixed(data_ + POS_PARTS + part * PART_SIZE + SIZE_U32, SIZE_U32);
+        if ((offsets_[part] < CONFIG_BLOB_HEADER_SIZE) || (offsets_[part] > size_) ||
+            (static_cast<uint64_t>(counts_[part]) * RECORD_SIZES[part] > size_ - offsets_[part])) {
+            return false;
+        }
+    }
+    dumperSeed_ = ReadFixed(data_ + POS_DUMPER_SEED, SIZE_U32);
+    groupSeed_ = ReadFixed(data_ + POS_GROUP_SEED, SIZE_U32);
+    return true;
+}
+
+bool DumpConfigBlob::CheckDumpers() const
+{
+    ConfigData::ItemCfg item;
+    for (uint32_t index = 0; index < counts_[CONFIG_BLOB_ITEMS]; index++) {
+        if (!ReadItem(index, item)) {
+            return false;
+        }
+    }
+    ConfigData::DumperCfg dumper;
+    for (uint32_t index = 0; index < counts_[CONFIG_BLOB_DUMPERS]; index++) {
+        if (!ReadDumper(index, dumper)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool DumpConfigBlob::CheckGroups() const
+{
+    std::string_view entry;
+    for (uint32_t index = 0; index < counts_[CONFIG_BLOB_ENTRIES]; index++) {
+        if (!ReadString(offsets_[CONFIG_BLOB_ENTRIES] + index * CONFIG_BLOB_ENTRY_SIZE, entry)) {
+            return false;
+        }
+    }
+    ConfigData::GroupCfg group;
+    for (uint32_t index = 0; index < counts_[CONFIG_BLOB_GROUPS]; index++) {
+        if (!ReadGroup(index, group)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool DumpConfigBlob::CheckIndex(uint32_t part, size_t records) const
+{
+    uint32_t count = counts_[part];
+    if ((count == 0) || ((count & (count - 1)) != 0)) {
+        return false;
+    }
+    for (uint32_t slot = 0; slot < count; slot++) {
+        int32_t index = static_cast<int32_t>(ReadFixed(data_ + offsets_[part] + slot * CONFIG_BLOB_SLOT_SIZE,
+            SIZE_U32));
+        if ((index < -1) || ((index > -1) && (static_cast<size_t>(index) >= records))) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool DumpConfigBlob::ReadItem(uint32_t index, ConfigData::ItemCfg &item) const
+{
+    size_t pos = offsets_[CONFIG_BLOB_ITEMS] + static_cast<size_t>(index) * CONFIG_BLOB_ITEM_SIZE;
+    std::string_view *strings[ITEM_STRINGS] = {
+        &item.name_, &item.desc_, &item.target_, &item.section_, &item.filterCfg_,
+    };
+    for (auto str : strings) {
+        if (!ReadString(pos, *str)) {
+            return false;
+        }
+        pos += CONFIG_BLOB_STRING_SIZE;
+    }
+    item.class_ = static_cast<int32_t>(ReadFixed(data_ + pos, SIZE_U32));
+    item.level_ = static_cast<int32_t>(ReadFixed(data_ + pos + SIZE_U32, SIZE_U32));
+    item.loop_ = static_cast<int32_t>(ReadFixed(data_ + pos + SIZE_U32 + SIZE_U32, SIZE_U32));
+    return IsItemClass(item.class_) && IsItemLevel(item.level_) &&
+        ((item.loop_ == DumperConstant::NONE) || (item.loop_ == DumperConstant::LOOP));
+}
+
+bool DumpConfigBlob::ReadDumper(uint32_t index, ConfigData::DumperCfg &dumper) const
+{
+    size_t pos = offsets_[CONFIG_BLOB_DUMPERS] + static_cast<size_t>(index) * CONFIG_BLOB_DUMPER_SIZE;
+    if (!ReadString(pos, dumper.name_) || !ReadString(pos + CONFIG_BLOB_STRING_SIZE, dumper.desc_)) {
+        return false;
+    }
+    pos += POS_RECORD_FIRST;
+    uint32_t first = ReadFixed(data_ + pos, SIZE_U32);
+    uint32_t count = ReadFixed(data_ + pos + SIZE_U32, SIZE_U32);
+    uint32_t items = counts_[CONFIG_BLOB_ITEMS];
+    dumper.list_ = nullptr;
+    dumper.size_ = static_cast<int>(count);
+    return (first <= items) && (count <= items - first);
+}
+
+bool DumpConfigBlob::ReadGroup(uint32_t index, ConfigData::GroupCfg &group) const
+{
+    size_t pos = offsets_[CONFIG_BLOB_GROUPS] + static_cast<size_t>(index) * CONFIG_BLOB_GROUP_SIZE;
+    if (!ReadString(pos, group.name_) || !ReadString(pos + CONFIG_BLOB_STRING_SIZE, group.desc_)) {
+        return false;
+    }
+    pos += POS_RECORD_FIRST;
+    uint32_t first = ReadFixed(data_ + pos, SIZE_U32);
+    uint32_t count = ReadFixed(data_ + pos + SIZE_U32, SIZE_U32);
+    uint32_t entries = counts_[CONFIG_BLOB_ENTRIES];
+    group.list_ = nullptr;
+    group.size_ = static_cast<int>(count);
+    group.type_ = static_cast<int32_t>(ReadFixed(data_ + pos + SIZE_U32 + SIZE_U32, SIZE_U32));
+    group.expand_ = (ReadFixed(data_ + pos + SIZE_U32 + SIZE_U32 + SIZE_U32, SIZE_U32) != 0);
+    return (first <= entries) && (count <= entries - first) && IsGroupType(group.type_);
+}
+
+uint32_t DumpConfigBlob::ReadFirst(uint32_t part, uint32_t index) const
+{
+    return ReadFixed(data_ + offsets_[part] + static_cast<size_t>(index) * RECORD_SIZES[part] + POS_RECORD_FIRST,
+        SIZE_U32);
+}
+
+bool DumpConfigBlob::ReadString(size_t pos, std::string_view &str) const
+{
+    uint32_t offset = ReadFixed(data_ + pos, SIZE_U32);
+    uint32_t size = ReadFixed(data_ + pos + SIZE_U32, SIZE_U32);
+    uint32_t begin = offsets_[CONFIG_BLOB_BYTES];
+    if ((offset < begin) || (offset - begin > counts_[CONFIG_BLOB_BYTES]) ||
+        (size > counts_[CONFIG_BLOB_BYTES] - (offset - begin))) {
+        return false;
+    }
+    str = std::string_view(data_ + offset, size);
+    return true;
+}
+
+int DumpConfigBlob::FindSlot(uint32_t part, uint32_t seed, std::string_view name) const
+{
+    if (counts_[part] == 0) {
+        return -1;
+    }
+    uint32_t slot = ConfigData::HashName(name, seed) & (counts_[part] - 1);
+    return static_cast<int32_t>(ReadFixed(data_ + offsets_[part] + slot * CONFIG_BLOB_SLOT_SIZE, SIZE_U32));
+}
+} // namespace HiviewDFX
+} // namespace OHOS
@@ -0,0 +1,500 @@
+/*
+ * Copyright (C) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "util/dump_config_compiler.h"
+#include <cstdint>
+#include <map>
+#include <set>
+#include <vector>
+#include "nlohmann/json.hpp"
+#include "common/dumper_constant.h"
+#include "util/config_data.h"
+#include "util/dump_config_blob.h"
+namespace OHOS {
+namespace HiviewDFX {
+namespace {
+static const int BYTE_BITS = 8;
+static const uint64_t BYTE_MASK = 0xFF;
+static const size_t SIZE_U16 = 2;
+static const size_t SIZE_U32 = 4;
+static const uint32_t SEED_MAX = 1024;
+static const uint32_t SLOTS_PER_NAME = 4;
+static const uint32_t SLOTS_MAX = 1u << 20;
+
+struct ConstantName {
+    const char *name;
+    int value;
+};
+
+static const ConstantName CLASS_NAMES[] = {
+    {"cpu_dumper", DumperConstant::CPU_DUMPER},
+    {"file_dumper", DumperConstant::FILE_DUMPER},
+    {"env_dumper", DumperConstant::ENV_PARAM_DUMPER},
+    {"cmd_dumper", DumperConstant::CMD_DUMPER},
+    {"prop_dumper", DumperConstant::PROPERTIES_DUMPER},
+    {"api_dumper", DumperConstant::API_DUMPER},
+    {"list_dumper", DumperConstant::LIST_DUMPER},
+    {"ver_dumper", DumperConstant::VERSION_DUMPER},
+    {"sa_dumper", DumperConstant::SA_DUMPER},
+    {"mem_dumper", DumperConstant::MEMORY_DUMPER},
+    {"stack_dumper", DumperConstant::STACK_DUMPER},
+    {"sched_dumper", DumperConstant::SCHED_DUMPER},
+    {"cgroup_dumper", DumperConstant::CGROUP_DUMPER},
+    {"col_row_filter", DumperConstant::COLUMN_ROWS_FILTER},
+    {"file_format_dump_filter", DumperConstant::FILE_FORMAT_DUMP_FILTER},
+    {"std_output", DumperConstant::STD_OUTPUT},
+    {"file_output", DumperConstant::FILE_OUTPUT},
+    {"fd_output", DumperConstant::FD_OUTPUT},
+    {"zip_output", DumperConstant::ZIP_OUTPUT},
+};
+
+static const ConstantName LEVEL_NAMES[] = {
+    {"none", DumperConstant::NONE},
+    {"level_none", DumperConstant::LEVEL_NONE},
+    {"level_low", DumperConstant::LEVEL_LOW},
+    {"level_middle", DumperConstant::LEVEL_MIDDLE},
+    {"level_high", DumperConstant::LEVEL_HIGH},
+    {"level_all", DumperConstant::LEVEL_ALL},
+};
+
+static const ConstantName TYPE_NAMES[] = {
+    {"type_none", DumperConstant::NONE},
+    {"type_pid", DumperConstant::GROUPTYPE_PID},
+    {"type_cpuid", DumperConstant::GROUPTYPE_CPUID},
+};
+
+struct ItemRecord {
+    std::string name;
+    std::string desc;
+    std::string target;
+    std::string section;
+    std::string filter;
+    int classId = DumperConstant::NONE;
+    int level = DumperConstant::NONE;
+    int loop = DumperConstant::NONE;
+};
+
+struct DumperRecord {
+    std::string name;
+    std::string desc;
+    uint32_t firstItem = 0;
+    uint32_t itemCount = 0;
+};
+
+struct GroupRecord {
+    std::string name;
+    std::string desc;
+    uint32_t firstEntry = 0;
+    uint32_t entryCount = 0;
+    int type = DumperConstant::NONE;
+    bool expand = false;
+};
+
+struct Config {
+    std::vector<ItemRecord> items;
+    std::vector<DumperRecord> dumpers;
+    std::vector<GroupRecord> groups;
+    std::vector<std::string> entries;
+};
+
+struct Index {
+    uint32_t seed = 0;
+    std::vector<int32_t> slots;
+};
+
+bool StartWith(const std::string &str, const std::string &prefix)
+{
+    return str.compare(0, prefix.size(), prefix) == 0;
+}
+
+// an absent key keeps the value.
+bool GetString(const nlohmann::json &object, const char *key, std::string &value, std::string &error)
+{
+    auto it = object.find(key);
+    if (it == object.end()) {
+        return true;
+    }
+    if (!it->is_string()) {
+        error = std::string("\"") + key + "\" is not a string";
+        return false;
+    }
+    value = it->get<std::string>();
+    return true;
+}
+
+template<size_t N>
+bool GetConstant(const nlohmann::json &object, const char *key, const ConstantName (&names)[N], int &value,
+    std::string &error)
+{
+    std::string name;
+    if (!GetString(object, key, name, error)) {
+        return false;
+    }
+    if (name.empty()) {
+        return true;
+    }
+    for (auto &constant : names) {
+        if (name == constant.name) {
+            value = constant.value;
+            return true;
+        }
+    }
+    error = std::string("unknown ") + key + " \"" + name + "\"";
+    return false;
+}
+
+bool GetBool(const nlohmann::json &object, const char *key, bool &value, std::string &error)
+{
+    auto it = object.find(key);
+    if (it == object.end()) {
+        return true;
+    }
+    if (!it->is_boolean()) {
+        error = std::string("\"") + key + "\" is not a bool";
+        return false;
+    }
+    value = it->get<bool>();
+    return true;
+}
+
+const nlohmann::json *GetArray(const nlohmann::json &object, const char *key, std::string &error)
+{
+    static const nlohmann::json EMPTY = nlohmann::json::array();
+    auto it = object.find(key);
+    if (it == object.end()) {
+        return &EMPTY;
+    }
+    if (!it->is_array()) {
+        error = std::string("\"") + key + "\" is not an array";
+        return nullptr;
+    }
+    return &(*it);
+}
+
+bool ParseItem(const nlohmann::json &object, ItemRecord &item, std::string &error)
+{
+    bool loop = false;
+    if (!object.is_object() || !GetString(object, "name", item.name, error) ||
+        !GetString(object, "desc", item.desc, error) || !GetString(object, "target", item.target, error) ||
+        !GetString(object, "section", item.section, error) || !GetString(object, "filter", item.filter, error) ||
+        !GetConstant(object, "class", CLASS_NAMES, item.classId, error) ||
+        !GetConstant(object, "level", LEVEL_NAMES, item.level, error) || !GetBool(object, "loop", loop, error)) {
+        error = error.empty() ? "an item is not an object" : error;
+        return false;
+    }
+    if (item.classId == DumperConstant::NONE) {
+        error = "an item has no class";
+        return false;
+    }
+    item.loop = loop ? DumperConstant::LOOP : DumperConstant::NONE;
+    return true;
+}
+
+bool ParseDumper(const nlohmann::json &object, Config &config, std::string &error)
+{
+    DumperRecord dumper;
+    if (!object.is_object() || !GetString(object, "name", dumper.name, error) ||
+        !GetString(object, "desc", dumper.desc, error)) {
+        error = error.empty() ? "a dumper is not an object" : error;
+        return false;
+    }
+    if (!StartWith(dumper.name, ConfigData::CONFIG_DUMPER_)) {
+        error = "dumper \"" + dumper.name + "\" does not start with " + ConfigData::CONFIG_DUMPER_;
+        return false;
+    }
+    const nlohmann::json *items = GetArray(object, "items", error);
+    if ((items == nullptr) || items->empty()) {
+        error = "dumper " + dumper.name + ": " + (error.empty() ? "no items" : error);
+        return false;
+    }
+    dumper.firstItem = static_cast<uint32_t>(config.items.size());
+    for (auto &itemObject : *items) {
+        ItemRecord item;
+        if (config.items.size() == dumper.firstItem) {
+            item.name = dumper.name;
+            item.desc = dumper.desc;
+        }
+        if (!ParseItem(itemObject, item, error)) {
+            error = "dumper " + dumper.name + ": " + error;
+            return false;
+        }
+        config.items.push_back(item);
+    }
+    dumper.itemCount = static_cast<uint32_t>(config.items.size()) - dumper.firstItem;
+    config.dumpers.push_back(dumper);
+    return true;
+}
+
+bool ParseGroup(const nlohmann::json &object, Config &config, std::string &error)
+{
+    GroupRecord group;
+    if (!object.is_object() || !GetString(object, "name", group.name, error) ||
+        !GetString(object, "desc", group.desc, error) || !GetConstant(object, "type", TYPE_NAMES, group.type, error) ||
+        !GetBool(object, "expand", group.expand, error)) {
+        error = error.empty() ? "a group is not an object" : error;
+        return false;
+    }
+    if (!StartWith(group.name, ConfigData::CONFIG_GROUP_) && !StartWith(group.name, ConfigData::CONFIG_MINIGROUP_)) {
+        error = "group \"" + group.name + "\" does not start with " + ConfigData::CONFIG_GROUP_ + " or " +
+            ConfigData::CONFIG_MINIGROUP_;
+        return false;
+    }
+    const nlohmann::json *entries = GetArray(object, "items", error);
+    if (entries == nullptr) {
+        error = "group " + group.name + ": " + error;
+        return false;
+    }
+    group.firstEntry = static_cast<uint32_t>(config.entries.size());
+    for (auto &entry : *entries) {
+        if (!entry.is_string()) {
+            error = "group " + group.name + ": an item is not a string";
+            return false;
+        }
+        config.entries.push_back(entry.get<std::string>());
+    }
+    group.entryCount = static_cast<uint32_t>(config.entries.size()) - group.firstEntry;
+    config.groups.push_back(group);
+    return true;
+}
+
+bool Parse(const std::string &text, Config &config, std::string &error)
+{
+    nlohmann::json root = nlohmann::json::parse(text, nullptr, false);
+    if (root.is_discarded() || !root.is_object()) {
+        error = "not a JSON object";
+        return false;
+    }
+    const nlohmann::json *dumpers = GetArray(root, "dumpers", error);
+    const nlohmann::json *groups = GetArray(root, "groups", error);
+    if ((dumpers == nullptr) || (groups == nullptr)) {
+        return false;
+    }
+    for (auto &dumper : *dumpers) {
+        if (!ParseDumper(dumper, config, error)) {
+            return false;
+        }
+    }
+    for (auto &group : *groups) {
+        if (!ParseGroup(group, config, error)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// names are new, the items of groups name something of the config or of ConfigData.
+bool Check(const Config &config, std::string &error)
+{
+    std::set<std::string> dumpers;
+    for (auto &dumper : config.dumpers) {
+        if ((ConfigData::FindDumper(dumper.name) > -1) || !dumpers.insert(dumper.name).second) {
+            error = "dumper " + dumper.name + " is defined twice";
+            return false;
+        }
+    }
+    std::set<std::string> groups;
+    for (auto &group : config.groups) {
+        if ((ConfigData::FindGroup(group.name) > -1) || !groups.insert(group.name).second) {
+            error = "group " + group.name + " is defined twice";
+            return false;
+        }
+    }
+    for (auto &group : config.groups) {
+        for (uint32_t i = group.firstEntry; i < group.firstEntry + group.entryCount; i++) {
+            const std::string &name = config.entries[i];
+            bool found = false;
+            if (StartWith(name, ConfigData::CONFIG_DUMPER_)) {
+                found = (dumpers.count(name) > 0) || (ConfigData::FindDumper(name) > -1);
+            } else if (StartWith(name, ConfigData::CONFIG_MINIGROUP_)) {
+                found = (groups.count(name) > 0) || (ConfigData::FindGroup(name) > -1);
+            }
+            if (!found) {
+                error = "group " + group.name + ": no dumper or mini group " + name;
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+// a seed with one name per slot, as for the tables of ConfigData.
+template<typename Record>
+Index BuildIndex(const std::vector<Record> &records)
+{
+    Index index;
+    uint32_t slots = 1;
+    while (slots < records.size() * SLOTS_PER_NAME) {
+        slots <<= 1;
+    }
+    for (; slots <= SLOTS_MAX; slots <<= 1) {
+        for (uint32_t seed = 0; seed < SEED_MAX; seed++) {
+            index.seed = seed;
+            index.slots.assign(slots, -1);
+            bool collided = false;
+            for (size_t i = 0; (i < records.size()) && !collided; i++) {
+                int32_t &slot = index.slots[ConfigData::HashName(records[i].name, seed) & (slots - 1)];
+                collided = (slot > -1);
+                slot = static_cast<int32_t>(i);
+            }
+            if (!collided) {
+                return index;
+            }
+        }
+    }
+    index.slots.clear();
+    return index;
+}
+
+class BlobWriter {
+public:
+    explicit BlobWriter(std::string &blob) : blob_(blob) {}
+
+    void Write(const Config &config, const Index &dumperIndex, const Index &groupIndex)
+    {
+        std::string bytes;
+        for (auto &item : config.items) {
+            AddString(bytes, item.name);
+            AddString(bytes, item.desc);
+            AddString(bytes, item.target);
+            AddString(bytes, item.section);
+            AddString(bytes, item.filter);
+        }
+        for (auto &dumper : config.dumpers) {
+            AddString(bytes, dumper.name);
+            AddString(bytes, dumper.desc);
+        }
+        for (auto &group : config.groups) {
+            AddString(bytes, group.name);
+            AddString(bytes, group.desc);
+        }
+        for (auto &entry : config.entries) {
+            AddString(bytes, entry);
+        }
+        while (bytes.size() % SIZE_U32 != 0) {
+            bytes.push_back('\0');
+        }
+
+        uint32_t counts[CONFIG_BLOB_PARTS] = {
+            static_cast<uint32_t>(bytes.size()), static_cast<uint32_t>(config.items.size()),
+            static_cast<uint32_t>(config.dumpers.size()), static_cast<uint32_t>(config.groups.size()),
+            static_cast<uint32_t>(config.entries.size()), static_cast<uint32_t>(dumperIndex.slots.size()),
+            static_cast<uint32_t>(groupIndex.slots.size()),
+        };
+        const size_t recordSizes[CONFIG_BLOB_PARTS] = {
+            1, CONFIG_BLOB_ITEM_SIZE, CONFIG_BLOB_DUMPER_SIZE, CONFIG_BLOB_GROUP_SIZE, CONFIG_BLOB_ENTRY_SIZE,
+            CONFIG_BLOB_SLOT_SIZE, CONFIG_BLOB_SLOT_SIZE,
+        };
+        uint32_t offsets[CONFIG_BLOB_PARTS];
+        size_t size = CONFIG_BLOB_HEADER_SIZE;
+        for (uint32_t part = 0; part < CONFIG_BLOB_PARTS; part++) {
+            offsets[part] = static_cast<uint32_t>(size);
+            size += counts[part] * recordSizes[part];
+        }
+
+        blob_.clear();
+        blob_.reserve(size);
+        blob_.append(CONFIG_BLOB_MAGIC, CONFIG_BLOB_MAGIC_SIZE);
+        AppendFixed(CONFIG_BLOB_VERSION, SIZE_U16);
+        AppendFixed(CONFIG_BLOB_HEADER_SIZE, SIZE_U16);
+        AppendFixed(size, SIZE_U32);
+        AppendFixed(DumperConstant::LOOP, SIZE_U32);
+        for (uint32_t part = 0; part < CONFIG_BLOB_PARTS; part++) {
+            AppendFixed(offsets[part], SIZE_U32);
+            AppendFixed(counts[part], SIZE_U32);
+        }
+        AppendFixed(dumperIndex.seed, SIZE_U32);
+        AppendFixed(groupIndex.seed, SIZE_U32);
+        blob_.append(bytes);
+
+        for (auto &item : config.items) {
+            AppendString(item.name);
+            AppendString(item.desc);
+            AppendString(item.target);
+            AppendString(item.section);
+            AppendString(item.filter);
+            AppendFixed(static_cast<uint32_t>(item.classId), SIZE_U32);
+            AppendFixed(static_cast<uint32_t>(item.level), SIZE_U32);
+            AppendFixed(static_cast<uint32_t>(item.loop), SIZE_U32);
+        }
+        for (auto &dumper : config.dumpers) {
+            AppendString(dumper.name);
+            AppendString(dumper.desc);
+            AppendFixed(dumper.firstItem, SIZE_U32);
+            AppendFixed(dumper.itemCount, SIZE_U32);
+        }
+        for (auto &group : config.groups) {
+            AppendString(group.name);
+            AppendString(group.desc);
+            AppendFixed(group.firstEntry, SIZE_U32);
+            AppendFixed(group.entryCount, SIZE_U32);
+            AppendFixed(static_cast<uint32_t>(group.type), SIZE_U32);
+            AppendFixed(group.expand ? 1 : 0, SIZE_U32);
+        }
+        for (auto &entry : config.entries) {
+            AppendString(entry);
+        }
+        for (int32_t slot : dumperIndex.slots) {
+            AppendFixed(static_cast<uint32_t>(slot), SIZE_U32);
+        }
+        for (int32_t slot : groupIndex.slots) {
+            AppendFixed(static_cast<uint32_t>(slot), SIZE_U32);
+        }
+    }
+
+private:
+    // each text once, the strings are offsets from the start of the blob.
+    void AddString(std::string &bytes, const std::string &str)
+    {
+        if (strings_.count(str) == 0) {
+            strings_[str] = static_cast<uint32_t>(CONFIG_BLOB_HEADER_SIZE + bytes.size());
+            bytes.append(str);
+        }
+    }
+
+    void AppendString(const std::string &str)
+    {
+        AppendFixed(strings_[str], SIZE_U32);
+        AppendFixed(str.size(), SIZE_U32);
+    }
+
+    void AppendFixed(uint64_t value, size_t size)
+    {
+        for (size_t i = 0; i < size; i++) {
+            blob_.push_back(static_cast<char>((value >> (i * BYTE_BITS)) & BYTE_MASK));
+        }
+    }
+
+private:
+    std::string &blob_;
+    std::map<std::string, uint32_t> strings_;
+};
+} // namespace
+
+bool DumpConfigCompiler::Compile(const std::string &text, std::string &blob, std::string &error)
+{
+    Config config;
+    if (!Parse(text, config, error) || !Check(config, error)) {
+        return false;
+    }
+    Index dumperIndex = BuildIndex(config.dumpers);
+    Index groupIndex = BuildIndex(config.groups);
+    if (dumperIndex.slots.empty() || groupIndex.slots.empty()) {
+        error = "no seed for the index";
+        return false;
+    }
+    BlobWriter(blob).Write(config, dumperIndex, groupIndex);
+    return true;
+}
+} // namespace HiviewDFX
+} // namespace OHOS
@@ -14,6 +14,8 @@
  */
 #include "util/dump_cpu_info_util.h"
 #include <dirent.h>
+#include <thread>
+#include "datetime_ex.h"
 #include "file_ex.h"
 #include "string_ex.h"
 #include "hilog_wrapper.h"
@@ -36,15 +38,59 @@ DumpCpuInfoUtil::~DumpCpuInfoUtil()
     oldCPUInfo_.reset();
     curProcs_.clear();
     oldProcs_.clear();
+    latestProcs_.clear();
 }
 
 void DumpCpuInfoUtil::UpdateCpuInfo()
 {
     DUMPER_HILOGD(MODULE_COMMON, "UpdateCpuInfo debug|");
+    TakeSample(false);
+}
+
+void DumpCpuInfoUtil::ResetCpuInfo()
+{
+    DUMPER_HILOGD(MODULE_COMMON, "ResetCpuInfo debug|");
+    TakeSample(true);
+}
+
+void DumpCpuInfoUtil::WaitCpuInfoWindow()
+{
+    uint64_t baseTick = 0;
+    uint64_t tick = static_cast<uint64_t>(GetTickCount());
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        baseTick = (tick - curProcsTick_ >= MIN_SAMPLE_WINDOW) ? curProcsTick_ : oldProcsTick_;
+    }
+    // no sample yet, the usage is since boot.
+    if ((baseTick == 0) || (tick - baseTick >= MIN_SAMPLE_WINDOW)) {
+        return;
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(MIN_SAMPLE_WINDOW - (tick - baseTick)));
+}
+
+void DumpCpuInfoUtil::TakeSample(bool reset)
+{
+    // scan outside of the lock, dump requests needn't wait for it.
+    std::shared_ptr<CPUInfo> cpuInfo = std::make_shared<CPUInfo>();
+    bool hasCpuInfo = GetCurCPUInfo(cpuInfo);
+    std::vector<std::shared_ptr<ProcInfo>> procInfos;
+    GetCurProcInfo(procInfos);
+    uint64_t tick = static_cast<uint64_t>(GetTickCount());
+
+    std::unique_lock<std::mutex> lock(mutex_);
     CopyCpuInfo(oldCPUInfo_, curCPUInfo_);
-    GetCurCPUInfo(curCPUInfo_);
-    oldProcs_.assign(curProcs_.begin(), curProcs_.end());
-    GetCurProcInfo(curProcs_);
+    if (hasCpuInfo) {
+        CopyCpuInfo(curCPUInfo_, cpuInfo);
+    }
+    oldProcs_.swap(curProcs_);
+    curProcs_.swap(procInfos);
+    oldProcsTick_ = curProcsTick_;
+    curProcsTick_ = tick;
+    if (reset) {
+        CopyCpuInfo(oldCPUInfo_, curCPUInfo_);
+        oldProcs_.assign(curProcs_.begin(), curProcs_.end());
+        oldProcsTick_ = curProcsTick_;
+    }
 }
 
 bool DumpCpuInfoUtil::GetCurCPUInfo(std::shared_ptr<CPUInfo> &cpuInfo)
@@ -61,6 +107,9 @@ bool DumpCpuInfoUtil::GetCurCPUInfo(std::shared_ptr<CPUInfo> &cpuInfo)
     statRawData = statRawData.substr(0, pos);
     std::vector<std::string> cpuStates;
     SplitStr(statRawData, SPACE, cpuStates);
+    if (cpuStates.size() <= CPU_STAT_SIRQ_TIME_INDEX) {
+        return false;
+    }
     SetCPUInfo(cpuInfo->uTime, cpuStates[CPU_STAT_USER_TIME_INDEX]);
     SetCPUInfo(cpuInfo->nTime, cpuStates[CPU_STAT_NICE_TIME_INDEX]);
     SetCPUInfo(cpuInfo->sTime, cpuStates[CPU_STAT_SYS_TIME_INDEX]);
@@ -83,43 +132,115 @@ void DumpCpuInfoUtil::SetCPUInfo(long unsigned &info, const std::string &strInfo
 
 bool DumpCpuInfoUtil::GetCurProcInfo(std::vector<std::shared_ptr<ProcInfo>> &procInfos)
 {
-    std::vector<std::string> procFiles;
-    GetProcessDirFiles("/proc", "stat", procFiles);
-    if (procFiles.size() < 1) {
-        return false;
-    }
     // Set procInfos size 0
     procInfos.clear();
-    for (size_t i = 0; i < procFiles.size(); i++) {
-        std::string rawData;
-        if (!LoadStringFromFile(procFiles[i], rawData)) {
-            continue;
+    return ScanProcInfo("/proc", procInfos);
+}
+
+bool DumpCpuInfoUtil::GetLatestProcInfo(std::vector<std::shared_ptr<ProcInfo>> &procInfos)
+{
+    uint64_t tick = static_cast<uint64_t>(GetTickCount());
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        if ((!latestProcs_.empty()) && (tick >= latestProcsTick_) &&
+            ((tick - latestProcsTick_) < LATEST_PROC_INFO_REUSE_TIME)) {
+            procInfos.assign(latestProcs_.begin(), latestProcs_.end());
+            return true;
         }
+    }
+
+    std::vector<std::shared_ptr<ProcInfo>> scanInfos;
+    if (!GetCurProcInfo(scanInfos)) {
+        return false;
+    }
+    std::unique_lock<std::mutex> lock(mutex_);
+    latestProcs_.assign(scanInfos.begin(), scanInfos.end());
+    latestProcsTick_ = tick;
+    procInfos.swap(scanInfos);
+    return true;
+}
 
+bool DumpCpuInfoUtil::GetCurTaskInfo(int pid, std::vector<std::shared_ptr<ProcInfo>> &taskInfos)
+{
+    taskInfos.clear();
+    return ScanProcInfo("/proc/" + std::to_string(pid) + "/task", taskInfos);
+}
+
+bool DumpCpuInfoUtil::ScanProcInfo(const std::string &path, std::vector<std::shared_ptr<ProcInfo>> &procInfos)
+{
+    std::vector<std::string> procDirs;
+    GetProcessDirFiles(path, "", procDirs);
+    if (procDirs.size() < 1) {
+        return false;
+    }
+    procInfos.reserve(procDirs.size());
+    for (size_t i = 0; i < procDirs.size(); i++) {
         std::shared_ptr<ProcInfo> ptrProcInfo = std::make_shared<ProcInfo>();
-        // Get comm name, (xxx) in stat file.
-        std::vector<std::string> comms;
-        GetSubStrBetween(rawData, "(", ")", comms);
-        ptrProcInfo->comm = comms[0];
-
-        /**
-         * @brief (xxx xxx xx) contain ' ' will effect function SplitStr,
-         * there will be wrong string for infos, so replace '()' instead of (xxx xxx xx)
-         */
-        rawData = ReplaceStr(rawData, comms[0], "()");
-        std::vector<std::string> procInfosStr;
-        SplitStr(rawData, SPACE, procInfosStr);
-
-        ptrProcInfo->pid = procInfosStr[0];
-        SetCPUInfo(ptrProcInfo->uTime, procInfosStr[PROC_INFO_USER_TIME_INDEX]);
-        SetCPUInfo(ptrProcInfo->sTime, procInfosStr[PROC_INFO_SYS_TIME_INDEX]);
-        ptrProcInfo->minflt = procInfosStr[PROC_INFO_MINOR_FAULT_INDEX];
-        ptrProcInfo->majflt = procInfosStr[PROC_INFO_MAJOR_FAULT_INDEX];
+        if (!ParseProcStat(procDirs[i] + "stat", ptrProcInfo)) {
+            continue;
+        }
+        // schedstat shares the directory walk, so --schedstat costs no extra scan.
+        ParseProcSchedStat(procDirs[i] + "schedstat", ptrProcInfo);
         procInfos.push_back(ptrProcInfo);
     }
     return true;
 }
 
+bool DumpCpuInfoUtil::ParseProcStat(const std::string &statPath, std::shared_ptr<ProcInfo> &procInfo)
+{
+    std::string rawData;
+    if (!LoadStringFromFile(statPath, rawData)) {
+        return false;
+    }
+
+    // Get comm name, (xxx) in stat file.
+    std::vector<std::string> comms;
+    GetSubStrBetween(rawData, "(", ")", comms);
+    if (comms.empty()) {
+        return false;
+    }
+    procInfo->comm = comms[0];
+
+    /**
+     * @brief (xxx xxx xx) contain ' ' will effect function SplitStr,
+     * there will be wrong string for infos, so replace '()' instead of (xxx xxx xx)
+     */
+    rawData = ReplaceStr(rawData, comms[0], "()");
+    std::vector<std::string> procInfosStr;
+    SplitStr(rawData, SPACE, procInfosStr);
+    if (procInfosStr.size() <= PROC_INFO_SYS_TIME_INDEX) {
+        return false;
+    }
+
+    procInfo->pid = procInfosStr[0];
+    SetCPUInfo(procInfo->uTime, procInfosStr[PROC_INFO_USER_TIME_INDEX]);
+    SetCPUInfo(procInfo->sTime, procInfosStr[PROC_INFO_SYS_TIME_INDEX]);
+    procInfo->minflt = procInfosStr[PROC_INFO_MINOR_FAULT_INDEX];
+    procInfo->majflt = procInfosStr[PROC_INFO_MAJOR_FAULT_INDEX];
+    return true;
+}
+
+void DumpCpuInfoUtil::ParseProcSchedStat(const std::string &schedStatPath, std::shared_ptr<ProcInfo> &procInfo)
+{
+    procInfo->runTime = 0;
+    procInfo->waitTime = 0;
+    procInfo->timeslices = 0;
+
+    // schedstat is "<run time ns> <wait time ns> <timeslices>", it's missing without CONFIG_SCHED_INFO.
+    std::string rawData;
+    if (!LoadStringFromFile(schedStatPath, rawData)) {
+        return;
+    }
+    std::vector<std::string> schedStats;
+    SplitStr(TrimStr(rawData, '\n'), SPACE, schedStats);
+    if (schedStats.size() <= SCHED_STAT_TIMESLICES_INDEX) {
+        return;
+    }
+    procInfo->runTime = strtoull(schedStats[SCHED_STAT_RUN_TIME_INDEX].c_str(), nullptr, CONSTANT_NUM_10);
+    procInfo->waitTime = strtoull(schedStats[SCHED_STAT_WAIT_TIME_INDEX].c_str(), nullptr, CONSTANT_NUM_10);
+    procInfo->timeslices = strtoull(schedStats[SCHED_STAT_TIMESLICES_INDEX].c_str(), nullptr, CONSTANT_NUM_10);
+}
+
 void DumpCpuInfoUtil::GetProcessDirFiles(const std::string &path, const std::string &file,
     std::vector<std::string> &files)
 {
@@ -146,36 +267,18 @@ void DumpCpuInfoUtil::GetProcessDirFiles(const std::string &path, const std::str
 
 bool DumpCpuInfoUtil::GetCurSpecProcInfo(int pid, std::shared_ptr<ProcInfo> &specProc)
 {
-    std::string filePath = "/proc/" + std::to_string(pid) + "/stat";
-    std::string rawData;
-    if (!LoadStringFromFile(filePath, rawData)) {
+    std::string procDir = "/proc/" + std::to_string(pid) + "/";
+    if (!ParseProcStat(procDir + "stat", specProc)) {
         return false;
     }
-
-    // Get comm name, (xxx) in stat file.
-    std::vector<std::string> comms;
-    GetSubStrBetween(rawData, "(", ")", comms);
-    specProc->comm = comms[0];
-
-    /**
-     * @brief (xxx xxx xx) contain ' ' will effect function SplitStr,
-     * there will be wrong string for infos, so replace '()' instead of (xxx xxx xx)
-     */
-    rawData = ReplaceStr(rawData, comms[0], "()");
-    std::vector<std::string> procInfosStr;
-    SplitStr(rawData, SPACE, procInfosStr);
-
-    specProc->pid = procInfosStr[0];
-    SetCPUInfo(specProc->uTime, procInfosStr[PROC_INFO_USER_TIME_INDEX]);
-    SetCPUInfo(specProc->sTime, procInfosStr[PROC_INFO_SYS_TIME_INDEX]);
-    specProc->minflt = procInfosStr[PROC_INFO_MINOR_FAULT_INDEX];
-    specProc->majflt = procInfosStr[PROC_INFO_MAJOR_FAULT_INDEX];
+    ParseProcSchedStat(procDir + "schedstat", specProc);
     return true;
 }
 
 bool DumpCpuInfoUtil::GetOldCPUInfo(std::shared_ptr<CPUInfo> &cpuInfo)
 {
-    if (!CheckFrequentDumpping()) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    if (!UseOldSample()) {
         CopyCpuInfo(cpuInfo, curCPUInfo_);
     } else {
         CopyCpuInfo(cpuInfo, oldCPUInfo_);
@@ -185,48 +288,64 @@ bool DumpCpuInfoUtil::GetOldCPUInfo(std::shared_ptr<CPUInfo> &cpuInfo)
 
 bool DumpCpuInfoUtil::GetOldProcInfo(std::vector<std::shared_ptr<ProcInfo>> &procInfos)
 {
-    if (!CheckFrequentDumpping()) {
+    uint64_t tick = 0;
+    return GetOldProcInfo(procInfos, tick);
+}
+
+bool DumpCpuInfoUtil::GetOldProcInfo(std::vector<std::shared_ptr<ProcInfo>> &procInfos, uint64_t &tick)
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    if (!UseOldSample()) {
         procInfos.assign(curProcs_.begin(), curProcs_.end());
+        tick = curProcsTick_;
     } else {
         procInfos.assign(oldProcs_.begin(), oldProcs_.end());
+        tick = oldProcsTick_;
     }
     return true;
 }
 
 bool DumpCpuInfoUtil::GetOldSpecProcInfo(int pid, std::shared_ptr<ProcInfo> &specProc)
 {
-    if (!CheckFrequentDumpping()) {
-        for (size_t i = 0; i < curProcs_.size(); i++) {
-            if (!IsNumericStr(curProcs_[i]->pid)) {
-                return false;
-            }
-            int specPid = 0;
-            if (!StrToInt(curProcs_[i]->pid, specPid)) {
-                return false;
-            }
-            if (pid == specPid) {
-                CopyProcInfo(specProc, curProcs_[i]);
-                return true;
-            }
+    std::unique_lock<std::mutex> lock(mutex_);
+    if (!UseOldSample()) {
+        return GetOldSpecProcInfo(pid, curProcs_, specProc);
+    }
+    return GetOldSpecProcInfo(pid, oldProcs_, specProc);
+}
+
+bool DumpCpuInfoUtil::GetOldSpecProcInfo(int pid, const std::vector<std::shared_ptr<ProcInfo>> &procInfos,
+    std::shared_ptr<ProcInfo> &specProc)
+{
+    for (size_t i = 0; i < procInfos.size(); i++) {
+        if (!IsNumericStr(procInfos[i]->pid)) {
+            return false;
         }
-    } else {
-        for (size_t i = 0; i < oldProcs_.size(); i++) {
-            if (!IsNumericStr(oldProcs_[i]->pid)) {
-                return false;
-            }
-            int specPid = 0;
-            if (!StrToInt(oldProcs_[i]->pid, specPid)) {
-                return false;
-            }
-            if (pid == specPid) {
-                CopyProcInfo(specProc, oldProcs_[i]);
-                return true;
-            }
+        int specPid = 0;
+        if (!StrToInt(procInfos[i]->pid, specPid)) {
+            return false;
+        }
+        if (pid == specPid) {
+            CopyProcInfo(specProc, procInfos[i]);
+            return true;
         }
     }
     return false;
 }
 
+void DumpCpuInfoUtil::BuildProcInfoMap(const std::vector<std::shared_ptr<ProcInfo>> &procInfos,
+    ProcInfoMap &procMap)
+{
+    procMap.clear();
+    procMap.reserve(procInfos.size());
+    for (const auto &procInfo : procInfos) {
+        if (procInfo == nullptr) {
+            continue;
+        }
+        procMap.emplace(procInfo->pid, procInfo);
+    }
+}
+
 void DumpCpuInfoUtil::CopyCpuInfo(std::shared_ptr<CPUInfo> &tar, const std::shared_ptr<CPUInfo> &source)
 {
     tar->uTime = source->uTime;
@@ -246,6 +365,19 @@ void DumpCpuInfoUtil::CopyProcInfo(std::shared_ptr<ProcInfo> &tar, const std::sh
     tar->sTime = source->sTime;
     tar->minflt = source->minflt;
     tar->majflt = source->majflt;
+    tar->runTime = source->runTime;
+    tar->waitTime = source->waitTime;
+    tar->timeslices = source->timeslices;
+}
+
+bool DumpCpuInfoUtil::UseOldSample()
+{
+    if (CheckFrequentDumpping()) {
+        return true;
+    }
+    // a sample taken while the request waited for its window is too fresh to diff against.
+    uint64_t tick = static_cast<uint64_t>(GetTickCount());
+    return (oldProcsTick_ != 0) && (tick - curProcsTick_ < MIN_SAMPLE_WINDOW);
 }
 
 bool DumpCpuInfoUtil::CheckFrequentDumpping()
@@ -0,0 +1,191 @@
+/*
+ * Copyright (C) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "util/dump_executor_stats.h"
+#include <ctime>
+#include <map>
+#include "hilog_wrapper.h"
+namespace OHOS {
+namespace HiviewDFX {
+namespace {
+static const uint64_t NS_PER_SEC = 1000000000;
+static const uint64_t NS_PER_US = 1000;
+static const size_t NAME_WIDTH = 40;
+static const size_t SECTION_WIDTH = 16;
+static const size_t NUMBER_WIDTH = 12;
+static const std::string COLUMN_PREFIX = " ";
+static const std::string OUTPUT_NAME = "output";
+static const std::string FILTER_NAME = "filter";
+enum StatsColumn {
+    STATS_NAME = 0,
+    STATS_SECTION,
+    STATS_WALL,
+    STATS_CPU,
+    STATS_LINES,
+    STATS_BYTES,
+    STATS_LOOPS,
+};
+
+std::string PadHeader(const std::string &prefix, const std::string &text, size_t width, bool leftAlign)
+{
+    std::string pad = (text.size() < width) ? std::string(width - text.size(), ' ') : "";
+    return leftAlign ? (prefix + text + pad) : (prefix + pad + text);
+}
+} // namespace
+
+DumpExecutorStats::DumpExecutorStats(size_t count) : items_(count, Item {"", "", false, 0, 0, 0, 0, 0})
+{
+}
+
+void DumpExecutorStats::SetExecutor(size_t index, const std::string &name, const std::string &section, bool isOutput)
+{
+    Item &item = items_[index];
+    item.name = name.empty() ? (isOutput ? OUTPUT_NAME : FILTER_NAME) : name;
+    item.section = isOutput ? "" : section;
+    item.isOutput = isOutput;
+}
+
+void DumpExecutorStats::Begin(const Matrix &matrix, const DumpLineBuffer *lines, Sample &sample) const
+{
+    Count(matrix, lines, sample.lines, sample.bytes);
+    sample.cpuNs = GetThreadCpuNs();
+    sample.wallNs = GetWallNs();
+}
+
+void DumpExecutorStats::End(size_t index, const Sample &sample, const Matrix &matrix, const DumpLineBuffer *lines)
+{
+    uint64_t wallNs = GetWallNs();
+    uint64_t cpuNs = GetThreadCpuNs();
+    Item &item = items_[index];
+    item.wallNs += (wallNs > sample.wallNs) ? (wallNs - sample.wallNs) : 0;
+    item.cpuNs += (cpuNs > sample.cpuNs) ? (cpuNs - sample.cpuNs) : 0;
+    item.loops++;
+    if (item.isOutput) {
+        // an output takes all lines waiting.
+        item.lines += sample.lines;
+        item.bytes += sample.bytes;
+        return;
+    }
+    size_t lineCount = 0;
+    size_t byteCount = 0;
+    Count(matrix, lines, lineCount, byteCount);
+    // a filter may drop lines, it produces none then.
+    item.lines += (lineCount > sample.lines) ? (lineCount - sample.lines) : 0;
+    item.bytes += (byteCount > sample.bytes) ? (byteCount - sample.bytes) : 0;
+}
+
+std::shared_ptr<DumpTable> DumpExecutorStats::CreateTable() const
+{
+    std::vector<Item> rows;
+    MergeItems(rows);
+    std::shared_ptr<DumpTable> table = std::make_shared<DumpTable>();
+    table->AddColumn({"name", DumpTable::COLUMN_STRING, PadHeader("", "Executor", NAME_WIDTH, true), "", "",
+        NAME_WIDTH, true});
+    table->AddColumn({"section", DumpTable::COLUMN_STRING, PadHeader(COLUMN_PREFIX, "Section", SECTION_WIDTH, true),
+        COLUMN_PREFIX, "", SECTION_WIDTH, true});
+    table->AddColumn({"wall_us", DumpTable::COLUMN_UINT, PadHeader(COLUMN_PREFIX, "Wall(us)", NUMBER_WIDTH, false),
+        COLUMN_PREFIX, "", NUMBER_WIDTH, false});
+    table->AddColumn({"cpu_us", DumpTable::COLUMN_UINT, PadHeader(COLUMN_PREFIX, "Cpu(us)", NUMBER_WIDTH, false),
+        COLUMN_PREFIX, "", NUMBER_WIDTH, false});
+    table->AddColumn({"lines", DumpTable::COLUMN_UINT, PadHeader(COLUMN_PREFIX, "Lines", NUMBER_WIDTH, false),
+        COLUMN_PREFIX, "", NUMBER_WIDTH, false});
+    table->AddColumn({"bytes", DumpTable::COLUMN_UINT, PadHeader(COLUMN_PREFIX, "Bytes", NUMBER_WIDTH, false),
+        COLUMN_PREFIX, "", NUMBER_WIDTH, false});
+    table->AddColumn({"loops", DumpTable::COLUMN_UINT, PadHeader(COLUMN_PREFIX, "Loops", NUMBER_WIDTH, false),
+        COLUMN_PREFIX, "", NUMBER_WIDTH, false});
+    for (const auto &item : rows) {
+        size_t row = table->AddRow();
+        table->SetString(row, STATS_NAME, item.name);
+        table->SetString(row, STATS_SECTION, item.section);
+        table->SetValue(row, STATS_WALL, item.wallNs / NS_PER_US);
+        table->SetValue(row, STATS_CPU, item.cpuNs / NS_PER_US);
+        table->SetValue(row, STATS_LINES, item.lines);
+        table->SetValue(row, STATS_BYTES, item.bytes);
+        table->SetValue(row, STATS_LOOPS, item.loops);
+    }
+    return table;
+}
+
+void DumpExecutorStats::Log() const
+{
+    std::vector<Item> rows;
+    MergeItems(rows);
+    for (const auto &item : rows) {
+        DUMPER_HILOGI(MODULE_COMMON, "info|stats name=%{public}s, section=%{public}s, wall=%{public}llu us,"
+            " cpu=%{public}llu us, lines=%{public}llu, bytes=%{public}llu, loops=%{public}u",
+            item.name.c_str(), item.section.c_str(), static_cast<unsigned long long>(item.wallNs / NS_PER_US),
+            static_cast<unsigned long long>(item.cpuNs / NS_PER_US), static_cast<unsigned long long>(item.lines),
+            static_cast<unsigned long long>(item.bytes), item.loops);
+    }
+}
+
+uint64_t DumpExecutorStats::GetWallNs()
+{
+    struct timespec ts = {0, 0};
+    (void)clock_gettime(CLOCK_MONOTONIC, &ts);
+    return static_cast<uint64_t>(ts.tv_sec) * NS_PER_SEC + static_cast<uint64_t>(ts.tv_nsec);
+}
+
+uint64_t DumpExecutorStats::GetThreadCpuNs()
+{
+    struct timespec ts = {0, 0};
+    (void)clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+    return static_cast<uint64_t>(ts.tv_sec) * NS_PER_SEC + static_cast<uint64_t>(ts.tv_nsec);
+}
+
+void DumpExecutorStats::Count(const Matrix &matrix, const DumpLineBuffer *lines, size_t &lineCount,
+    size_t &byteCount)
+{
+    lineCount = matrix.size();
+    byteCount = 0;
+    for (const auto &line : matrix) {
+        for (const auto &cell : line) {
+            byteCount += cell.size();
+        }
+    }
+    if (lines != nullptr) {
+        lineCount += lines->GetLineCount();
+        byteCount += lines->GetByteCount();
+    }
+}
+
+void DumpExecutorStats::MergeItems(std::vector<Item> &rows) const
+{
+    std::map<std::pair<std::string, std::string>, size_t> rowIndex;
+    std::map<std::pair<std::string, std::string>, size_t> outputIndex;
+    std::vector<Item> outputs;
+    for (const auto &item : items_) {
+        if (item.loops == 0) {
+            continue;
+        }
+        std::vector<Item> &target = item.isOutput ? outputs : rows;
+        auto &index = item.isOutput ? outputIndex : rowIndex;
+        auto key = std::make_pair(item.name, item.section);
+        auto it = index.find(key);
+        if (it == index.end()) {
+            index.emplace(key, target.size());
+            target.push_back(item);
+            continue;
+        }
+        Item &row = target[it->second];
+        row.wallNs += item.wallNs;
+        row.cpuNs += item.cpuNs;
+        row.lines += item.lines;
+        row.bytes += item.bytes;
+        row.loops += item.loops;
+    }
+    rows.insert(rows.end(), outputs.begin(), outputs.end());
+}
+} // namespace HiviewDFX
+} // namespace OHOS
@@ -0,0 +1,379 @@
+/*
+ * Copyright (C) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "util/dump_fd_writer.h"
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <poll.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "hilog_wrapper.h"
+namespace OHOS {
+namespace HiviewDFX {
+namespace {
+static const char NEW_LINE = '\n';
+static const int BUFFER_IOV_COUNT = 2;
+static const size_t MAX_BATCH_SLOTS = 64;
+static const size_t MAX_SLOT_CAPACITY_TIMES = 4; // a slot keeps the capacity of a few buffers only
+static const std::string DROP_MARKER_HEAD = "\n[hidumper: ";
+static const std::string DROP_MARKER_TAIL = " bytes dropped, the client reads too slowly]\n";
+
+uint64_t ElapsedUs(const std::chrono::steady_clock::time_point &start)
+{
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count());
+}
+}
+
+DumpFdWriter::DumpFdWriter(int fd, size_t highWater)
+    : fd_(fd), highWater_(highWater), policy_(GetDefaultFlushPolicy(fd))
+{
+    buffer_.reserve(highWater_ + 1);
+}
+
+DumpFdWriter::~DumpFdWriter()
+{
+    Flush();
+    StopAsync();
+}
+
+bool DumpFdWriter::Append(const std::string &str)
+{
+    return Append(str.data(), str.size());
+}
+
+bool DumpFdWriter::Append(const char *data, size_t len)
+{
+    if (broken_) {
+        return false;
+    }
+    if (len >= highWater_) {
+        // a huge cell, write it out together with the buffer without copying.
+        return Write(data, len);
+    }
+    if (len > 0) {
+        buffer_.append(data, len);
+    }
+    if (buffer_.size() >= highWater_) {
+        return Write(nullptr, 0);
+    }
+    return true;
+}
+
+bool DumpFdWriter::AppendLine(const std::string &str)
+{
+    return AppendLine(str.data(), str.size());
+}
+
+bool DumpFdWriter::AppendLine(const char *data, size_t len)
+{
+    if (!Append(data, len)) {
+        return false;
+    }
+    if ((len > 0) && (memchr(data, NEW_LINE, len) != nullptr)) {
+        return true;
+    }
+    if (broken_) {
+        return false;
+    }
+    buffer_.push_back(NEW_LINE);
+    if (buffer_.size() >= highWater_) {
+        return Write(nullptr, 0);
+    }
+    return true;
+}
+
+bool DumpFdWriter::Flush()
+{
+    bool ret = Write(nullptr, 0);
+    if (!async_) {
+        return ret;
+    }
+    WaitDrained();
+    if ((droppedPending_ > 0) && !broken_) {
+        // the ring has drained, there is room for the marker now.
+        std::string marker;
+        Push(marker);
+        WaitDrained();
+    }
+    return !broken_;
+}
+
+bool DumpFdWriter::FlushSection()
+{
+    if (policy_ != FLUSH_SECTION) {
+        return !broken_;
+    }
+    // hand the section to the writer thread, don't wait for the client.
+    return Write(nullptr, 0);
+}
+
+DumpFdWriter::FlushPolicy DumpFdWriter::GetFlushPolicy() const
+{
+    return policy_;
+}
+
+bool DumpFdWriter::IsBroken() const
+{
+    return broken_;
+}
+
+int DumpFdWriter::GetError() const
+{
+    return error_;
+}
+
+int DumpFdWriter::GetFd() const
+{
+    return fd_;
+}
+
+bool DumpFdWriter::StartAsync(size_t slots, Backpressure backpressure)
+{
+    if (async_ || (fd_ < 0) || (slots == 0) || !Flush()) {
+        return false;
+    }
+    slots_.resize(slots);
+    backpressure_ = backpressure;
+    stopping_ = false;
+    async_ = true;
+    thread_ = std::thread(&DumpFdWriter::WriterLoop, this);
+    return true;
+}
+
+bool DumpFdWriter::IsAsync() const
+{
+    return async_;
+}
+
+DumpFdWriter::Stats DumpFdWriter::GetStats() const
+{
+    Stats stats;
+    stats.bytes = statBytes_;
+    stats.writes = statWrites_;
+    stats.clientWaitUs = statClientWaitUs_;
+    stats.producerWaitUs = statProducerWaitUs_;
+    stats.droppedBytes = statDroppedBytes_;
+    return stats;
+}
+
+bool DumpFdWriter::Write(const char *data, size_t len)
+{
+    if (broken_ || (fd_ < 0)) {
+        buffer_.clear();
+        return false;
+    }
+    if (async_) {
+        bool ret = buffer_.empty() || Push(buffer_);
+        if (ret && (data != nullptr) && (len > 0)) {
+            std::string chunk(data, len);
+            ret = Push(chunk);
+        }
+        buffer_.clear(); // holds a drained slot now, keep its capacity
+        return ret;
+    }
+    struct iovec iov[BUFFER_IOV_COUNT];
+    int iovcnt = 0;
+    if (!buffer_.empty()) {
+        iov[iovcnt].iov_base = const_cast<char *>(buffer_.data());
+        iov[iovcnt].iov_len = buffer_.size();
+        iovcnt++;
+    }
+    if ((data != nullptr) && (len > 0)) {
+        iov[iovcnt].iov_base = const_cast<char *>(data);
+        iov[iovcnt].iov_len = len;
+        iovcnt++;
+    }
+    bool ret = (iovcnt == 0) || WriteFully(iov, iovcnt);
+    buffer_.clear(); // keep the capacity for reuse
+    return ret;
+}
+
+bool DumpFdWriter::WriteFully(struct iovec *iov, int iovcnt)
+{
+    while (iovcnt > 0) {
+        auto start = std::chrono::steady_clock::now();
+        ssize_t written = writev(fd_, iov, iovcnt);
+        statClientWaitUs_ += ElapsedUs(start);
+        statWrites_++;
+        if (written < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            if ((errno == EAGAIN) || (errno == EWOULDBLOCK)) {
+                start = std::chrono::steady_clock::now();
+                bool writable = WaitWritable();
+                statClientWaitUs_ += ElapsedUs(start);
+                if (writable) {
+                    continue;
+                }
+            }
+            int error = errno;
+            error_ = error;
+            broken_ = true;
+            DUMPER_HILOGE(MODULE_COMMON, "error|write fd=%{public}d failed, errno=%{public}d", fd_, error);
+            return false;
+        }
+        statBytes_ += static_cast<uint64_t>(written);
+        // partial write, skip what has been written and go on.
+        size_t left = static_cast<size_t>(written);
+        while ((iovcnt > 0) && (left >= iov->iov_len)) {
+            left -= iov->iov_len;
+            iov++;
+            iovcnt--;
+        }
+        if (iovcnt > 0) {
+            iov->iov_base = static_cast<char *>(iov->iov_base) + left;
+            iov->iov_len -= left;
+        }
+    }
+    return true;
+}
+
+bool DumpFdWriter::WaitWritable()
+{
+    struct pollfd pfd = {
+        .fd = fd_,
+        .events = POLLOUT,
+        .revents = 0,
+    };
+    int ret = poll(&pfd, 1, WRITE_POLL_TIMEOUT);
+    if (ret <= 0) {
+        // the reader doesn't drain the pipe, give up rather than block the dump forever.
+        errno = (ret == 0) ? ETIMEDOUT : errno;
+        return false;
+    }
+    return (pfd.revents & (POLLERR | POLLHUP | POLLNVAL)) == 0;
+}
+
+bool DumpFdWriter::Push(std::string &chunk)
+{
+    size_t tail = tail_;
+    if (tail - head_ >= slots_.size()) {
+        if (backpressure_ == BACKPRESSURE_DROP) {
+            droppedPending_ += chunk.size();
+            statDroppedBytes_ += chunk.size();
+            chunk.clear();
+            return true;
+        }
+        auto start = std::chrono::steady_clock::now();
+        std::unique_lock<std::mutex> lock(mutex_);
+        producerWaiting_ = true;
+        notFull_.wait(lock, [this, tail] { return (tail - head_ < slots_.size()) || broken_; });
+        producerWaiting_ = false;
+        lock.unlock();
+        statProducerWaitUs_ += ElapsedUs(start);
+        if (broken_) {
+            chunk.clear();
+            return false;
+        }
+    }
+    if (droppedPending_ > 0) {
+        chunk.insert(0, DROP_MARKER_HEAD + std::to_string(droppedPending_) + DROP_MARKER_TAIL);
+        droppedPending_ = 0;
+    }
+    // the slot was cleared by the writer thread, chunk takes over its capacity.
+    slots_[tail % slots_.size()].swap(chunk);
+    tail_ = tail + 1;
+    if (consumerWaiting_) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        notEmpty_.notify_one();
+    }
+    return !broken_;
+}
+
+void DumpFdWriter::WaitDrained()
+{
+    auto start = std::chrono::steady_clock::now();
+    std::unique_lock<std::mutex> lock(mutex_);
+    producerWaiting_ = true;
+    notFull_.wait(lock, [this] { return (head_ == tail_) || broken_; });
+    producerWaiting_ = false;
+    lock.unlock();
+    statProducerWaitUs_ += ElapsedUs(start);
+}
+
+void DumpFdWriter::WriterLoop()
+{
+    std::vector<struct iovec> iov;
+    iov.reserve(std::min(slots_.size(), MAX_BATCH_SLOTS));
+    while (true) {
+        size_t head = head_;
+        if (tail_ == head) {
+            std::unique_lock<std::mutex> lock(mutex_);
+            consumerWaiting_ = true;
+            notEmpty_.wait(lock, [this, head] { return (tail_ != head) || stopping_; });
+            consumerWaiting_ = false;
+            if (tail_ == head) {
+                break; // stopping and drained
+            }
+            continue;
+        }
+        size_t count = std::min(tail_ - head, std::min(slots_.size(), MAX_BATCH_SLOTS));
+        iov.clear();
+        for (size_t i = 0; i < count; i++) {
+            std::string &slot = slots_[(head + i) % slots_.size()];
+            if (!slot.empty()) {
+                iov.push_back({ const_cast<char *>(slot.data()), slot.size() });
+            }
+        }
+        // one writev for all buffers ready, after an error they are dropped.
+        if (!broken_ && !iov.empty()) {
+            WriteFully(iov.data(), static_cast<int>(iov.size()));
+        }
+        for (size_t i = 0; i < count; i++) {
+            std::string &slot = slots_[(head + i) % slots_.size()];
+            if (slot.capacity() > highWater_ * MAX_SLOT_CAPACITY_TIMES) {
+                std::string().swap(slot);
+            } else {
+                slot.clear();
+            }
+        }
+        head_ = head + count;
+        if (producerWaiting_) {
+            std::lock_guard<std::mutex> lock(mutex_);
+            notFull_.notify_one();
+        }
+    }
+}
+
+void DumpFdWriter::StopAsync()
+{
+    if (!async_) {
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+    }
+    notEmpty_.notify_one();
+    if (thread_.joinable()) {
+        thread_.join();
+    }
+    async_ = false;
+}
+
+DumpFdWriter::FlushPolicy DumpFdWriter::GetDefaultFlushPolicy(int fd)
+{
+    struct stat st;
+    if ((fd >= 0) && (fstat(fd, &st) == 0) && S_ISREG(st.st_mode)) {
+        return FLUSH_REQUEST;
+    }
+    // pipe, socket or tty, somebody is reading it right now.
+    return FLUSH_SECTION;
+}
+} // namespace HiviewDFX
+} // namespace OHOS
@@ -0,0 +1,176 @@
+/*
+ * Copyright (C) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "util/dump_line_buffer.h"
+#include "securec.h"
+namespace OHOS {
+namespace HiviewDFX {
+DumpLineBuffer::DumpLineBuffer(size_t chunkSize)
+    : chunkSize_(chunkSize), bigChunkBytes_(0), chunkIndex_(0), chunkUsed_(0), lineStart_(0), byteCount_(0),
+      tableBytes_(0)
+{
+}
+
+void DumpLineBuffer::AppendCell(const char *data, size_t size)
+{
+    char *dest = Allocate(size);
+    if ((size > 0) && (memcpy_s(dest, size, data, size) != EOK)) {
+        size = 0;
+    }
+    cells_.push_back({ dest, size });
+    byteCount_ += size;
+}
+
+void DumpLineBuffer::AppendCell(const std::string &str)
+{
+    AppendCell(str.data(), str.size());
+}
+
+void DumpLineBuffer::EndLine()
+{
+    lines_.push_back({ static_cast<uint32_t>(lineStart_), static_cast<uint32_t>(cells_.size() - lineStart_), 0 });
+    lineStart_ = cells_.size();
+}
+
+void DumpLineBuffer::AppendLine(const std::vector<std::string> &cells)
+{
+    for (const auto &cell : cells) {
+        AppendCell(cell);
+    }
+    EndLine();
+}
+
+void DumpLineBuffer::MoveFrom(std::vector<std::vector<std::string>> &matrix)
+{
+    for (const auto &line : matrix) {
+        AppendLine(line);
+    }
+    matrix.clear();
+}
+
+void DumpLineBuffer::AppendTable(const std::shared_ptr<DumpTable> &table)
+{
+    if (table == nullptr) {
+        return;
+    }
+    if (lineStart_ < cells_.size()) {
+        EndLine();
+    }
+    tables_.push_back(table);
+    tableBytes_ += table->GetRowCount() * table->GetRowWidth();
+    lines_.push_back({ static_cast<uint32_t>(lineStart_), 0, static_cast<uint32_t>(tables_.size()) });
+}
+
+size_t DumpLineBuffer::GetLineCount() const
+{
+    return lines_.size();
+}
+
+bool DumpLineBuffer::IsEmpty() const
+{
+    return lines_.empty();
+}
+
+size_t DumpLineBuffer::GetCellCount(size_t line) const
+{
+    return lines_[line].cellCount;
+}
+
+DumpTable *DumpLineBuffer::GetTable(size_t line) const
+{
+    uint32_t table = lines_[line].table;
+    return (table == 0) ? nullptr : tables_[table - 1].get();
+}
+
+DumpLineBuffer::Cell DumpLineBuffer::GetCell(size_t line, size_t cell) const
+{
+    const CellRef &ref = cells_[lines_[line].firstCell + cell];
+    return { ref.data, ref.size };
+}
+
+char *DumpLineBuffer::GetMutableCell(size_t line, size_t cell, size_t &size)
+{
+    CellRef &ref = cells_[lines_[line].firstCell + cell];
+    size = ref.size;
+    return ref.data;
+}
+
+void DumpLineBuffer::ShrinkCell(size_t line, size_t cell, size_t size)
+{
+    CellRef &ref = cells_[lines_[line].firstCell + cell];
+    if (size < ref.size) {
+        byteCount_ -= ref.size - size;
+        ref.size = size;
+    }
+}
+
+void DumpLineBuffer::GetLine(size_t line, std::vector<std::string> &cells) const
+{
+    const LineRef &ref = lines_[line];
+    cells.resize(ref.cellCount);
+    for (uint32_t i = 0; i < ref.cellCount; i++) {
+        const CellRef &cell = cells_[ref.firstCell + i];
+        cells[i].assign(cell.data, cell.size);
+    }
+}
+
+void DumpLineBuffer::Clear()
+{
+    cells_.clear();
+    lines_.clear();
+    tables_.clear();
+    lineStart_ = 0;
+    byteCount_ = 0;
+    tableBytes_ = 0;
+    chunkIndex_ = 0;
+    chunkUsed_ = 0;
+    bigChunks_.clear();
+    bigChunkBytes_ = 0;
+}
+
+size_t DumpLineBuffer::GetCapacity() const
+{
+    return chunks_.size() * chunkSize_ + bigChunkBytes_;
+}
+
+size_t DumpLineBuffer::GetByteCount() const
+{
+    return byteCount_;
+}
+
+size_t DumpLineBuffer::GetPendingSize() const
+{
+    return byteCount_ + tableBytes_;
+}
+
+char *DumpLineBuffer::Allocate(size_t size)
+{
+    if (size > chunkSize_) {
+        bigChunks_.emplace_back(new char[size]);
+        bigChunkBytes_ += size;
+        return bigChunks_.back().get();
+    }
+    if ((chunkIndex_ < chunks_.size()) && (chunkSize_ - chunkUsed_ < size)) {
+        chunkIndex_++;
+        chunkUsed_ = 0;
+    }
+    if (chunkIndex_ == chunks_.size()) {
+        chunks_.emplace_back(new char[chunkSize_]);
+    }
+    char *dest = chunks_[chunkIndex_].get() + chunkUsed_;
+    chunkUsed_ += size;
+    return dest;
+}
+} // namespace HiviewDFX
+} // namespace OHOS
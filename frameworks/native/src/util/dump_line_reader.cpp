@@ -0,0 +1,140 @@
+/*
+ * Copyright (C) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "util/dump_line_reader.h"
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <fcntl.h>
+#include <poll.h>
+#include <unistd.h>
+namespace OHOS {
+namespace HiviewDFX {
+DumpLineReader::DumpLineReader(int fd) : fd_(-1), begin_(0), end_(0), eof_(false)
+{
+    Reset(fd);
+}
+
+void DumpLineReader::Reset(int fd)
+{
+    fd_ = fd;
+    begin_ = 0;
+    end_ = 0;
+    eof_ = false;
+    if (fd_ < 0) {
+        return;
+    }
+    if (buffer_.empty()) {
+        buffer_.resize(DEFAULT_BUFFER_SIZE);
+    }
+    int flags = fcntl(fd_, F_GETFL);
+    if ((flags >= 0) && ((static_cast<unsigned int>(flags) & O_NONBLOCK) == 0)) {
+        (void)fcntl(fd_, F_SETFL, static_cast<unsigned int>(flags) | O_NONBLOCK);
+    }
+}
+
+DumpLineReader::Result DumpLineReader::ReadLine(uint64_t timeoutMs, const CancelCheck &isCanceled,
+    const char *&data, size_t &size)
+{
+    if (fd_ < 0) {
+        return READ_ERROR;
+    }
+    uint64_t deadline = GetNowMillSec() + timeoutMs;
+    while (!TakeLine(data, size)) {
+        if (eof_) {
+            return READ_END;
+        }
+        Result ret = Fill(deadline, isCanceled);
+        if (ret != READ_LINE) {
+            return ret;
+        }
+    }
+    return READ_LINE;
+}
+
+bool DumpLineReader::TakeLine(const char *&data, size_t &size)
+{
+    if (begin_ >= end_) {
+        return false;
+    }
+    char *start = buffer_.data() + begin_;
+    char *lineEnd = static_cast<char *>(memchr(start, '\n', end_ - begin_));
+    if (lineEnd != nullptr) {
+        data = start;
+        size = static_cast<size_t>(lineEnd - start);
+        begin_ += size + 1;
+        return true;
+    }
+    if (eof_ || (end_ - begin_ >= MAX_LINE_SIZE)) {
+        data = start;
+        size = (end_ - begin_ < MAX_LINE_SIZE) ? (end_ - begin_) : MAX_LINE_SIZE;
+        begin_ += size;
+        return true;
+    }
+    return false;
+}
+
+DumpLineReader::Result DumpLineReader::Fill(uint64_t deadline, const CancelCheck &isCanceled)
+{
+    // keep the start of a line, grow for a line longer than the buffer, up to MAX_LINE_SIZE.
+    if (begin_ > 0) {
+        if (end_ > begin_) {
+            (void)memmove(buffer_.data(), buffer_.data() + begin_, end_ - begin_);
+        }
+        end_ -= begin_;
+        begin_ = 0;
+    }
+    if (end_ == buffer_.size()) {
+        size_t bufferSize = buffer_.size() * 2; // 2: double the buffer
+        buffer_.resize((bufferSize < MAX_LINE_SIZE) ? bufferSize : MAX_LINE_SIZE);
+    }
+    while (true) {
+        if ((isCanceled != nullptr) && isCanceled()) {
+            return READ_CANCELED;
+        }
+        uint64_t now = GetNowMillSec();
+        if (now >= deadline) {
+            return READ_TIMEOUT;
+        }
+        uint64_t wait = deadline - now;
+        struct pollfd pfd = { fd_, POLLIN, 0 };
+        int ready = poll(&pfd, 1, static_cast<int>((wait < CANCEL_POLL_MILLSEC) ? wait : CANCEL_POLL_MILLSEC));
+        if ((ready < 0) && (errno != EINTR)) {
+            return READ_ERROR;
+        }
+        if (ready <= 0) {
+            continue;
+        }
+        ssize_t len = read(fd_, buffer_.data() + end_, buffer_.size() - end_);
+        if (len > 0) {
+            end_ += static_cast<size_t>(len);
+            return READ_LINE;
+        }
+        if (len == 0) {
+            eof_ = true;
+            return READ_LINE;
+        }
+        if ((errno != EAGAIN) && (errno != EINTR)) {
+            return READ_ERROR;
+        }
+    }
+}
+
+uint64_t DumpLineReader::GetNowMillSec()
+{
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+} // namespace HiviewDFX
+} // namespace OHOS
@@ -0,0 +1,71 @@
+/*
+ * Copyright (C) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "util/dump_plan_cache.h"
+namespace OHOS {
+namespace HiviewDFX {
+DumpPlanCache::DumpPlanCache()
+{
+}
+
+DumpPlanCache::~DumpPlanCache()
+{
+}
+
+std::shared_ptr<const DumpPlanCache::Plan> DumpPlanCache::Find(const std::string &key)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (auto it = plans_.begin(); it != plans_.end(); ++it) {
+        if (it->first != key) {
+            continue;
+        }
+        plans_.splice(plans_.begin(), plans_, it);
+        return plans_.front().second;
+    }
+    return nullptr;
+}
+
+void DumpPlanCache::Add(const std::string &key, const std::shared_ptr<const Plan> &plan)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    plans_.remove_if([&key](const std::pair<std::string, std::shared_ptr<const Plan>> &item) {
+        return item.first == key;
+    });
+    plans_.emplace_front(key, plan);
+    if (plans_.size() > MAX_PLANS) {
+        plans_.pop_back();
+    }
+}
+
+void DumpPlanCache::Clear()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    plans_.clear();
+}
+
+void DumpPlanCache::CloneConfigs(const std::vector<std::shared_ptr<DumpCfg>> &configs,
+                                 std::vector<std::shared_ptr<DumpCfg>> &result)
+{
+    // parents are indexes in the list, so they hold for the clones.
+    for (auto &config : configs) {
+        auto clone = DumpCfg::Create();
+        *clone = *config;
+        clone->type_ = config->type_;
+        clone->expand_ = config->expand_;
+        clone->parent_ = config->parent_;
+        result.push_back(clone);
+    }
+}
+} // namespace HiviewDFX
+} // namespace OHOS
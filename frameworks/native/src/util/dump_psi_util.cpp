@@ -0,0 +1,198 @@
+/*
+ * Copyright (C) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "util/dump_psi_util.h"
+#include <cstdlib>
+#include <cstring>
+#include "datetime_ex.h"
+#include "file_ex.h"
+#include "string_ex.h"
+#include "securec.h"
+#include "hilog_wrapper.h"
+namespace OHOS {
+namespace HiviewDFX {
+namespace {
+static const int DECIMAL_BASE = 10;
+static const double HUNDRED_PERCENT = 100.0;
+}
+const std::string DumpPsiUtil::PSI_CPU = "cpu";
+const std::string DumpPsiUtil::PSI_MEMORY = "memory";
+const std::string DumpPsiUtil::PSI_IO = "io";
+const std::string DumpPsiUtil::PRESSURE_PATH = "/proc/pressure/";
+
+DumpPsiUtil::DumpPsiUtil()
+{
+    DUMPER_HILOGD(MODULE_COMMON, "create debug|");
+}
+
+DumpPsiUtil::~DumpPsiUtil()
+{
+    DUMPER_HILOGD(MODULE_COMMON, "release debug|");
+    curSamples_.clear();
+    oldSamples_.clear();
+}
+
+void DumpPsiUtil::UpdatePsiInfo()
+{
+    const std::string resources[] = {PSI_CPU, PSI_MEMORY, PSI_IO};
+    for (const auto &resource : resources) {
+        PsiSample sample;
+        if (!GetCurPsiInfo(resource, sample.info)) {
+            continue;
+        }
+        sample.tick = static_cast<uint64_t>(GetTickCount());
+        std::unique_lock<std::mutex> lock(mutex_);
+        auto it = curSamples_.find(resource);
+        if (it != curSamples_.end()) {
+            oldSamples_[resource] = it->second;
+        }
+        curSamples_[resource] = sample;
+    }
+}
+
+bool DumpPsiUtil::GetCurPsiInfo(const std::string &resource, PsiInfo &psiInfo)
+{
+    return GetPsiInfoFromFile(PRESSURE_PATH + resource, psiInfo);
+}
+
+bool DumpPsiUtil::GetPsiInfoFromFile(const std::string &path, PsiInfo &psiInfo)
+{
+    // some avg10=0.00 avg60=0.00 avg300=0.00 total=0
+    // full avg10=0.00 avg60=0.00 avg300=0.00 total=0
+    std::string rawData;
+    if (!LoadStringFromFile(path, rawData)) {
+        return false;
+    }
+    psiInfo.some.valid = false;
+    psiInfo.full.valid = false;
+    std::vector<std::string> lines;
+    SplitStr(rawData, "\n", lines);
+    for (const auto &line : lines) {
+        if (line.compare(0, strlen("some"), "some") == 0) {
+            ParsePsiLine(line, psiInfo.some);
+        } else if (line.compare(0, strlen("full"), "full") == 0) {
+            ParsePsiLine(line, psiInfo.full);
+        }
+    }
+    return psiInfo.some.valid;
+}
+
+bool DumpPsiUtil::GetOldPsiInfo(const std::string &resource, PsiInfo &psiInfo, uint64_t &tick)
+{
+    uint64_t curTick = static_cast<uint64_t>(GetTickCount());
+    std::unique_lock<std::mutex> lock(mutex_);
+    auto it = curSamples_.find(resource);
+    if (it == curSamples_.end()) {
+        return false;
+    }
+    // the latest sample is too close for a meaningful delta, fall back to the one before it.
+    if ((curTick - it->second.tick) < PSI_MIN_DELTA_WINDOW) {
+        it = oldSamples_.find(resource);
+        if (it == oldSamples_.end()) {
+            return false;
+        }
+    }
+    psiInfo = it->second.info;
+    tick = it->second.tick;
+    return true;
+}
+
+bool DumpPsiUtil::GetPsiLines(const std::string &resource, std::vector<std::string> &lines)
+{
+    PsiInfo curInfo;
+    if (!GetCurPsiInfo(resource, curInfo)) {
+        return false;
+    }
+    uint64_t curTick = static_cast<uint64_t>(GetTickCount());
+    std::string line = "Pressure(" + resource + "): ";
+    line.append(CreatePsiString("some", curInfo.some));
+    if (curInfo.full.valid) {
+        line.append("; ").append(CreatePsiString("full", curInfo.full));
+    }
+    lines.push_back(line);
+
+    PsiInfo oldInfo;
+    uint64_t oldTick = 0;
+    if (GetOldPsiInfo(resource, oldInfo, oldTick) && (curTick > oldTick)) {
+        lines.push_back(CreateStallString(curInfo, oldInfo, curTick - oldTick));
+    }
+    return true;
+}
+
+bool DumpPsiUtil::ParsePsiLine(const std::string &line, PsiItem &psiItem)
+{
+    std::vector<std::string> fields;
+    SplitStr(line, " ", fields);
+    psiItem.avg10 = 0;
+    psiItem.avg60 = 0;
+    psiItem.avg300 = 0;
+    psiItem.total = 0;
+    for (const auto &field : fields) {
+        size_t pos = field.find('=');
+        if (pos == std::string::npos) {
+            continue;
+        }
+        std::string key = field.substr(0, pos);
+        const char *value = field.c_str() + pos + 1;
+        if (key == "avg10") {
+            psiItem.avg10 = strtod(value, nullptr);
+        } else if (key == "avg60") {
+            psiItem.avg60 = strtod(value, nullptr);
+        } else if (key == "avg300") {
+            psiItem.avg300 = strtod(value, nullptr);
+        } else if (key == "total") {
+            psiItem.total = strtoull(value, nullptr, DECIMAL_BASE);
+            psiItem.valid = true;
+        }
+    }
+    return psiItem.valid;
+}
+
+std::string DumpPsiUtil::CreatePsiString(const std::string &type, const PsiItem &psiItem)
+{
+    char format[PSI_STR_LENGTH] = {0};
+    int ret = sprintf_s(format, PSI_STR_LENGTH, "%s avg10=%.2f%% avg60=%.2f%% avg300=%.2f%% total=%llu us",
+        type.c_str(), psiItem.avg10, psiItem.avg60, psiItem.avg300, static_cast<unsigned long long>(psiItem.total));
+    if (ret < 0) {
+        return type;
+    }
+    return std::string(format);
+}
+
+std::string DumpPsiUtil::CreateStallString(const PsiInfo &curInfo, const PsiInfo &oldInfo, uint64_t window)
+{
+    uint64_t windowUs = window * US_PER_MS;
+    uint64_t someStall = GetDeltaValue(curInfo.some.total, oldInfo.some.total);
+    std::string str = "    stall in the last " + std::to_string(window) + " ms: some ";
+    str.append(std::to_string(someStall)).append(" us");
+    char percent[PSI_STR_LENGTH] = {0};
+    if (sprintf_s(percent, PSI_STR_LENGTH, " (%.2f%%)", someStall * HUNDRED_PERCENT / windowUs) >= 0) {
+        str.append(percent);
+    }
+    if (curInfo.full.valid && oldInfo.full.valid) {
+        uint64_t fullStall = GetDeltaValue(curInfo.full.total, oldInfo.full.total);
+        str.append("; full ").append(std::to_string(fullStall)).append(" us");
+        if (sprintf_s(percent, PSI_STR_LENGTH, " (%.2f%%)", fullStall * HUNDRED_PERCENT / windowUs) >= 0) {
+            str.append(percent);
+        }
+    }
+    return str;
+}
+
+uint64_t DumpPsiUtil::GetDeltaValue(uint64_t curValue, uint64_t oldValue)
+{
+    return (curValue > oldValue) ? (curValue - oldValue) : 0;
+}
+} // namespace HiviewDFX
+} // namespace OHOS
@@ -0,0 +1,190 @@
+/*
+ * Copyright (C) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "util/dump_snapshot_writer.h"
+#include "dump_snapshot_format.h"
+#include "util/dump_cell_utils.h"
+namespace OHOS {
+namespace HiviewDFX {
+namespace {
+static const uint8_t VARINT_MORE = 0x80;
+static const uint8_t VARINT_MASK = 0x7F;
+static const int VARINT_SHIFT = 7;
+static const int BYTE_BITS = 8;
+static const uint64_t BYTE_MASK = 0xFF;
+static const size_t SIZE_U16 = 2;
+static const size_t SIZE_U32 = 4;
+static const size_t SIZE_U64 = 8;
+static const int SIGN_SHIFT = 63;
+} // namespace
+
+DumpSnapshotWriter::DumpSnapshotWriter() : started_(false)
+{
+}
+
+void DumpSnapshotWriter::Begin(uint64_t timeMs)
+{
+    buffer_.append(SNAPSHOT_MAGIC, SNAPSHOT_MAGIC_SIZE);
+    AppendFixed(SNAPSHOT_VERSION, SIZE_U16, buffer_);
+    AppendFixed(timeMs, SIZE_U64, buffer_);
+    strings_.clear();
+    lastInts_.clear();
+    started_ = true;
+}
+
+void DumpSnapshotWriter::End()
+{
+    if (!started_) {
+        return;
+    }
+    AppendRecord(SNAPSHOT_RECORD_END, nullptr, 0);
+    started_ = false;
+}
+
+bool DumpSnapshotWriter::IsStarted() const
+{
+    return started_;
+}
+
+void DumpSnapshotWriter::WriteSection(const std::string &name)
+{
+    uint32_t id = GetStringId(name);
+    payload_.clear();
+    AppendVarint(id, payload_);
+    AppendRecord(SNAPSHOT_RECORD_SECTION, payload_);
+}
+
+void DumpSnapshotWriter::BeginTable(uint32_t headerRows)
+{
+    lastInts_.clear();
+    payload_.clear();
+    AppendVarint(headerRows, payload_);
+    AppendRecord(SNAPSHOT_RECORD_TABLE, payload_);
+}
+
+void DumpSnapshotWriter::WriteRow(const std::vector<std::string> &line)
+{
+    BeginRow(line.size());
+    for (size_t i = 0; i < line.size(); i++) {
+        std::string value = DumpCellUtils::Trim(line[i]);
+        int64_t mantissa = 0;
+        uint8_t scale = 0;
+        bool percent = false;
+        if (!DumpCellUtils::ParseNumber(value, mantissa, scale, percent)) {
+            AppendStringCell(value);
+            continue;
+        }
+        if (scale > 0) {
+            uint8_t flag = percent ? SNAPSHOT_CELL_PERCENT : 0;
+            payload_.push_back(static_cast<char>(SNAPSHOT_CELL_DECIMAL | flag));
+            payload_.push_back(static_cast<char>(scale));
+            AppendZigzag(mantissa, payload_);
+            continue;
+        }
+        AppendIntCell(i, mantissa, percent);
+    }
+    EndRow();
+}
+
+void DumpSnapshotWriter::BeginRow(size_t cellCount)
+{
+    if (lastInts_.size() < cellCount) {
+        lastInts_.resize(cellCount, 0);
+    }
+    // strings of the row are recorded into buffer_ while the row is built.
+    payload_.clear();
+    AppendVarint(cellCount, payload_);
+}
+
+void DumpSnapshotWriter::AppendIntCell(size_t column, int64_t value, bool percent)
+{
+    // wraps like the reader adds it back.
+    uint64_t delta = static_cast<uint64_t>(value) - static_cast<uint64_t>(lastInts_[column]);
+    lastInts_[column] = value;
+    uint8_t flag = percent ? SNAPSHOT_CELL_PERCENT : 0;
+    payload_.push_back(static_cast<char>(SNAPSHOT_CELL_INT | flag));
+    AppendZigzag(static_cast<int64_t>(delta), payload_);
+}
+
+void DumpSnapshotWriter::AppendStringCell(const std::string &value)
+{
+    uint32_t id = GetStringId(value);
+    payload_.push_back(static_cast<char>(SNAPSHOT_CELL_STRING));
+    AppendVarint(id, payload_);
+}
+
+void DumpSnapshotWriter::EndRow()
+{
+    AppendRecord(SNAPSHOT_RECORD_ROW, payload_);
+}
+
+void DumpSnapshotWriter::WriteText(const std::string &text)
+{
+    AppendRecord(SNAPSHOT_RECORD_TEXT, text);
+}
+
+std::string &DumpSnapshotWriter::GetBuffer()
+{
+    return buffer_;
+}
+
+void DumpSnapshotWriter::AppendVarint(uint64_t value, std::string &out)
+{
+    while (value > VARINT_MASK) {
+        out.push_back(static_cast<char>((value & VARINT_MASK) | VARINT_MORE));
+        value >>= VARINT_SHIFT;
+    }
+    out.push_back(static_cast<char>(value));
+}
+
+void DumpSnapshotWriter::AppendZigzag(int64_t value, std::string &out)
+{
+    uint64_t sign = static_cast<uint64_t>(value >> SIGN_SHIFT);
+    AppendVarint((static_cast<uint64_t>(value) << 1) ^ sign, out);
+}
+
+uint32_t DumpSnapshotWriter::GetStringId(const std::string &str)
+{
+    auto it = strings_.find(str);
+    if (it != strings_.end()) {
+        return it->second;
+    }
+    uint32_t id = static_cast<uint32_t>(strings_.size());
+    strings_.emplace(str, id);
+    AppendRecord(SNAPSHOT_RECORD_STRING, str);
+    return id;
+}
+
+void DumpSnapshotWriter::AppendRecord(uint8_t type, const std::string &payload)
+{
+    AppendRecord(type, payload.data(), payload.size());
+}
+
+void DumpSnapshotWriter::AppendRecord(uint8_t type, const char *payload, size_t size)
+{
+    buffer_.push_back(static_cast<char>(type));
+    AppendFixed(size, SIZE_U32, buffer_);
+    if (size > 0) {
+        buffer_.append(payload, size);
+    }
+}
+
+void DumpSnapshotWriter::AppendFixed(uint64_t value, size_t size, std::string &out)
+{
+    for (size_t i = 0; i < size; i++) {
+        out.push_back(static_cast<char>((value >> (i * BYTE_BITS)) & BYTE_MASK));
+    }
+}
+} // namespace HiviewDFX
+} // namespace OHOS
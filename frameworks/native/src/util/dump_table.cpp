@@ -0,0 +1,203 @@
+/*
+ * Copyright (C) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "util/dump_table.h"
+#include <algorithm>
+namespace OHOS {
+namespace HiviewDFX {
+namespace {
+static const char PAD_CHAR = ' ';
+static const char PERCENT_CHAR = '%';
+static const uint32_t EMPTY_STRING_ID = 0;
+} // namespace
+
+DumpTable::DumpTable() : storedRows_(0), headerVisible_(true)
+{
+    (void)GetStringId("");
+}
+
+size_t DumpTable::AddColumn(const Column &column)
+{
+    columns_.push_back(column);
+    values_.emplace_back(storedRows_, (column.type == COLUMN_STRING) ? EMPTY_STRING_ID : 0);
+    return columns_.size() - 1;
+}
+
+size_t DumpTable::GetColumnCount() const
+{
+    return columns_.size();
+}
+
+const DumpTable::Column &DumpTable::GetColumn(size_t column) const
+{
+    return columns_[column];
+}
+
+size_t DumpTable::AddRow()
+{
+    for (auto &values : values_) {
+        values.push_back(0); // 0 is also the id of ""
+    }
+    order_.push_back(storedRows_++);
+    return order_.size() - 1;
+}
+
+size_t DumpTable::GetRowCount() const
+{
+    return order_.size();
+}
+
+size_t DumpTable::GetRowWidth() const
+{
+    size_t width = 0;
+    for (const auto &column : columns_) {
+        width += column.prefix.size() + column.width + column.unit.size();
+    }
+    return width;
+}
+
+void DumpTable::SetValue(size_t row, size_t column, uint64_t value)
+{
+    values_[column][order_[row]] = value;
+}
+
+void DumpTable::SetString(size_t row, size_t column, const std::string &value)
+{
+    values_[column][order_[row]] = GetStringId(value);
+}
+
+uint64_t DumpTable::GetValue(size_t row, size_t column) const
+{
+    return values_[column][order_[row]];
+}
+
+const std::string &DumpTable::GetString(size_t row, size_t column) const
+{
+    return strings_[values_[column][order_[row]]];
+}
+
+void DumpTable::Sort(const std::vector<SortKey> &keys)
+{
+    std::stable_sort(order_.begin(), order_.end(), [this, &keys](uint32_t left, uint32_t right) {
+        for (const auto &key : keys) {
+            const auto &values = values_[key.column];
+            uint64_t a = values[left];
+            uint64_t b = values[right];
+            int result = 0;
+            if (columns_[key.column].type == COLUMN_STRING) {
+                result = strings_[a].compare(strings_[b]);
+            } else if (a != b) {
+                result = (a < b) ? -1 : 1;
+            }
+            if (result != 0) {
+                return key.descending ? (result > 0) : (result < 0);
+            }
+        }
+        return false;
+    });
+}
+
+void DumpTable::Top(size_t count)
+{
+    if (order_.size() > count) {
+        order_.resize(count);
+    }
+}
+
+void DumpTable::Filter(const RowFilter &keep)
+{
+    std::vector<uint32_t> kept;
+    kept.reserve(order_.size());
+    for (size_t row = 0; row < order_.size(); row++) {
+        if (keep(*this, row)) {
+            kept.push_back(order_[row]);
+        }
+    }
+    order_.swap(kept);
+}
+
+void DumpTable::FilterStrings(const StringFilter &filter)
+{
+    stringIds_.clear();
+    for (uint32_t id = 0; id < strings_.size(); id++) {
+        std::string &str = strings_[id];
+        if (!str.empty()) {
+            str.resize(filter(&str[0], str.size()));
+        }
+        stringIds_.emplace(str, id);
+    }
+}
+
+void DumpTable::SetHeaderVisible(bool visible)
+{
+    headerVisible_ = visible;
+}
+
+bool DumpTable::IsHeaderVisible() const
+{
+    return headerVisible_;
+}
+
+void DumpTable::FormatHeader(std::string &out) const
+{
+    for (const auto &column : columns_) {
+        out.append(column.header);
+    }
+}
+
+void DumpTable::FormatRow(size_t row, std::string &out) const
+{
+    for (size_t column = 0; column < columns_.size(); column++) {
+        FormatCell(row, column, out);
+    }
+}
+
+void DumpTable::FormatCell(size_t row, size_t column, std::string &out) const
+{
+    const Column &layout = columns_[column];
+    uint64_t value = values_[column][order_[row]];
+    std::string text = (layout.type == COLUMN_STRING) ? strings_[value] : std::to_string(value);
+    text.append(layout.unit);
+    out.append(layout.prefix);
+    AppendPadded(text, layout.width, layout.leftAlign, out);
+    if (layout.type == COLUMN_PERCENT) {
+        out.push_back(PERCENT_CHAR);
+    }
+}
+
+uint32_t DumpTable::GetStringId(const std::string &value)
+{
+    auto it = stringIds_.find(value);
+    if (it != stringIds_.end()) {
+        return it->second;
+    }
+    uint32_t id = static_cast<uint32_t>(strings_.size());
+    strings_.push_back(value);
+    stringIds_.emplace(value, id);
+    return id;
+}
+
+void DumpTable::AppendPadded(const std::string &text, size_t width, bool leftAlign, std::string &out)
+{
+    size_t pad = (text.size() < width) ? (width - text.size()) : 0;
+    if (!leftAlign) {
+        out.append(pad, PAD_CHAR);
+    }
+    out.append(text);
+    if (leftAlign) {
+        out.append(pad, PAD_CHAR);
+    }
+}
+} // namespace HiviewDFX
+} // namespace OHOS
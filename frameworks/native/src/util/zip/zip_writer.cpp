@@ -13,28 +13,137 @@
  * limitations under the License.
  */
 #include "util/zip/zip_writer.h"
+#include <algorithm>
+#include <cerrno>
 #include <chrono>
+#include <climits>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
 #include "directory_ex.h"
 #include "dump_utils.h"
 #include "hilog_wrapper.h"
+#include "util/dump_compressor.h"
 namespace OHOS {
 namespace HiviewDFX {
 namespace {
 static const int PROCENT100 = 100;
-static const int kZipBufSize = 8192;
+static const size_t kZipBufSize = 256 * 1024;
 static const int kBaseYear = 1900;
 static const uLong LANGUAGE_ENCODING_FLAG = 0x1 << 11;
+static const uint64_t MAX_MEMORY_ENTRY_SIZE = 64 * 1024 * 1024;
+static const uint64_t MAX_PENDING_BYTES = 128 * 1024 * 1024;
+static const uint64_t ZIP64_LIMIT = 0xffffffffULL;
+static const size_t MAX_MAGIC_SIZE = 6;
+struct Magic {
+    unsigned char bytes[MAX_MAGIC_SIZE];
+    size_t len;
+};
+static const Magic COMPRESSED_MAGICS[] = {
+    { { 0x1f, 0x8b }, 2 }, // gzip
+    { { 'P', 'K', 0x03, 0x04 }, 4 }, // zip, hap
+    { { 0x28, 0xb5, 0x2f, 0xfd }, 4 }, // zstd
+    { { 0xfd, '7', 'z', 'X', 'Z', 0x00 }, 6 }, // xz
+    { { 'B', 'Z', 'h' }, 3 }, // bzip2
+    { { 0x04, 0x22, 0x4d, 0x18 }, 4 }, // lz4
+    { { 0x89, 'P', 'N', 'G' }, 4 }, // png
+    { { 0xff, 0xd8, 0xff }, 3 }, // jpeg
+};
 } // namespace
 
-ZipWriter::ZipWriter(const std::string &zipFilePath) : zipFilePath_(zipFilePath), zipFile_(nullptr)
+class ZipWriter::MappedFile {
+public:
+    MappedFile() = default;
+    ~MappedFile()
+    {
+        if (addr_ != nullptr) {
+            (void)munmap(addr_, len_);
+        }
+    }
+
+    // tooBig is set, and false returned, for files over maxSize.
+    bool Load(const std::string &path, uint64_t maxSize, bool &tooBig)
+    {
+        tooBig = false;
+        int fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+        if (fd < 0) {
+            return false;
+        }
+        struct stat st = {0};
+        bool ret = (fstat(fd, &st) == 0);
+        if (ret && (static_cast<uint64_t>(st.st_size) > maxSize)) {
+            tooBig = true;
+            ret = false;
+        } else if (ret && (st.st_size > 0)) {
+            void *addr = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (addr != MAP_FAILED) {
+                (void)madvise(addr, st.st_size, MADV_SEQUENTIAL);
+                addr_ = addr;
+                len_ = static_cast<size_t>(st.st_size);
+            } else {
+                ret = ReadAll(fd, maxSize, tooBig);
+            }
+        } else if (ret) {
+            // proc and sys files report 0 bytes, read them instead.
+            ret = ReadAll(fd, maxSize, tooBig);
+        }
+        close(fd);
+        return ret;
+    }
+
+    const unsigned char *Data() const
+    {
+        return (addr_ != nullptr) ? static_cast<const unsigned char *>(addr_) : buffer_.data();
+    }
+
+    size_t Size() const
+    {
+        return (addr_ != nullptr) ? len_ : buffer_.size();
+    }
+
+private:
+    bool ReadAll(int fd, uint64_t maxSize, bool &tooBig)
+    {
+        size_t used = 0;
+        while (true) {
+            buffer_.resize(used + kZipBufSize);
+            ssize_t len = read(fd, buffer_.data() + used, kZipBufSize);
+            if ((len < 0) && (errno == EINTR)) {
+                continue;
+            }
+            if (len <= 0) {
+                buffer_.resize(used);
+                return (len == 0);
+            }
+            used += static_cast<size_t>(len);
+            if (used > maxSize) {
+                tooBig = true;
+                return false;
+            }
+        }
+    }
+
+private:
+    void *addr_ = nullptr;
+    size_t len_ = 0;
+    std::vector<unsigned char> buffer_;
+};
+
+ZipWriter::ZipWriter(const std::string &zipFilePath, const DumpCodec &codec)
+    : zipFilePath_(zipFilePath), zipFile_(nullptr), codec_(codec),
+      workers_(DumpCompressor::GetDefaultWorkers()), maxMemoryEntrySize_(MAX_MEMORY_ENTRY_SIZE)
 {
-    DUMPER_HILOGD(MODULE_COMMON, "create|zipFilePath=[%{public}s]", zipFilePath_.c_str());
+    DUMPER_HILOGD(MODULE_COMMON, "create|zipFilePath=[%{public}s], codec=[%{public}s]",
+        zipFilePath_.c_str(), codec_.GetName().c_str());
 }
 
 ZipWriter::~ZipWriter()
 {
     DUMPER_HILOGD(MODULE_COMMON, "release|");
     zipItems_.clear();
+    StopWorkers();
     Close();
 }
 
@@ -64,6 +173,9 @@ bool ZipWriter::Close()
 
     int res = ZIP_OK;
 
+    if (entryOpened_) {
+        (void)CloseEntry();
+    }
     if (zipFile_ != nullptr) {
         res = zipClose(zipFile_, nullptr);
     }
@@ -96,6 +208,83 @@ bool ZipWriter::Write(const std::vector<std::pair<std::string, std::string>> &zi
     return ret;
 }
 
+bool ZipWriter::OpenEntry(const std::string &relativePath)
+{
+    DUMPER_HILOGD(MODULE_COMMON, "OpenEntry enter|relativePath=[%{public}s]", relativePath.c_str());
+
+    if ((zipFile_ == nullptr) || entryOpened_) {
+        DUMPER_HILOGE(MODULE_COMMON, "OpenEntry leave|false, not opened or entry in use");
+        return false;
+    }
+    // deflated entries are compressed here and written raw, the sizes and crc are given on close.
+    // the size is not known up front, so the entry gets zip64 records in case it passes 4 GB.
+    entryRaw_ = (codec_.GetType() != DumpCodec::CODEC_STORE);
+    entryOpened_ = ZipOpenNewFileInZip(zipFile_, relativePath, codec_.GetZipMethod(), entryRaw_, true);
+    if (entryOpened_ && entryRaw_) {
+        zipFile zip = zipFile_;
+        auto sink = [zip] (const unsigned char *data, size_t len) { return WriteInZip(zip, data, len); };
+        if (compressor_.Init(sink, codec_, workers_, DumpCompressor::FORMAT_RAW) != DumpStatus::DUMP_OK) {
+            DUMPER_HILOGE(MODULE_COMMON, "OpenEntry error|init compressor failed");
+            (void)zipCloseFileInZipRaw64(zipFile_, 0, 0);
+            entryOpened_ = false;
+        }
+    }
+
+    DUMPER_HILOGD(MODULE_COMMON, "OpenEntry leave|ret=%{public}d", entryOpened_);
+    return entryOpened_;
+}
+
+bool ZipWriter::WriteEntry(const char *data, size_t len)
+{
+    if (!entryOpened_) {
+        return false;
+    }
+    if (entryRaw_) {
+        return compressor_.Append(data, len) == DumpStatus::DUMP_OK;
+    }
+    return WriteInZip(zipFile_, reinterpret_cast<const unsigned char *>(data), len);
+}
+
+bool ZipWriter::CloseEntry()
+{
+    if (!entryOpened_) {
+        return false;
+    }
+    entryOpened_ = false;
+    if (!entryRaw_) {
+        return CloseNewFileEntry(zipFile_);
+    }
+    bool ret = (compressor_.Finish() == DumpStatus::DUMP_OK);
+    if (zipCloseFileInZipRaw64(zipFile_, compressor_.GetTotalIn(), compressor_.GetCrc()) != ZIP_OK) {
+        ret = false;
+    }
+    DUMPER_HILOGD(MODULE_COMMON, "CloseEntry leave|ret=%{public}d", ret);
+    return ret;
+}
+
+void ZipWriter::SetWorkers(uint32_t workers)
+{
+    workers_ = workers;
+}
+
+void ZipWriter::SetMaxMemoryEntrySize(uint64_t size)
+{
+    maxMemoryEntrySize_ = size;
+}
+
+bool ZipWriter::IsCompressedData(const unsigned char *data, size_t len)
+{
+    if (data == nullptr) {
+        return false;
+    }
+    for (auto &magic : COMPRESSED_MAGICS) {
+        if ((len >= magic.len) && (memcmp(data, magic.bytes, magic.len) == 0)) {
+            return true;
+        }
+    }
+    return false;
+}
+
 bool ZipWriter::FlushItems(const ZipTickNotify notify)
 {
     DUMPER_HILOGD(MODULE_COMMON, "FlushItems enter|");
@@ -104,6 +293,22 @@ bool ZipWriter::FlushItems(const ZipTickNotify notify)
     zipItems.assign(zipItems_.begin(), zipItems_.end());
     zipItems_.clear();
 
+    uint32_t workers = static_cast<uint32_t>(std::min<size_t>(workers_, zipItems.size()));
+    z_stream stream = {0};
+    bool streamReady = false;
+    if (workers > 1) {
+        entries_.clear();
+        nextItem_ = 0;
+        pendingBytes_ = 0;
+        stopping_ = false;
+        for (uint32_t i = 0; i < workers; i++) {
+            threads_.emplace_back(&ZipWriter::WorkerLoop, this, std::cref(zipItems));
+        }
+    } else {
+        streamReady = (deflateInit2(&stream, codec_.GetZlibLevel(), Z_DEFLATED, -MAX_WBITS, DEF_MEM_LEVEL,
+            Z_DEFAULT_STRATEGY) == Z_OK);
+    }
+
     bool ret = true;
     for (size_t i = 0; i < zipItems.size(); i++) {
         if ((notify != nullptr) && (notify(((PROCENT100 * i) / zipItems.size()), UNSET_PROGRESS))) {
@@ -118,17 +323,149 @@ bool ZipWriter::FlushItems(const ZipTickNotify notify)
         DUMPER_HILOGD(MODULE_COMMON, "FlushItems debug|relativePath=[%{public}s], absolutePath=[%{public}s]",
             relativePath.c_str(), absolutePath.c_str());
 
-        if (!AddFileEntryToZip(zipFile_, relativePath, absolutePath)) {
+        std::shared_ptr<Entry> entry = (workers > 1) ? WaitEntry(i) : PrepareEntry(stream, streamReady, absolutePath);
+        if (!AddPreparedEntryToZip(zipFile_, relativePath, absolutePath, *entry)) {
             DUMPER_HILOGE(MODULE_COMMON, "FlushItems error|false, failed to write file");
             ret = false;
             break;
         }
     }
 
+    StopWorkers();
+    if (streamReady) {
+        (void)deflateEnd(&stream);
+    }
+
     DUMPER_HILOGD(MODULE_COMMON, "FlushItems leave|ret=%{public}d", ret);
     return ret;
 }
 
+void ZipWriter::WorkerLoop(const std::vector<std::pair<std::string, std::string>> &zipItems)
+{
+    // each worker keeps its own raw deflate state and resets it per entry.
+    z_stream stream = {0};
+    bool streamReady = (deflateInit2(&stream, codec_.GetZlibLevel(), Z_DEFLATED, -MAX_WBITS, DEF_MEM_LEVEL,
+        Z_DEFAULT_STRATEGY) == Z_OK);
+    while (true) {
+        size_t index = 0;
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            roomCond_.wait(lock, [this, &zipItems] {
+                return stopping_ || (nextItem_ >= zipItems.size()) || (pendingBytes_ < MAX_PENDING_BYTES);
+            });
+            if (stopping_ || (nextItem_ >= zipItems.size())) {
+                break;
+            }
+            index = nextItem_++;
+        }
+        std::shared_ptr<Entry> entry = PrepareEntry(stream, streamReady, zipItems[index].first);
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            pendingBytes_ += entry->dataLen;
+            entries_[index] = entry;
+        }
+        readyCond_.notify_all();
+    }
+    if (streamReady) {
+        (void)deflateEnd(&stream);
+    }
+}
+
+std::shared_ptr<ZipWriter::Entry> ZipWriter::WaitEntry(size_t index)
+{
+    std::shared_ptr<Entry> entry;
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        readyCond_.wait(lock, [this, index] { return entries_.count(index) > 0; });
+        auto it = entries_.find(index);
+        entry = it->second;
+        entries_.erase(it);
+        pendingBytes_ -= entry->dataLen;
+    }
+    roomCond_.notify_all();
+    return entry;
+}
+
+void ZipWriter::StopWorkers()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+    }
+    roomCond_.notify_all();
+    for (auto &thread : threads_) {
+        if (thread.joinable()) {
+            thread.join();
+        }
+    }
+    threads_.clear();
+    entries_.clear();
+    pendingBytes_ = 0;
+}
+
+std::shared_ptr<ZipWriter::Entry> ZipWriter::PrepareEntry(z_stream &stream, bool streamReady,
+    const std::string &absolutePath) const
+{
+    auto entry = std::make_shared<Entry>();
+    std::string path = absolutePath;
+    if (!DumpUtils::PathIsValid(path)) {
+        DUMPER_HILOGE(MODULE_COMMON, "PrepareEntry error|PathIsValid");
+        return entry;
+    }
+    auto source = std::make_shared<MappedFile>();
+    bool tooBig = false;
+    if (!source->Load(absolutePath, maxMemoryEntrySize_, tooBig)) {
+        // too big to hold in memory, the writer thread streams it.
+        entry->ok = tooBig;
+        entry->streamed = tooBig;
+        return entry;
+    }
+    entry->size = source->Size();
+    entry->crc = crc32(0L, Z_NULL, 0);
+    for (size_t pos = 0; pos < source->Size();) {
+        uInt piece = static_cast<uInt>(std::min<size_t>(source->Size() - pos, UINT_MAX));
+        entry->crc = crc32(entry->crc, source->Data() + pos, piece);
+        pos += piece;
+    }
+    entry->source = source;
+    bool store = (codec_.GetType() == DumpCodec::CODEC_STORE) || (entry->size == 0) ||
+        IsCompressedData(source->Data(), source->Size());
+    if (!store && streamReady && DeflateEntry(stream, *entry) && (entry->deflated.size() < entry->size)) {
+        entry->method = Z_DEFLATED;
+        entry->data = entry->deflated.data();
+        entry->dataLen = entry->deflated.size();
+        entry->source = nullptr;
+    } else {
+        // already compressed, or does not shrink.
+        entry->method = DumpCodec::ZIP_METHOD_STORE;
+        entry->deflated.clear();
+        entry->data = source->Data();
+        entry->dataLen = source->Size();
+    }
+    entry->ok = true;
+    return entry;
+}
+
+bool ZipWriter::DeflateEntry(z_stream &stream, Entry &entry) const
+{
+    if (deflateReset(&stream) != Z_OK) {
+        return false;
+    }
+    const unsigned char *data = entry.source->Data();
+    size_t size = entry.source->Size();
+    entry.deflated.resize(deflateBound(&stream, size));
+    stream.next_in = const_cast<Bytef *>(data);
+    stream.avail_in = static_cast<uInt>(size);
+    stream.next_out = entry.deflated.data();
+    stream.avail_out = static_cast<uInt>(entry.deflated.size());
+    if (deflate(&stream, Z_FINISH) != Z_STREAM_END) {
+        entry.deflated.clear();
+        return false;
+    }
+    entry.deflated.resize(stream.total_out);
+    return true;
+}
+
 bool ZipWriter::SetTimeToZipFileInfo(zip_fileinfo &zipInfo)
 {
     auto nowTime = std::chrono::system_clock::to_time_t(std::chrono::system_clock::now());
@@ -149,19 +486,23 @@ bool ZipWriter::SetTimeToZipFileInfo(zip_fileinfo &zipInfo)
 
 zipFile ZipWriter::OpenForZipping(const std::string &fileName, int append)
 {
-    return zipOpen2(fileName.c_str(), append, nullptr, nullptr);
+    // the 64 bit api writes zip64 records once the archive passes 4 GB.
+    return zipOpen64(fileName.c_str(), append);
 }
 
-bool ZipWriter::ZipOpenNewFileInZip(zipFile zip_file, const std::string &strPath)
+bool ZipWriter::ZipOpenNewFileInZip(zipFile zip_file, const std::string &strPath, int method, bool raw, bool zip64)
 {
-    DUMPER_HILOGD(MODULE_COMMON, "ZipOpenNewFileInZip enter|strPath=[%{public}s]", strPath.c_str());
+    DUMPER_HILOGD(MODULE_COMMON, "ZipOpenNewFileInZip enter|strPath=[%{public}s], method=%{public}d, raw=%{public}d",
+        strPath.c_str(), method, raw);
 
     zip_fileinfo fileInfo = {};
     SetTimeToZipFileInfo(fileInfo);
 
-    int res = zipOpenNewFileInZip4(zip_file, strPath.c_str(), &fileInfo,
-        nullptr, 0u, nullptr, 0u, nullptr, Z_DEFLATED, Z_DEFAULT_COMPRESSION,
-        0, -MAX_WBITS, DEF_MEM_LEVEL, Z_DEFAULT_STRATEGY, nullptr, 0, 0, LANGUAGE_ENCODING_FLAG);
+    int level = (method == DumpCodec::ZIP_METHOD_STORE) ? Z_NO_COMPRESSION : codec_.GetZlibLevel();
+    int res = zipOpenNewFileInZip4_64(zip_file, strPath.c_str(), &fileInfo,
+        nullptr, 0u, nullptr, 0u, nullptr, method, level,
+        raw ? 1 : 0, -MAX_WBITS, DEF_MEM_LEVEL, Z_DEFAULT_STRATEGY, nullptr, 0, 0, LANGUAGE_ENCODING_FLAG,
+        zip64 ? 1 : 0);
 
     bool ret = (res == ZIP_OK);
 
@@ -185,14 +526,18 @@ bool ZipWriter::AddFileContentToZip(zipFile zip_file, std::string &file_path)
     }
 
     bool ret = true;
-    char buf[kZipBufSize];
+    std::vector<char> buf(kZipBufSize);
     while (!feof(fp)) {
-        size_t readSum = fread(buf, 1, kZipBufSize, fp);
+        size_t readSum = fread(buf.data(), 1, buf.size(), fp);
         if (readSum < 1) {
+            if (ferror(fp)) {
+                ret = false;
+                break;
+            }
             continue;
         }
 
-        if (zipWriteInFileInZip(zip_file, buf, readSum) != ZIP_OK) {
+        if (zipWriteInFileInZip(zip_file, buf.data(), readSum) != ZIP_OK) {
             DUMPER_HILOGE(MODULE_COMMON, "AddFileContentToZip error|could not write data to zip");
             ret = false;
             break;
@@ -206,14 +551,17 @@ bool ZipWriter::AddFileContentToZip(zipFile zip_file, std::string &file_path)
     return ret;
 }
 
-bool ZipWriter::OpenNewFileEntry(zipFile zip_file, std::string &path)
+bool ZipWriter::WriteInZip(zipFile zip_file, const unsigned char *data, size_t len)
 {
-    DUMPER_HILOGD(MODULE_COMMON, "OpenNewFileEntry enter|path=[%{public}s]", path.c_str());
-
-    bool ret = ZipOpenNewFileInZip(zip_file, path);
-
-    DUMPER_HILOGD(MODULE_COMMON, "OpenNewFileEntry leave|ret=%{public}d", ret);
-    return ret;
+    for (size_t pos = 0; pos < len;) {
+        unsigned piece = static_cast<unsigned>(std::min<size_t>(len - pos, UINT_MAX));
+        if (zipWriteInFileInZip(zip_file, data + pos, piece) != ZIP_OK) {
+            DUMPER_HILOGE(MODULE_COMMON, "WriteInZip error|could not write data to zip");
+            return false;
+        }
+        pos += piece;
+    }
+    return true;
 }
 
 bool ZipWriter::CloseNewFileEntry(zipFile zip_file)
@@ -232,7 +580,9 @@ bool ZipWriter::AddFileEntryToZip(zipFile zip_file, std::string &relativePath, s
     DUMPER_HILOGD(MODULE_COMMON, "AddFileEntryToZip enter|relativePath=[%{public}s], absolutePath=[%{public}s]",
         relativePath.c_str(), absolutePath.c_str());
 
-    if (!OpenNewFileEntry(zip_file, relativePath)) {
+    struct stat st = {0};
+    bool zip64 = (stat(absolutePath.c_str(), &st) == 0) && (static_cast<uint64_t>(st.st_size) >= ZIP64_LIMIT);
+    if (!ZipOpenNewFileInZip(zip_file, relativePath, codec_.GetZipMethod(), false, zip64)) {
         DUMPER_HILOGD(MODULE_COMMON, "AddFileEntryToZip leave|false, open");
         return false;
     }
@@ -247,5 +597,39 @@ bool ZipWriter::AddFileEntryToZip(zipFile zip_file, std::string &relativePath, s
     DUMPER_HILOGD(MODULE_COMMON, "AddFileEntryToZip leave|ret=%{public}d", ret);
     return ret;
 }
+
+bool ZipWriter::AddPreparedEntryToZip(zipFile zip_file, std::string &relativePath, std::string &absolutePath,
+    Entry &entry)
+{
+    if (!entry.ok) {
+        DUMPER_HILOGE(MODULE_COMMON, "AddPreparedEntryToZip error|prepare failed, path=[%{public}s]",
+            absolutePath.c_str());
+        return false;
+    }
+    if (entry.streamed) {
+        return AddFileEntryToZip(zip_file, relativePath, absolutePath);
+    }
+
+    if (!ZipOpenNewFileInZip(zip_file, relativePath, entry.method, true, entry.size >= ZIP64_LIMIT)) {
+        DUMPER_HILOGD(MODULE_COMMON, "AddPreparedEntryToZip leave|false, open");
+        return false;
+    }
+    bool ret = true;
+    for (size_t pos = 0; pos < entry.dataLen;) {
+        unsigned piece = static_cast<unsigned>(std::min<size_t>(entry.dataLen - pos, UINT_MAX));
+        if (zipWriteInFileInZip(zip_file, entry.data + pos, piece) != ZIP_OK) {
+            DUMPER_HILOGE(MODULE_COMMON, "AddPreparedEntryToZip error|could not write data to zip");
+            ret = false;
+            break;
+        }
+        pos += piece;
+    }
+    // raw entries carry their own crc and size.
+    if (zipCloseFileInZipRaw64(zip_file, entry.size, entry.crc) != ZIP_OK) {
+        DUMPER_HILOGD(MODULE_COMMON, "AddPreparedEntryToZip leave|false, close");
+        return false;
+    }
+    return ret;
+}
 } // namespace HiviewDFX
 } // namespace OHOS
@@ -15,14 +15,26 @@
 #include "util/zip_utils.h"
 #include "directory_ex.h"
 #include "dump_utils.h"
-#include "util/zip/zip_writer.h"
 #include "hilog_wrapper.h"
 namespace OHOS {
 namespace HiviewDFX {
-bool ZipUtils::ZipFolder(const std::string &srcPath, const std::string &dstFile, const ZipTickNotify notify)
+bool ZipUtils::ZipFolder(const std::string &srcPath, const std::string &dstFile, const DumpCodec &codec,
+    const ZipTickNotify notify)
 {
-    DUMPER_HILOGD(MODULE_COMMON, "enter|srcPath=[%{public}s], dstFile=[%{public}s]",
-        srcPath.c_str(), dstFile.c_str());
+    DUMPER_HILOGD(MODULE_COMMON, "enter|srcPath=[%{public}s], dstFile=[%{public}s], codec=[%{public}s]",
+        srcPath.c_str(), dstFile.c_str(), codec.GetName().c_str());
+
+    ZipWriter zipWriter(dstFile, codec);
+    zipWriter.Open();
+    bool ret = AppendFolder(srcPath, zipWriter, notify);
+
+    DUMPER_HILOGD(MODULE_COMMON, "leave|ret=%{public}d", ret);
+    return ret;
+}
+
+bool ZipUtils::AppendFolder(const std::string &srcPath, ZipWriter &zipWriter, const ZipTickNotify notify)
+{
+    DUMPER_HILOGD(MODULE_COMMON, "AppendFolder enter|srcPath=[%{public}s]", srcPath.c_str());
 
     std::string srcFolder = IncludeTrailingPathDelimiter(srcPath);
 
@@ -60,13 +72,9 @@ bool ZipUtils::ZipFolder(const std::string &srcPath, const std::string &dstFile,
             zipItem.first.c_str(), zipItem.second.c_str());
     }
 
-    DUMPER_HILOGD(MODULE_COMMON, "debug|Create, dstFile=[%{public}s]", dstFile.c_str());
-
-    ZipWriter zipWriter(dstFile);
-    zipWriter.Open();
     bool ret = zipWriter.Write(zipItems, notify);
 
-    DUMPER_HILOGD(MODULE_COMMON, "leave|ret=%{public}d", ret);
+    DUMPER_HILOGD(MODULE_COMMON, "AppendFolder leave|ret=%{public}d", ret);
     return ret;
 }
 } // namespace HiviewDFX
@@ -0,0 +1,366 @@
+/*
+ * Copyright (C) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "dump_snapshot_reader.h"
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+namespace OHOS {
+namespace HiviewDFX {
+namespace {
+static const uint8_t VARINT_MORE = 0x80;
+static const uint8_t VARINT_MASK = 0x7F;
+static const int VARINT_SHIFT = 7;
+static const int VARINT_MAX_SHIFT = 63;
+static const int BYTE_BITS = 8;
+static const size_t SIZE_U16 = 2;
+static const size_t SIZE_U32 = 4;
+static const size_t SIZE_U64 = 8;
+static const int DECIMAL_BASE = 10;
+static const uint8_t CELL_KIND_MASK = 0x7F;
+} // namespace
+
+std::string SnapshotSlice::ToString() const
+{
+    return (data == nullptr) ? std::string() : std::string(data, size);
+}
+
+double SnapshotCell::ToDouble() const
+{
+    double result = static_cast<double>(value);
+    for (uint8_t i = 0; i < scale; i++) {
+        result /= DECIMAL_BASE;
+    }
+    return result;
+}
+
+std::string SnapshotCell::ToString() const
+{
+    if (kind == SNAPSHOT_CELL_STRING) {
+        return str.ToString();
+    }
+    uint64_t magnitude = (value < 0) ? (0 - static_cast<uint64_t>(value)) : static_cast<uint64_t>(value);
+    std::string digits = std::to_string(magnitude);
+    if (scale > 0) {
+        if (digits.size() <= scale) {
+            digits.insert(0, scale + 1 - digits.size(), '0');
+        }
+        digits.insert(digits.size() - scale, 1, '.');
+    }
+    if (value < 0) {
+        digits.insert(0, 1, '-');
+    }
+    if (percent) {
+        digits.push_back('%');
+    }
+    return digits;
+}
+
+DumpSnapshotReader::DumpSnapshotReader()
+    : data_(nullptr), size_(0), pos_(0), map_(nullptr), mapSize_(0), corrupted_(false), inSnapshot_(false),
+      version_(0), time_(0), type_(SNAPSHOT_RECORD_END), payload_(nullptr), payloadSize_(0), payloadPos_(0),
+      headerRows_(0), cellCount_(0), cellIndex_(0)
+{
+}
+
+DumpSnapshotReader::~DumpSnapshotReader()
+{
+    Close();
+}
+
+bool DumpSnapshotReader::Open(const std::string &path)
+{
+    Close();
+    int fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        return false;
+    }
+    struct stat st;
+    if ((fstat(fd, &st) != 0) || (st.st_size < 0)) {
+        close(fd);
+        return false;
+    }
+    size_t size = static_cast<size_t>(st.st_size);
+    if (size == 0) {
+        close(fd);
+        return Attach(nullptr, 0);
+    }
+    void *map = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (map == MAP_FAILED) {
+        return false;
+    }
+    (void)madvise(map, size, MADV_SEQUENTIAL);
+    Attach(static_cast<const char *>(map), size);
+    map_ = map;
+    mapSize_ = size;
+    return true;
+}
+
+bool DumpSnapshotReader::Attach(const char *data, size_t size)
+{
+    Close();
+    data_ = data;
+    size_ = (data == nullptr) ? 0 : size;
+    return true;
+}
+
+void DumpSnapshotReader::Close()
+{
+    if (map_ != nullptr) {
+        munmap(map_, mapSize_);
+    }
+    map_ = nullptr;
+    mapSize_ = 0;
+    data_ = nullptr;
+    size_ = 0;
+    pos_ = 0;
+    corrupted_ = false;
+    inSnapshot_ = false;
+    type_ = SNAPSHOT_RECORD_END;
+    payload_ = nullptr;
+    payloadSize_ = 0;
+    payloadPos_ = 0;
+    section_ = SnapshotSlice();
+    cellCount_ = 0;
+    cellIndex_ = 0;
+    strings_.clear();
+    lastInts_.clear();
+}
+
+bool DumpSnapshotReader::Next()
+{
+    if (corrupted_) {
+        return false;
+    }
+    // cells left in the row still move the deltas of their columns.
+    SnapshotCell cell;
+    while (NextCell(cell)) {
+    }
+    if (corrupted_) {
+        return false;
+    }
+    while (true) {
+        if (!inSnapshot_) {
+            if (pos_ == size_) {
+                return false;
+            }
+            return ReadHeader();
+        }
+        if (size_ - pos_ < SNAPSHOT_RECORD_HEAD_SIZE) {
+            return Fail(); // truncated, e.g. the capture was killed
+        }
+        uint8_t type = static_cast<uint8_t>(data_[pos_]);
+        size_t size = static_cast<size_t>(ReadFixed(data_ + pos_ + 1, SIZE_U32));
+        if (size_ - pos_ - SNAPSHOT_RECORD_HEAD_SIZE < size) {
+            return Fail();
+        }
+        payload_ = data_ + pos_ + SNAPSHOT_RECORD_HEAD_SIZE;
+        payloadSize_ = size;
+        payloadPos_ = 0;
+        pos_ += SNAPSHOT_RECORD_HEAD_SIZE + size;
+        uint64_t value = 0;
+        switch (type) {
+            case SNAPSHOT_RECORD_END:
+                inSnapshot_ = false;
+                break;
+            case SNAPSHOT_RECORD_STRING:
+                strings_.push_back({ payload_, payloadSize_ });
+                continue;
+            case SNAPSHOT_RECORD_SECTION:
+                if (!ReadVarint(value) || (value >= strings_.size())) {
+                    return Fail();
+                }
+                section_ = strings_[value];
+                break;
+            case SNAPSHOT_RECORD_TABLE:
+                if (!ReadVarint(value)) {
+                    return Fail();
+                }
+                headerRows_ = static_cast<uint32_t>(value);
+                lastInts_.clear();
+                break;
+            case SNAPSHOT_RECORD_ROW:
+                // a cell takes two bytes at least.
+                if (!ReadVarint(value) || (value > payloadSize_)) {
+                    return Fail();
+                }
+                cellCount_ = static_cast<uint32_t>(value);
+                cellIndex_ = 0;
+                if (lastInts_.size() < cellCount_) {
+                    lastInts_.resize(cellCount_, 0);
+                }
+                break;
+            case SNAPSHOT_RECORD_TEXT:
+                break;
+            default:
+                continue; // written by a newer version
+        }
+        type_ = type;
+        return true;
+    }
+}
+
+bool DumpSnapshotReader::IsCorrupted() const
+{
+    return corrupted_;
+}
+
+uint8_t DumpSnapshotReader::GetType() const
+{
+    return type_;
+}
+
+uint16_t DumpSnapshotReader::GetVersion() const
+{
+    return version_;
+}
+
+uint64_t DumpSnapshotReader::GetTime() const
+{
+    return time_;
+}
+
+SnapshotSlice DumpSnapshotReader::GetSection() const
+{
+    return section_;
+}
+
+SnapshotSlice DumpSnapshotReader::GetText() const
+{
+    if (type_ != SNAPSHOT_RECORD_TEXT) {
+        return SnapshotSlice();
+    }
+    return { payload_, payloadSize_ };
+}
+
+uint32_t DumpSnapshotReader::GetHeaderRows() const
+{
+    return headerRows_;
+}
+
+uint32_t DumpSnapshotReader::GetCellCount() const
+{
+    return (type_ == SNAPSHOT_RECORD_ROW) ? cellCount_ : 0;
+}
+
+bool DumpSnapshotReader::NextCell(SnapshotCell &cell)
+{
+    if (corrupted_ || (type_ != SNAPSHOT_RECORD_ROW) || (cellIndex_ >= cellCount_)) {
+        return false;
+    }
+    if (payloadPos_ >= payloadSize_) {
+        return Fail();
+    }
+    uint8_t kind = static_cast<uint8_t>(payload_[payloadPos_++]);
+    cell = SnapshotCell();
+    cell.kind = kind & CELL_KIND_MASK;
+    cell.percent = ((kind & SNAPSHOT_CELL_PERCENT) != 0);
+    uint64_t id = 0;
+    int64_t delta = 0;
+    switch (cell.kind) {
+        case SNAPSHOT_CELL_STRING:
+            if (!ReadVarint(id) || (id >= strings_.size())) {
+                return Fail();
+            }
+            cell.str = strings_[id];
+            break;
+        case SNAPSHOT_CELL_INT:
+            if (!ReadZigzag(delta)) {
+                return Fail();
+            }
+            cell.value = static_cast<int64_t>(static_cast<uint64_t>(lastInts_[cellIndex_]) +
+                static_cast<uint64_t>(delta));
+            lastInts_[cellIndex_] = cell.value;
+            break;
+        case SNAPSHOT_CELL_DECIMAL:
+            if (payloadPos_ >= payloadSize_) {
+                return Fail();
+            }
+            cell.scale = static_cast<uint8_t>(payload_[payloadPos_++]);
+            if (!ReadZigzag(cell.value)) {
+                return Fail();
+            }
+            break;
+        default:
+            return Fail();
+    }
+    cellIndex_++;
+    return true;
+}
+
+bool DumpSnapshotReader::ReadHeader()
+{
+    if ((size_ - pos_ < SNAPSHOT_HEADER_SIZE) ||
+        (memcmp(data_ + pos_, SNAPSHOT_MAGIC, SNAPSHOT_MAGIC_SIZE) != 0)) {
+        return Fail();
+    }
+    version_ = static_cast<uint16_t>(ReadFixed(data_ + pos_ + SNAPSHOT_MAGIC_SIZE, SIZE_U16));
+    if (version_ > SNAPSHOT_VERSION) {
+        return Fail();
+    }
+    time_ = ReadFixed(data_ + pos_ + SNAPSHOT_MAGIC_SIZE + SIZE_U16, SIZE_U64);
+    pos_ += SNAPSHOT_HEADER_SIZE;
+    inSnapshot_ = true;
+    type_ = RECORD_BEGIN;
+    section_ = SnapshotSlice();
+    strings_.clear();
+    lastInts_.clear();
+    return true;
+}
+
+bool DumpSnapshotReader::ReadVarint(uint64_t &value)
+{
+    value = 0;
+    for (int shift = 0; shift <= VARINT_MAX_SHIFT; shift += VARINT_SHIFT) {
+        if (payloadPos_ >= payloadSize_) {
+            return false;
+        }
+        uint8_t byte = static_cast<uint8_t>(payload_[payloadPos_++]);
+        value |= static_cast<uint64_t>(byte & VARINT_MASK) << shift;
+        if ((byte & VARINT_MORE) == 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool DumpSnapshotReader::ReadZigzag(int64_t &value)
+{
+    uint64_t raw = 0;
+    if (!ReadVarint(raw)) {
+        return false;
+    }
+    value = static_cast<int64_t>((raw >> 1) ^ (0 - (raw & 1)));
+    return true;
+}
+
+uint64_t DumpSnapshotReader::ReadFixed(const char *data, size_t size) const
+{
+    uint64_t value = 0;
+    for (size_t i = 0; i < size; i++) {
+        value |= static_cast<uint64_t>(static_cast<uint8_t>(data[i])) << (i * BYTE_BITS);
+    }
+    return value;
+}
+
+bool DumpSnapshotReader::Fail()
+{
+    corrupted_ = true;
+    return false;
+}
+} // namespace HiviewDFX
+} // namespace OHOS
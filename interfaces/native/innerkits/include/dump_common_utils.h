@@ -40,6 +40,10 @@ public:
     };
     // get all process information in device.
     static bool GetPidInfos(std::vector<PidInfo> &infos, bool all = false);
+    // get pid and uid of all processes, the other fields are not read.
+    static bool GetPidUids(std::vector<PidInfo> &infos);
+    // get real uid of a process, from the "Uid:" line of its status.
+    static bool GetProcessUid(int pid, int &uid);
     // get process name by pid.
     static bool GetProcessNameByPid(int pid, std::string &name);
     // get process information by pid.
@@ -0,0 +1,63 @@
+/*
+ * Copyright (C) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef DUMP_SNAPSHOT_FORMAT_H
+#define DUMP_SNAPSHOT_FORMAT_H
+#include <cstddef>
+#include <cstdint>
+namespace OHOS {
+namespace HiviewDFX {
+/**
+ * Binary snapshot of a dump, written by --format snapshot. Little endian.
+ *
+ *   header   "HDSNAP" u16 version, u64 time in ms              16 bytes
+ *   record   u8 type, u32 size, size bytes of payload
+ *     STRING   bytes, takes the next id of the string table of the snapshot
+ *     SECTION  varint id of the section name
+ *     TABLE    varint count of header rows, the ROW records that follow
+ *     ROW      varint count of cells, then the cells
+ *     TEXT     bytes of one text line
+ *     END      no payload, closes the snapshot
+ *   cell     u8 kind, a percentage has SNAPSHOT_CELL_PERCENT set
+ *     STRING   varint string id
+ *     INT      zigzag varint delta to the INT before it in the column
+ *     DECIMAL  u8 scale, zigzag varint mantissa, value is mantissa / 10^scale
+ *
+ * Snapshots may be concatenated in one file. Readers skip records of types
+ * they do not know, the size frames every record.
+ */
+constexpr char SNAPSHOT_MAGIC[] = "HDSNAP";
+constexpr size_t SNAPSHOT_MAGIC_SIZE = sizeof(SNAPSHOT_MAGIC) - 1;
+constexpr uint16_t SNAPSHOT_VERSION = 1;
+constexpr size_t SNAPSHOT_HEADER_SIZE = 16;
+constexpr size_t SNAPSHOT_RECORD_HEAD_SIZE = 5;
+
+enum SnapshotRecordType : uint8_t {
+    SNAPSHOT_RECORD_END = 0,
+    SNAPSHOT_RECORD_STRING = 1,
+    SNAPSHOT_RECORD_SECTION = 2,
+    SNAPSHOT_RECORD_TABLE = 3,
+    SNAPSHOT_RECORD_ROW = 4,
+    SNAPSHOT_RECORD_TEXT = 5,
+};
+
+enum SnapshotCellKind : uint8_t {
+    SNAPSHOT_CELL_STRING = 0,
+    SNAPSHOT_CELL_INT = 1,
+    SNAPSHOT_CELL_DECIMAL = 2,
+};
+constexpr uint8_t SNAPSHOT_CELL_PERCENT = 0x80;
+} // namespace HiviewDFX
+} // namespace OHOS
+#endif // DUMP_SNAPSHOT_FORMAT_H
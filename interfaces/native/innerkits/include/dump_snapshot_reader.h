@@ -0,0 +1,113 @@
+/*
+ * Copyright (C) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef DUMP_SNAPSHOT_READER_H
+#define DUMP_SNAPSHOT_READER_H
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "dump_snapshot_format.h"
+namespace OHOS {
+namespace HiviewDFX {
+// bytes inside the snapshot, valid while the reader is open.
+struct SnapshotSlice {
+    const char *data = nullptr;
+    size_t size = 0;
+    std::string ToString() const;
+};
+
+struct SnapshotCell {
+    uint8_t kind = SNAPSHOT_CELL_STRING;
+    bool percent = false;
+    int64_t value = 0; // the integer, or the mantissa of a decimal
+    uint8_t scale = 0;
+    SnapshotSlice str;
+    double ToDouble() const;
+    // as the cell was printed, e.g. "12.5%".
+    std::string ToString() const;
+};
+
+/**
+ * Iterates the records of snapshot files in place: the file is mapped and
+ * strings are returned as slices of it, nothing is copied.
+ *
+ *   DumpSnapshotReader reader;
+ *   if (reader.Open(path)) {
+ *       while (reader.Next()) {
+ *           if (reader.GetType() == SNAPSHOT_RECORD_ROW) {
+ *               SnapshotCell cell;
+ *               while (reader.NextCell(cell)) { ... }
+ *           }
+ *       }
+ *   }
+ */
+class DumpSnapshotReader {
+public:
+    // type of Next() at the header of each snapshot.
+    static constexpr uint8_t RECORD_BEGIN = 0xFF;
+
+    DumpSnapshotReader();
+    ~DumpSnapshotReader();
+    DumpSnapshotReader(const DumpSnapshotReader &) = delete;
+    DumpSnapshotReader &operator=(const DumpSnapshotReader &) = delete;
+
+    bool Open(const std::string &path);
+    // data is not copied and must outlive the reader.
+    bool Attach(const char *data, size_t size);
+    void Close();
+
+    // BEGIN, SECTION, TABLE, ROW, TEXT or END; false at the end or on an error.
+    bool Next();
+    bool IsCorrupted() const;
+    uint8_t GetType() const;
+    uint16_t GetVersion() const;
+    uint64_t GetTime() const;
+    SnapshotSlice GetSection() const;
+    SnapshotSlice GetText() const;
+    uint32_t GetHeaderRows() const;
+    uint32_t GetCellCount() const;
+    bool NextCell(SnapshotCell &cell);
+
+private:
+    bool ReadHeader();
+    bool ReadVarint(uint64_t &value);
+    bool ReadZigzag(int64_t &value);
+    uint64_t ReadFixed(const char *data, size_t size) const;
+    bool Fail();
+
+private:
+    const char *data_;
+    size_t size_;
+    size_t pos_;
+    void *map_;
+    size_t mapSize_;
+    bool corrupted_;
+    bool inSnapshot_;
+    uint16_t version_;
+    uint64_t time_;
+    uint8_t type_;
+    const char *payload_;
+    size_t payloadSize_;
+    size_t payloadPos_;
+    SnapshotSlice section_;
+    uint32_t headerRows_;
+    uint32_t cellCount_;
+    uint32_t cellIndex_;
+    std::vector<SnapshotSlice> strings_;
+    std::vector<int64_t> lastInts_; // per column of the table
+};
+} // namespace HiviewDFX
+} // namespace OHOS
+#endif // DUMP_SNAPSHOT_READER_H
@@ -14,6 +14,8 @@
  */
 #ifndef HIDUMPER_SERVICES_DUMP_EVENT_HANDLER_H
 #define HIDUMPER_SERVICES_DUMP_EVENT_HANDLER_H
+#include <atomic>
+#include <cstdint>
 #include <event_handler.h>
 #include <refbase.h>
 namespace OHOS {
@@ -25,11 +27,34 @@ public:
         const wptr<DumpManagerService>& service);
     ~DumpEventHandler() = default;
     void ProcessEvent(const AppExecFwk::InnerEvent::Pointer& event) override;
+    // Schedule the first cpu info sample, used for deferred startup.
+    void StartCpuInfoSampler(int64_t delayTime);
+    // Remove pending cpu info samples, the next demand will restart the sampler.
+    void StopCpuInfoSampler();
+    // Notify the sampler that someone asked for dump data, thread safe. A stopped sampler
+    // takes its base sample in the caller, before the request reads cpu usage.
+    void NotifyCpuInfoDemand();
+    void SetIdleStopTime(int64_t idleStopTime);
+    int64_t GetIdleStopTime() const;
+    bool IsCpuInfoSampling() const;
 public:
     static const int MSG_GET_CPU_INFO_ID;
+    static const int MSG_CPU_INFO_DEMAND_ID;
     static const int GET_CPU_INFO_DELAY_TIME;
+    static const int GET_CPU_INFO_DELAY_TIME_MAX;
+    static const int GET_CPU_INFO_STARTUP_DELAY_TIME;
+    static const int GET_CPU_INFO_IDLE_STOP_TIME;
+private:
+    void OnCpuInfoDemand();
+    void OnCpuInfoTick();
+    static int64_t GetIdleStopTimeFromParam();
 private:
     wptr<DumpManagerService> service_;
+    // below members are only touched in the event runner thread, except sampling_ and idleStopTime_.
+    std::atomic<bool> sampling_ {false};
+    int64_t delayTime_ {0};
+    int64_t lastDemandTime_ {0};
+    std::atomic<int64_t> idleStopTime_ {0};
 };
 } // namespace HiviewDFX
 } // namespace OHOS
@@ -14,6 +14,7 @@
  */
 #ifndef HIDUMPER_SERVICES_DUMP_MANAGER_SERVICE_H
 #define HIDUMPER_SERVICES_DUMP_MANAGER_SERVICE_H
+#include <atomic>
 #include <map>
 #include <vector>
 #include <system_ability.h>
@@ -70,8 +71,9 @@ private:
     std::mutex mutex_;
     std::shared_ptr<AppExecFwk::EventRunner> eventRunner_;
     std::shared_ptr<DumpEventHandler> handler_;
-    bool started_ {false};
-    bool blockRequest_ {false};
+    // read by the ipc threads of requests.
+    std::atomic<bool> started_ {false};
+    std::atomic<bool> blockRequest_ {false};
     uint32_t requestIndex_ {0};
     std::map<uint32_t, std::shared_ptr<RawParam>> requestRawParamMap_;
 #ifdef DUMP_TEST_MODE // for mock test
@@ -16,6 +16,8 @@
 #include <file_ex.h>
 #include <securec.h>
 #include <string_ex.h>
+#include <cstdio>
+#include <cstring>
 #include <dirent.h>
 #include <fstream>
 #include <iostream>
@@ -29,7 +31,10 @@ constexpr int LINE_KEY = 0;
 constexpr int LINE_VALUE = 1;
 constexpr int LINE_VALUE_0 = 0;
 constexpr int UNSET = -1;
+constexpr int DECIMAL_BASE = 10;
+constexpr int STATUS_LINE_LENGTH = 256;
 static const std::string CPU_STR = "cpu";
+static const char UID_KEY[] = "Uid:";
 }
 
 DumpCommonUtils::CpuInfo::CpuInfo()
@@ -99,6 +104,54 @@ bool DumpCommonUtils::GetPidInfos(std::vector<PidInfo> &infos, bool all)
     return true;
 }
 
+bool DumpCommonUtils::GetPidUids(std::vector<PidInfo> &infos)
+{
+    std::vector<std::string> names;
+    if (!GetNamesInFolder("/proc/", names)) {
+        return false;
+    }
+    for (size_t i = 0; i < names.size(); i++) {
+        std::string name = names[i];
+        if (name.empty() || !IsNumericStr(name)) {
+            continue;
+        }
+        PidInfo pidInfo;
+        StrToInt(name, pidInfo.pid_);
+        GetProcessUid(pidInfo.pid_, pidInfo.uid_);
+        infos.push_back(pidInfo);
+    }
+    return true;
+}
+
+bool DumpCommonUtils::GetProcessUid(int pid, int &uid)
+{
+    char filesysdir[128] = { 0 };
+    if (sprintf_s(filesysdir, sizeof(filesysdir), "/proc/%d/status", pid) < 0) {
+        return false;
+    }
+    FILE *fp = fopen(filesysdir, "re");
+    if (fp == nullptr) {
+        return false;
+    }
+    // the uid is some lines after the top, the rest of the file is not read.
+    bool ret = false;
+    char line[STATUS_LINE_LENGTH] = { 0 };
+    while (fgets(line, sizeof(line), fp) != nullptr) {
+        if (strncmp(line, UID_KEY, sizeof(UID_KEY) - 1) != 0) {
+            continue;
+        }
+        char *end = nullptr;
+        long value = strtol(line + sizeof(UID_KEY) - 1, &end, DECIMAL_BASE);
+        if (end != line + sizeof(UID_KEY) - 1) {
+            uid = static_cast<int>(value);
+            ret = true;
+        }
+        break;
+    }
+    (void)fclose(fp);
+    return ret;
+}
+
 bool DumpCommonUtils::IsUserPid(const std::string &pid)
 {
     string filename = "/proc/" + pid + "/smaps";
@@ -13,17 +13,34 @@
  * limitations under the License.
  */
 #include "dump_event_handler.h"
+#include <algorithm>
+#include <cstdlib>
+#include "datetime_ex.h"
+#include "parameter.h"
 #include "util/dump_cpu_info_util.h"
+#include "util/dump_psi_util.h"
 #include "dump_manager_service.h"
 #include "hilog_wrapper.h"
 namespace OHOS {
 namespace HiviewDFX {
+namespace {
+static const char IDLE_STOP_TIME_PARAM[] = "persist.hidumper.cpuinfo.idlestop";
+static const int PARAM_VALUE_LEN = 32;
+static const int SEC_TO_MILLISEC_VALUE = 1000;
+static const int BACKOFF_FACTOR = 2;
+static const int DECIMAL_BASE = 10;
+} // namespace
 const int DumpEventHandler::MSG_GET_CPU_INFO_ID = 1;
+const int DumpEventHandler::MSG_CPU_INFO_DEMAND_ID = 2;
 const int DumpEventHandler::GET_CPU_INFO_DELAY_TIME = 5 * 1000;
+const int DumpEventHandler::GET_CPU_INFO_DELAY_TIME_MAX = 80 * 1000;
+const int DumpEventHandler::GET_CPU_INFO_STARTUP_DELAY_TIME = 30 * 1000;
+const int DumpEventHandler::GET_CPU_INFO_IDLE_STOP_TIME = 10 * 60 * 1000;
 
 DumpEventHandler::DumpEventHandler(const std::shared_ptr<AppExecFwk::EventRunner>& runner,
     const wptr<DumpManagerService>& service)
-    : AppExecFwk::EventHandler(runner), service_(service)
+    : AppExecFwk::EventHandler(runner), service_(service), delayTime_(GET_CPU_INFO_DELAY_TIME),
+    idleStopTime_(GetIdleStopTimeFromParam())
 {
 }
 
@@ -44,13 +61,97 @@ void DumpEventHandler::ProcessEvent([[maybe_unused]] const AppExecFwk::InnerEven
     switch (eventId) {
         case MSG_GET_CPU_INFO_ID: {
             DUMPER_HILOGD(MODULE_SERVICE, "MSG_GET_CPU_INFO_ID!");
-            DumpCpuInfoUtil::GetInstance().UpdateCpuInfo();
-            (dmsptr->GetHandler())->SendEvent(MSG_GET_CPU_INFO_ID, GET_CPU_INFO_DELAY_TIME);
+            OnCpuInfoTick();
+            break;
+        }
+        case MSG_CPU_INFO_DEMAND_ID: {
+            DUMPER_HILOGD(MODULE_SERVICE, "MSG_CPU_INFO_DEMAND_ID!");
+            OnCpuInfoDemand();
             break;
         }
         default:
             break;
     }
 }
+
+void DumpEventHandler::StartCpuInfoSampler(int64_t delayTime)
+{
+    RemoveEvent(MSG_GET_CPU_INFO_ID);
+    SendEvent(MSG_GET_CPU_INFO_ID, delayTime);
+}
+
+void DumpEventHandler::StopCpuInfoSampler()
+{
+    RemoveEvent(MSG_GET_CPU_INFO_ID);
+    RemoveEvent(MSG_CPU_INFO_DEMAND_ID);
+    sampling_ = false;
+}
+
+void DumpEventHandler::NotifyCpuInfoDemand()
+{
+    if (!sampling_.exchange(true)) {
+        // the sampler was stopped, the old sample may be minutes old.
+        DumpCpuInfoUtil::GetInstance().ResetCpuInfo();
+        DumpPsiUtil::GetInstance().UpdatePsiInfo();
+    }
+    SendEvent(MSG_CPU_INFO_DEMAND_ID);
+}
+
+void DumpEventHandler::SetIdleStopTime(int64_t idleStopTime)
+{
+    idleStopTime_ = idleStopTime;
+}
+
+int64_t DumpEventHandler::GetIdleStopTime() const
+{
+    return idleStopTime_;
+}
+
+bool DumpEventHandler::IsCpuInfoSampling() const
+{
+    return sampling_;
+}
+
+void DumpEventHandler::OnCpuInfoDemand()
+{
+    lastDemandTime_ = GetTickCount();
+    delayTime_ = GET_CPU_INFO_DELAY_TIME;
+    sampling_ = true;
+    // the pending sample maybe scheduled with a backed off delay, pull it in.
+    RemoveEvent(MSG_GET_CPU_INFO_ID);
+    SendEvent(MSG_GET_CPU_INFO_ID, delayTime_);
+}
+
+void DumpEventHandler::OnCpuInfoTick()
+{
+    DumpCpuInfoUtil::GetInstance().UpdateCpuInfo();
+    DumpPsiUtil::GetInstance().UpdatePsiInfo();
+    int64_t idleTime = GetTickCount() - lastDemandTime_;
+    if ((lastDemandTime_ == 0) || (idleTime >= idleStopTime_)) {
+        // nobody asked for a long time, stop until the next demand.
+        DUMPER_HILOGD(MODULE_SERVICE, "debug|sampler stop, idleTime=%{public}lld", static_cast<long long>(idleTime));
+        sampling_ = false;
+        delayTime_ = GET_CPU_INFO_DELAY_TIME;
+        return;
+    }
+    if (idleTime >= delayTime_) {
+        delayTime_ = std::min<int64_t>(delayTime_ * BACKOFF_FACTOR, GET_CPU_INFO_DELAY_TIME_MAX);
+    }
+    sampling_ = true;
+    SendEvent(MSG_GET_CPU_INFO_ID, delayTime_);
+}
+
+int64_t DumpEventHandler::GetIdleStopTimeFromParam()
+{
+    char value[PARAM_VALUE_LEN] = {0};
+    if (GetParameter(IDLE_STOP_TIME_PARAM, "", value, sizeof(value)) > 0) {
+        char *end = nullptr;
+        long long sec = strtoll(value, &end, DECIMAL_BASE);
+        if ((end != value) && (sec > 0)) {
+            return sec * SEC_TO_MILLISEC_VALUE;
+        }
+    }
+    return GET_CPU_INFO_IDLE_STOP_TIME;
+}
 } // namespace HiviewDFX
 } // namespace OHOS
@@ -29,6 +29,7 @@
 #include "raw_param.h"
 #include "inner/dump_service_id.h"
 #include "common/dumper_constant.h"
+#include "util/config_utils.h"
 using namespace std;
 namespace OHOS {
 namespace HiviewDFX {
@@ -55,6 +56,9 @@ void DumpManagerService::OnStart()
         return;
     }
 
+    // the config blobs are mapped and used in place, the first request already sees them.
+    ConfigUtils::LoadConfigBlobs();
+
     if (!Init()) {
         DUMPER_HILOGE(MODULE_SERVICE, "error|init fail, nothing to do.");
         return;
@@ -63,7 +67,10 @@ void DumpManagerService::OnStart()
     if (eventRunner_ != nullptr) {
         eventRunner_->Run();
     }
+    // take one deferred base sample, later samples are driven by requests.
+    handler_->StartCpuInfoSampler(DumpEventHandler::GET_CPU_INFO_STARTUP_DELAY_TIME);
 
+    // requests come in once published, the handler is ready by then.
     if (!Publish(DelayedSpSingleton<DumpManagerService>::GetInstance())) {
         DUMPER_HILOGE(MODULE_SERVICE, "error|register to system ability manager failed.");
         return;
@@ -78,6 +85,9 @@ void DumpManagerService::OnStop()
     }
     DUMPER_HILOGD(MODULE_SERVICE, "enter|");
     blockRequest_ = true;
+    if (handler_ != nullptr) {
+        handler_->StopCpuInfoSampler();
+    }
     CancelAllRequest();
     for (int i = 0; i < STOP_WAIT; i++) {
         if (requestRawParamMap_.empty()) {
@@ -125,6 +135,9 @@ int32_t DumpManagerService::Request(std::vector<std::u16string> &args, int outfd
         DumpLogManager::Init();
     }
     DUMPER_HILOGD(MODULE_SERVICE, "enter|");
+    if (handler_ != nullptr) {
+        handler_->NotifyCpuInfoDemand();
+    }
     const std::shared_ptr<RawParam> rawParam = AddRequestRawParam(args, outfd, callback);
     int32_t ret = StartRequest(rawParam);
     DUMPER_HILOGD(MODULE_SERVICE, "leave|ret=%{public}d", ret);
@@ -168,7 +181,6 @@ bool DumpManagerService::Init()
     if (!handler_) {
         handler_ = std::make_shared<DumpEventHandler>(eventRunner_, dumpManagerService);
     }
-    handler_->SendEvent(DumpEventHandler::MSG_GET_CPU_INFO_ID, DumpEventHandler::GET_CPU_INFO_DELAY_TIME);
     return true;
 }
 
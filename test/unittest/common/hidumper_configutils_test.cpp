@@ -13,6 +13,14 @@
  * limitations under the License.
  */
 #include "hidumper_configutils_test.h"
+#include <algorithm>
+#include <unistd.h>
+#include "common/dumper_constant.h"
+#include "util/dump_config_blob.h"
+#include "util/dump_config_compiler.h"
+#include "util/dump_plan_cache.h"
+#include "parameter.h"
+#include "raw_param.h"
 using namespace std;
 using namespace testing::ext;
 using namespace OHOS;
@@ -139,5 +147,282 @@ HWTEST_F (HidumperConfigUtilsTest, HidumperConfigUtils003, TestSize.Level3)
     ASSERT_TRUE(!result.empty());
     ASSERT_TRUE(result[0]->name_ == name);
 }
+
+/**
+ * @tc.name: HidumperConfigUtils004
+ * @tc.desc: Test the configs of a request are reused by the next one with the same options.
+ * @tc.type: FUNC
+ */
+HWTEST_F (HidumperConfigUtilsTest, HidumperConfigUtils004, TestSize.Level3)
+{
+    DumpPlanCache::GetInstance().Clear();
+    DumperOpts opts;
+    opts.isDumpCpuFreq_ = true;
+    auto param = std::make_shared<DumperParameter>();
+    param->SetOpts(opts);
+    param->SetUid(0);
+    ASSERT_EQ(ConfigUtils::GetDumperConfigs(param), DumpStatus::DUMP_OK);
+    std::vector<std::shared_ptr<DumpCfg>> first = param->GetExecutorConfigList();
+    ASSERT_FALSE(first.empty());
+
+    std::string key = ConfigUtils::GetPlanKey(opts, 0);
+    auto plan = DumpPlanCache::GetInstance().Find(key);
+    ASSERT_TRUE(plan != nullptr);
+    ASSERT_NE(plan->inputs & DumpPlanCache::PLAN_INPUT_CPUS, 0u);
+    ASSERT_EQ(plan->inputs & DumpPlanCache::PLAN_INPUT_PIDS, 0u);
+    ASSERT_TRUE(DumpPlanCache::GetInstance().Find(ConfigUtils::GetPlanKey(opts, PID_TEST)) == nullptr);
+
+    auto next = std::make_shared<DumperParameter>();
+    next->SetOpts(opts);
+    next->SetUid(0);
+    ASSERT_TRUE(ConfigUtils::GetPlanDumperConfigs(next, key));
+    std::vector<std::shared_ptr<DumpCfg>> second = next->GetExecutorConfigList();
+    ASSERT_EQ(second.size(), first.size());
+    for (size_t i = 0; i < first.size(); i++) {
+        ASSERT_NE(second[i], first[i]);
+        ASSERT_EQ(second[i]->name_, first[i]->name_);
+        ASSERT_EQ(second[i]->class_, first[i]->class_);
+        ASSERT_EQ(second[i]->args_, first[i]->args_);
+        ASSERT_EQ(second[i]->parent_, first[i]->parent_);
+        if (first[i]->parent_ < 0) {
+            continue;
+        }
+        // the parent is a group before the config.
+        ASSERT_LT(static_cast<size_t>(first[i]->parent_), i);
+        ASSERT_TRUE(first[first[i]->parent_]->IsGroup());
+    }
+}
+
+/**
+ * @tc.name: HidumperConfigUtils005
+ * @tc.desc: Test processes are listed only for a group expanded by them.
+ * @tc.type: FUNC
+ */
+HWTEST_F (HidumperConfigUtilsTest, HidumperConfigUtils005, TestSize.Level3)
+{
+    int uid = UID_EMPTY;
+    ASSERT_TRUE(DumpCommonUtils::GetProcessUid(getpid(), uid));
+    ASSERT_EQ(uid, static_cast<int>(getuid()));
+
+    DumpPlanCache::GetInstance().Clear();
+    DumperOpts opts;
+    opts.isDumpCpuUsage_ = true;
+    opts.cpuUsagePid_ = PID_EMPTY;
+    auto param = std::make_shared<DumperParameter>();
+    param->SetOpts(opts);
+    param->SetUid(0);
+    ConfigUtils configUtils(param);
+    ASSERT_EQ(configUtils.GetDumperConfigs(), DumpStatus::DUMP_OK);
+    ASSERT_FALSE(param->GetExecutorConfigList().empty());
+    // the cpu usage group takes pid -1, not each process.
+    auto plan = DumpPlanCache::GetInstance().Find(ConfigUtils::GetPlanKey(opts, 0));
+    ASSERT_TRUE(plan != nullptr);
+    ASSERT_EQ(plan->inputs, 0u);
+
+    std::vector<DumpCommonUtils::PidInfo> pidInfos;
+    configUtils.MergePidInfos(pidInfos, PID_EMPTY);
+    ASSERT_FALSE(configUtils.GetCurrentPidInfos().empty());
+    for (auto &pidInfo : configUtils.GetCurrentPidInfos()) {
+        ASSERT_GT(pidInfo.pid_, 0);
+        ASSERT_TRUE(pidInfo.name_.empty());
+    }
+}
+
+/**
+ * @tc.name: HidumperConfigUtils006
+ * @tc.desc: Test the group names of ConfigData are found in the config tables.
+ * @tc.type: FUNC
+ */
+HWTEST_F (HidumperConfigUtilsTest, HidumperConfigUtils006, TestSize.Level3)
+{
+    auto param = std::make_shared<DumperParameter>();
+    param->SetUid(0);
+    ConfigUtils configUtils(param);
+    auto args = OptionArgs::Create();
+    const std::string groups[] = {
+        ConfigData::CONFIG_GROUP_CPU_FREQ, ConfigData::CONFIG_GROUP_CPU_USAGE, ConfigData::CONFIG_GROUP_SCHED_STAT,
+        ConfigData::CONFIG_GROUP_LOG_KERNEL, ConfigData::CONFIG_GROUP_LOG_HILOG, ConfigData::CONFIG_GROUP_LOG_INIT,
+        ConfigData::CONFIG_GROUP_MEMORY, ConfigData::CONFIG_GROUP_STORAGE, ConfigData::CONFIG_GROUP_CGROUP,
+        ConfigData::CONFIG_GROUP_NET, ConfigData::CONFIG_GROUP_SERVICE, ConfigData::CONFIG_GROUP_ABILITY,
+        ConfigData::CONFIG_GROUP_SYSTEM_BASE, ConfigData::CONFIG_GROUP_SYSTEM_SYSTEM, ConfigData::CONFIG_GROUP_PROCESSES,
+        ConfigData::CONFIG_GROUP_PROCESSES_ENG, ConfigData::CONFIG_GROUP_PROCESSES_PID,
+        ConfigData::CONFIG_GROUP_PROCESSES_PID_ENG, ConfigData::CONFIG_GROUP_FAULT_LOG, ConfigData::CONFIG_GROUP_STACK,
+        ConfigData::CONFIG_GROUP_TEST,
+    };
+    for (auto &group : groups) {
+        std::vector<std::shared_ptr<DumpCfg>> result;
+        ASSERT_EQ(configUtils.GetGroup(group, result, args), DumpStatus::DUMP_OK) << group;
+    }
+    std::vector<std::string> systemNames;
+    ASSERT_EQ(ConfigUtils::GetSectionNames(ConfigData::CONFIG_GROUP_SYSTEM_, systemNames), DumpStatus::DUMP_OK);
+    ASSERT_EQ(systemNames.size(), 2u);
+
+    std::vector<std::shared_ptr<DumpCfg>> result;
+    ASSERT_EQ(configUtils.GetDumper(ConfigData::CONFIG_DUMPER_LIST_SYSTEM, result, args), DumpStatus::DUMP_OK);
+    ASSERT_FALSE(result.empty());
+    ASSERT_EQ(result[0]->name_, ConfigData::CONFIG_DUMPER_LIST_SYSTEM);
+    ASSERT_EQ(configUtils.GetDumper("dumper_unknown", result, args), DumpStatus::DUMP_FAIL);
+}
+
+/**
+ * @tc.name: HidumperConfigUtils007
+ * @tc.desc: Test the dumpers and groups of a config blob are found after the config tables.
+ * @tc.type: FUNC
+ */
+HWTEST_F (HidumperConfigUtilsTest, HidumperConfigUtils007, TestSize.Level3)
+{
+    const std::string text = R"({
+        "dumpers": [{
+            "name": "dumper_vendor_test",
+            "desc": "Vendor Test",
+            "items": [
+                { "class": "cmd_dumper", "target": "echo vendor", "loop": true },
+                { "class": "col_row_filter", "level": "level_all", "filter": "1" }
+            ]
+        }],
+        "groups": [{
+            "name": "group_system_vendor",
+            "desc": "Vendor Information",
+            "type": "type_none",
+            "expand": true,
+            "items": [ "dumper_vendor_test", "dumper_kernel_version", "groupmini_vendor" ]
+        }, {
+            "name": "groupmini_vendor",
+            "type": "type_cpuid",
+            "items": [ "dumper_cpu_freq" ]
+        }]
+    })";
+    std::string data;
+    std::string error;
+    ASSERT_TRUE(DumpConfigCompiler::Compile(text, data, error)) << error;
+    auto blob = std::make_shared<DumpConfigBlob>();
+    ASSERT_TRUE(blob->Attach(data.data(), data.size()));
+    ASSERT_EQ(blob->GetVersion(), CONFIG_BLOB_VERSION);
+    ASSERT_EQ(blob->GetDumperSum(), 1);
+    ASSERT_EQ(blob->GetGroupSum(), 2);
+    int index = blob->FindDumper("dumper_vendor_test");
+    ASSERT_EQ(index, 0);
+    ConfigData::DumperCfg dumper = blob->GetDumper(index);
+    ASSERT_EQ(dumper.size_, 2);
+    // the items are read from the blob, they are not copied out of it.
+    ASSERT_TRUE(dumper.list_ == nullptr);
+    ASSERT_EQ(blob->GetItem(index, 0).name_, "dumper_vendor_test");
+    const char *name = blob->GetItem(index, 0).name_.data();
+    ASSERT_TRUE((name >= data.data()) && (name < data.data() + data.size()));
+    ASSERT_EQ(blob->GetItem(index, 0).class_, DumperConstant::CMD_DUMPER);
+    ASSERT_EQ(blob->GetItem(index, 0).loop_, DumperConstant::LOOP);
+    ASSERT_EQ(blob->GetItem(index, 1).level_, DumperConstant::LEVEL_ALL);
+    ASSERT_EQ(blob->GetItem(index, 1).filterCfg_, "1");
+    ASSERT_EQ(blob->FindDumper(DUMPER_NAME), -1);
+    int group = blob->FindGroup("group_system_vendor");
+    ASSERT_EQ(blob->GetGroup(group).size_, 3); // 3: two dumpers and a mini group
+    ASSERT_EQ(blob->GetEntry(group, 2), "groupmini_vendor"); // 2: the mini group
+    ASSERT_EQ(blob->GetGroup(blob->FindGroup("groupmini_vendor")).type_, DumperConstant::GROUPTYPE_CPUID);
+
+    ConfigUtils::SetConfigBlobs({blob});
+    std::vector<std::string> systemNames;
+    ConfigUtils::GetSectionNames(ConfigData::CONFIG_GROUP_SYSTEM_, systemNames);
+    ASSERT_TRUE(std::find(systemNames.begin(), systemNames.end(), "vendor") != systemNames.end());
+
+    auto param = std::make_shared<DumperParameter>();
+    param->SetUid(0);
+    ConfigUtils configUtils(param);
+    auto args = OptionArgs::Create();
+    std::vector<std::shared_ptr<DumpCfg>> result;
+    ASSERT_EQ(configUtils.GetConfig("group_system_vendor", result, args), DumpStatus::DUMP_OK);
+    auto vendor = std::find_if(result.begin(), result.end(),
+        [](const std::shared_ptr<DumpCfg> &cfg) { return cfg->name_ == "dumper_vendor_test"; });
+    ASSERT_TRUE(vendor != result.end());
+    ASSERT_EQ((*vendor)->target_, "echo vendor");
+    ASSERT_EQ((*vendor)->section_, "vendor");
+    auto kernel = std::find_if(result.begin(), result.end(),
+        [](const std::shared_ptr<DumpCfg> &cfg) { return cfg->name_ == DUMPER_NAME; });
+    ASSERT_TRUE(kernel != result.end());
+    ConfigUtils::SetConfigBlobs({});
+
+    ConfigUtils configUtilsAfter(param);
+    result.clear();
+    ASSERT_EQ(configUtilsAfter.GetConfig("group_system_vendor", result, args), DumpStatus::DUMP_FAIL);
+}
+
+/**
+ * @tc.name: HidumperConfigUtils008
+ * @tc.desc: Test invalid configs are not compiled and damaged blobs are not taken.
+ * @tc.type: FUNC
+ */
+HWTEST_F (HidumperConfigUtilsTest, HidumperConfigUtils008, TestSize.Level3)
+{
+    const std::string texts[] = {
+        "{",
+        R"({ "dumpers": {} })",
+        R"({ "dumpers": [{ "name": "dumper_vendor_test", "items": [{ "class": "unknown" }] }] })",
+        R"({ "dumpers": [{ "name": "dumper_vendor_test", "items": [] }] })",
+        R"({ "dumpers": [{ "name": "dumper_kernel_version", "items": [{ "class": "file_dumper" }] }] })",
+        R"({ "groups": [{ "name": "group_system_vendor", "items": [ "dumper_vendor_unknown" ] }] })",
+        R"({ "groups": [{ "name": "group_system_vendor", "expand": "yes" }] })",
+        R"({ "groups": [{ "name": "vendor" }] })",
+    };
+    for (auto &text : texts) {
+        std::string data;
+        std::string error;
+        ASSERT_FALSE(DumpConfigCompiler::Compile(text, data, error)) << text;
+        ASSERT_FALSE(error.empty()) << text;
+    }
+
+    std::string data;
+    std::string error;
+    ASSERT_TRUE(DumpConfigCompiler::Compile(R"({ "groups": [{ "name": "group_system_vendor" }] })", data, error));
+    DumpConfigBlob blob;
+    ASSERT_TRUE(blob.Attach(data.data(), data.size()));
+    ASSERT_EQ(blob.GetDumperSum(), 0);
+    ASSERT_EQ(blob.FindDumper("dumper_vendor_test"), -1);
+    ASSERT_EQ(blob.FindGroup("group_system_vendor"), 0);
+    ASSERT_FALSE(blob.Attach(data.data(), data.size() - 1));
+    ASSERT_EQ(blob.FindGroup("group_system_vendor"), -1);
+    std::string damaged = data;
+    damaged[CONFIG_BLOB_MAGIC_SIZE] = '\x7F'; // the version
+    ASSERT_FALSE(blob.Attach(damaged.data(), damaged.size()));
+    damaged = data;
+    damaged[damaged.size() - 1] = '\x7F'; // the last slot of the group index
+    ASSERT_FALSE(blob.Attach(damaged.data(), damaged.size()));
+    ASSERT_FALSE(blob.Open("/data/dumper_config_not_exist.bin"));
+}
+
+/**
+ * @tc.name: HidumperConfigUtils009
+ * @tc.desc: Test a zip request of processes after a plain one takes no plan and copies the smaps.
+ * @tc.type: FUNC
+ */
+HWTEST_F (HidumperConfigUtilsTest, HidumperConfigUtils009, TestSize.Level3)
+{
+    DumpPlanCache::GetInstance().Clear();
+    DumperOpts opts;
+    opts.isDumpProcesses_ = true;
+    opts.processPid_ = getpid();
+    auto param = std::make_shared<DumperParameter>();
+    param->SetOpts(opts);
+    param->SetUid(0);
+    ASSERT_EQ(ConfigUtils::GetDumperConfigs(param), DumpStatus::DUMP_OK);
+    ASSERT_TRUE(DumpPlanCache::GetInstance().Find(ConfigUtils::GetPlanKey(opts, 0)) != nullptr);
+
+    const std::string folder = "/data/local/tmp/hidumper_configutils_test009/";
+    opts.path_ = folder + "hidumper.zip";
+    std::vector<std::u16string> args;
+    auto rawParam = std::make_shared<RawParam>(0, 0, 0, args, -1, nullptr);
+    rawParam->SetFolder(folder);
+    auto zipParam = std::make_shared<DumperParameter>();
+    zipParam->SetOpts(opts);
+    zipParam->SetUid(0);
+    zipParam->setClientCallback(rawParam);
+    ASSERT_EQ(ConfigUtils::GetDumperConfigs(zipParam), DumpStatus::DUMP_OK);
+    ASSERT_FALSE(zipParam->GetExecutorConfigList().empty());
+    if (std::string(GetBuildType()) == RELEASE_MODE) {
+        return; // smaps are copied in the engine mode only
+    }
+    DumpCommonUtils::PidInfo info;
+    ASSERT_TRUE(DumpCommonUtils::GetProcessInfo(getpid(), info));
+    std::string smaps = folder + "smaps/" + info.name_ + "-" + std::to_string(getpid()) + "/smaps";
+    ASSERT_EQ(access(smaps.c_str(), F_OK), 0) << smaps;
+}
 } // namespace HiviewDFX
-} // namespace OHOS
\ No newline at end of file
+} // namespace OHOS
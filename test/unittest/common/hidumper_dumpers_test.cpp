@@ -12,10 +12,17 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
  */
+#include <chrono>
 #include <gtest/gtest.h>
+#include <unistd.h>
 #include "executor/api_dumper.h"
+#include "executor/cgroup_dumper.h"
 #include "executor/cmd_dumper.h"
 #include "executor/file_stream_dumper.h"
+#include "executor/memory_dumper.h"
+#include "executor/sched_dumper.h"
+#include "util/dump_cpu_info_util.h"
+#include "util/dump_psi_util.h"
 #include "executor/version_dumper.h"
 
 using namespace std;
@@ -364,5 +371,149 @@ HWTEST_F(HidumperDumpersTest, HidumperDumpers012, TestSize.Level3)
         ASSERT_TRUE(ret == DumpStatus::DUMP_OK || ret == DumpStatus::DUMP_MORE_DATA) << "Execute failed.";
     }
 }
+
+/**
+ * @tc.name: HidumperDumpers013
+ * @tc.desc: Test SchedDumper of all processes and of threads of specified pid.
+ * @tc.type: FUNC
+ */
+HWTEST_F(HidumperDumpersTest, HidumperDumpers013, TestSize.Level3)
+{
+    auto parameter = std::make_shared<DumperParameter>();
+    DumperOpts opts;
+    opts.isDumpSchedStat_ = true;
+    parameter->SetOpts(opts);
+    auto dump_datas = std::make_shared<std::vector<std::vector<std::string>>>();
+    auto sched_dumper = make_shared<SchedDumper>();
+    DumpStatus ret = sched_dumper->DoPreExecute(parameter, dump_datas);
+    ASSERT_TRUE(ret == DumpStatus::DUMP_OK) << "PreExecute failed.";
+    ret = sched_dumper->DoExecute();
+    ASSERT_TRUE(ret == DumpStatus::DUMP_OK) << "Execute failed.";
+    ret = sched_dumper->DoAfterExecute();
+    ASSERT_TRUE(ret == DumpStatus::DUMP_OK) << "AfterExecute failed.";
+    ASSERT_TRUE(dump_datas->size() > 2) << "no process found.";
+
+    opts.schedStatPid_ = getpid();
+    parameter->SetOpts(opts);
+    dump_datas->clear();
+    ret = sched_dumper->DoPreExecute(parameter, dump_datas);
+    ASSERT_TRUE(ret == DumpStatus::DUMP_OK) << "PreExecute failed.";
+    ret = sched_dumper->DoExecute();
+    ASSERT_TRUE(ret == DumpStatus::DUMP_OK) << "Execute failed.";
+    ret = sched_dumper->DoAfterExecute();
+    ASSERT_TRUE(ret == DumpStatus::DUMP_OK) << "AfterExecute failed.";
+    ASSERT_TRUE(dump_datas->size() > 2) << "no thread found.";
+}
+
+/**
+ * @tc.name: HidumperDumpers014
+ * @tc.desc: Test DumpPsiUtil with and without an old sample.
+ * @tc.type: FUNC
+ */
+HWTEST_F(HidumperDumpersTest, HidumperDumpers014, TestSize.Level3)
+{
+    PsiInfo psiInfo;
+    if (!DumpPsiUtil::GetInstance().GetCurPsiInfo(DumpPsiUtil::PSI_CPU, psiInfo)) {
+        // kernel without CONFIG_PSI
+        std::vector<std::string> lines;
+        ASSERT_FALSE(DumpPsiUtil::GetInstance().GetPsiLines(DumpPsiUtil::PSI_CPU, lines));
+        return;
+    }
+    ASSERT_TRUE(psiInfo.some.valid);
+    std::vector<std::string> lines;
+    ASSERT_TRUE(DumpPsiUtil::GetInstance().GetPsiLines(DumpPsiUtil::PSI_MEMORY, lines));
+    ASSERT_TRUE(lines.size() >= 1);
+
+    DumpPsiUtil::GetInstance().UpdatePsiInfo();
+    sleep(2); // 2: longer than the minimal delta window
+    lines.clear();
+    ASSERT_TRUE(DumpPsiUtil::GetInstance().GetPsiLines(DumpPsiUtil::PSI_MEMORY, lines));
+    ASSERT_TRUE(lines.size() == 2) << "no stall delta line.";
+}
+
+/**
+ * @tc.name: HidumperDumpers015
+ * @tc.desc: Test CgroupDumper twice, the second one is against the first sample.
+ * @tc.type: FUNC
+ */
+HWTEST_F(HidumperDumpersTest, HidumperDumpers015, TestSize.Level3)
+{
+    std::string root;
+    if (!DumpCgroupUtil::GetInstance().GetCgroupRoot(root)) {
+        return; // cgroup v2 isn't mounted
+    }
+    auto parameter = std::make_shared<DumperParameter>();
+    auto dump_datas = std::make_shared<std::vector<std::vector<std::string>>>();
+    for (int i = 0; i < 2; i++) { // 2: without and with the old sample
+        dump_datas->clear();
+        auto cgroup_dumper = make_shared<CgroupDumper>();
+        DumpStatus ret = cgroup_dumper->DoPreExecute(parameter, dump_datas);
+        ASSERT_TRUE(ret == DumpStatus::DUMP_OK) << "PreExecute failed.";
+        ret = cgroup_dumper->DoExecute();
+        ASSERT_TRUE(ret == DumpStatus::DUMP_OK) << "Execute failed.";
+        ret = cgroup_dumper->DoAfterExecute();
+        ASSERT_TRUE(ret == DumpStatus::DUMP_OK) << "AfterExecute failed.";
+        ASSERT_TRUE(dump_datas->size() > 2) << "no cgroup found.";
+    }
+}
+
+/**
+ * @tc.name: HidumperDumpers016
+ * @tc.desc: Test a new base sample is not diffed against before the minimal window.
+ * @tc.type: FUNC
+ */
+HWTEST_F(HidumperDumpersTest, HidumperDumpers016, TestSize.Level3)
+{
+    const auto window = std::chrono::milliseconds(900); // 900: the 1 s window, less the time of the sample
+    DumpCpuInfoUtil::GetInstance().ResetCpuInfo();
+    auto start = std::chrono::steady_clock::now();
+    DumpCpuInfoUtil::GetInstance().WaitCpuInfoWindow();
+    ASSERT_GE(std::chrono::steady_clock::now() - start, window);
+
+    // a sample taken meanwhile is too fresh, the base stays the one of the window.
+    DumpCpuInfoUtil::GetInstance().UpdateCpuInfo();
+    start = std::chrono::steady_clock::now();
+    DumpCpuInfoUtil::GetInstance().WaitCpuInfoWindow();
+    ASSERT_LT(std::chrono::steady_clock::now() - start, window);
+    auto curCPUInfo = std::make_shared<CPUInfo>();
+    auto oldCPUInfo = std::make_shared<CPUInfo>();
+    ASSERT_TRUE(DumpCpuInfoUtil::GetInstance().GetCurCPUInfo(curCPUInfo));
+    ASSERT_TRUE(DumpCpuInfoUtil::GetInstance().GetOldCPUInfo(oldCPUInfo));
+    ASSERT_GT(curCPUInfo->uTime + curCPUInfo->sTime + curCPUInfo->iTime,
+        oldCPUInfo->uTime + oldCPUInfo->sTime + oldCPUInfo->iTime);
+}
+
+/**
+ * @tc.name: HidumperDumpers017
+ * @tc.desc: Test MemoryDumper dumps groups of processes until the chunk budget, then yields.
+ * @tc.type: FUNC
+ */
+HWTEST_F(HidumperDumpersTest, HidumperDumpers017, TestSize.Level3)
+{
+    const size_t budget = 256; // 256: a few rows of the table of processes
+    auto parameter = std::make_shared<DumperParameter>();
+    parameter->SetChunkBudget(budget);
+    DumperOpts opts;
+    opts.memPid_ = -1;
+    parameter->SetOpts(opts);
+    auto dump_datas = std::make_shared<std::vector<std::vector<std::string>>>();
+    std::shared_ptr<DumpLineBuffer> lines = parameter->GetLineBuffer();
+    auto memory_dumper = make_shared<MemoryDumper>();
+    size_t chunks = 0;
+    DumpStatus ret = DumpStatus::DUMP_MORE_DATA;
+    while (ret == DumpStatus::DUMP_MORE_DATA) {
+        ASSERT_EQ(memory_dumper->DoPreExecute(parameter, dump_datas), DumpStatus::DUMP_OK);
+        ret = memory_dumper->DoExecute();
+        ASSERT_NE(ret, DumpStatus::DUMP_FAIL);
+        ASSERT_EQ(memory_dumper->DoAfterExecute(), ret);
+        if (ret == DumpStatus::DUMP_MORE_DATA) {
+            ASSERT_GE(lines->GetPendingSize(), budget);
+        }
+        lines->Clear();
+        chunks++;
+    }
+    ASSERT_EQ(ret, DumpStatus::DUMP_OK);
+    ASSERT_GT(chunks, 1u);
+}
 } // namespace HiviewDFX
-} // namespace OHOS
\ No newline at end of file
+} // namespace OHOS
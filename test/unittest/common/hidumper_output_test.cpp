@@ -13,9 +13,35 @@
  * limitations under the License.
  */
 #include <gtest/gtest.h>
+#include <chrono>
+#include <csignal>
+#include <cstdio>
+#include <thread>
+#include <atomic>
+#include <fcntl.h>
+#include <thread>
+#include <unistd.h>
+#include <sys/stat.h>
+#include <zlib.h>
 #include "directory_ex.h"
+#include "file_ex.h"
 #include "executor/zip_output.h"
+#include "executor/cmd_dumper.h"
 #include "executor/fd_output.h"
+#include "executor/json_output.h"
+#include "executor/snapshot_output.h"
+#include "executor/tee_output.h"
+#include "executor/zipfolder_output.h"
+#include "manager/dump_implement.h"
+#include "util/dump_command.h"
+#include "util/dump_compressor.h"
+#include "util/dump_executor_stats.h"
+#include "util/dump_fd_writer.h"
+#include "util/dump_line_buffer.h"
+#include "util/dump_line_reader.h"
+#include "util/dump_table.h"
+#include "util/zip/zip_writer.h"
+#include "dump_snapshot_reader.h"
 
 using namespace std;
 using namespace testing::ext;
@@ -51,6 +77,194 @@ void HidumperOutputTest::TearDown(void)
 
 const std::string HidumperOutputTest::FILE_ROOT = "/data/local/tmp/hidumper_test/";
 
+static int InflateFile(const std::string &path, int windowBits, size_t maxSize, std::string &out, size_t &remain)
+{
+    std::string compressed;
+    int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        return Z_ERRNO;
+    }
+    char buf[4096] = {0}; // 4096: read buffer
+    ssize_t len = 0;
+    while ((len = read(fd, buf, sizeof(buf))) > 0) {
+        compressed.append(buf, len);
+    }
+    close(fd);
+
+    z_stream stream = {0};
+    if (inflateInit2(&stream, windowBits) != Z_OK) {
+        return Z_STREAM_ERROR;
+    }
+    out.assign(maxSize + 1, '\0');
+    stream.next_in = reinterpret_cast<Bytef*>(&compressed[0]);
+    stream.avail_in = compressed.size();
+    stream.next_out = reinterpret_cast<Bytef*>(&out[0]);
+    stream.avail_out = out.size();
+    int ret = inflate(&stream, Z_FINISH);
+    out.resize(stream.total_out);
+    remain = stream.avail_in;
+    inflateEnd(&stream);
+    return ret;
+}
+
+// reads the local entry at offset of a deflated zip and checks its crc.
+static bool InflateZipEntry(const std::string &zip, size_t &offset, std::string &name, std::string &out)
+{
+    const size_t headerSize = 30; // 30: fixed part of a local file header
+    const size_t crcOffset = 14; // 14: crc32 in the local file header
+    const size_t nameLenOffset = 26; // 26: name and extra field lengths follow
+    auto read16 = [&zip] (size_t pos) {
+        return static_cast<size_t>(static_cast<unsigned char>(zip[pos])) |
+            (static_cast<size_t>(static_cast<unsigned char>(zip[pos + 1])) << 8); // 8: second byte
+    };
+    if ((offset + headerSize > zip.size()) || (zip.compare(offset, 4, "PK\x03\x04") != 0)) { // 4: magic
+        return false;
+    }
+    uLong crc = read16(offset + crcOffset) | (read16(offset + crcOffset + 2) << 16); // 2, 16: high half
+    size_t nameLen = read16(offset + nameLenOffset);
+    size_t extraLen = read16(offset + nameLenOffset + 2); // 2: after the name length
+    name = zip.substr(offset + headerSize, nameLen);
+    size_t data = offset + headerSize + nameLen + extraLen;
+
+    z_stream stream = {0};
+    if (inflateInit2(&stream, -MAX_WBITS) != Z_OK) {
+        return false;
+    }
+    out.clear();
+    stream.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(zip.data() + data));
+    stream.avail_in = zip.size() - data;
+    int ret = Z_OK;
+    char buf[4096] = {0}; // 4096: inflate buffer
+    while (ret == Z_OK) {
+        stream.next_out = reinterpret_cast<Bytef*>(buf);
+        stream.avail_out = sizeof(buf);
+        ret = inflate(&stream, Z_NO_FLUSH);
+        out.append(buf, sizeof(buf) - stream.avail_out);
+    }
+    offset = data + stream.total_in;
+    inflateEnd(&stream);
+    return (ret == Z_STREAM_END) && (crc32(0L, reinterpret_cast<const Bytef*>(out.data()), out.size()) == crc);
+}
+
+// a dumper of the section tests, adds a line a round and asks for more data until its rounds are done.
+class SectionTestDumper : public HidumperExecutor {
+public:
+    SectionTestDumper(const std::string &text, int rounds, int sleepMs = 0, size_t lineSize = 0)
+        : text_(text), rounds_(rounds), sleepMs_(sleepMs), lineSize_(lineSize)
+    {
+    }
+
+    DumpStatus PreExecute(const std::shared_ptr<DumperParameter> &parameter, StringMatrix dumpDatas) override
+    {
+        dumpDatas_ = dumpDatas;
+        return DumpStatus::DUMP_OK;
+    }
+
+    DumpStatus Execute() override
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(sleepMs_));
+        executed_++;
+        if (!text_.empty()) {
+            dumpDatas_->push_back({text_ + " " + std::to_string(round_) + std::string(lineSize_, '.')});
+        }
+        return DumpStatus::DUMP_OK;
+    }
+
+    DumpStatus AfterExecute() override
+    {
+        return (++round_ < rounds_) ? DumpStatus::DUMP_MORE_DATA : DumpStatus::DUMP_OK;
+    }
+
+    void Reset() override
+    {
+        round_ = 0;
+        dumpDatas_ = nullptr;
+        HidumperExecutor::Reset();
+    }
+
+    static std::atomic<int> executed_;
+
+private:
+    std::string text_;
+    int rounds_;
+    int sleepMs_;
+    size_t lineSize_;
+    int round_ = 0;
+    StringMatrix dumpDatas_;
+};
+std::atomic<int> SectionTestDumper::executed_ {0};
+
+/**
+ * Executors of sections sec0, sec1... of one group each. Every section has a dumper of one round and
+ * a dumper of loopRounds rounds, each one followed by the shared fd output.
+ */
+static std::vector<std::shared_ptr<HidumperExecutor>> CreateSectionExecutors(int sections, int loopRounds,
+    const std::vector<int> &sleepMs, size_t lineSize = 0)
+{
+    std::vector<std::shared_ptr<HidumperExecutor>> executors;
+    auto output = std::make_shared<FDOutput>();
+    auto outputCfg = std::make_shared<DumpCfg>();
+    outputCfg->class_ = DumperConstant::FD_OUTPUT;
+    output->SetDumpConfig(outputCfg);
+    for (int section = 0; section < sections; section++) {
+        auto groupCfg = std::make_shared<DumpCfg>();
+        groupCfg->class_ = DumperConstant::GROUP;
+        groupCfg->type_ = DumperConstant::NONE;
+        auto group = std::make_shared<SectionTestDumper>("", 1);
+        group->SetDumpConfig(groupCfg);
+        int parent = static_cast<int>(executors.size());
+        executors.push_back(group);
+        int sleep = sleepMs[section % sleepMs.size()];
+        const int rounds[] = {1, loopRounds};
+        for (int dumper = 0; dumper < 2; dumper++) { // 2: the plain and the looping dumper
+            auto cfg = std::make_shared<DumpCfg>();
+            cfg->class_ = DumperConstant::CMD_DUMPER;
+            cfg->section_ = "sec" + std::to_string(section);
+            cfg->parent_ = parent;
+            auto executor = std::make_shared<SectionTestDumper>(cfg->section_ + "/d" + std::to_string(dumper),
+                rounds[dumper], sleep, lineSize);
+            executor->SetDumpConfig(cfg);
+            executor->SetParent(group.get());
+            executors.push_back(executor);
+            executors.push_back(output);
+        }
+    }
+    return executors;
+}
+
+// runs the executors as DumpDatas does with that many workers and returns what the client got.
+static std::string DumpSectionsToFile(const std::vector<std::shared_ptr<HidumperExecutor>> &executors,
+    const std::string &path, uint32_t workers, size_t maxPendingBytes, const DumperOpts &opts = DumperOpts())
+{
+    int fd = open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, S_IRUSR | S_IWUSR);
+    if (fd < 0) {
+        return "";
+    }
+    std::vector<std::u16string> args;
+    auto rawParam = std::make_shared<RawParam>(0, 0, 0, args, fd, nullptr);
+    auto parameter = std::make_shared<DumperParameter>();
+    parameter->setClientCallback(rawParam);
+    parameter->SetOpts(opts);
+    DumpImplement &dumpImplement = DumpImplement::GetInstance();
+    DumpImplement::SectionSchedule schedule;
+    schedule.maxPendingBytes = maxPendingBytes;
+    dumpImplement.SplitSections(executors, schedule.jobs);
+    if (workers > 1) {
+        dumpImplement.DumpSections(executors, parameter, schedule, workers);
+    } else {
+        auto dumpDatas = std::make_shared<std::vector<std::vector<std::string>>>();
+        dumpImplement.DumpRange(executors, 0, executors.size(), parameter, dumpDatas, nullptr, 0, nullptr);
+    }
+    for (auto &executor : executors) {
+        executor->Reset();
+    }
+    (void)parameter->FlushOutputWriter();
+    close(fd);
+    std::string actual;
+    (void)LoadStringFromFile(path, actual);
+    return actual;
+}
+
 /**
  * @tc.name: HidumperOutputTest001
  * @tc.desc: Test ZipOutpu with multibytes content.
@@ -317,5 +531,1097 @@ HWTEST_F(HidumperOutputTest, HidumperOutputTest007, TestSize.Level3)
     ret = fd_output->AfterExecute();
     ASSERT_TRUE(ret == DumpStatus::DUMP_OK) << "AfterExecute failed.";
 }
+
+/**
+ * @tc.name: HidumperOutputTest008
+ * @tc.desc: Test DumpFdWriter batches lines and keeps the order across high water flushes.
+ * @tc.type: FUNC
+ */
+HWTEST_F(HidumperOutputTest, HidumperOutputTest008, TestSize.Level3)
+{
+    int fds[2] = {-1, -1}; // 2: read end and write end
+    ASSERT_TRUE(pipe(fds) == 0);
+    std::string expected;
+    {
+        DumpFdWriter writer(fds[1], 16); // 16: tiny high water, flush often
+        ASSERT_TRUE(writer.GetFlushPolicy() == DumpFdWriter::FLUSH_SECTION);
+        for (int i = 0; i < 100; i++) { // 100: lines
+            std::string line = "line " + std::to_string(i);
+            ASSERT_TRUE(writer.AppendLine(line));
+            expected += line + "\n";
+        }
+        std::string big(64, 'x'); // 64: larger than high water, written without copy
+        ASSERT_TRUE(writer.AppendLine(big));
+        expected += big + "\n";
+        ASSERT_TRUE(writer.Flush());
+    }
+    close(fds[1]);
+    std::string actual;
+    char buf[256] = {0}; // 256: read buffer
+    ssize_t len = 0;
+    while ((len = read(fds[0], buf, sizeof(buf))) > 0) {
+        actual.append(buf, len);
+    }
+    close(fds[0]);
+    ASSERT_EQ(actual, expected);
+}
+
+/**
+ * @tc.name: HidumperOutputTest009
+ * @tc.desc: Test DumpFdWriter reports EPIPE when the reader has gone.
+ * @tc.type: FUNC
+ */
+HWTEST_F(HidumperOutputTest, HidumperOutputTest009, TestSize.Level3)
+{
+    signal(SIGPIPE, SIG_IGN);
+    int fds[2] = {-1, -1}; // 2: read end and write end
+    ASSERT_TRUE(pipe(fds) == 0);
+    close(fds[0]);
+    DumpFdWriter writer(fds[1]);
+    ASSERT_TRUE(writer.AppendLine("this is FdWriterTest"));
+    ASSERT_FALSE(writer.Flush());
+    ASSERT_TRUE(writer.IsBroken());
+    ASSERT_EQ(writer.GetError(), EPIPE);
+    ASSERT_FALSE(writer.AppendLine("dropped"));
+    close(fds[1]);
+}
+/**
+ * @tc.name: HidumperOutputTest010
+ * @tc.desc: Test ZipOutput writes every section into one gzip member.
+ * @tc.type: FUNC
+ */
+HWTEST_F(HidumperOutputTest, HidumperOutputTest010, TestSize.Level3)
+{
+    auto parameter = std::make_shared<DumperParameter>();
+    auto dump_datas = std::make_shared<std::vector<std::vector<std::string>>>();
+    auto zip_output = make_shared<ZipOutput>();
+    DumperOpts opts;
+    opts.path_ = FILE_ROOT + "GZ_HidumperOutputTest010.gz";
+    parameter->SetOpts(opts);
+    zip_output->SetDumpConfig(std::make_shared<DumpCfg>());
+
+    std::string expected;
+    for (int section = 0; section < 3; section++) { // 3: sections share the stream
+        for (int i = 0; i < 2000; i++) { // 2000: several input buffers per section
+            std::vector<std::string> line_vector = {"section " + std::to_string(section), " line ",
+                std::to_string(i)};
+            dump_datas->push_back(line_vector);
+            expected += line_vector[0] + line_vector[1] + line_vector[2] + "\n";
+        }
+        std::string big(MAX_COMPRESS_BUFFER_SIZE + 1, 'a' + section); // bigger than the input buffer
+        dump_datas->push_back({big});
+        expected += big + "\n";
+        ASSERT_TRUE(zip_output->PreExecute(parameter, dump_datas) == DumpStatus::DUMP_OK);
+        ASSERT_TRUE(zip_output->Execute() == DumpStatus::DUMP_OK);
+        ASSERT_TRUE(zip_output->AfterExecute() == DumpStatus::DUMP_OK);
+    }
+    zip_output->Reset();
+
+    std::string actual;
+    size_t remain = 0;
+    // a single member consumes the whole file.
+    ASSERT_EQ(InflateFile(opts.path_, MAX_WBITS + WINDOWS_BITS, expected.size(), actual, remain), Z_STREAM_END);
+    ASSERT_EQ(remain, 0u);
+    ASSERT_EQ(actual, expected);
+}
+/**
+ * @tc.name: HidumperOutputTest011
+ * @tc.desc: Test DumpCompressor with worker threads writes one valid gzip and raw deflate stream.
+ * @tc.type: FUNC
+ */
+HWTEST_F(HidumperOutputTest, HidumperOutputTest011, TestSize.Level3)
+{
+    std::string expected;
+    for (int i = 0; expected.size() < DumpCompressor::PARALLEL_BLOCK_SIZE * 5; i++) { // 5: several blocks
+        expected += "pid " + std::to_string(i * 7919 % 100003) + " name process_" + std::to_string(i % 97) + "\n";
+    }
+    const std::string paths[] = {
+        FILE_ROOT + "GZ_HidumperOutputTest011.gz", FILE_ROOT + "HidumperOutputTest011.raw"
+    };
+    const DumpCompressor::Format formats[] = {DumpCompressor::FORMAT_GZIP, DumpCompressor::FORMAT_RAW};
+    const int windowBits[] = {MAX_WBITS + WINDOWS_BITS, -MAX_WBITS};
+    for (int i = 0; i < 2; i++) { // 2: gzip and raw
+        int fd = open(paths[i].c_str(), O_WRONLY | O_CREAT | O_TRUNC, S_IRUSR | S_IWUSR);
+        ASSERT_TRUE(fd >= 0);
+        DumpCompressor compressor;
+        ASSERT_TRUE(compressor.Init(fd, DumpCodec(), 4, formats[i]) == DumpStatus::DUMP_OK); // 4: workers
+        size_t pos = 0;
+        size_t step = 1000; // 1000: uneven pieces that straddle blocks
+        while (pos < expected.size()) {
+            size_t len = std::min(step, expected.size() - pos);
+            ASSERT_TRUE(compressor.Append(expected.data() + pos, len) == DumpStatus::DUMP_OK);
+            pos += len;
+            step = (step == 1000) ? 70000 : 1000; // 70000: big piece
+        }
+        ASSERT_TRUE(compressor.Finish() == DumpStatus::DUMP_OK);
+        ASSERT_FALSE(compressor.IsActive());
+        close(fd);
+
+        std::string actual;
+        size_t remain = 0;
+        ASSERT_EQ(InflateFile(paths[i], windowBits[i], expected.size(), actual, remain), Z_STREAM_END);
+        ASSERT_EQ(remain, 0u);
+        ASSERT_EQ(actual, expected);
+    }
+}
+/**
+ * @tc.name: HidumperOutputTest012
+ * @tc.desc: Test DumpCodec parses --zip=<codec>[:level].
+ * @tc.type: FUNC
+ */
+HWTEST_F(HidumperOutputTest, HidumperOutputTest012, TestSize.Level3)
+{
+    DumpCodec codec;
+    ASSERT_TRUE(DumpCodec::Parse("", codec));
+    ASSERT_EQ(codec.GetName(), "deflate:6");
+    ASSERT_TRUE(DumpCodec::Parse("deflate:1", codec));
+    ASSERT_EQ(codec.GetZlibLevel(), 1);
+    ASSERT_EQ(codec.GetZipMethod(), Z_DEFLATED);
+    ASSERT_TRUE(DumpCodec::Parse("store", codec));
+    ASSERT_EQ(codec.GetZipMethod(), DumpCodec::ZIP_METHOD_STORE);
+    ASSERT_EQ(codec.GetZlibLevel(), Z_NO_COMPRESSION);
+    const std::string invalids[] = {"deflate:", "deflate:10", "deflate:1x", "store:1", "zstd", "lz4", ":1"};
+    for (auto &text : invalids) {
+        ASSERT_FALSE(DumpCodec::Parse(text, codec)) << text;
+    }
+}
+
+/**
+ * @tc.name: HidumperOutputTest013
+ * @tc.desc: Benchmark throughput and ratio of every codec, and check they round trip.
+ * @tc.type: PERF
+ */
+HWTEST_F(HidumperOutputTest, HidumperOutputTest013, TestSize.Level3)
+{
+    std::string expected;
+    for (int i = 0; expected.size() < 4 * 1024 * 1024; i++) { // 4 MB of dump like text
+        expected += std::to_string(i * 7919 % 32768) + "    root    " + std::to_string(i % 20) + "    " +
+            std::to_string(i * 31 % 100000) + "K    S    com.ohos.process" + std::to_string(i % 53) + "\n";
+    }
+    const std::string codecs[] = {"store", "deflate:1", "deflate:6", "deflate:9"};
+    const uint32_t workerCounts[] = {1, 4}; // 4: parallel blocks
+    for (auto &name : codecs) {
+        for (auto workers : workerCounts) {
+            DumpCodec codec;
+            ASSERT_TRUE(DumpCodec::Parse(name, codec));
+            std::string path = FILE_ROOT + "GZ_HidumperOutputTest013.gz";
+            int fd = open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, S_IRUSR | S_IWUSR);
+            ASSERT_TRUE(fd >= 0);
+            auto start = std::chrono::steady_clock::now();
+            DumpCompressor compressor;
+            ASSERT_TRUE(compressor.Init(fd, codec, workers) == DumpStatus::DUMP_OK);
+            for (size_t pos = 0; pos < expected.size(); pos += CHUNK) {
+                ASSERT_TRUE(compressor.Append(expected.data() + pos,
+                    std::min<size_t>(CHUNK, expected.size() - pos)) == DumpStatus::DUMP_OK);
+            }
+            ASSERT_TRUE(compressor.Finish() == DumpStatus::DUMP_OK);
+            auto cost = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+            off_t outSize = lseek(fd, 0, SEEK_END);
+            close(fd);
+            ASSERT_TRUE(outSize > 0);
+            printf("codec %-10s workers %u: %8.1f MB/s, ratio %5.2f\n", name.c_str(), workers,
+                expected.size() / (1024.0 * 1024.0) / cost, static_cast<double>(expected.size()) / outSize);
+
+            std::string actual;
+            size_t remain = 0;
+            ASSERT_EQ(InflateFile(path, MAX_WBITS + WINDOWS_BITS, expected.size(), actual, remain), Z_STREAM_END);
+            ASSERT_TRUE(actual == expected) << name;
+        }
+    }
+}
+/**
+ * @tc.name: HidumperOutputTest014
+ * @tc.desc: Test ZipWriter recognises already compressed entries.
+ * @tc.type: FUNC
+ */
+HWTEST_F(HidumperOutputTest, HidumperOutputTest014, TestSize.Level3)
+{
+    const unsigned char gzip[] = {0x1f, 0x8b, 0x08, 0x00};
+    const unsigned char zip[] = {'P', 'K', 0x03, 0x04, 0x14};
+    const unsigned char png[] = {0x89, 'P', 'N', 'G', '\r', '\n'};
+    const unsigned char text[] = {'P', 'i', 'd', ' ', '1'};
+    ASSERT_TRUE(ZipWriter::IsCompressedData(gzip, sizeof(gzip)));
+    ASSERT_TRUE(ZipWriter::IsCompressedData(zip, sizeof(zip)));
+    ASSERT_TRUE(ZipWriter::IsCompressedData(png, sizeof(png)));
+    ASSERT_FALSE(ZipWriter::IsCompressedData(text, sizeof(text)));
+    ASSERT_FALSE(ZipWriter::IsCompressedData(zip, 2)); // 2: shorter than the zip magic
+    ASSERT_FALSE(ZipWriter::IsCompressedData(nullptr, 0));
+}
+/**
+ * @tc.name: HidumperOutputTest015
+ * @tc.desc: Test ZipFolderOutput streams one entry per section and only reads external files from the folder.
+ * @tc.type: FUNC
+ */
+HWTEST_F(HidumperOutputTest, HidumperOutputTest015, TestSize.Level3)
+{
+    std::string folder = FILE_ROOT + "ZipFolder015/";
+    ForceCreateDirectory(folder + "smaps/");
+    ASSERT_TRUE(SaveStringToFile(folder + "smaps/smaps", "external smaps"));
+    std::vector<std::u16string> args;
+    auto rawParam = std::make_shared<RawParam>(0, 0, 0, args, -1, nullptr);
+    rawParam->SetFolder(folder);
+    auto parameter = std::make_shared<DumperParameter>();
+    parameter->setClientCallback(rawParam);
+    DumperOpts opts;
+    opts.path_ = FILE_ROOT + "ZIP_HidumperOutputTest015.zip";
+    opts.zipCodec_ = "store"; // entries readable in the file
+    parameter->SetOpts(opts);
+    auto dump_datas = std::make_shared<std::vector<std::vector<std::string>>>();
+    auto zip_output = make_shared<ZipFolderOutput>();
+    zip_output->SetDumpConfig(std::make_shared<DumpCfg>());
+
+    const std::string sections[] = {"base", "memory", "base"}; // base again: an entry of its own
+    for (auto &section : sections) {
+        parameter->SetCurrentSection(section);
+        dump_datas->push_back({"content of ", section});
+        ASSERT_TRUE(zip_output->PreExecute(parameter, dump_datas) == DumpStatus::DUMP_OK);
+        ASSERT_TRUE(zip_output->Execute() == DumpStatus::DUMP_OK);
+        ASSERT_TRUE(zip_output->AfterExecute() == DumpStatus::DUMP_OK);
+    }
+    zip_output->Reset();
+
+    ASSERT_FALSE(FileExists(folder + LOG_DEFAULT));
+    std::string zip;
+    ASSERT_TRUE(LoadStringFromFile(opts.path_, zip));
+    const std::string expected[] = {"base.txt", "memory.txt", "base_1.txt", "smaps/smaps",
+        "content of base\n", "content of memory\n", "external smaps"};
+    for (auto &text : expected) {
+        ASSERT_TRUE(zip.find(text) != std::string::npos) << text;
+    }
+    ForceRemoveDirectory(folder);
+}
+/**
+ * @tc.name: HidumperOutputTest016
+ * @tc.desc: Test JsonOutput streams sections, typed tables and text blocks.
+ * @tc.type: FUNC
+ */
+HWTEST_F(HidumperOutputTest, HidumperOutputTest016, TestSize.Level3)
+{
+    std::string path = FILE_ROOT + "JSON_HidumperOutputTest016.json";
+    int fd = open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, S_IRUSR | S_IWUSR);
+    ASSERT_TRUE(fd >= 0);
+    std::vector<std::u16string> args;
+    auto rawParam = std::make_shared<RawParam>(0, 0, 0, args, fd, nullptr);
+    auto parameter = std::make_shared<DumperParameter>();
+    parameter->setClientCallback(rawParam);
+    DumperOpts opts;
+    opts.format_ = "json";
+    parameter->SetOpts(opts);
+    auto dump_datas = std::make_shared<std::vector<std::vector<std::string>>>();
+    auto json_output = make_shared<JsonOutput>();
+    json_output->SetDumpConfig(std::make_shared<DumpCfg>());
+
+    parameter->SetCurrentSection("memory");
+    dump_datas->push_back({" ", "   Pss", "Shared"});
+    dump_datas->push_back({" ", " Total", " Dirty"});
+    dump_datas->push_back({" ", " -----", "------"});
+    dump_datas->push_back({"init", "  1024", "-12"});
+    dump_datas->push_back({"app \"a\"", "3.5", "007"});
+    dump_datas->push_back({});
+    dump_datas->push_back({"Total: 1 MB\n"});
+    ASSERT_TRUE(json_output->PreExecute(parameter, dump_datas) == DumpStatus::DUMP_OK);
+    ASSERT_TRUE(json_output->Execute() == DumpStatus::DUMP_OK);
+    ASSERT_TRUE(json_output->AfterExecute() == DumpStatus::DUMP_OK);
+    parameter->SetCurrentSection("cpu");
+    dump_datas->push_back({"    PID", "   Total Usage", "    Name"});
+    dump_datas->push_back({"    1    ", "  12%", "   init   "});
+    dump_datas->push_back({"line one\nline\ttwo\n"});
+    dump_datas->push_back({""});
+    dump_datas->push_back({"line three"});
+    ASSERT_TRUE(json_output->PreExecute(parameter, dump_datas) == DumpStatus::DUMP_OK);
+    ASSERT_TRUE(json_output->Execute() == DumpStatus::DUMP_OK);
+    ASSERT_TRUE(json_output->AfterExecute() == DumpStatus::DUMP_OK);
+    json_output->Reset();
+    ASSERT_TRUE(parameter->FlushOutputWriter());
+    close(fd);
+
+    std::string actual;
+    ASSERT_TRUE(LoadStringFromFile(path, actual));
+    std::string expected = "{\"sections\":[\n"
+        "{\"name\":\"memory\",\"blocks\":[\n"
+        "{\"type\":\"table\",\"header\":[\n[\"\",\"Pss\",\"Shared\"],\n[\"\",\"Total\",\"Dirty\"]],\"rows\":[\n"
+        "[\"init\",1024,-12],\n[\"app \\\"a\\\"\",3.5,\"007\"]]},\n"
+        "{\"type\":\"text\",\"lines\":[\n\"Total: 1 MB\"]}]},\n"
+        "{\"name\":\"cpu\",\"blocks\":[\n"
+        "{\"type\":\"table\",\"header\":[\n[\"PID\",\"Total Usage\",\"Name\"]],\"rows\":[\n[1,12,\"init\"]]},\n"
+        "{\"type\":\"text\",\"lines\":[\n\"line one\",\n\"line\\ttwo\",\n\"\",\n\"line three\"]}]}]}\n";
+    ASSERT_EQ(actual, expected);
+}
+/**
+ * @tc.name: HidumperOutputTest017
+ * @tc.desc: Test SnapshotOutput writes snapshots DumpSnapshotReader reads back.
+ * @tc.type: FUNC
+ */
+HWTEST_F(HidumperOutputTest, HidumperOutputTest017, TestSize.Level3)
+{
+    std::string path = FILE_ROOT + "SNAPSHOT_HidumperOutputTest017.snap";
+    int fd = open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, S_IRUSR | S_IWUSR);
+    ASSERT_TRUE(fd >= 0);
+    std::vector<std::u16string> args;
+    auto rawParam = std::make_shared<RawParam>(0, 0, 0, args, fd, nullptr);
+    auto parameter = std::make_shared<DumperParameter>();
+    parameter->setClientCallback(rawParam);
+    DumperOpts opts;
+    opts.format_ = "snapshot";
+    parameter->SetOpts(opts);
+    auto dump_datas = std::make_shared<std::vector<std::vector<std::string>>>();
+    auto snapshot_output = make_shared<SnapshotOutput>();
+    snapshot_output->SetDumpConfig(std::make_shared<DumpCfg>());
+    // two requests, so two snapshots in the file.
+    for (int i = 0; i < 2; i++) {
+        parameter->SetCurrentSection("memory");
+        dump_datas->push_back({" ", "   Pss", "  Usage"});
+        dump_datas->push_back({" ", " -----", "  -----"});
+        dump_datas->push_back({"init", "  1024", "12.5%"});
+        dump_datas->push_back({"init", "  1000", "-0.05"});
+        dump_datas->push_back({"app", "-9000000000", "7%"});
+        dump_datas->push_back({});
+        dump_datas->push_back({"Total: 1 MB\nend\n"});
+        ASSERT_TRUE(snapshot_output->PreExecute(parameter, dump_datas) == DumpStatus::DUMP_OK);
+        ASSERT_TRUE(snapshot_output->Execute() == DumpStatus::DUMP_OK);
+        ASSERT_TRUE(snapshot_output->AfterExecute() == DumpStatus::DUMP_OK);
+        snapshot_output->Reset();
+    }
+    ASSERT_TRUE(parameter->FlushOutputWriter());
+    close(fd);
+
+    DumpSnapshotReader reader;
+    ASSERT_TRUE(reader.Open(path));
+    std::string actual;
+    SnapshotCell cell;
+    while (reader.Next()) {
+        switch (reader.GetType()) {
+            case DumpSnapshotReader::RECORD_BEGIN:
+                ASSERT_EQ(reader.GetVersion(), SNAPSHOT_VERSION);
+                actual += "<begin>";
+                break;
+            case SNAPSHOT_RECORD_SECTION:
+                actual += "[" + reader.GetSection().ToString() + "]";
+                break;
+            case SNAPSHOT_RECORD_TABLE:
+                actual += "<table " + std::to_string(reader.GetHeaderRows()) + ">";
+                break;
+            case SNAPSHOT_RECORD_ROW:
+                while (reader.NextCell(cell)) {
+                    actual += std::to_string(cell.kind) + ":" + cell.ToString() + ",";
+                }
+                actual += ";";
+                break;
+            case SNAPSHOT_RECORD_TEXT:
+                actual += "\"" + reader.GetText().ToString() + "\"";
+                break;
+            case SNAPSHOT_RECORD_END:
+                actual += "<end>";
+                break;
+            default:
+                break;
+        }
+    }
+    ASSERT_FALSE(reader.IsCorrupted());
+    std::string snapshot = "<begin>[memory]<table 1>0:,0:Pss,0:Usage,;"
+        "0:init,1:1024,2:12.5%,;0:init,1:1000,2:-0.05,;0:app,1:-9000000000,1:7%,;"
+        "\"Total: 1 MB\"\"end\"<end>";
+    ASSERT_EQ(actual, snapshot + snapshot);
+
+    // a truncated capture is reported.
+    std::string data;
+    ASSERT_TRUE(LoadStringFromFile(path, data));
+    ASSERT_TRUE(reader.Attach(data.data(), data.size() / 2 - 1));
+    while (reader.Next()) {
+    }
+    ASSERT_TRUE(reader.IsCorrupted());
+}
+/**
+ * @tc.name: HidumperOutputTest018
+ * @tc.desc: Test DumpFdWriter in async mode keeps the order when blocking, and marks dropped data.
+ * @tc.type: FUNC
+ */
+HWTEST_F(HidumperOutputTest, HidumperOutputTest018, TestSize.Level3)
+{
+    auto readAll = [](int fd, std::string &out) {
+        char buf[4096] = {0}; // 4096: read buffer
+        ssize_t len = 0;
+        while ((len = read(fd, buf, sizeof(buf))) > 0) {
+            out.append(buf, len);
+            std::this_thread::sleep_for(std::chrono::microseconds(100)); // 100: a slow client
+        }
+    };
+    int fds[2] = {-1, -1}; // 2: read end and write end
+    ASSERT_TRUE(pipe(fds) == 0);
+    std::string expected;
+    std::string actual;
+    std::thread reader(readAll, fds[0], std::ref(actual));
+    {
+        DumpFdWriter writer(fds[1], 1024); // 1024: high water
+        ASSERT_TRUE(writer.StartAsync(4)); // 4: slots
+        ASSERT_TRUE(writer.IsAsync());
+        for (int i = 0; i < 20000; i++) { // 20000: lines, more than the pipe and the ring hold
+            std::string line = "line " + std::to_string(i);
+            ASSERT_TRUE(writer.AppendLine(line));
+            expected += line + "\n";
+        }
+        std::string big(4096, 'x'); // 4096: larger than high water
+        ASSERT_TRUE(writer.AppendLine(big));
+        expected += big + "\n";
+        ASSERT_TRUE(writer.Flush());
+        ASSERT_EQ(writer.GetStats().bytes, expected.size());
+        ASSERT_EQ(writer.GetStats().droppedBytes, 0u);
+    }
+    close(fds[1]);
+    reader.join();
+    close(fds[0]);
+    ASSERT_EQ(actual, expected);
+
+    ASSERT_TRUE(pipe(fds) == 0);
+    size_t total = 0;
+    actual.clear();
+    DumpFdWriter writer(fds[1], 1024); // 1024: high water
+    ASSERT_TRUE(writer.StartAsync(2, DumpFdWriter::BACKPRESSURE_DROP)); // 2: slots
+    for (int i = 0; i < 1024; i++) { // 1024: lines of 1 KB, nobody reads yet
+        std::string line(1023, 'a' + (i % 26)); // 1023, 26: a line of one letter
+        EXPECT_TRUE(writer.AppendLine(line)); // no return before the reader starts
+        total += line.size() + 1;
+    }
+    std::thread dropReader(readAll, fds[0], std::ref(actual));
+    ASSERT_TRUE(writer.Flush());
+    DumpFdWriter::Stats stats = writer.GetStats();
+    close(fds[1]);
+    dropReader.join();
+    close(fds[0]);
+    ASSERT_GT(stats.droppedBytes, 0u);
+    // the client may catch up in between, then every run of drops gets its own marker.
+    const std::string markerHead = "[hidumper: ";
+    uint64_t marked = 0;
+    for (size_t pos = actual.find(markerHead); pos != std::string::npos; pos = actual.find(markerHead, pos + 1)) {
+        marked += std::stoull(actual.substr(pos + markerHead.size()));
+    }
+    ASSERT_EQ(marked, stats.droppedBytes);
+    ASSERT_EQ(stats.bytes, actual.size());
+    ASSERT_LT(actual.size(), total);
+}
+/**
+ * @tc.name: HidumperOutputTest019
+ * @tc.desc: Test TeeOutput writes the same chunks to the client and to the zip archive.
+ * @tc.type: FUNC
+ */
+HWTEST_F(HidumperOutputTest, HidumperOutputTest019, TestSize.Level3)
+{
+    std::string folder = FILE_ROOT + "ZipFolder019/";
+    ForceCreateDirectory(folder);
+    std::string path = FILE_ROOT + "TEE_HidumperOutputTest019.txt";
+    int fd = open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, S_IRUSR | S_IWUSR);
+    ASSERT_TRUE(fd >= 0);
+    std::vector<std::u16string> args;
+    auto rawParam = std::make_shared<RawParam>(0, 0, 0, args, fd, nullptr);
+    rawParam->SetFolder(folder);
+    auto parameter = std::make_shared<DumperParameter>();
+    parameter->setClientCallback(rawParam);
+    DumperOpts opts;
+    opts.path_ = FILE_ROOT + "ZIP_HidumperOutputTest019.zip";
+    opts.zipCodec_ = "store"; // entries readable in the file
+    opts.isTee_ = true;
+    parameter->SetOpts(opts);
+    auto dump_datas = std::make_shared<std::vector<std::vector<std::string>>>();
+    std::vector<std::shared_ptr<HidumperExecutor>> sinks = { make_shared<FDOutput>(), make_shared<ZipFolderOutput>() };
+    auto tee_output = make_shared<TeeOutput>(sinks);
+    tee_output->SetDumpConfig(std::make_shared<DumpCfg>());
+
+    const std::string sections[] = {"base", "memory"};
+    for (auto &section : sections) {
+        parameter->SetCurrentSection(section);
+        dump_datas->push_back({"content of ", section});
+        ASSERT_TRUE(tee_output->PreExecute(parameter, dump_datas) == DumpStatus::DUMP_OK);
+        ASSERT_TRUE(tee_output->Execute() == DumpStatus::DUMP_OK);
+        ASSERT_TRUE(tee_output->AfterExecute() == DumpStatus::DUMP_OK);
+        ASSERT_TRUE(dump_datas->empty());
+    }
+    tee_output->Reset();
+    ASSERT_TRUE(parameter->FlushOutputWriter());
+    close(fd);
+
+    std::string client;
+    ASSERT_TRUE(LoadStringFromFile(path, client));
+    ASSERT_EQ(client, "content of base\ncontent of memory\n");
+    std::string zip;
+    ASSERT_TRUE(LoadStringFromFile(opts.path_, zip));
+    const std::string expected[] = {"base.txt", "memory.txt", "content of base\n", "content of memory\n"};
+    for (auto &text : expected) {
+        ASSERT_TRUE(zip.find(text) != std::string::npos) << text;
+    }
+    // the client output doesn't end up in the archive path.
+    ASSERT_TRUE(zip.compare(0, 2, "PK") == 0);
+    ASSERT_EQ(zip.find(client), std::string::npos);
+    ForceRemoveDirectory(folder);
+}
+/**
+ * @tc.name: HidumperOutputTest020
+ * @tc.desc: Test DumpLineBuffer keeps the lines and tables in order and reuses its chunks after Clear.
+ * @tc.type: FUNC
+ */
+HWTEST_F(HidumperOutputTest, HidumperOutputTest020, TestSize.Level3)
+{
+    DumpLineBuffer buffer(16); // 16: tiny chunks, cells spill over several
+    std::vector<std::vector<std::string>> matrix = {{"title"}};
+    buffer.MoveFrom(matrix);
+    ASSERT_TRUE(matrix.empty());
+    buffer.AppendCell("name", 4); // 4: size of name
+    buffer.AppendCell(std::string(" "));
+    buffer.AppendCell(std::string(40, 'x')); // 40: bigger than a chunk
+    buffer.EndLine();
+    buffer.EndLine(); // an empty line
+    matrix.push_back({"a", "b\r\n"});
+    buffer.MoveFrom(matrix);
+    ASSERT_EQ(buffer.GetLineCount(), 4u);
+    ASSERT_EQ(buffer.GetCellCount(2), 0u);
+
+    std::vector<std::string> line;
+    buffer.GetLine(0, line);
+    ASSERT_EQ(line, std::vector<std::string>({"title"}));
+    buffer.GetLine(1, line);
+    ASSERT_EQ(line, std::vector<std::string>({"name", " ", std::string(40, 'x')}));
+    size_t size = 0;
+    char *cell = buffer.GetMutableCell(3, 1, size);
+    ASSERT_EQ(std::string(cell, size), "b\r\n");
+    buffer.ShrinkCell(3, 1, 1);
+    buffer.GetLine(3, line);
+    ASSERT_EQ(line, std::vector<std::string>({"a", "b"}));
+    // a table ends the open line first.
+    buffer.AppendCell(std::string("open"));
+    buffer.AppendTable(std::make_shared<DumpTable>());
+    ASSERT_EQ(buffer.GetLineCount(), 6u);
+    buffer.GetLine(4, line);
+    ASSERT_EQ(line, std::vector<std::string>({"open"}));
+    ASSERT_TRUE(buffer.GetTable(4) == nullptr);
+    ASSERT_TRUE(buffer.GetTable(5) != nullptr);
+    ASSERT_EQ(buffer.GetCellCount(5), 0u);
+
+    size_t capacity = buffer.GetCapacity();
+    buffer.Clear();
+    ASSERT_TRUE(buffer.IsEmpty());
+    for (int i = 0; i < 2; i++) { // 2: the second round fits in the kept chunks
+        buffer.AppendLine({"0123456789", "abcdef"});
+        buffer.Clear();
+        ASSERT_LE(buffer.GetCapacity(), capacity);
+    }
+}
+/**
+ * @tc.name: HidumperOutputTest021
+ * @tc.desc: Test DumpTable sorts and filters values, counts to the budget, and outputs format it as text and json.
+ * @tc.type: FUNC
+ */
+HWTEST_F(HidumperOutputTest, HidumperOutputTest021, TestSize.Level3)
+{
+    auto table = std::make_shared<DumpTable>();
+    table->AddColumn({"pid", DumpTable::COLUMN_UINT, "PID  ", "", "", 5, true}); // 5: width of pid
+    table->AddColumn({"usage", DumpTable::COLUMN_PERCENT, " Usage", " ", "", 3, false}); // 3: width of usage
+    table->AddColumn({"name", DumpTable::COLUMN_STRING, " Name", " ", " kB", 0, true});
+    const uint64_t pids[] = {1, 20, 300, 4000};
+    const uint64_t usages[] = {5, 12, 5, 0};
+    const std::string names[] = {"init", "a\033[1mb", "init", "idle"};
+    for (size_t i = 0; i < sizeof(pids) / sizeof(pids[0]); i++) {
+        size_t row = table->AddRow();
+        table->SetValue(row, 0, pids[i]);
+        table->SetValue(row, 1, usages[i]);
+        table->SetString(row, 2, names[i]);
+    }
+    table->Sort({{1, true}, {0, true}});
+    table->Filter([](const DumpTable &t, size_t row) { return t.GetValue(row, 1) > 0; });
+    ASSERT_EQ(table->GetRowCount(), 3u);
+    ASSERT_EQ(table->GetValue(1, 0), 300u);
+    table->Top(2); // 2: the two busiest
+    std::string text;
+    table->FormatRow(1, text);
+    ASSERT_EQ(text, "300     5% init kB");
+
+    int fds[2] = {-1, -1}; // 2: read end and write end
+    ASSERT_TRUE(pipe(fds) == 0);
+    std::vector<std::u16string> args;
+    auto rawParam = std::make_shared<RawParam>(0, 0, 0, args, fds[1], nullptr);
+    auto parameter = std::make_shared<DumperParameter>();
+    parameter->setClientCallback(rawParam);
+    auto dump_datas = std::make_shared<std::vector<std::vector<std::string>>>();
+    dump_datas->push_back({"Details:"});
+    parameter->GetLineBuffer()->MoveFrom(*dump_datas);
+    parameter->GetLineBuffer()->AppendTable(table);
+    // the rows of the table are held to the chunk budget at their padded width.
+    ASSERT_EQ(table->GetRowWidth(), 13u); // 13: "PID  " 5, " " and 3, " " and " kB"
+    ASSERT_EQ(parameter->GetLineBuffer()->GetByteCount(), 8u); // 8: "Details:"
+    ASSERT_EQ(parameter->GetLineBuffer()->GetPendingSize(), 34u); // 34: "Details:" and 2 rows
+    auto fd_output = make_shared<FDOutput>();
+    ASSERT_TRUE(fd_output->PreExecute(parameter, dump_datas) == DumpStatus::DUMP_OK);
+    ASSERT_TRUE(fd_output->Execute() == DumpStatus::DUMP_OK);
+    ASSERT_TRUE(fd_output->AfterExecute() == DumpStatus::DUMP_OK);
+    ASSERT_TRUE(parameter->GetLineBuffer()->IsEmpty());
+    ASSERT_TRUE(parameter->FlushOutputWriter());
+    close(fds[1]);
+    std::string actual;
+    char buf[256] = {0}; // 256: more than the output
+    ssize_t len = 0;
+    while ((len = read(fds[0], buf, sizeof(buf))) > 0) {
+        actual.append(buf, len);
+    }
+    close(fds[0]);
+    ASSERT_EQ(actual, "Details:\nPID   Usage Name\n20     12% a\033[1mb kB\n300     5% init kB\n");
+
+    std::string json;
+    JsonOutput::AppendString(table->GetString(0, 2), json);
+    std::string path = FILE_ROOT + "JSON_HidumperOutputTest021.json";
+    int fd = open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, S_IRUSR | S_IWUSR);
+    ASSERT_TRUE(fd >= 0);
+    auto jsonParam = std::make_shared<DumperParameter>();
+    jsonParam->setClientCallback(std::make_shared<RawParam>(0, 0, 0, args, fd, nullptr));
+    jsonParam->SetCurrentSection("cpu");
+    jsonParam->GetLineBuffer()->AppendTable(table);
+    auto json_output = make_shared<JsonOutput>();
+    ASSERT_TRUE(json_output->PreExecute(jsonParam, dump_datas) == DumpStatus::DUMP_OK);
+    ASSERT_TRUE(json_output->Execute() == DumpStatus::DUMP_OK);
+    ASSERT_TRUE(json_output->AfterExecute() == DumpStatus::DUMP_OK);
+    json_output->Reset();
+    ASSERT_TRUE(jsonParam->FlushOutputWriter());
+    close(fd);
+    ASSERT_TRUE(LoadStringFromFile(path, actual));
+    ASSERT_EQ(actual, "{\"sections\":[\n{\"name\":\"cpu\",\"blocks\":[\n"
+        "{\"type\":\"table\",\"header\":[\n[\"pid\",\"usage\",\"name\"]],\"rows\":[\n"
+        "[20,12," + json + "],\n[300,5,\"init\"]]}]}]}\n");
+}
+/**
+ * @tc.name: HidumperOutputTest022
+ * @tc.desc: Test DumpExecutorStats counts lines, bytes and loops of executors and merges rows by name.
+ * @tc.type: FUNC
+ */
+HWTEST_F(HidumperOutputTest, HidumperOutputTest022, TestSize.Level3)
+{
+    const size_t executorCount = 4; // 4: two pid dumpers of one name, a filter and the output
+    DumpExecutorStats stats(executorCount);
+    stats.SetExecutor(0, "dumper_smaps", "process", false);
+    stats.SetExecutor(1, "dumper_smaps", "process", false);
+    stats.SetExecutor(2, "", "process", false); // 2: the filter
+    stats.SetExecutor(3, "", "", true); // 3: the output
+    DumpExecutorStats::Matrix matrix;
+    DumpLineBuffer lines;
+    DumpExecutorStats::Sample sample;
+
+    stats.Begin(matrix, &lines, sample);
+    matrix.push_back({"ab", "c"});
+    stats.End(0, sample, matrix, &lines);
+    stats.Begin(matrix, &lines, sample);
+    lines.MoveFrom(matrix);
+    lines.AppendLine({"defg"});
+    stats.End(1, sample, matrix, &lines);
+    stats.Begin(matrix, &lines, sample);
+    size_t size = 0;
+    (void)lines.GetMutableCell(1, 0, size);
+    lines.ShrinkCell(1, 0, 1); // 1: keep "d"
+    stats.End(2, sample, matrix, &lines);
+    ASSERT_EQ(lines.GetByteCount(), 4u); // 4: "ab", "c" and "d"
+    stats.Begin(matrix, &lines, sample);
+    lines.Clear();
+    stats.End(3, sample, matrix, &lines);
+
+    auto table = stats.CreateTable();
+    ASSERT_EQ(table->GetRowCount(), 3u); // 3: the dumpers, the filter and the output
+    ASSERT_EQ(table->GetString(0, 0), "dumper_smaps");
+    ASSERT_EQ(table->GetValue(0, 4), 2u); // 4: lines, 2: one line by each dumper
+    ASSERT_EQ(table->GetValue(0, 5), 7u); // 5: bytes, 7: "ab", "c" and "defg"
+    ASSERT_EQ(table->GetValue(0, 6), 2u); // 6: loops, 2: both dumpers ran once
+    ASSERT_EQ(table->GetString(1, 0), "filter");
+    ASSERT_EQ(table->GetValue(1, 5), 0u); // 5: bytes, the filter only removes
+    ASSERT_EQ(table->GetString(2, 0), "output");
+    ASSERT_EQ(table->GetValue(2, 4), 2u); // 4: lines written
+    ASSERT_EQ(table->GetValue(2, 5), 4u); // 5: bytes written
+    std::string header;
+    table->FormatHeader(header);
+    ASSERT_EQ(header.find("Executor"), 0u);
+}
+/**
+ * @tc.name: HidumperOutputTest023
+ * @tc.desc: Test DumpLineReader times out, splits a line at the cap and DumpCommand kills a hung command.
+ * @tc.type: FUNC
+ */
+HWTEST_F(HidumperOutputTest, HidumperOutputTest023, TestSize.Level3)
+{
+    int fds[2] = { -1, -1 }; // 2: read and write ends
+    ASSERT_EQ(pipe(fds), 0);
+    ASSERT_EQ(write(fds[1], "a\nb", 3), 3); // 3: "a\nb", the last line is not terminated yet
+    DumpLineReader reader(fds[0]);
+    auto isCanceled = [] { return false; };
+    const char *data = nullptr;
+    size_t size = 0;
+    ASSERT_EQ(reader.ReadLine(1000, isCanceled, data, size), DumpLineReader::READ_LINE); // 1000: 1s
+    ASSERT_EQ(std::string(data, size), "a");
+    const uint64_t timeoutMs = 200; // 200: the writer stays silent past it
+    auto begin = std::chrono::steady_clock::now();
+    ASSERT_EQ(reader.ReadLine(timeoutMs, isCanceled, data, size), DumpLineReader::READ_TIMEOUT);
+    auto cost = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - begin);
+    ASSERT_LT(cost.count(), 2000); // 2000: far less than a hang
+    close(fds[1]);
+    ASSERT_EQ(reader.ReadLine(1000, isCanceled, data, size), DumpLineReader::READ_LINE); // 1000: 1s
+    ASSERT_EQ(std::string(data, size), "b");
+    ASSERT_EQ(reader.ReadLine(1000, isCanceled, data, size), DumpLineReader::READ_END); // 1000: 1s
+    close(fds[0]);
+
+    // a line with no end is split at the cap, the buffer doesn't grow past it.
+    ASSERT_EQ(pipe(fds), 0);
+    const size_t maxLineSize = DumpLineReader::MAX_LINE_SIZE;
+    std::string longLine(maxLineSize + 10, 'x'); // 10: the rest after the cap
+    reader.Reset(fds[0]);
+    std::thread writer([&fds, &longLine] {
+        (void)write(fds[1], longLine.data(), longLine.size());
+        close(fds[1]);
+    });
+    ASSERT_EQ(reader.ReadLine(5000, isCanceled, data, size), DumpLineReader::READ_LINE); // 5000: 5s
+    ASSERT_EQ(size, maxLineSize);
+    ASSERT_EQ(reader.ReadLine(5000, isCanceled, data, size), DumpLineReader::READ_LINE); // 5000: 5s
+    ASSERT_EQ(size, 10u); // 10: the rest after the cap
+    ASSERT_EQ(reader.ReadLine(1000, isCanceled, data, size), DumpLineReader::READ_END); // 1000: 1s
+    writer.join();
+    close(fds[0]);
+
+    DumpCommand command;
+    ASSERT_TRUE(command.Start("echo start; sleep 30"));
+    reader.Reset(command.GetOutputFd());
+    ASSERT_EQ(reader.ReadLine(5000, isCanceled, data, size), DumpLineReader::READ_LINE); // 5000: 5s
+    ASSERT_EQ(std::string(data, size), "start");
+    ASSERT_EQ(reader.ReadLine(timeoutMs, isCanceled, data, size), DumpLineReader::READ_TIMEOUT);
+    begin = std::chrono::steady_clock::now();
+    command.Stop(timeoutMs);
+    cost = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - begin);
+    ASSERT_FALSE(command.IsRunning());
+    ASSERT_LT(cost.count(), 5000); // 5000: the sleep is killed, not waited for
+}
+/**
+ * @tc.name: HidumperOutputTest024
+ * @tc.desc: Test a dumper yields at the chunk budget and goes on where it stopped.
+ * @tc.type: FUNC
+ */
+HWTEST_F(HidumperOutputTest, HidumperOutputTest024, TestSize.Level3)
+{
+    const size_t budget = 64; // 64: a few lines of the command
+    const size_t maxOverrun = 32; // 32: "cmd is" line and a number
+    auto parameter = std::make_shared<DumperParameter>();
+    parameter->SetChunkBudget(budget);
+    auto config = std::make_shared<DumpCfg>();
+    config->class_ = DumperConstant::CMD_DUMPER;
+    config->loop_ = DumperConstant::NONE;
+    config->target_ = "seq 1 1000";
+    auto dumper = std::make_shared<CMDDumper>();
+    dumper->SetDumpConfig(config);
+    auto dumpDatas = std::make_shared<std::vector<std::vector<std::string>>>();
+    std::shared_ptr<DumpLineBuffer> lines = parameter->GetLineBuffer();
+
+    size_t chunks = 0;
+    size_t lineCount = 0;
+    DumpStatus ret = DumpStatus::DUMP_MORE_DATA;
+    while (ret == DumpStatus::DUMP_MORE_DATA) {
+        ASSERT_EQ(dumper->DoPreExecute(parameter, dumpDatas), DumpStatus::DUMP_OK);
+        ASSERT_NE(dumper->DoExecute(), DumpStatus::DUMP_FAIL);
+        ret = dumper->DoAfterExecute();
+        if (ret == DumpStatus::DUMP_MORE_DATA) {
+            ASSERT_GE(lines->GetByteCount(), budget);
+        }
+        // a chunk overruns the budget by its last line, the first one also holds the "cmd is" line.
+        ASSERT_LT(lines->GetByteCount(), budget + maxOverrun);
+        lineCount += lines->GetLineCount();
+        lines->Clear();
+        chunks++;
+    }
+    ASSERT_EQ(ret, DumpStatus::DUMP_OK);
+    ASSERT_GT(chunks, 1u);
+    ASSERT_EQ(lineCount, 1001u); // 1001: "cmd is" line and 1000 numbers
+}
+/**
+ * @tc.name: HidumperOutputTest025
+ * @tc.desc: Test ZipWriter deflates section entries on its workers into raw entries.
+ * @tc.type: FUNC
+ */
+HWTEST_F(HidumperOutputTest, HidumperOutputTest025, TestSize.Level3)
+{
+    std::string text;
+    for (int i = 0; text.size() < DumpCompressor::PARALLEL_BLOCK_SIZE * 3; i++) { // 3: several blocks
+        text += "section line " + std::to_string(i) + "\n";
+    }
+    const std::string names[] = {"base.txt", "memory.txt"};
+    const uint32_t workers[] = {1, 4};
+    for (uint32_t count : workers) {
+        std::string path = FILE_ROOT + "ZIP_HidumperOutputTest025_" + std::to_string(count) + ".zip";
+        ZipWriter writer(path);
+        writer.SetWorkers(count);
+        ASSERT_TRUE(writer.Open());
+        for (auto &name : names) {
+            ASSERT_TRUE(writer.OpenEntry(name));
+            for (size_t pos = 0; pos < text.size(); pos += 1000) { // 1000: pieces across block borders
+                ASSERT_TRUE(writer.WriteEntry(text.data() + pos, std::min<size_t>(1000, text.size() - pos)));
+            }
+            ASSERT_TRUE(writer.CloseEntry());
+        }
+        ASSERT_TRUE(writer.Close());
+
+        std::string zip;
+        ASSERT_TRUE(LoadStringFromFile(path, zip));
+        size_t offset = 0;
+        for (auto &name : names) {
+            std::string entryName;
+            std::string content;
+            ASSERT_TRUE(InflateZipEntry(zip, offset, entryName, content)) << name;
+            ASSERT_EQ(entryName, name);
+            ASSERT_TRUE(content == text) << name;
+        }
+    }
+}
+/**
+ * @tc.name: HidumperOutputTest026
+ * @tc.desc: Test sections run by 4 workers are output as with 1 worker, in config order.
+ * @tc.type: FUNC
+ */
+HWTEST_F(HidumperOutputTest, HidumperOutputTest026, TestSize.Level3)
+{
+    // the first sections are the slow ones, so the later jobs finish first.
+    const std::vector<int> sleepMs = {60, 40, 20, 0};
+    std::string serial = DumpSectionsToFile(CreateSectionExecutors(6, 3, sleepMs), // 6, 3: sections, rounds
+        FILE_ROOT + "HidumperOutputTest026_1.txt", 1, 0);
+    std::string concurrent = DumpSectionsToFile(CreateSectionExecutors(6, 3, sleepMs), // 6, 3: sections, rounds
+        FILE_ROOT + "HidumperOutputTest026_4.txt", 4, 0);
+    ASSERT_FALSE(serial.empty());
+    ASSERT_EQ(concurrent, serial);
+    size_t last = 0;
+    for (int section = 0; section < 6; section++) { // 6: sections
+        size_t pos = serial.find("sec" + std::to_string(section) + "/d0 0");
+        ASSERT_NE(pos, std::string::npos);
+        ASSERT_GE(pos, last);
+        last = pos;
+    }
+    // a tight pending limit makes the workers wait, but changes nothing in the output.
+    std::string limited = DumpSectionsToFile(CreateSectionExecutors(6, 3, sleepMs), // 6, 3: sections, rounds
+        FILE_ROOT + "HidumperOutputTest026_l.txt", 4, 1);
+    ASSERT_EQ(limited, serial);
+}
+/**
+ * @tc.name: HidumperOutputTest027
+ * @tc.desc: Test a cancel stops the section workers waiting for room.
+ * @tc.type: FUNC
+ */
+HWTEST_F(HidumperOutputTest, HidumperOutputTest027, TestSize.Level3)
+{
+    // sec0 is slow, the later sections fill the pending limit at once and wait for it.
+    auto executors = CreateSectionExecutors(4, 20, {100, 0}, 1000); // 4, 20: sections, rounds; 1000: line size
+    std::string path = FILE_ROOT + "HidumperOutputTest027.txt";
+    int fd = open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, S_IRUSR | S_IWUSR);
+    ASSERT_TRUE(fd >= 0);
+    std::vector<std::u16string> args;
+    auto rawParam = std::make_shared<RawParam>(0, 0, 0, args, fd, nullptr);
+    auto parameter = std::make_shared<DumperParameter>();
+    parameter->setClientCallback(rawParam);
+    DumpImplement &dumpImplement = DumpImplement::GetInstance();
+    DumpImplement::SectionSchedule schedule;
+    schedule.maxPendingBytes = 2000; // 2000: two lines
+    dumpImplement.SplitSections(executors, schedule.jobs);
+    ASSERT_EQ(schedule.jobs.size(), 4u);
+    SectionTestDumper::executed_ = 0;
+
+    size_t pendingBytes = 0;
+    bool laterJobsDone = true;
+    std::thread canceler([&schedule, &rawParam, &pendingBytes, &laterJobsDone] {
+        bool blocked = false;
+        for (int poll = 0; (poll < 100) && !blocked; poll++) { // 100: a second at most
+            std::this_thread::sleep_for(std::chrono::milliseconds(10)); // 10: poll
+            std::lock_guard<std::mutex> lock(schedule.mutex);
+            blocked = (schedule.pendingBytes > 0) && !schedule.jobs[1].done;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(50)); // 50: the workers are waiting
+        {
+            std::lock_guard<std::mutex> lock(schedule.mutex);
+            pendingBytes = schedule.pendingBytes;
+            laterJobsDone = schedule.jobs[1].done || schedule.jobs[2].done || schedule.jobs[3].done;
+        }
+        rawParam->Cancel();
+    });
+    auto start = std::chrono::steady_clock::now();
+    dumpImplement.DumpSections(executors, parameter, schedule, 4); // 4: workers
+    auto spent = std::chrono::steady_clock::now() - start;
+    canceler.join();
+    for (auto &executor : executors) {
+        executor->Reset();
+    }
+    (void)parameter->FlushOutputWriter();
+    close(fd);
+
+    ASSERT_LE(pendingBytes, schedule.maxPendingBytes);
+    ASSERT_FALSE(laterJobsDone);
+    // sec0 alone runs 2 seconds, the waiting workers drop their batch and stop.
+    ASSERT_LT(spent, std::chrono::milliseconds(1000)); // 1000: well before sec0 is done
+    ASSERT_LT(SectionTestDumper::executed_, 4 * 2 * 20); // 4, 2, 20: sections, dumpers, rounds
+}
+/**
+ * @tc.name: HidumperOutputTest028
+ * @tc.desc: Test a dumper of a concurrent section job times out as in the serial dump.
+ * @tc.type: FUNC
+ */
+HWTEST_F(HidumperOutputTest, HidumperOutputTest028, TestSize.Level3)
+{
+    DumperOpts opts;
+    opts.timeout_ = 1; // 1: second
+    // every dumper of sec1 sleeps past the timeout of its group, its second one is not run.
+    const std::vector<int> sleepMs = {0, 1100, 0};
+    std::string serial = DumpSectionsToFile(CreateSectionExecutors(3, 1, sleepMs), // 3, 1: sections, rounds
+        FILE_ROOT + "HidumperOutputTest028_1.txt", 1, 0, opts);
+    std::string concurrent = DumpSectionsToFile(CreateSectionExecutors(3, 1, sleepMs), // 3, 1: sections, rounds
+        FILE_ROOT + "HidumperOutputTest028_4.txt", 4, 0, opts);
+    ASSERT_EQ(concurrent, serial);
+    size_t timeout = concurrent.find(SectionTestDumper("", 1).GetTimeoutStr());
+    ASSERT_NE(timeout, std::string::npos);
+    ASSERT_LT(concurrent.find("sec1/d0 0"), timeout);
+    ASSERT_EQ(concurrent.find("sec1/d1 0"), std::string::npos);
+    ASSERT_GT(concurrent.find("sec2/d1 0"), timeout);
+}
+/**
+ * @tc.name: HidumperOutputTest029
+ * @tc.desc: Test a dumper having more data goes on before the dumpers behind it, and drained buffers are reused.
+ * @tc.type: FUNC
+ */
+HWTEST_F(HidumperOutputTest, HidumperOutputTest029, TestSize.Level3)
+{
+    const int rounds = 4; // 4: a batch each
+    const std::vector<int> sleepMs = {20, 0};
+    auto executors = CreateSectionExecutors(3, rounds, sleepMs); // 3: sections
+    std::string path = FILE_ROOT + "HidumperOutputTest029.txt";
+    int fd = open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, S_IRUSR | S_IWUSR);
+    ASSERT_TRUE(fd >= 0);
+    std::vector<std::u16string> args;
+    auto parameter = std::make_shared<DumperParameter>();
+    parameter->setClientCallback(std::make_shared<RawParam>(0, 0, 0, args, fd, nullptr));
+    DumpImplement &dumpImplement = DumpImplement::GetInstance();
+    DumpImplement::SectionSchedule schedule;
+    dumpImplement.SplitSections(executors, schedule.jobs);
+    // the job of sec1 alone, it runs ahead of nothing and keeps its batches.
+    auto sectionParameter = parameter->CreateSectionParameter();
+    auto dumpDatas = std::make_shared<std::vector<std::vector<std::string>>>();
+    dumpImplement.DumpRange(executors, schedule.jobs[1].begin, schedule.jobs[1].end, sectionParameter, dumpDatas,
+        &schedule, 1, nullptr);
+    ASSERT_EQ(schedule.jobs[1].batches.size(), static_cast<size_t>(1 + rounds)); // 1: the plain dumper
+    for (int round = 0; round < rounds; round++) {
+        std::string line = "sec1/d1 " + std::to_string(round);
+        const DumpImplement::SectionBatch &batch = schedule.jobs[1].batches[1 + round];
+        ASSERT_EQ(batch.section, "sec1");
+        ASSERT_EQ(batch.lines->GetLineCount(), 1u);
+        DumpLineBuffer::Cell cell = batch.lines->GetCell(0, 0);
+        ASSERT_EQ(std::string(cell.data, cell.size), line);
+    }
+    // a drained batch gives its buffer back, the next batch of the job is filled in it.
+    DumpImplement::SectionBatch batch;
+    ASSERT_TRUE(dumpImplement.WaitSectionBatch(schedule, 1, parameter->getClientCallback(), batch));
+    DumpLineBuffer *drained = batch.lines.get();
+    dumpImplement.RecycleSectionLines(schedule, 1, batch.lines);
+    batch.lines = nullptr;
+    dumpDatas->push_back({"next"});
+    dumpImplement.AddSectionBatch(schedule, 1, schedule.jobs[1].end - 1, sectionParameter, dumpDatas);
+    ASSERT_EQ(sectionParameter->GetLineBuffer().get(), drained);
+    ASSERT_TRUE(sectionParameter->GetLineBuffer()->IsEmpty());
+    for (int i = 0; i < 3; i++) { // 3: more than a job keeps
+        dumpImplement.RecycleSectionLines(schedule, 1, std::make_shared<DumpLineBuffer>());
+    }
+    ASSERT_EQ(schedule.jobs[1].freeLines.size(), 2u); // 2: kept by a job at most
+    close(fd);
+
+    // the executors keep their group as parent until Reset, so every run gets new ones.
+    std::string serial = DumpSectionsToFile(CreateSectionExecutors(3, rounds, sleepMs), // 3: sections
+        FILE_ROOT + "HidumperOutputTest029_1.txt", 1, 0);
+    std::string concurrent = DumpSectionsToFile(CreateSectionExecutors(3, rounds, sleepMs), // 3: sections
+        FILE_ROOT + "HidumperOutputTest029_4.txt", 4, 1);
+    ASSERT_EQ(concurrent, serial);
+    size_t last = 0;
+    for (int round = 0; round < rounds; round++) {
+        size_t pos = concurrent.find("sec0/d1 " + std::to_string(round));
+        ASSERT_NE(pos, std::string::npos);
+        ASSERT_GT(pos, last);
+        last = pos;
+    }
+    ASSERT_GT(concurrent.find("sec1/d0 0"), last);
+}
+/**
+ * @tc.name: HidumperOutputTest030
+ * @tc.desc: Test JsonOutput keeps valid UTF-8, replaces bytes of no valid sequence and writes an empty document.
+ * @tc.type: FUNC
+ */
+HWTEST_F(HidumperOutputTest, HidumperOutputTest030, TestSize.Level3)
+{
+    std::string json;
+    JsonOutput::AppendString("a\xc3\xa9\xe4\xb8\xad\xf0\x9f\x98\x80z", json);
+    ASSERT_EQ(json, "\"a\xc3\xa9\xe4\xb8\xad\xf0\x9f\x98\x80z\"");
+    const std::string invalid[] = {
+        "\xff", "\x80", "\xc0\xaf", "\xc3", "\xe0\x80\xaf", "\xed\xa0\x80", "\xf4\x90\x80\x80", "\xe4\xb8"
+    };
+    for (const auto &str : invalid) {
+        json.clear();
+        JsonOutput::AppendString(str + "z", json);
+        ASSERT_EQ(json.find_first_of("\x80\xc0\xc3\xe0\xe4\xed\xf4\xff"), std::string::npos) << json;
+        ASSERT_EQ(json.substr(json.size() - 2), "z\""); // 2: z and the quote
+        ASSERT_EQ(json.find("\\ufffd"), 1u);
+    }
+
+    std::string path = FILE_ROOT + "JSON_HidumperOutputTest030.json";
+    int fd = open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, S_IRUSR | S_IWUSR);
+    ASSERT_TRUE(fd >= 0);
+    {
+        DumpFdWriter writer(fd);
+        JsonOutput::AppendEmptyDocument(writer);
+        ASSERT_TRUE(writer.Flush());
+    }
+    close(fd);
+    std::string actual;
+    ASSERT_TRUE(LoadStringFromFile(path, actual));
+    ASSERT_EQ(actual, "{\"sections\":[]}\n");
+}
+/**
+ * @tc.name: HidumperOutputTest031
+ * @tc.desc: Test options after --zip keep the archive path, and the json sink of --tee writes its own file.
+ * @tc.type: FUNC
+ */
+HWTEST_F(HidumperOutputTest, HidumperOutputTest031, TestSize.Level3)
+{
+    const std::vector<std::vector<std::string>> cmds = {
+        {"hidumper", "--zip", "--tee"}, {"hidumper", "--zip", "--stats"}, {"hidumper", "--tee", "--zip", "--stats"}
+    };
+    std::vector<std::u16string> args;
+    for (const auto &cmd : cmds) {
+        std::vector<std::string> argStrs(cmd);
+        std::vector<char *> argv;
+        for (auto &arg : argStrs) {
+            argv.push_back(&arg[0]);
+        }
+        auto parameter = std::make_shared<DumperParameter>();
+        parameter->setClientCallback(std::make_shared<RawParam>(0, 0, 0, args, -1, nullptr));
+        DumperOpts opts;
+        ASSERT_EQ(DumpImplement::GetInstance().CmdParseWithParameter(parameter, static_cast<int>(argv.size()),
+            argv.data(), opts), DumpStatus::DUMP_OK);
+        ASSERT_TRUE(opts.IsDumpZip());
+        ASSERT_GT(opts.path_.size(), 4u); // 4: size of .zip
+        ASSERT_EQ(opts.path_.substr(opts.path_.size() - 4), ".zip"); // 4: size of .zip
+    }
+    ASSERT_EQ(DumpImplement::GetTeeJsonPath("/data/log/hidumper/a.zip"), "/data/log/hidumper/a.json");
+
+    std::string path = FILE_ROOT + "JSON_HidumperOutputTest031.json";
+    std::string clientPath = FILE_ROOT + "JSON_HidumperOutputTest031_client.txt";
+    int fd = open(clientPath.c_str(), O_WRONLY | O_CREAT | O_TRUNC, S_IRUSR | S_IWUSR);
+    ASSERT_TRUE(fd >= 0);
+    auto parameter = std::make_shared<DumperParameter>();
+    parameter->setClientCallback(std::make_shared<RawParam>(0, 0, 0, args, fd, nullptr));
+    parameter->SetCurrentSection("cpu");
+    auto dump_datas = std::make_shared<std::vector<std::vector<std::string>>>();
+    dump_datas->push_back({"usage"});
+    auto json_output = make_shared<JsonOutput>(path);
+    json_output->SetDumpConfig(std::make_shared<DumpCfg>());
+    ASSERT_TRUE(json_output->PreExecute(parameter, dump_datas) == DumpStatus::DUMP_OK);
+    ASSERT_TRUE(json_output->Execute() == DumpStatus::DUMP_OK);
+    ASSERT_TRUE(json_output->AfterExecute() == DumpStatus::DUMP_OK);
+    json_output->Reset();
+    ASSERT_TRUE(parameter->FlushOutputWriter());
+    close(fd);
+    std::string actual;
+    ASSERT_TRUE(LoadStringFromFile(clientPath, actual));
+    ASSERT_TRUE(actual.empty());
+    ASSERT_TRUE(LoadStringFromFile(path, actual));
+    ASSERT_EQ(actual, "{\"sections\":[\n{\"name\":\"cpu\",\"blocks\":[\n"
+        "{\"type\":\"text\",\"lines\":[\n\"usage\"]}]}]}\n");
+}
 } // namespace HiviewDFX
 } // namespace OHOS
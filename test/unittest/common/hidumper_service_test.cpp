@@ -33,6 +33,8 @@ static const int TEST_LOOP = 100;
 static const int TASK_WAITTIME_MAX = 1;
 static const int TASK_REQUEST_MAX = 1000;
 static const int TASK_WAIT_ONETIME = 100;
+static const int SAMPLER_WAIT_LOOP = 100;
+static const int SAMPLER_WAIT_ONETIME = 10 * 1000;
 static const std::string TEST_ARGV_0 = "hidumper";
 static const std::string TEST_ARGV_1 = "-h";
 static int g_TaskOutfd = -1;
@@ -311,5 +313,41 @@ HWTEST_F (HidumperServiceTest, HidumperServiceTest007, TestSize.Level3)
     // check result
     ASSERT_TRUE(!hasError) << "request error, times = " << hasErrorIndex << ", res = " << hasErrorCode;
 }
+
+/**
+ * @tc.name: HidumperServiceTest008
+ * @tc.desc: Test DumpManagerService cpu info sampler stops when idle and restarts on demand.
+ * @tc.type: FUNC
+ */
+HWTEST_F (HidumperServiceTest, HidumperServiceTest008, TestSize.Level3)
+{
+    auto dmsTest = DelayedSpSingleton<DumpManagerService>::GetInstance();
+    ASSERT_TRUE(dmsTest != nullptr) << "Fail to get DumpManagerService";
+    dmsTest->OnStart();
+    ASSERT_TRUE(dmsTest->IsServiceStarted()) << "DumpManagerService isn't ready";
+    auto handler = dmsTest->GetHandler();
+    ASSERT_TRUE(handler != nullptr) << "Fail to get DumpEventHandler";
+    EXPECT_GT(handler->GetIdleStopTime(), 0);
+    handler->SetIdleStopTime(1); // 1: every tick after a demand is idle
+    handler->NotifyCpuInfoDemand();
+    EXPECT_TRUE(handler->IsCpuInfoSampling());
+    usleep(SAMPLER_WAIT_ONETIME);
+    // the tick finds no demand for longer than the idle time and stops.
+    handler->StartCpuInfoSampler(0);
+    for (int i = 0; (i < SAMPLER_WAIT_LOOP) && handler->IsCpuInfoSampling(); i++) {
+        usleep(SAMPLER_WAIT_ONETIME);
+    }
+    EXPECT_FALSE(handler->IsCpuInfoSampling());
+    // the next demand restarts it.
+    handler->NotifyCpuInfoDemand();
+    EXPECT_TRUE(handler->IsCpuInfoSampling());
+    usleep(SAMPLER_WAIT_ONETIME);
+    // a stop leaves the next demand to take a new base sample.
+    handler->StopCpuInfoSampler();
+    EXPECT_FALSE(handler->IsCpuInfoSampling());
+    handler->SetIdleStopTime(DumpEventHandler::GET_CPU_INFO_IDLE_STOP_TIME);
+    dmsTest->OnStop();
+    ASSERT_TRUE(!dmsTest->IsServiceStarted()) << "DumpManagerService stop fail";
+}
 } // namespace HiviewDFX
 } // namespace OHOS
\ No newline at end of file